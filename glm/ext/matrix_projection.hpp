@@ -130,6 +130,160 @@ namespace glm
 	GLM_FUNC_DECL vec<3, T, Q> unProject(
 		vec<3, T, Q> const& win, mat<4, 4, T, Q> const& model, mat<4, 4, T, Q> const& proj, vec<4, U, Q> const& viewport);
 
+	/// Map an array of object coordinates into window coordinates.
+	/// The near and far clip planes correspond to z normalized device coordinates of 0 and +1 respectively. (Direct3D clip volume definition)
+	///
+	/// The combined matrix is taken once for the whole array and the viewport mapping is folded into a single scale and bias,
+	/// so the per-point cost is one matrix-vector product and one division.
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param wins Array of count window coordinates receiving the results. May alias objs.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see projectZO
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void projectBatchZO(
+		vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport);
+
+	/// Map an array of object coordinates into window coordinates.
+	/// The near and far clip planes correspond to z normalized device coordinates of -1 and +1 respectively. (OpenGL clip volume definition)
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param wins Array of count window coordinates receiving the results. May alias objs.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see projectNO
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void projectBatchNO(
+		vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport);
+
+	/// Map an array of object coordinates into window coordinates using default near and far clip planes definition.
+	/// To change default near and far clip planes definition use GLM_FORCE_DEPTH_ZERO_TO_ONE.
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param wins Array of count window coordinates receiving the results. May alias objs.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see project
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void projectBatch(
+		vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport);
+
+	/// Map an array of object coordinates into window coordinates and only keep the points that land inside the viewport.
+	/// A point is kept when it is in front of the eye, its window x and y are inside the viewport rectangle and its window depth is within [0, 1].
+	/// The near and far clip planes correspond to z normalized device coordinates of 0 and +1 respectively. (Direct3D clip volume definition)
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @param wins Array of at least count elements receiving the visible window coordinates, packed at the front. May alias objs.
+	/// @param indices Optional array of at least count elements receiving the index in objs of each visible point. May be null.
+	/// @return Returns the number of visible points written to wins.
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL std::size_t projectVisibleZO(
+		vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices);
+
+	/// Map an array of object coordinates into window coordinates and only keep the points that land inside the viewport.
+	/// A point is kept when it is in front of the eye, its window x and y are inside the viewport rectangle and its window depth is within [0, 1].
+	/// The near and far clip planes correspond to z normalized device coordinates of -1 and +1 respectively. (OpenGL clip volume definition)
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @param wins Array of at least count elements receiving the visible window coordinates, packed at the front. May alias objs.
+	/// @param indices Optional array of at least count elements receiving the index in objs of each visible point. May be null.
+	/// @return Returns the number of visible points written to wins.
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL std::size_t projectVisibleNO(
+		vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices);
+
+	/// Map an array of object coordinates into window coordinates and only keep the points that land inside the viewport,
+	/// using default near and far clip planes definition.
+	/// To change default near and far clip planes definition use GLM_FORCE_DEPTH_ZERO_TO_ONE.
+	///
+	/// @param objs Array of count object coordinates.
+	/// @param count Number of points to project.
+	/// @param projModel Specifies the combined matrix proj * model
+	/// @param viewport Specifies the current viewport
+	/// @param wins Array of at least count elements receiving the visible window coordinates, packed at the front. May alias objs.
+	/// @param indices Optional array of at least count elements receiving the index in objs of each visible point. May be null.
+	/// @return Returns the number of visible points written to wins.
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL std::size_t projectVisible(
+		vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices);
+
+	/// Map an array of window coordinates into object coordinates.
+	/// The near and far clip planes correspond to z normalized device coordinates of 0 and +1 respectively. (Direct3D clip volume definition)
+	///
+	/// Unlike unProjectZO, the inverse matrix is provided by the caller so it can be computed once and cached across calls.
+	///
+	/// @param wins Array of count window coordinates to be mapped.
+	/// @param objs Array of count object coordinates receiving the results. May alias wins.
+	/// @param count Number of points to unproject.
+	/// @param inverseProjModel Specifies inverse(proj * model)
+	/// @param viewport Specifies the viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see unProjectZO
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void unProjectBatchZO(
+		vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport);
+
+	/// Map an array of window coordinates into object coordinates.
+	/// The near and far clip planes correspond to z normalized device coordinates of -1 and +1 respectively. (OpenGL clip volume definition)
+	///
+	/// Unlike unProjectNO, the inverse matrix is provided by the caller so it can be computed once and cached across calls.
+	///
+	/// @param wins Array of count window coordinates to be mapped.
+	/// @param objs Array of count object coordinates receiving the results. May alias wins.
+	/// @param count Number of points to unproject.
+	/// @param inverseProjModel Specifies inverse(proj * model)
+	/// @param viewport Specifies the viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see unProjectNO
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void unProjectBatchNO(
+		vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport);
+
+	/// Map an array of window coordinates into object coordinates using default near and far clip planes definition.
+	/// To change default near and far clip planes definition use GLM_FORCE_DEPTH_ZERO_TO_ONE.
+	///
+	/// @param wins Array of count window coordinates to be mapped.
+	/// @param objs Array of count object coordinates receiving the results. May alias wins.
+	/// @param count Number of points to unproject.
+	/// @param inverseProjModel Specifies inverse(proj * model)
+	/// @param viewport Specifies the viewport
+	/// @tparam T Native type used for the computation. Currently supported: half (not recommended), float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see unProject
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DECL void unProjectBatch(
+		vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport);
+
 	/// Define a picking region
 	///
 	/// @param center Specify the center of a picking region in window coordinates.
@@ -85,6 +85,158 @@ namespace glm
 #		endif
 	}
 
+	namespace detail
+	{
+		// Window coordinates are an affine function of normalized device coordinates: win = ndc * Scale + Bias.
+		// Folding the viewport and the depth range into Scale and Bias keeps the per point work to a multiply-add.
+		template<typename T, typename U, qualifier Q>
+		GLM_FUNC_QUALIFIER void compute_window_transform(vec<4, U, Q> const& viewport, bool zeroToOne, vec<3, T, Q>& Scale, vec<3, T, Q>& Bias)
+		{
+			T const Half = static_cast<T>(0.5);
+			Scale = vec<3, T, Q>(T(viewport[2]) * Half, T(viewport[3]) * Half, zeroToOne ? static_cast<T>(1) : Half);
+			Bias = vec<3, T, Q>(T(viewport[0]) + Scale.x, T(viewport[1]) + Scale.y, zeroToOne ? static_cast<T>(0) : Half);
+		}
+
+		template<typename T, qualifier Q>
+		GLM_FUNC_QUALIFIER vec<4, T, Q> transform_point(mat<4, 4, T, Q> const& m, vec<3, T, Q> const& p)
+		{
+			return m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3];
+		}
+
+		template<typename T, qualifier Q>
+		GLM_FUNC_QUALIFIER void project_batch(vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& m, vec<3, T, Q> const& Scale, vec<3, T, Q> const& Bias)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				vec<4, T, Q> const Clip = transform_point(m, objs[i]);
+				T const InvW = static_cast<T>(1) / Clip.w;
+				wins[i] = vec<3, T, Q>(Clip) * (Scale * InvW) + Bias;
+			}
+		}
+
+		template<typename T, qualifier Q>
+		GLM_FUNC_QUALIFIER std::size_t project_visible(vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& m, vec<4, T, Q> const& Rect, vec<3, T, Q> const& Scale, vec<3, T, Q> const& Bias, vec<3, T, Q>* wins, std::size_t* indices)
+		{
+			std::size_t Visible = 0;
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				vec<4, T, Q> const Clip = transform_point(m, objs[i]);
+				T const InvW = static_cast<T>(1) / Clip.w;
+				vec<3, T, Q> const Win = vec<3, T, Q>(Clip) * (Scale * InvW) + Bias;
+
+				bool const Keep =
+					Clip.w > static_cast<T>(0) &&
+					Win.x >= Rect.x && Win.x <= Rect.z &&
+					Win.y >= Rect.y && Win.y <= Rect.w &&
+					Win.z >= static_cast<T>(0) && Win.z <= static_cast<T>(1);
+
+				// Always store then advance conditionally: no branch on the visibility test.
+				// The slot at Visible is either a dropped point or i itself, so aliasing objs is safe.
+				wins[Visible] = Win;
+				if(indices)
+					indices[Visible] = i;
+				Visible += Keep ? 1 : 0;
+			}
+			return Visible;
+		}
+
+		template<typename T, typename U, qualifier Q>
+		GLM_FUNC_QUALIFIER std::size_t project_visible(vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& m, vec<4, U, Q> const& viewport, bool zeroToOne, vec<3, T, Q>* wins, std::size_t* indices)
+		{
+			vec<3, T, Q> Scale, Bias;
+			compute_window_transform(viewport, zeroToOne, Scale, Bias);
+			vec<4, T, Q> const Rect(static_cast<T>(viewport[0]), static_cast<T>(viewport[1]), static_cast<T>(viewport[0]) + static_cast<T>(viewport[2]), static_cast<T>(viewport[1]) + static_cast<T>(viewport[3]));
+			return project_visible(objs, count, m, Rect, Scale, Bias, wins, indices);
+		}
+
+		template<typename T, typename U, qualifier Q>
+		GLM_FUNC_QUALIFIER void unproject_batch(vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inv, vec<4, U, Q> const& viewport, bool zeroToOne)
+		{
+			vec<3, T, Q> Scale, Bias;
+			compute_window_transform(viewport, zeroToOne, Scale, Bias);
+
+			// Invert win = ndc * Scale + Bias once for the whole array
+			vec<3, T, Q> const InvScale = static_cast<T>(1) / Scale;
+			vec<3, T, Q> const InvBias = -Bias * InvScale;
+
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				vec<4, T, Q> const Obj = transform_point(inv, wins[i] * InvScale + InvBias);
+				objs[i] = vec<3, T, Q>(Obj) * (static_cast<T>(1) / Obj.w);
+			}
+		}
+	}//namespace detail
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void projectBatchZO(vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport)
+	{
+		vec<3, T, Q> Scale, Bias;
+		detail::compute_window_transform(viewport, true, Scale, Bias);
+		detail::project_batch(objs, wins, count, projModel, Scale, Bias);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void projectBatchNO(vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport)
+	{
+		vec<3, T, Q> Scale, Bias;
+		detail::compute_window_transform(viewport, false, Scale, Bias);
+		detail::project_batch(objs, wins, count, projModel, Scale, Bias);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void projectBatch(vec<3, T, Q> const* objs, vec<3, T, Q>* wins, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport)
+	{
+#		if GLM_CONFIG_CLIP_CONTROL & GLM_CLIP_CONTROL_ZO_BIT
+			projectBatchZO(objs, wins, count, projModel, viewport);
+#		else
+			projectBatchNO(objs, wins, count, projModel, viewport);
+#		endif
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t projectVisibleZO(vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices)
+	{
+		return detail::project_visible(objs, count, projModel, viewport, true, wins, indices);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t projectVisibleNO(vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices)
+	{
+		return detail::project_visible(objs, count, projModel, viewport, false, wins, indices);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t projectVisible(vec<3, T, Q> const* objs, std::size_t count, mat<4, 4, T, Q> const& projModel, vec<4, U, Q> const& viewport, vec<3, T, Q>* wins, std::size_t* indices)
+	{
+#		if GLM_CONFIG_CLIP_CONTROL & GLM_CLIP_CONTROL_ZO_BIT
+			return projectVisibleZO(objs, count, projModel, viewport, wins, indices);
+#		else
+			return projectVisibleNO(objs, count, projModel, viewport, wins, indices);
+#		endif
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectBatchZO(vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport)
+	{
+		detail::unproject_batch(wins, objs, count, inverseProjModel, viewport, true);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectBatchNO(vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport)
+	{
+		detail::unproject_batch(wins, objs, count, inverseProjModel, viewport, false);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectBatch(vec<3, T, Q> const* wins, vec<3, T, Q>* objs, std::size_t count, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport)
+	{
+#		if GLM_CONFIG_CLIP_CONTROL & GLM_CLIP_CONTROL_ZO_BIT
+			unProjectBatchZO(wins, objs, count, inverseProjModel, viewport);
+#		else
+			unProjectBatchNO(wins, objs, count, inverseProjModel, viewport);
+#		endif
+	}
+
 	template<typename T, qualifier Q, typename U>
 	GLM_FUNC_QUALIFIER mat<4, 4, T, Q> pickMatrix(vec<2, T, Q> const& center, vec<2, T, Q> const& delta, vec<4, U, Q> const& viewport)
 	{
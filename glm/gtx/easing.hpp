@@ -13,6 +13,8 @@
 /// All functions take a parameter x in the range [0.0,1.0]
 ///
 /// Based on the AHEasing project of Warren Moore (https://github.com/warrenm/AHEasing)
+///
+/// easingBatch evaluates any of them, selected by easing_function, over arrays of values.
 
 #pragma once
 
@@ -211,6 +213,33 @@ namespace glm{
 	template <typename genType>
 	GLM_FUNC_DECL genType bounceEaseInOut(genType const& a);
 
+	/// Easing functions accepted by easingBatch.
+	/// easing_quadratic_in names quadraticEaseIn, and so on. The back functions use the default overshoot.
+	/// @see gtx_easing
+	enum easing_function
+	{
+		easing_linear,
+		easing_quadratic_in, easing_quadratic_out, easing_quadratic_in_out,
+		easing_cubic_in, easing_cubic_out, easing_cubic_in_out,
+		easing_quartic_in, easing_quartic_out, easing_quartic_in_out,
+		easing_quintic_in, easing_quintic_out, easing_quintic_in_out,
+		easing_sine_in, easing_sine_out, easing_sine_in_out,
+		easing_circular_in, easing_circular_out, easing_circular_in_out,
+		easing_exponential_in, easing_exponential_out, easing_exponential_in_out,
+		easing_elastic_in, easing_elastic_out, easing_elastic_in_out,
+		easing_back_in, easing_back_out, easing_back_in_out,
+		easing_bounce_in, easing_bounce_out, easing_bounce_in_out
+	};
+
+	/// Evaluates an easing function over count values in [0, 1]: out[i] is the scalar function of the given kind at in[i].
+	/// The function is dispatched once per call to a branchless loop the compiler can vectorize.
+	/// The sine and exponential functions use polynomial approximations instead of sin and pow,
+	/// within a few ulps of them.
+	/// in and out may be the same array.
+	/// @see gtx_easing
+	template <typename T>
+	GLM_FUNC_DECL void easingBatch(easing_function function, T const* in, std::size_t count, T* out);
+
 	/// @}
 }//namespace glm
 
@@ -1,6 +1,8 @@
 /// @ref gtx_easing
 
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace glm{
 
@@ -433,4 +435,252 @@ namespace glm{
 		}
 	}
 
+	namespace detail
+	{
+		// 2^n for an integer n within the normal exponent range, built from the exponent bits
+		GLM_FUNC_QUALIFIER float compute_easing_exp2i(int n, float)
+		{
+			int const Bits = (n + 127) << 23;
+			float Result;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		GLM_FUNC_QUALIFIER double compute_easing_exp2i(int n, double)
+		{
+			detail::int64 const Bits = static_cast<detail::int64>(n + 1023) << 52;
+			double Result;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		// 2^x for |x| < 126: 2^round(x) times the degree 12 Taylor polynomial of e^(f ln 2), f in [-1/2, 1/2]
+		template<typename T>
+		GLM_FUNC_QUALIFIER T compute_easing_exp2(T x)
+		{
+			int const n = static_cast<int>(x + static_cast<T>(128.5)) - 128;
+			T const f = (x - static_cast<T>(n)) * static_cast<T>(0.69314718055994530942);
+
+			T p = static_cast<T>(1.0 / 479001600.0);
+			p = p * f + static_cast<T>(1.0 / 39916800.0);
+			p = p * f + static_cast<T>(1.0 / 3628800.0);
+			p = p * f + static_cast<T>(1.0 / 362880.0);
+			p = p * f + static_cast<T>(1.0 / 40320.0);
+			p = p * f + static_cast<T>(1.0 / 5040.0);
+			p = p * f + static_cast<T>(1.0 / 720.0);
+			p = p * f + static_cast<T>(1.0 / 120.0);
+			p = p * f + static_cast<T>(1.0 / 24.0);
+			p = p * f + static_cast<T>(1.0 / 6.0);
+			p = p * f + static_cast<T>(0.5);
+			p = p * f + static_cast<T>(1);
+			p = p * f + static_cast<T>(1);
+			return p * compute_easing_exp2i(n, x);
+		}
+
+		// sin(x) for |x| < 128 pi: reduced by the nearest multiple of pi (in two parts), then the degree 21 Taylor polynomial
+		template<typename T>
+		GLM_FUNC_QUALIFIER T compute_easing_sin(T x)
+		{
+			T const q = x * static_cast<T>(0.31830988618379067154);
+			int const k = static_cast<int>(q + static_cast<T>(128.5)) - 128;
+			T const r = (x - static_cast<T>(k) * static_cast<T>(3.140625)) - static_cast<T>(k) * static_cast<T>(9.67653589793238462643e-4);
+			T const r2 = r * r;
+
+			T p = static_cast<T>(1.0 / 51090942171709440000.0);
+			p = p * r2 - static_cast<T>(1.0 / 121645100408832000.0);
+			p = p * r2 + static_cast<T>(1.0 / 355687428096000.0);
+			p = p * r2 - static_cast<T>(1.0 / 1307674368000.0);
+			p = p * r2 + static_cast<T>(1.0 / 6227020800.0);
+			p = p * r2 - static_cast<T>(1.0 / 39916800.0);
+			p = p * r2 + static_cast<T>(1.0 / 362880.0);
+			p = p * r2 - static_cast<T>(1.0 / 5040.0);
+			p = p * r2 + static_cast<T>(1.0 / 120.0);
+			p = p * r2 - static_cast<T>(1.0 / 6.0);
+			p = (p * r2 + static_cast<T>(1)) * r;
+			return p * static_cast<T>(1 - 2 * (k & 1));
+		}
+
+		template<typename T>
+		GLM_FUNC_QUALIFIER T compute_easing_bounce_out(T a)
+		{
+			// The four parabolas of bounceEaseOut, selected by coefficients
+			bool const A = a < static_cast<T>(4.0 / 11.0);
+			bool const B = a < static_cast<T>(8.0 / 11.0);
+			bool const C = a < static_cast<T>(9.0 / 10.0);
+			T const c2 = A ? static_cast<T>(121.0 / 16.0) : B ? static_cast<T>(363.0 / 40.0) : C ? static_cast<T>(4356.0 / 361.0) : static_cast<T>(54.0 / 5.0);
+			T const c1 = A ? static_cast<T>(0) : B ? static_cast<T>(-99.0 / 10.0) : C ? static_cast<T>(-35442.0 / 1805.0) : static_cast<T>(-513.0 / 25.0);
+			T const c0 = A ? static_cast<T>(0) : B ? static_cast<T>(17.0 / 5.0) : C ? static_cast<T>(16061.0 / 1805.0) : static_cast<T>(268.0 / 25.0);
+			return (c2 * a + c1) * a + c0;
+		}
+
+		// Branchless form of the easing functions. Function is a constant, so the switch folds away in each easing_loop.
+		template<easing_function Function, typename T>
+		GLM_FUNC_QUALIFIER T compute_easing(T a)
+		{
+			T const Half = static_cast<T>(0.5);
+			T const One = static_cast<T>(1);
+			T const Two = static_cast<T>(2);
+			// 0 below one half and 1 above, from the integer part of 2a in {0, 1, 2} for a in [0, 1].
+			// The piecewise functions select their halves arithmetically, without a comparison the compiler could turn into a branch.
+			int const Twice = static_cast<int>(a + a);
+			T const High = static_cast<T>(Twice - (Twice >> 1));
+			T const f = a - One;
+
+			switch(Function)
+			{
+			default:
+			case easing_linear:
+				return a;
+			case easing_quadratic_in:
+				return a * a;
+			case easing_quadratic_out:
+				return -(a * (a - Two));
+			case easing_quadratic_in_out:
+				return (Two - static_cast<T>(4) * High) * a * a + static_cast<T>(4) * High * a - High;
+			case easing_cubic_in:
+				return a * a * a;
+			case easing_cubic_out:
+				return f * f * f + One;
+			case easing_cubic_in_out:
+			{
+				T const g = Two * a - Two * High;
+				return Half * g * g * g + High;
+			}
+			case easing_quartic_in:
+				return a * a * a * a;
+			case easing_quartic_out:
+				return f * f * f * (One - a) + One;
+			case easing_quartic_in_out:
+			{
+				T const g = a - High;
+				return (static_cast<T>(8) - static_cast<T>(16) * High) * g * g * g * g + High;
+			}
+			case easing_quintic_in:
+				return a * a * a * a * a;
+			case easing_quintic_out:
+				return f * f * f * f * f + One;
+			case easing_quintic_in_out:
+			{
+				T const g = Two * a - Two * High;
+				return Half * g * g * g * g * g + High;
+			}
+			case easing_sine_in:
+			{
+				// 1 - cos(a pi / 2) without the cancellation near 0
+				T const s = compute_easing_sin(a * quarter_pi<T>());
+				return Two * s * s;
+			}
+			case easing_sine_out:
+				return compute_easing_sin(a * half_pi<T>());
+			case easing_sine_in_out:
+			{
+				// (1 - cos(a pi)) / 2
+				T const s = compute_easing_sin(a * half_pi<T>());
+				return s * s;
+			}
+			case easing_circular_in:
+				return One - std::sqrt(One - (a * a));
+			case easing_circular_out:
+				return std::sqrt((Two - a) * a);
+			case easing_circular_in_out:
+			{
+				// (1 - 2a)(1 + 2a) below one half, (3 - 2a)(2a - 1) above
+				T const r = std::sqrt((One + Two * High - Two * a) * (One - Two * High + Two * a));
+				return Half + (High - Half) * r;
+			}
+			case easing_exponential_in:
+			{
+				// exponentialEaseIn returns 0 at 0: the factor is 0 there and rounds to 1 for a above 2^-100 or so
+				T const Tiny = std::numeric_limits<T>::min();
+				return compute_easing_exp2(static_cast<T>(10) * f) * (a / (a + Tiny));
+			}
+			case easing_exponential_out:
+			{
+				// exponentialEaseOut returns 1 at 1: the factor is 0 there and 1 for any other a
+				T const Tiny = std::numeric_limits<T>::min();
+				return One - compute_easing_exp2(-static_cast<T>(10) * a) * (-f / (-f + Tiny));
+			}
+			case easing_exponential_in_out:
+			{
+				T const Sign = One - Two * High;
+				return High + Sign * Half * compute_easing_exp2(Sign * (static_cast<T>(20) * a - static_cast<T>(10)));
+			}
+			case easing_elastic_in:
+				return compute_easing_sin(static_cast<T>(13) * half_pi<T>() * a) * compute_easing_exp2(static_cast<T>(10) * f);
+			case easing_elastic_out:
+				return compute_easing_sin(-static_cast<T>(13) * half_pi<T>() * (a + One)) * compute_easing_exp2(-static_cast<T>(10) * a) + One;
+			case easing_elastic_in_out:
+			{
+				T const Sign = One - Two * High;
+				T const e = Half * compute_easing_sin(Sign * static_cast<T>(13) * pi<T>() * a) * compute_easing_exp2(Sign * static_cast<T>(10) * (Two * a - One));
+				return e + High;
+			}
+			case easing_back_in:
+			{
+				T const o = static_cast<T>(1.70158);
+				return a * a * (((o + One) * a) - o);
+			}
+			case easing_back_out:
+			{
+				T const o = static_cast<T>(1.70158);
+				return f * f * (((o + One) * f) + o) + One;
+			}
+			case easing_back_in_out:
+			{
+				T const s = static_cast<T>(1.70158) * static_cast<T>(1.525);
+				T const n = Two * a - Two * High;
+				T const m = n * n * (((s + One) * n) + s * (Two * High - One));
+				return Half * m + High;
+			}
+			case easing_bounce_in:
+				return One - compute_easing_bounce_out(One - a);
+			case easing_bounce_out:
+				return compute_easing_bounce_out(a);
+			case easing_bounce_in_out:
+			{
+				T const Sign = Two * High - One;
+				return Half + Sign * Half * compute_easing_bounce_out(Sign * (Two * a - One));
+			}
+			}
+		}
+
+		template<easing_function Function, typename T>
+		GLM_FUNC_QUALIFIER void easing_loop(T const* In, std::size_t Count, T* Out)
+		{
+			// Whole blocks go through a local buffer, so their loops need no aliasing checks between In and Out
+			std::size_t First = 0;
+			for(; First + 16 <= Count; First += 16)
+			{
+				T Block[16];
+				for(std::size_t i = 0; i < 16; ++i)
+					Block[i] = compute_easing<Function>(In[First + i]);
+				for(std::size_t i = 0; i < 16; ++i)
+					Out[First + i] = Block[i];
+			}
+			for(; First < Count; ++First)
+				Out[First] = compute_easing<Function>(In[First]);
+		}
+	}//namespace detail
+
+	template <typename T>
+	GLM_FUNC_QUALIFIER void easingBatch(easing_function function, T const* in, std::size_t count, T* out)
+	{
+		typedef void (*loop)(T const*, std::size_t, T*);
+		static loop const Loops[] =
+		{
+			detail::easing_loop<easing_linear, T>,
+			detail::easing_loop<easing_quadratic_in, T>, detail::easing_loop<easing_quadratic_out, T>, detail::easing_loop<easing_quadratic_in_out, T>,
+			detail::easing_loop<easing_cubic_in, T>, detail::easing_loop<easing_cubic_out, T>, detail::easing_loop<easing_cubic_in_out, T>,
+			detail::easing_loop<easing_quartic_in, T>, detail::easing_loop<easing_quartic_out, T>, detail::easing_loop<easing_quartic_in_out, T>,
+			detail::easing_loop<easing_quintic_in, T>, detail::easing_loop<easing_quintic_out, T>, detail::easing_loop<easing_quintic_in_out, T>,
+			detail::easing_loop<easing_sine_in, T>, detail::easing_loop<easing_sine_out, T>, detail::easing_loop<easing_sine_in_out, T>,
+			detail::easing_loop<easing_circular_in, T>, detail::easing_loop<easing_circular_out, T>, detail::easing_loop<easing_circular_in_out, T>,
+			detail::easing_loop<easing_exponential_in, T>, detail::easing_loop<easing_exponential_out, T>, detail::easing_loop<easing_exponential_in_out, T>,
+			detail::easing_loop<easing_elastic_in, T>, detail::easing_loop<easing_elastic_out, T>, detail::easing_loop<easing_elastic_in_out, T>,
+			detail::easing_loop<easing_back_in, T>, detail::easing_loop<easing_back_out, T>, detail::easing_loop<easing_back_in_out, T>,
+			detail::easing_loop<easing_bounce_in, T>, detail::easing_loop<easing_bounce_out, T>, detail::easing_loop<easing_bounce_in_out, T>
+		};
+
+		Loops[function](in, count, out);
+	}
 }//namespace glm
@@ -12,11 +12,15 @@
 ///
 /// Extraction of Euler angles from rotation matrix.
 /// Based on the original paper 2014 Mike Day - Extracting Euler Angles from a Rotation Matrix.
+///
+/// Batched construction and extraction over arrays of angles for the 12 rotation orders.
+/// Based on Ken Shoemake 1994 - Euler Angle Conversion, Graphics Gems IV.
 
 #pragma once
 
 // Dependency:
 #include "../glm.hpp"
+#include "../detail/type_quat.hpp"
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #	error "GLM: GLM_GTX_euler_angles is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
@@ -327,6 +331,54 @@ namespace glm
 											T & t2,
 											T & t3);
 
+	/// Rotation orders accepted by the batched Euler angle functions.
+	/// euler_xyz names the (X * Y * Z) order of eulerAngleXYZ and extractEulerAngleXYZ, and so on.
+	/// @see gtx_euler_angles
+	enum euler_order
+	{
+		euler_xyz, euler_xzy, euler_yxz, euler_yzx, euler_zxy, euler_zyx,
+		euler_xyx, euler_xzx, euler_yxy, euler_yzy, euler_zxz, euler_zyz
+	};
+
+	/// Creates count 3 * 3 rotation matrices from structure of arrays Euler angles.
+	/// out[i] is the matrix returned by the eulerAngle function of the given order for (t1[i], t2[i], t3[i]).
+	/// The order is dispatched once per call and the sines and cosines are evaluated in blocks ahead of the matrix assembly.
+	/// @see gtx_euler_angles
+	template<typename T>
+	GLM_FUNC_DECL void eulerAngleBatch(euler_order order,
+		T const* t1, T const* t2, T const* t3, std::size_t count,
+		mat<3, 3, T, defaultp>* out);
+
+	/// Creates count 4 * 4 homogeneous rotation matrices from structure of arrays Euler angles.
+	/// out[i] is the matrix returned by the eulerAngle function of the given order for (t1[i], t2[i], t3[i]).
+	/// @see gtx_euler_angles
+	template<typename T>
+	GLM_FUNC_DECL void eulerAngleBatch(euler_order order,
+		T const* t1, T const* t2, T const* t3, std::size_t count,
+		mat<4, 4, T, defaultp>* out);
+
+	/// Creates count rotation quaternions from structure of arrays Euler angles.
+	/// out[i] represents the rotation of the eulerAngle function of the given order for (t1[i], t2[i], t3[i]).
+	/// @see gtx_euler_angles
+	template<typename T>
+	GLM_FUNC_DECL void eulerAngleBatch(euler_order order,
+		T const* t1, T const* t2, T const* t3, std::size_t count,
+		qua<T, defaultp>* out);
+
+	/// Extracts the Euler angles of the given order from count 3 * 3 rotation matrices into structure of arrays outputs.
+	/// @see gtx_euler_angles
+	template<typename T>
+	GLM_FUNC_DECL void extractEulerAngleBatch(euler_order order,
+		mat<3, 3, T, defaultp> const* M, std::size_t count,
+		T* t1, T* t2, T* t3);
+
+	/// Extracts the Euler angles of the given order from count 4 * 4 rotation matrices into structure of arrays outputs.
+	/// @see gtx_euler_angles
+	template<typename T>
+	GLM_FUNC_DECL void extractEulerAngleBatch(euler_order order,
+		mat<4, 4, T, defaultp> const* M, std::size_t count,
+		T* t1, T* t2, T* t3);
+
 	/// @}
 }//namespace glm
 
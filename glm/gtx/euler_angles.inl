@@ -896,4 +896,197 @@ namespace glm
 		t2 = T2;
 		t3 = T3;
 	}
+
+	namespace detail
+	{
+		// Every rotation order is a relabelling of the axes of either X * Y * Z (Tait-Bryan) or X * Y * X (proper Euler).
+		// Axis holds the axes playing the roles of X, Y and Z. Odd permutations flip the handedness,
+		// which is the same as negating the angles of the base order (Shoemake).
+		struct euler_axes
+		{
+			length_t Axis[3];
+			bool Odd;
+			bool Repeat;
+		};
+
+		GLM_FUNC_QUALIFIER euler_axes compute_euler_axes(euler_order Order)
+		{
+			static length_t const Table[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+			int const Index = static_cast<int>(Order);
+			euler_axes Result;
+			Result.Repeat = Index >= static_cast<int>(euler_xyx);
+			for(int i = 0; i < 3; ++i)
+				Result.Axis[i] = Table[Index % 6][i];
+			Result.Odd = Result.Axis[1] != (Result.Axis[0] + 1) % 3;
+			return Result;
+		}
+
+		template<typename T>
+		GLM_FUNC_QUALIFIER void compute_euler_sincos(T const* Angles, std::size_t Count, T Scale, T* Sin, T* Cos)
+		{
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				T const Angle = Angles[i] * Scale;
+				Sin[i] = glm::sin(Angle);
+				Cos[i] = glm::cos(Angle);
+			}
+		}
+
+		template<typename T, typename matType>
+		GLM_FUNC_QUALIFIER void compute_euler_rotation(euler_axes const& Axes, T ca, T sa, T cb, T sb, T cc, T sc, matType& m)
+		{
+			// Base matrix in row, column order
+			T B[3][3];
+			if(Axes.Repeat)
+			{
+				B[0][0] = cb;       B[0][1] = sb * sc;                B[0][2] = sb * cc;
+				B[1][0] = sa * sb;  B[1][1] = ca * cc - sa * cb * sc; B[1][2] =-ca * sc - sa * cb * cc;
+				B[2][0] =-ca * sb;  B[2][1] = sa * cc + ca * cb * sc; B[2][2] = ca * cb * cc - sa * sc;
+			}
+			else
+			{
+				B[0][0] = cb * cc;                B[0][1] =-cb * sc;                B[0][2] = sb;
+				B[1][0] = sa * sb * cc + ca * sc; B[1][1] = ca * cc - sa * sb * sc; B[1][2] =-sa * cb;
+				B[2][0] = sa * sc - ca * sb * cc; B[2][1] = ca * sb * sc + sa * cc; B[2][2] = ca * cb;
+			}
+
+			for(length_t r = 0; r < 3; ++r)
+			for(length_t c = 0; c < 3; ++c)
+				m[Axes.Axis[c]][Axes.Axis[r]] = B[r][c];
+		}
+
+		template<typename T>
+		GLM_FUNC_QUALIFIER void compute_euler_rotation(euler_axes const& Axes, T ca, T sa, T cb, T sb, T cc, T sc, qua<T, defaultp>& q)
+		{
+			// Product of the three axis quaternions of the base order, from half angles
+			T W, V[3];
+			if(Axes.Repeat)
+			{
+				W    = ca * cb * cc - sa * cb * sc;
+				V[0] = sa * cb * cc + ca * cb * sc;
+				V[1] = ca * sb * cc + sa * sb * sc;
+				V[2] = sa * sb * cc - ca * sb * sc;
+			}
+			else
+			{
+				W    = ca * cb * cc - sa * sb * sc;
+				V[0] = sa * cb * cc + ca * sb * sc;
+				V[1] = ca * sb * cc - sa * cb * sc;
+				V[2] = sa * sb * cc + ca * cb * sc;
+			}
+
+			// Relabelling the axes with an odd permutation also flips the vector part
+			T const Sign = Axes.Odd ? static_cast<T>(-1) : static_cast<T>(1);
+			T Out[3];
+			for(length_t i = 0; i < 3; ++i)
+				Out[Axes.Axis[i]] = V[i] * Sign;
+
+			q.w = W;
+			q.x = Out[0];
+			q.y = Out[1];
+			q.z = Out[2];
+		}
+
+		template<typename T, typename outType>
+		GLM_FUNC_QUALIFIER void compute_euler_angle_batch(euler_order Order, T const* t1, T const* t2, T const* t3, std::size_t count, T Scale, outType* out)
+		{
+			std::size_t const BlockSize = 16;
+
+			euler_axes const Axes = compute_euler_axes(Order);
+			if(Axes.Odd)
+				Scale = -Scale;
+
+			T S1[BlockSize], C1[BlockSize], S2[BlockSize], C2[BlockSize], S3[BlockSize], C3[BlockSize];
+			for(std::size_t Base = 0; Base < count; Base += BlockSize)
+			{
+				std::size_t const Count = count - Base < BlockSize ? count - Base : BlockSize;
+
+				// Evaluate the sines and cosines of the block as contiguous streams first
+				compute_euler_sincos(t1 + Base, Count, Scale, S1, C1);
+				compute_euler_sincos(t2 + Base, Count, Scale, S2, C2);
+				compute_euler_sincos(t3 + Base, Count, Scale, S3, C3);
+
+				for(std::size_t i = 0; i < Count; ++i)
+					compute_euler_rotation(Axes, C1[i], S1[i], C2[i], S2[i], C3[i], S3[i], out[Base + i]);
+			}
+		}
+
+		template<typename T, typename matType>
+		GLM_FUNC_QUALIFIER void compute_extract_euler_angle(euler_axes const& Axes, matType const& m, T& t1, T& t2, T& t3)
+		{
+			// Base matrix in row, column order
+			T B[3][3];
+			for(length_t r = 0; r < 3; ++r)
+			for(length_t c = 0; c < 3; ++c)
+				B[r][c] = m[Axes.Axis[c]][Axes.Axis[r]];
+
+			T const Sign = Axes.Odd ? static_cast<T>(-1) : static_cast<T>(1);
+
+			T A1, A2, A3;
+			if(Axes.Repeat)
+			{
+				// Pick the solution whose middle angle ends up in [0, pi] once the sign is restored
+				A1 = glm::atan2(B[1][0] * Sign, -B[2][0] * Sign);
+				T const S2 = glm::sqrt(B[0][1] * B[0][1] + B[0][2] * B[0][2]) * Sign;
+				A2 = glm::atan2(S2, B[0][0]);
+				T const S1 = glm::sin(A1);
+				T const C1 = glm::cos(A1);
+				A3 = glm::atan2(-C1 * B[1][2] - S1 * B[2][2], C1 * B[1][1] + S1 * B[2][1]);
+			}
+			else
+			{
+				A1 = glm::atan2(-B[1][2], B[2][2]);
+				T const C2 = glm::sqrt(B[0][0] * B[0][0] + B[0][1] * B[0][1]);
+				A2 = glm::atan2(B[0][2], C2);
+				T const S1 = glm::sin(A1);
+				T const C1 = glm::cos(A1);
+				A3 = glm::atan2(C1 * B[1][0] + S1 * B[2][0], C1 * B[1][1] + S1 * B[2][1]);
+			}
+
+			t1 = A1 * Sign;
+			t2 = A2 * Sign;
+			t3 = A3 * Sign;
+		}
+
+		template<typename T, typename matType>
+		GLM_FUNC_QUALIFIER void compute_extract_euler_angle_batch(euler_order Order, matType const* M, std::size_t count, T* t1, T* t2, T* t3)
+		{
+			euler_axes const Axes = compute_euler_axes(Order);
+			for(std::size_t i = 0; i < count; ++i)
+				compute_extract_euler_angle(Axes, M[i], t1[i], t2[i], t3[i]);
+		}
+	}//namespace detail
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void eulerAngleBatch(euler_order order, T const* t1, T const* t2, T const* t3, std::size_t count, mat<3, 3, T, defaultp>* out)
+	{
+		detail::compute_euler_angle_batch(order, t1, t2, t3, count, static_cast<T>(1), out);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void eulerAngleBatch(euler_order order, T const* t1, T const* t2, T const* t3, std::size_t count, mat<4, 4, T, defaultp>* out)
+	{
+		for(std::size_t i = 0; i < count; ++i)
+			out[i] = mat<4, 4, T, defaultp>(static_cast<T>(1));
+		detail::compute_euler_angle_batch(order, t1, t2, t3, count, static_cast<T>(1), out);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void eulerAngleBatch(euler_order order, T const* t1, T const* t2, T const* t3, std::size_t count, qua<T, defaultp>* out)
+	{
+		detail::compute_euler_angle_batch(order, t1, t2, t3, count, static_cast<T>(0.5), out);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void extractEulerAngleBatch(euler_order order, mat<3, 3, T, defaultp> const* M, std::size_t count, T* t1, T* t2, T* t3)
+	{
+		detail::compute_extract_euler_angle_batch(order, M, count, t1, t2, t3);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void extractEulerAngleBatch(euler_order order, mat<4, 4, T, defaultp> const* M, std::size_t count, T* t1, T* t2, T* t3)
+	{
+		detail::compute_extract_euler_angle_batch(order, M, count, t1, t2, t3);
+	}
 }//namespace glm
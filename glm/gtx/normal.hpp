@@ -3,18 +3,27 @@
 ///
 /// @see core (dependence)
 /// @see gtx_extented_min_max (dependence)
+/// @see gtx_orthonormalize (dependence)
 ///
 /// @defgroup gtx_normal GLM_GTX_normal
 /// @ingroup gtx
 ///
 /// Include <glm/gtx/normal.hpp> to use the features of this extension.
 ///
-/// Compute the normal of a triangle.
+/// Compute the normal of a triangle, and the vertex normals and tangent frames of indexed triangle meshes.
+///
+/// Mesh attributes are accumulated per vertex. To split the work of a large mesh, give each partition of
+/// triangles its own zero initialized accumulation buffer, then sum the buffers with reduceVertexAttributes:
+/// no two partitions write the same memory, so no atomic operation is needed.
 
 #pragma once
 
 // Dependency:
 #include "../glm.hpp"
+#include "../ext/scalar_constants.hpp"
+#include "../ext/scalar_uint_sized.hpp"
+#include "../gtx/orthonormalize.hpp"
+#include <vector>
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #	error "GLM: GLM_GTX_normal is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
@@ -33,6 +42,65 @@ namespace glm
 	template<typename T, qualifier Q>
 	GLM_FUNC_DECL vec<3, T, Q> triangleNormal(vec<3, T, Q> const& p1, vec<3, T, Q> const& p2, vec<3, T, Q> const& p3);
 
+	/// Computes the unit normals of TriangleCount triangles, given by three indices each, as triangleNormal.
+	///
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void triangleNormalBatch(vec<3, T, Q> const* Positions, uint32 const* Indices, std::size_t TriangleCount, vec<3, T, Q>* Normals);
+
+	/// Adds the area weighted normal of the triangles [FirstTriangle, FirstTriangle + TriangleCount) to the normal of their vertices.
+	///
+	/// @param Accum One entry per vertex, initialized by the caller
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void accumulateVertexNormals(vec<3, T, Q> const* Positions, uint32 const* Indices, std::size_t FirstTriangle, std::size_t TriangleCount, vec<3, T, Q>* Accum);
+
+	/// Adds the area weighted tangent and bitangent of the triangles [FirstTriangle, FirstTriangle + TriangleCount) to those of their vertices.
+	/// Tangents follow the increasing u texture coordinate and bitangents the increasing v texture coordinate.
+	///
+	/// @param TangentAccum One entry per vertex, initialized by the caller
+	/// @param BitangentAccum One entry per vertex, initialized by the caller
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void accumulateVertexTangents(vec<3, T, Q> const* Positions, vec<2, T, Q> const* TexCoords, uint32 const* Indices, std::size_t FirstTriangle, std::size_t TriangleCount, vec<3, T, Q>* TangentAccum, vec<3, T, Q>* BitangentAccum);
+
+	/// Sums PartitionCount per partition accumulation buffers: Out[i] = sum of Partials[p * Stride + i] for i in [0, Count).
+	///
+	/// Stride is the vertex count of the mesh, passing Partials + First, Out + First and a vertex Count reduces a range of vertices only.
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void reduceVertexAttributes(vec<3, T, Q> const* Partials, std::size_t PartitionCount, std::size_t Stride, std::size_t Count, vec<3, T, Q>* Out);
+
+	/// Normalizes Count accumulated normals in place. Null normals, of vertices referenced by no triangle, are left null.
+	///
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void normalizeVertexNormals(vec<3, T, Q>* Normals, std::size_t Count);
+
+	/// Builds Count tangent frames from unit normals and accumulated tangents and bitangents.
+	///
+	/// Tangents are orthonormalized against the normal with orthonormalize, the w component stores the handedness,
+	/// such that bitangent = cross(normal, tangent.xyz) * tangent.w. Degenerate tangents are replaced by an arbitrary
+	/// unit vector orthogonal to the normal.
+	///
+	/// @see gtx_normal
+	/// @see gtx_orthonormalize
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void orthonormalizeTangents(vec<3, T, Q> const* Normals, vec<3, T, Q> const* Tangents, vec<3, T, Q> const* Bitangents, std::size_t Count, vec<4, T, Q>* Out);
+
+	/// Computes the unit vertex normals of an indexed triangle mesh, weighting each face normal by the triangle area.
+	///
+	/// @see gtx_normal
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void computeVertexNormals(vec<3, T, Q> const* Positions, std::size_t VertexCount, uint32 const* Indices, std::size_t TriangleCount, vec<3, T, Q>* Normals);
+
+	/// Computes the vertex tangent frames of an indexed triangle mesh from its unit vertex normals and texture coordinates.
+	///
+	/// @see gtx_normal
+	/// @see orthonormalizeTangents
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void computeVertexTangents(vec<3, T, Q> const* Positions, vec<3, T, Q> const* Normals, vec<2, T, Q> const* TexCoords, std::size_t VertexCount, uint32 const* Indices, std::size_t TriangleCount, vec<4, T, Q>* Tangents);
+
 	/// @}
 }//namespace glm
 
@@ -1,7 +1,48 @@
 /// @ref gtx_normal
 
-namespace glm
+namespace glm{
+namespace detail
 {
+	// Unnormalized normals, twice the area of the triangles, computed in blocks of structure of arrays
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void compute_triangle_normals(vec<3, T, Q> const* Positions, uint32 const* Indices, std::size_t Count, vec<3, T, Q>* Out)
+	{
+		std::size_t const BlockSize = 16;
+
+		T E1x[BlockSize], E1y[BlockSize], E1z[BlockSize];
+		T E2x[BlockSize], E2y[BlockSize], E2z[BlockSize];
+		for(std::size_t Base = 0; Base < Count; Base += BlockSize)
+		{
+			std::size_t const BlockCount = Count - Base < BlockSize ? Count - Base : BlockSize;
+
+			// Gather the edges of the block
+			for(std::size_t i = 0; i < BlockCount; ++i)
+			{
+				uint32 const* Triangle = Indices + (Base + i) * 3;
+				vec<3, T, Q> const& P1 = Positions[Triangle[0]];
+				vec<3, T, Q> const E1 = Positions[Triangle[1]] - P1;
+				vec<3, T, Q> const E2 = Positions[Triangle[2]] - P1;
+				E1x[i] = E1.x; E1y[i] = E1.y; E1z[i] = E1.z;
+				E2x[i] = E2.x; E2y[i] = E2.y; E2z[i] = E2.z;
+			}
+
+			for(std::size_t i = 0; i < BlockCount; ++i)
+			{
+				Out[Base + i].x = E1y[i] * E2z[i] - E1z[i] * E2y[i];
+				Out[Base + i].y = E1z[i] * E2x[i] - E1x[i] * E2z[i];
+				Out[Base + i].z = E1x[i] * E2y[i] - E1y[i] * E2x[i];
+			}
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER vec<3, T, Q> compute_any_orthogonal(vec<3, T, Q> const& Normal)
+	{
+		vec<3, T, Q> const Axis = abs(Normal.x) < static_cast<T>(0.5) ? vec<3, T, Q>(1, 0, 0) : vec<3, T, Q>(0, 1, 0);
+		return normalize(cross(Normal, Axis));
+	}
+}//namespace detail
+
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER vec<3, T, Q> triangleNormal
 	(
@@ -12,4 +53,124 @@ namespace glm
 	{
 		return normalize(cross(p1 - p2, p1 - p3));
 	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void triangleNormalBatch(vec<3, T, Q> const* Positions, uint32 const* Indices, std::size_t TriangleCount, vec<3, T, Q>* Normals)
+	{
+		detail::compute_triangle_normals(Positions, Indices, TriangleCount, Normals);
+		for(std::size_t i = 0; i < TriangleCount; ++i)
+			Normals[i] = normalize(Normals[i]);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void accumulateVertexNormals(vec<3, T, Q> const* Positions, uint32 const* Indices, std::size_t FirstTriangle, std::size_t TriangleCount, vec<3, T, Q>* Accum)
+	{
+		std::size_t const BlockSize = 16;
+
+		vec<3, T, Q> Normals[BlockSize];
+		for(std::size_t Base = 0; Base < TriangleCount; Base += BlockSize)
+		{
+			std::size_t const BlockCount = TriangleCount - Base < BlockSize ? TriangleCount - Base : BlockSize;
+			uint32 const* Triangles = Indices + (FirstTriangle + Base) * 3;
+
+			detail::compute_triangle_normals(Positions, Triangles, BlockCount, Normals);
+			for(std::size_t i = 0; i < BlockCount; ++i)
+			{
+				Accum[Triangles[i * 3 + 0]] += Normals[i];
+				Accum[Triangles[i * 3 + 1]] += Normals[i];
+				Accum[Triangles[i * 3 + 2]] += Normals[i];
+			}
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void accumulateVertexTangents(vec<3, T, Q> const* Positions, vec<2, T, Q> const* TexCoords, uint32 const* Indices, std::size_t FirstTriangle, std::size_t TriangleCount, vec<3, T, Q>* TangentAccum, vec<3, T, Q>* BitangentAccum)
+	{
+		for(std::size_t i = 0; i < TriangleCount; ++i)
+		{
+			uint32 const* Triangle = Indices + (FirstTriangle + i) * 3;
+
+			vec<3, T, Q> const E1 = Positions[Triangle[1]] - Positions[Triangle[0]];
+			vec<3, T, Q> const E2 = Positions[Triangle[2]] - Positions[Triangle[0]];
+			vec<2, T, Q> const D1 = TexCoords[Triangle[1]] - TexCoords[Triangle[0]];
+			vec<2, T, Q> const D2 = TexCoords[Triangle[2]] - TexCoords[Triangle[0]];
+
+			// Scaling by the sign of the texture area instead of its inverse weights the tangents by the triangle area
+			T const Area = D1.x * D2.y - D2.x * D1.y;
+			if(Area == static_cast<T>(0))
+				continue;
+			T const Sign = Area < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+
+			vec<3, T, Q> const Tangent = (E1 * D2.y - E2 * D1.y) * Sign;
+			vec<3, T, Q> const Bitangent = (E2 * D1.x - E1 * D2.x) * Sign;
+			for(length_t k = 0; k < 3; ++k)
+			{
+				TangentAccum[Triangle[k]] += Tangent;
+				BitangentAccum[Triangle[k]] += Bitangent;
+			}
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void reduceVertexAttributes(vec<3, T, Q> const* Partials, std::size_t PartitionCount, std::size_t Stride, std::size_t Count, vec<3, T, Q>* Out)
+	{
+		for(std::size_t i = 0; i < Count; ++i)
+			Out[i] = vec<3, T, Q>(0);
+		for(std::size_t p = 0; p < PartitionCount; ++p)
+		{
+			vec<3, T, Q> const* Partial = Partials + p * Stride;
+			for(std::size_t i = 0; i < Count; ++i)
+				Out[i] += Partial[i];
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void normalizeVertexNormals(vec<3, T, Q>* Normals, std::size_t Count)
+	{
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			T const Length2 = dot(Normals[i], Normals[i]);
+			if(Length2 > static_cast<T>(0))
+				Normals[i] *= inversesqrt(Length2);
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void orthonormalizeTangents(vec<3, T, Q> const* Normals, vec<3, T, Q> const* Tangents, vec<3, T, Q> const* Bitangents, std::size_t Count, vec<4, T, Q>* Out)
+	{
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			vec<3, T, Q> const& Normal = Normals[i];
+			vec<3, T, Q> const Projected = Tangents[i] - Normal * dot(Normal, Tangents[i]);
+
+			// Tangents parallel to the normal, or null, leave no usable direction once projected
+			vec<3, T, Q> const Tangent = dot(Projected, Projected) > epsilon<T>() * dot(Tangents[i], Tangents[i])
+				? orthonormalize(Tangents[i], Normal)
+				: detail::compute_any_orthogonal(Normal);
+			T const Handedness = dot(cross(Normal, Tangent), Bitangents[i]) < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+
+			Out[i] = vec<4, T, Q>(Tangent, Handedness);
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void computeVertexNormals(vec<3, T, Q> const* Positions, std::size_t VertexCount, uint32 const* Indices, std::size_t TriangleCount, vec<3, T, Q>* Normals)
+	{
+		for(std::size_t i = 0; i < VertexCount; ++i)
+			Normals[i] = vec<3, T, Q>(0);
+		accumulateVertexNormals(Positions, Indices, 0, TriangleCount, Normals);
+		normalizeVertexNormals(Normals, VertexCount);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void computeVertexTangents(vec<3, T, Q> const* Positions, vec<3, T, Q> const* Normals, vec<2, T, Q> const* TexCoords, std::size_t VertexCount, uint32 const* Indices, std::size_t TriangleCount, vec<4, T, Q>* Tangents)
+	{
+		if(VertexCount == 0)
+			return;
+
+		std::vector<vec<3, T, Q> > TangentAccum(VertexCount, vec<3, T, Q>(0));
+		std::vector<vec<3, T, Q> > BitangentAccum(VertexCount, vec<3, T, Q>(0));
+		accumulateVertexTangents(Positions, TexCoords, Indices, 0, TriangleCount, &TangentAccum[0], &BitangentAccum[0]);
+		orthonormalizeTangents(Normals, &TangentAccum[0], &BitangentAccum[0], VertexCount, Tangents);
+	}
 }//namespace glm
@@ -9,11 +9,15 @@
 /// Include <glm/gtx/polar_coordinates.hpp> to use the features of this extension.
 ///
 /// Conversion from Euclidean space to polar space and revert.
+///
+/// Batched conversions over structure of arrays points, optionally fused with an affine transform,
+/// use polynomial atan2, sin and cos approximations the compiler can vectorize.
 
 #pragma once
 
 // Dependency:
 #include "../glm.hpp"
+#include "../gtc/constants.hpp"
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
 #	error "GLM: GLM_GTX_polar_coordinates is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
@@ -40,6 +44,45 @@ namespace glm
 	GLM_FUNC_DECL vec<3, T, Q> euclidean(
 		vec<2, T, Q> const& polar);
 
+	/// Converts count Euclidean points, given as structure of arrays, to latitude, longitude and radius.
+	/// latitude[i] and longitude[i] match the x and y of polar(vec3(x[i], y[i], z[i])), and radius[i] is the length of the point.
+	/// The latitude is computed as atan2(y, sqrt(x * x + z * z)), which is better conditioned than asin(y / radius) near the poles.
+	/// The angles are within 4 ulps and the radius within 2 ulps of the exact results for float and double. radius may be NULL.
+	/// @see gtx_polar_coordinates
+	template<typename T>
+	GLM_FUNC_DECL void polarBatch(
+		T const* x, T const* y, T const* z, std::size_t count,
+		T* latitude, T* longitude, T* radius);
+
+	/// Converts count Euclidean points, first transformed by the affine matrix transform, to latitude, longitude and radius.
+	/// Given a sensor to world matrix, pass its inverse to convert world points to sensor relative coordinates.
+	/// @see gtx_polar_coordinates
+	template<typename T>
+	GLM_FUNC_DECL void polarBatch(
+		mat<4, 4, T, defaultp> const& transform,
+		T const* x, T const* y, T const* z, std::size_t count,
+		T* latitude, T* longitude, T* radius);
+
+	/// Converts count latitude, longitude and radius triples, given as structure of arrays, to Euclidean points.
+	/// (x[i], y[i], z[i]) is euclidean(vec2(latitude[i], longitude[i])) scaled by radius[i], or unscaled if radius is NULL.
+	/// For angles in [-2 pi, 2 pi] the sines and cosines are within 2 ulps of the exact results for float and double.
+	/// Any other angle is reduced to that range with an absolute error under 2e-7 for float while |angle| < 8192,
+	/// and under 2e-16 for double while |angle| < 2^20; beyond these, the float results lose accuracy.
+	/// @see gtx_polar_coordinates
+	template<typename T>
+	GLM_FUNC_DECL void euclideanBatch(
+		T const* latitude, T const* longitude, T const* radius, std::size_t count,
+		T* x, T* y, T* z);
+
+	/// Converts count latitude, longitude and radius triples to Euclidean points, then transforms them by the affine matrix transform,
+	/// for instance from a sensor to the world.
+	/// @see gtx_polar_coordinates
+	template<typename T>
+	GLM_FUNC_DECL void euclideanBatch(
+		mat<4, 4, T, defaultp> const& transform,
+		T const* latitude, T const* longitude, T const* radius, std::size_t count,
+		T* x, T* y, T* z);
+
 	/// @}
 }//namespace glm
 
@@ -1,5 +1,8 @@
 /// @ref gtx_polar_coordinates
 
+#include <cstring>
+#include <limits>
+
 namespace glm
 {
 	template<typename T, qualifier Q>
@@ -33,4 +36,316 @@ namespace glm
 			cos(latitude) * cos(longitude));
 	}
 
+	namespace detail
+	{
+		// Taylor series of atan(t) / t in t2 = t * t, for |t| <= tan(pi / 12): 6 terms are enough for float, 13 for double
+		GLM_FUNC_QUALIFIER float compute_polar_atan_series(float t2)
+		{
+			float p = 1.0f / 11.0f;
+			p = p * -t2 + 1.0f / 9.0f;
+			p = p * -t2 + 1.0f / 7.0f;
+			p = p * -t2 + 1.0f / 5.0f;
+			p = p * -t2 + 1.0f / 3.0f;
+			return p * -t2 + 1.0f;
+		}
+
+		GLM_FUNC_QUALIFIER double compute_polar_atan_series(double t2)
+		{
+			double p = 1.0 / 25.0;
+			p = p * -t2 + 1.0 / 23.0;
+			p = p * -t2 + 1.0 / 21.0;
+			p = p * -t2 + 1.0 / 19.0;
+			p = p * -t2 + 1.0 / 17.0;
+			p = p * -t2 + 1.0 / 15.0;
+			p = p * -t2 + 1.0 / 13.0;
+			p = p * -t2 + 1.0 / 11.0;
+			p = p * -t2 + 1.0 / 9.0;
+			p = p * -t2 + 1.0 / 7.0;
+			p = p * -t2 + 1.0 / 5.0;
+			p = p * -t2 + 1.0 / 3.0;
+			return p * -t2 + 1.0;
+		}
+
+		// Taylor series of sin(r) / r and cos(r) in r2 = r * r, for |r| <= pi / 4
+		GLM_FUNC_QUALIFIER void compute_polar_sincos_series(float r2, float& s, float& c)
+		{
+			s = ((((1.0f / 362880.0f) * r2 - 1.0f / 5040.0f) * r2 + 1.0f / 120.0f) * r2 - 1.0f / 6.0f) * r2 + 1.0f;
+			c = ((((1.0f / 40320.0f) * r2 - 1.0f / 720.0f) * r2 + 1.0f / 24.0f) * r2 - 1.0f / 2.0f) * r2 + 1.0f;
+		}
+
+		GLM_FUNC_QUALIFIER void compute_polar_sincos_series(double r2, double& s, double& c)
+		{
+			s = -1.0 / 1307674368000.0;
+			s = s * r2 + 1.0 / 6227020800.0;
+			s = s * r2 - 1.0 / 39916800.0;
+			s = s * r2 + 1.0 / 362880.0;
+			s = s * r2 - 1.0 / 5040.0;
+			s = s * r2 + 1.0 / 120.0;
+			s = s * r2 - 1.0 / 6.0;
+			s = s * r2 + 1.0;
+
+			c = 1.0 / 20922789888000.0;
+			c = c * r2 - 1.0 / 87178291200.0;
+			c = c * r2 + 1.0 / 479001600.0;
+			c = c * r2 - 1.0 / 3628800.0;
+			c = c * r2 + 1.0 / 40320.0;
+			c = c * r2 - 1.0 / 720.0;
+			c = c * r2 + 1.0 / 24.0;
+			c = c * r2 - 1.0 / 2.0;
+			c = c * r2 + 1.0;
+		}
+
+		// The bits of x as an integer of the same size
+		GLM_FUNC_QUALIFIER int compute_polar_bits(float x)
+		{
+			int Bits;
+			memcpy(&Bits, &x, sizeof(Bits));
+			return Bits;
+		}
+
+		GLM_FUNC_QUALIFIER detail::int64 compute_polar_bits(double x)
+		{
+			detail::int64 Bits;
+			memcpy(&Bits, &x, sizeof(Bits));
+			return Bits;
+		}
+
+		// 1 if the integer i is negative, else 0, built from the bits of 1 so that no comparison can become a branch
+		GLM_FUNC_QUALIFIER float compute_polar_negative(int i, float)
+		{
+			int const Bits = -((i >> 31) & 1) & 0x3F800000;
+			float Result;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		GLM_FUNC_QUALIFIER double compute_polar_negative(detail::int64 i, double)
+		{
+			detail::int64 const Bits = -((i >> 63) & 1) & 0x3FF0000000000000LL;
+			double Result;
+			memcpy(&Result, &Bits, sizeof(Result));
+			return Result;
+		}
+
+		// atan2(y, x) without branches. The ratio of the smaller to the larger magnitude, in [0, 1], is reduced to
+		// [0, tan(pi / 12)] by atan(a) = pi / 6 + atan((a sqrt(3) - 1) / (a + sqrt(3))), then the octant is restored
+		// from the signs and magnitudes. The selections are products with exact 0 or 1 factors: non-negative floats
+		// order like their bits, so comparisons are signs of bit differences.
+		template<typename T>
+		GLM_FUNC_QUALIFIER T compute_polar_atan2(T y, T x)
+		{
+			T const One = static_cast<T>(1);
+			T const Sqrt3 = static_cast<T>(1.73205080756887729353);
+
+			T const ax = abs(x);
+			T const ay = abs(y);
+			T const a = min(ax, ay) / max(max(ax, ay), std::numeric_limits<T>::min());
+
+			T const Reduce = compute_polar_negative(compute_polar_bits(static_cast<T>(0.26794919243112270647)) - compute_polar_bits(a), a);
+			T const Scale = Sqrt3 * Reduce + (One - Reduce);
+			T const t = (a * Scale - Reduce) / (a * Reduce + Scale);
+			T const Angle = static_cast<T>(0.52359877559829887308) * Reduce + t * compute_polar_atan_series(t * t);
+
+			T const Swap = compute_polar_negative(compute_polar_bits(ax) - compute_polar_bits(ay), a);
+			T const Octant = half_pi<T>() * Swap + (One - static_cast<T>(2) * Swap) * Angle;
+			T const Left = compute_polar_negative(compute_polar_bits(x), a);
+			T const Half = pi<T>() * Left + (One - static_cast<T>(2) * Left) * Octant;
+			return (One - static_cast<T>(2) * compute_polar_negative(compute_polar_bits(y), a)) * Half;
+		}
+
+		// sin and cos without branches: reduced by the nearest multiple k of pi / 2, subtracted in three parts whose
+		// products with k are exact, to r in [-pi / 4, pi / 4], then swapped and negated by quadrant. See
+		// euclideanBatch for the accuracy of the reduction as |Angle| grows.
+		template<typename T>
+		GLM_FUNC_QUALIFIER void compute_polar_sincos(T Angle, T& Sin, T& Cos)
+		{
+			// Rounds to the nearest quadrant by adding and removing 1.5 * 2^(digits - 1), which works for any sign. The
+			// sum has an ulp of 1, so its low mantissa bits hold k modulo 4; reading them rather than converting kf to
+			// int keeps NaN and huge angles defined.
+			T const Shifter = static_cast<T>(1.5) * static_cast<T>(detail::int64(1) << (std::numeric_limits<T>::digits - 1));
+			T const Shifted = Angle * static_cast<T>(0.63661977236758134308) + Shifter;
+			T const kf = Shifted - Shifter;
+			int const k = static_cast<int>(compute_polar_bits(Shifted) & 3);
+			T const r = ((Angle - kf * static_cast<T>(1.5703125)) - kf * static_cast<T>(4.837512969970703125e-4)) - kf * static_cast<T>(7.54978995489188216e-8);
+
+			T s, c;
+			compute_polar_sincos_series(r * r, s, c);
+			s *= r;
+
+			T const Swap = static_cast<T>(k & 1);
+			T const Keep = static_cast<T>(1) - Swap;
+			Sin = (Keep * s + Swap * c) * static_cast<T>(1 - (k & 2));
+			Cos = (Keep * c + Swap * s) * static_cast<T>(1 - ((k + 1) & 2));
+		}
+
+		// The 16 points of a block go through local streams, so that the sqrt loop, which only vectorizes without errno
+		// handling, stays apart from the polynomial loops
+		template<typename T>
+		GLM_FUNC_QUALIFIER void compute_polar_block(mat<4, 4, T, defaultp> const& m,
+			T const* x, T const* y, T const* z,
+			T* latitude, T* longitude, T* radius)
+		{
+			T const m00 = m[0][0], m10 = m[1][0], m20 = m[2][0], m30 = m[3][0];
+			T const m01 = m[0][1], m11 = m[1][1], m21 = m[2][1], m31 = m[3][1];
+			T const m02 = m[0][2], m12 = m[1][2], m22 = m[2][2], m32 = m[3][2];
+
+			T X[16], Y[16], Z[16], Rho[16], R[16];
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				X[i] = m00 * x[i] + m10 * y[i] + m20 * z[i] + m30;
+				Y[i] = m01 * x[i] + m11 * y[i] + m21 * z[i] + m31;
+				Z[i] = m02 * x[i] + m12 * y[i] + m22 * z[i] + m32;
+				Rho[i] = X[i] * X[i] + Z[i] * Z[i];
+				R[i] = Rho[i] + Y[i] * Y[i];
+			}
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				Rho[i] = sqrt(Rho[i]);
+				R[i] = sqrt(R[i]);
+			}
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				Y[i] = compute_polar_atan2(Y[i], Rho[i]);
+				X[i] = compute_polar_atan2(X[i], Z[i]);
+			}
+
+			// Copied out separately, since the outputs may alias each other
+			for(std::size_t i = 0; i < 16; ++i)
+				latitude[i] = Y[i];
+			for(std::size_t i = 0; i < 16; ++i)
+				longitude[i] = X[i];
+			if(radius)
+				for(std::size_t i = 0; i < 16; ++i)
+					radius[i] = R[i];
+		}
+
+		template<typename T>
+		GLM_FUNC_QUALIFIER void compute_euclidean_block(mat<4, 4, T, defaultp> const& m,
+			T const* latitude, T const* longitude, T const* radius,
+			T* x, T* y, T* z)
+		{
+			T const m00 = m[0][0], m10 = m[1][0], m20 = m[2][0], m30 = m[3][0];
+			T const m01 = m[0][1], m11 = m[1][1], m21 = m[2][1], m31 = m[3][1];
+			T const m02 = m[0][2], m12 = m[1][2], m22 = m[2][2], m32 = m[3][2];
+
+			T SinLat[16], CosLat[16], SinLon[16], CosLon[16];
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				compute_polar_sincos(latitude[i], SinLat[i], CosLat[i]);
+				compute_polar_sincos(longitude[i], SinLon[i], CosLon[i]);
+			}
+			if(radius)
+				for(std::size_t i = 0; i < 16; ++i)
+				{
+					SinLat[i] *= radius[i];
+					CosLat[i] *= radius[i];
+				}
+			for(std::size_t i = 0; i < 16; ++i)
+			{
+				T const px = CosLat[i] * SinLon[i];
+				T const py = SinLat[i];
+				T const pz = CosLat[i] * CosLon[i];
+				SinLon[i] = m00 * px + m10 * py + m20 * pz + m30;
+				SinLat[i] = m01 * px + m11 * py + m21 * pz + m31;
+				CosLon[i] = m02 * px + m12 * py + m22 * pz + m32;
+			}
+
+			// Copied out separately, since the outputs may alias each other
+			for(std::size_t i = 0; i < 16; ++i)
+				x[i] = SinLon[i];
+			for(std::size_t i = 0; i < 16; ++i)
+				y[i] = SinLat[i];
+			for(std::size_t i = 0; i < 16; ++i)
+				z[i] = CosLon[i];
+		}
+	}//namespace detail
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void polarBatch
+	(
+		mat<4, 4, T, defaultp> const& transform,
+		T const* x, T const* y, T const* z, std::size_t count,
+		T* latitude, T* longitude, T* radius
+	)
+	{
+		std::size_t First = 0;
+		for(; First + 16 <= count; First += 16)
+			detail::compute_polar_block(transform, x + First, y + First, z + First,
+				latitude + First, longitude + First, radius ? radius + First : radius);
+
+		// The last partial block is padded
+		if(First < count)
+		{
+			std::size_t const Size = count - First;
+			T X[16] = {}, Y[16] = {}, Z[16] = {}, Latitude[16], Longitude[16], Radius[16];
+			for(std::size_t i = 0; i < Size; ++i)
+			{
+				X[i] = x[First + i];
+				Y[i] = y[First + i];
+				Z[i] = z[First + i];
+			}
+			detail::compute_polar_block(transform, X, Y, Z, Latitude, Longitude, Radius);
+			for(std::size_t i = 0; i < Size; ++i)
+			{
+				latitude[First + i] = Latitude[i];
+				longitude[First + i] = Longitude[i];
+				if(radius)
+					radius[First + i] = Radius[i];
+			}
+		}
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void polarBatch
+	(
+		T const* x, T const* y, T const* z, std::size_t count,
+		T* latitude, T* longitude, T* radius
+	)
+	{
+		polarBatch(mat<4, 4, T, defaultp>(static_cast<T>(1)), x, y, z, count, latitude, longitude, radius);
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void euclideanBatch
+	(
+		mat<4, 4, T, defaultp> const& transform,
+		T const* latitude, T const* longitude, T const* radius, std::size_t count,
+		T* x, T* y, T* z
+	)
+	{
+		std::size_t First = 0;
+		for(; First + 16 <= count; First += 16)
+			detail::compute_euclidean_block(transform, latitude + First, longitude + First, radius ? radius + First : radius,
+				x + First, y + First, z + First);
+
+		// The last partial block is padded
+		if(First < count)
+		{
+			std::size_t const Size = count - First;
+			T Latitude[16] = {}, Longitude[16] = {}, Radius[16] = {}, X[16], Y[16], Z[16];
+			for(std::size_t i = 0; i < Size; ++i)
+			{
+				Latitude[i] = latitude[First + i];
+				Longitude[i] = longitude[First + i];
+				Radius[i] = radius ? radius[First + i] : static_cast<T>(1);
+			}
+			detail::compute_euclidean_block(transform, Latitude, Longitude, Radius, X, Y, Z);
+			for(std::size_t i = 0; i < Size; ++i)
+			{
+				x[First + i] = X[i];
+				y[First + i] = Y[i];
+				z[First + i] = Z[i];
+			}
+		}
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void euclideanBatch
+	(
+		T const* latitude, T const* longitude, T const* radius, std::size_t count,
+		T* x, T* y, T* z
+	)
+	{
+		euclideanBatch(mat<4, 4, T, defaultp>(static_cast<T>(1)), latitude, longitude, radius, count, x, y, z);
+	}
 }//namespace glm
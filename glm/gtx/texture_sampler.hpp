@@ -0,0 +1,201 @@
+/// @ref gtx_texture_sampler
+/// @file glm/gtx/texture_sampler.hpp
+///
+/// @see core (dependence)
+/// @see gtx_texture (dependence)
+/// @see gtx_wrap
+///
+/// @defgroup gtx_texture_sampler GLM_GTX_texture_sampler
+/// @ingroup gtx
+///
+/// Include <glm/gtx/texture_sampler.hpp> to use the features of this extension.
+///
+/// CPU sampling of 2D RGBA images: texel addressing with wrap modes, nearest, bilinear and trilinear filtering,
+/// batched sampling of arrays of texture coordinates and mipmap chain generation with box or Kaiser filters.
+///
+/// Images are tightly packed, row major arrays of vec4 (RGBA32F), u16vec4 (RGBA16F, half float bits as produced by packHalf)
+/// or u8vec4 (RGBA8 unorm) texels. Texture coordinates are normalized, texel centers are at (i + 0.5) / size,
+/// and all filtering is computed in float.
+///
+/// Complete mipmap chains can also be stored in a single contiguous buffer, level after level, and generated
+/// with gamma correct downsampling of sRGB content.
+///
+/// Example:
+/// ```
+/// std::vector<glm::u8vec4> Texels(...); // 256 * 256 base level followed by the smaller levels
+/// glm::texture_image<glm::u8vec4> Levels[9];
+/// // ... point each level to its storage, halving the extent each time
+///
+/// glm::generateMipmaps(Levels, 9, glm::mip_filter_kaiser, glm::wrap_repeat);
+/// glm::sampleTrilinearBatch(Levels, 9, UVs, Count, 2.5f, glm::wrap_repeat, Colors);
+/// ```
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../ext/vector_uint4_sized.hpp"
+#include "../gtc/constants.hpp"
+#include "../gtc/color_space.hpp"
+#include "../gtc/packing.hpp"
+#include "../gtx/texture.hpp"
+#include <algorithm>
+#include <vector>
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_texture_sampler is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_texture_sampler extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_texture_sampler
+	/// @{
+
+	/// Texel addressing modes, matching the texture coordinate functions of gtx_wrap.
+	enum wrap_mode
+	{
+		wrap_clamp,			///< Clamp to the edge texels, see glm::clamp
+		wrap_repeat,		///< Tile the image, see glm::repeat
+		wrap_mirror_repeat,	///< Tile the image, mirroring every other tile, see glm::mirrorRepeat
+		wrap_mirror_clamp	///< Mirror the image once around the origin then clamp, see glm::mirrorClamp
+	};
+
+	/// Downsampling filters used to build mipmap chains.
+	enum mip_filter
+	{
+		mip_filter_box,		///< Area weighted average of the covered texels, 2 * 2 average for even extents
+		mip_filter_kaiser	///< Kaiser windowed sinc, sharper than box with little ringing
+	};
+
+	/// Non owning view on a tightly packed, row major 2D image.
+	///
+	/// @tparam texelType vec<4, float, Q>, vec<4, uint16, Q> (half floats) or vec<4, uint8, Q>, optionally const qualified for read only images
+	template<typename texelType>
+	struct texture_image
+	{
+		texelType* data;
+		int width;
+		int height;
+	};
+
+namespace detail
+{
+	// One dimensional resampling filter, with the same number of taps for every destination texel
+	struct resample_taps
+	{
+		int TapCount;
+		std::vector<int> Coords;
+		std::vector<float> Weights;
+	};
+}//namespace detail
+
+	/// Filters of one level of a contiguous mipmap chain, computed once by prepareMipmapLevel then shared, read only,
+	/// by every downsampleMipmapRows call on that level.
+	struct mipmap_level_filter
+	{
+		vec<2, int, defaultp> sourceExtent;
+		vec<2, int, defaultp> extent;
+		std::size_t sourceOffset;	///< Offset of the source level in the chain, in texels
+		std::size_t offset;			///< Offset of the level in the chain, in texels
+		bool srgb;
+		detail::resample_taps tapsX;	///< Empty when the source width is twice the level width
+		detail::resample_taps tapsY;
+		float decodeTable[256];		///< RGBA8 channel values, decoded to linear when srgb
+	};
+
+	/// Map a texel coordinate that may lie outside of [0, Size) onto the image according to Mode.
+	GLM_FUNC_DECL int wrapTexel(int Coord, int Size, wrap_mode Mode);
+
+	/// Fetch a single texel converted to float, addressing outside texels according to Mode.
+	template<typename texelType>
+	GLM_FUNC_DECL vec<4, float, defaultp> texelFetch(texture_image<texelType> const& Image, vec<2, int, defaultp> const& Texel, wrap_mode Mode);
+
+	/// Sample the texel nearest to the normalized texture coordinate UV.
+	template<typename texelType>
+	GLM_FUNC_DECL vec<4, float, defaultp> sampleNearest(texture_image<texelType> const& Image, vec<2, float, defaultp> const& UV, wrap_mode Mode);
+
+	/// Bilinearly interpolate the four texels around the normalized texture coordinate UV.
+	template<typename texelType>
+	GLM_FUNC_DECL vec<4, float, defaultp> sampleBilinear(texture_image<texelType> const& Image, vec<2, float, defaultp> const& UV, wrap_mode Mode);
+
+	/// Bilinearly sample the two mipmap levels around Lod and interpolate between them.
+	///
+	/// @param Levels Array of LevelCount images, Levels[0] being the base level
+	/// @param LevelCount Number of levels in Levels, at least 1
+	/// @param UV Normalized texture coordinate
+	/// @param Lod Level of detail, clamped to [0, LevelCount - 1]
+	/// @param Mode Texel addressing mode
+	template<typename texelType>
+	GLM_FUNC_DECL vec<4, float, defaultp> sampleTrilinear(texture_image<texelType> const* Levels, int LevelCount, vec<2, float, defaultp> const& UV, float Lod, wrap_mode Mode);
+
+	/// Bilinearly sample Count normalized texture coordinates.
+	///
+	/// Coordinates are processed in blocks: texel addresses and weights are computed as contiguous streams,
+	/// the wrap mode is resolved once per block, then the texels are gathered and blended.
+	template<typename texelType>
+	GLM_FUNC_DECL void sampleBilinearBatch(texture_image<texelType> const& Image, vec<2, float, defaultp> const* UVs, std::size_t Count, wrap_mode Mode, vec<4, float, defaultp>* Out);
+
+	/// Trilinearly sample Count normalized texture coordinates at the same level of detail. LevelCount must be at least 1.
+	template<typename texelType>
+	GLM_FUNC_DECL void sampleTrilinearBatch(texture_image<texelType> const* Levels, int LevelCount, vec<2, float, defaultp> const* UVs, std::size_t Count, float Lod, wrap_mode Mode, vec<4, float, defaultp>* Out);
+
+	/// Resample Source into Dest with a separable filter. Extents don't need to be powers of two nor exact halves.
+	template<typename srcTexelType, typename dstTexelType>
+	GLM_FUNC_DECL void downsample(texture_image<srcTexelType> const& Source, texture_image<dstTexelType> const& Dest, mip_filter Filter, wrap_mode Mode);
+
+	/// Fill the levels 1 to LevelCount - 1 of a mipmap chain, each level being downsampled from the previous one.
+	///
+	/// The caller provides the storage and extents of every level, typically max(1, extent >> level) for level
+	/// in [0, levels(extent)). Levels[0] is only read.
+	template<typename texelType>
+	GLM_FUNC_DECL void generateMipmaps(texture_image<texelType> const* Levels, int LevelCount, mip_filter Filter, wrap_mode Mode);
+
+	/// Extent of Level in a mipmap chain whose base level is Extent: max(1, Extent >> Level).
+	GLM_FUNC_DECL vec<2, int, defaultp> mipmapLevelExtent(vec<2, int, defaultp> const& Extent, int Level);
+
+	/// Offset, in texels, of Level in a contiguous mipmap chain whose base level is Extent.
+	GLM_FUNC_DECL std::size_t mipmapLevelOffset(vec<2, int, defaultp> const& Extent, int Level);
+
+	/// Number of texels of the complete contiguous mipmap chain, levels(Extent) levels, whose base level is Extent.
+	GLM_FUNC_DECL std::size_t mipmapChainSize(vec<2, int, defaultp> const& Extent);
+
+	/// Fill Levels with views on each of the levels(Extent) levels of the contiguous mipmap chain Chain.
+	template<typename texelType>
+	GLM_FUNC_DECL void mipmapChainLevels(texelType* Chain, vec<2, int, defaultp> const& Extent, texture_image<texelType>* Levels);
+
+	/// Downsample the rows [FirstRow, FirstRow + RowCount) of Level from Level - 1 in a contiguous mipmap chain.
+	///
+	/// Texels are filtered in linear space: with SRGB, the RGB channels are decoded with convertSRGBToLinear before
+	/// filtering and encoded back with convertLinearToSRGB, alpha is always linear. Even extents use a 2 * 2 average,
+	/// odd extents an area weighted box filter so that no source texel is dropped.
+	///
+	/// This prepares the filter of Level and allocates its scratch row on each call. To process a level by tiles,
+	/// prepare the filter once with prepareMipmapLevel and pass it to the overload taking a scratch buffer.
+	template<typename texelType>
+	GLM_FUNC_DECL void downsampleMipmapRows(texelType* Chain, vec<2, int, defaultp> const& Extent, int Level, int FirstRow, int RowCount, bool SRGB);
+
+	/// Compute the filters of Level, from 1 to levels(Extent) - 1, of a contiguous mipmap chain whose base level is Extent.
+	/// Filter is reused without allocating when it held a level of the same extents.
+	GLM_FUNC_DECL void prepareMipmapLevel(vec<2, int, defaultp> const& Extent, int Level, bool SRGB, mipmap_level_filter& Filter);
+
+	/// Downsample the rows [FirstRow, FirstRow + RowCount) of the level of Filter from the previous level, without allocating.
+	///
+	/// Scratch is a caller owned buffer of at least Filter.sourceExtent.x texels. Calls on disjoint row ranges of the
+	/// same level, each with its own Scratch, may run concurrently and share Filter, but every row of the previous
+	/// level must be complete before the level is processed.
+	template<typename texelType>
+	GLM_FUNC_DECL void downsampleMipmapRows(texelType* Chain, mipmap_level_filter const& Filter, int FirstRow, int RowCount, vec<4, float, defaultp>* Scratch);
+
+	/// Fill the levels 1 to levels(Extent) - 1 of a contiguous mipmap chain of mipmapChainSize(Extent) texels
+	/// whose base level is initialized, processing each level by tiles of rows.
+	///
+	/// @see downsampleMipmapRows
+	template<typename texelType>
+	GLM_FUNC_DECL void generateMipmapChain(texelType* Chain, vec<2, int, defaultp> const& Extent, bool SRGB);
+
+	/// @}
+}// namespace glm
+
+#include "texture_sampler.inl"
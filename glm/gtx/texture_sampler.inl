@@ -0,0 +1,479 @@
+/// @ref gtx_texture_sampler
+
+namespace glm{
+namespace detail
+{
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> texel_to_float(vec<4, float, Q> const& Texel)
+	{
+		return vec<4, float, defaultp>(Texel);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> texel_to_float(vec<4, uint8, Q> const& Texel)
+	{
+		return vec<4, float, defaultp>(Texel) * (1.0f / 255.0f);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> texel_to_float(vec<4, uint16, Q> const& Texel)
+	{
+		return vec<4, float, defaultp>(unpackHalf(Texel));
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void texel_from_float(vec<4, float, defaultp> const& Color, vec<4, float, Q>& Texel)
+	{
+		Texel = vec<4, float, Q>(Color);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void texel_from_float(vec<4, float, defaultp> const& Color, vec<4, uint16, Q>& Texel)
+	{
+		Texel = vec<4, uint16, Q>(packHalf(Color));
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void texel_from_float(vec<4, float, defaultp> const& Color, vec<4, uint8, Q>& Texel)
+	{
+		Texel = vec<4, uint8, Q>(clamp(Color, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	// Wrap a stream of texel coordinates, resolving the mode once for the whole stream
+	GLM_FUNC_QUALIFIER void wrap_texels(int* Coords, std::size_t Count, int Size, wrap_mode Mode)
+	{
+		switch(Mode)
+		{
+		default:
+		case wrap_clamp:
+			for(std::size_t i = 0; i < Count; ++i)
+				Coords[i] = Coords[i] < 0 ? 0 : (Coords[i] >= Size ? Size - 1 : Coords[i]);
+			break;
+		case wrap_repeat:
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				int const r = Coords[i] % Size;
+				Coords[i] = r < 0 ? r + Size : r;
+			}
+			break;
+		case wrap_mirror_repeat:
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				int r = Coords[i] % (Size * 2);
+				r = r < 0 ? r + Size * 2 : r;
+				Coords[i] = r < Size ? r : Size * 2 - 1 - r;
+			}
+			break;
+		case wrap_mirror_clamp:
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				int const m = Coords[i] < 0 ? -1 - Coords[i] : Coords[i];
+				Coords[i] = m >= Size ? Size - 1 : m;
+			}
+			break;
+		}
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> load_texel(texture_image<texelType> const& Image, int x, int y)
+	{
+		return texel_to_float(Image.data[static_cast<std::size_t>(y) * static_cast<std::size_t>(Image.width) + static_cast<std::size_t>(x)]);
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void sample_bilinear_block(texture_image<texelType> const& Image, vec<2, float, defaultp> const* UVs, std::size_t Count, wrap_mode Mode, vec<4, float, defaultp>* Out)
+	{
+		std::size_t const BlockSize = 16;
+
+		int X0[BlockSize], X1[BlockSize], Y0[BlockSize], Y1[BlockSize];
+		float FX[BlockSize], FY[BlockSize];
+
+		float const Width = static_cast<float>(Image.width);
+		float const Height = static_cast<float>(Image.height);
+
+		for(std::size_t Base = 0; Base < Count; Base += BlockSize)
+		{
+			std::size_t const n = Count - Base < BlockSize ? Count - Base : BlockSize;
+
+			// Addresses and weights, in structure of arrays form
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				float const x = UVs[Base + i].x * Width - 0.5f;
+				float const y = UVs[Base + i].y * Height - 0.5f;
+				float const fx = floor(x);
+				float const fy = floor(y);
+				X0[i] = static_cast<int>(fx);
+				Y0[i] = static_cast<int>(fy);
+				X1[i] = X0[i] + 1;
+				Y1[i] = Y0[i] + 1;
+				FX[i] = x - fx;
+				FY[i] = y - fy;
+			}
+
+			wrap_texels(X0, n, Image.width, Mode);
+			wrap_texels(X1, n, Image.width, Mode);
+			wrap_texels(Y0, n, Image.height, Mode);
+			wrap_texels(Y1, n, Image.height, Mode);
+
+			// Gather and blend
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				vec<4, float, defaultp> const A = mix(load_texel(Image, X0[i], Y0[i]), load_texel(Image, X1[i], Y0[i]), FX[i]);
+				vec<4, float, defaultp> const B = mix(load_texel(Image, X0[i], Y1[i]), load_texel(Image, X1[i], Y1[i]), FX[i]);
+				Out[Base + i] = mix(A, B, FY[i]);
+			}
+		}
+	}
+
+	// Zeroth order modified Bessel function of the first kind, by its power series
+	GLM_FUNC_QUALIFIER float bessel_i0(float x)
+	{
+		float Sum = 1.0f;
+		float Term = 1.0f;
+		float const HalfSquare = x * x * 0.25f;
+		for(int k = 1; k < 32 && Term > Sum * 1e-8f; ++k)
+		{
+			Term *= HalfSquare / static_cast<float>(k * k);
+			Sum += Term;
+		}
+		return Sum;
+	}
+
+	GLM_FUNC_QUALIFIER void compute_resample_taps(int SrcSize, int DstSize, mip_filter Filter, wrap_mode Mode, resample_taps& Taps)
+	{
+		float const Alpha = 4.0f;
+		float const Lobes = 3.0f;
+
+		float const Scale = static_cast<float>(SrcSize) / static_cast<float>(DstSize);
+		// Never filter narrower than a source texel when upsampling
+		float const Width = max(Scale, 1.0f);
+		float const Radius = Filter == mip_filter_box ? Width * 0.5f : Width * Lobes;
+
+		Taps.TapCount = static_cast<int>(ceil(Radius * 2.0f)) + 1;
+		Taps.Coords.resize(static_cast<std::size_t>(DstSize * Taps.TapCount));
+		Taps.Weights.resize(Taps.Coords.size());
+
+		float const InvBesselAlpha = 1.0f / bessel_i0(Alpha);
+
+		for(int d = 0; d < DstSize; ++d)
+		{
+			float const Center = (static_cast<float>(d) + 0.5f) * Scale;
+			int const First = static_cast<int>(floor(Center - Radius));
+			std::size_t const Offset = static_cast<std::size_t>(d * Taps.TapCount);
+
+			float Sum = 0.0f;
+			for(int t = 0; t < Taps.TapCount; ++t)
+			{
+				int const Coord = First + t;
+				float Weight = 0.0f;
+				if(Filter == mip_filter_box)
+				{
+					// Overlap of the source texel [Coord, Coord + 1) with the footprint
+					float const Lo = max(static_cast<float>(Coord), Center - Radius);
+					float const Hi = min(static_cast<float>(Coord + 1), Center + Radius);
+					Weight = max(Hi - Lo, 0.0f);
+				}
+				else
+				{
+					float const x = (static_cast<float>(Coord) + 0.5f - Center) / Width;
+					if(abs(x) < Lobes)
+					{
+						float const PiX = x * pi<float>();
+						float const Sinc = x == 0.0f ? 1.0f : sin(PiX) / PiX;
+						float const r = x / Lobes;
+						Weight = Sinc * bessel_i0(Alpha * sqrt(1.0f - r * r)) * InvBesselAlpha;
+					}
+				}
+
+				Taps.Coords[Offset + static_cast<std::size_t>(t)] = Coord;
+				Taps.Weights[Offset + static_cast<std::size_t>(t)] = Weight;
+				Sum += Weight;
+			}
+
+			for(int t = 0; t < Taps.TapCount; ++t)
+				Taps.Weights[Offset + static_cast<std::size_t>(t)] /= Sum;
+		}
+
+		wrap_texels(&Taps.Coords[0], Taps.Coords.size(), SrcSize, Mode);
+	}
+
+	GLM_FUNC_QUALIFIER void compute_srgb_table(bool SRGB, float* Table)
+	{
+		for(int i = 0; i < 256; ++i)
+		{
+			float const Value = static_cast<float>(i) / 255.0f;
+			Table[i] = SRGB ? convertSRGBToLinear(vec<1, float, defaultp>(Value)).x : Value;
+		}
+	}
+
+	// Decoding of sRGB RGBA8 texels through a table from compute_srgb_table, the other formats go through convertSRGBToLinear
+	struct srgb_decoder
+	{
+		float const* Table;
+
+		explicit srgb_decoder(float const* DecodeTable)
+			: Table(DecodeTable)
+		{}
+
+		template<qualifier Q>
+		vec<4, float, defaultp> operator()(vec<4, uint8, Q> const& Texel, bool) const
+		{
+			return vec<4, float, defaultp>(Table[Texel.x], Table[Texel.y], Table[Texel.z], static_cast<float>(Texel.w) / 255.0f);
+		}
+
+		template<typename texelType>
+		vec<4, float, defaultp> operator()(texelType const& Texel, bool SRGB) const
+		{
+			vec<4, float, defaultp> const Color = texel_to_float(Texel);
+			return SRGB ? convertSRGBToLinear(Color) : Color;
+		}
+	};
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void accumulate_linear_row(texelType const* Row, int Width, float Weight, srgb_decoder const& Decoder, bool SRGB, vec<4, float, defaultp>* Accum)
+	{
+		for(int x = 0; x < Width; ++x)
+			Accum[x] += Decoder(Row[x], SRGB) * Weight;
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER int wrapTexel(int Coord, int Size, wrap_mode Mode)
+	{
+		detail::wrap_texels(&Coord, 1, Size, Mode);
+		return Coord;
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> texelFetch(texture_image<texelType> const& Image, vec<2, int, defaultp> const& Texel, wrap_mode Mode)
+	{
+		return detail::load_texel(Image, wrapTexel(Texel.x, Image.width, Mode), wrapTexel(Texel.y, Image.height, Mode));
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> sampleNearest(texture_image<texelType> const& Image, vec<2, float, defaultp> const& UV, wrap_mode Mode)
+	{
+		vec<2, int, defaultp> const Texel(
+			static_cast<int>(floor(UV.x * static_cast<float>(Image.width))),
+			static_cast<int>(floor(UV.y * static_cast<float>(Image.height))));
+		return texelFetch(Image, Texel, Mode);
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> sampleBilinear(texture_image<texelType> const& Image, vec<2, float, defaultp> const& UV, wrap_mode Mode)
+	{
+		vec<4, float, defaultp> Result;
+		detail::sample_bilinear_block(Image, &UV, 1, Mode, &Result);
+		return Result;
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER vec<4, float, defaultp> sampleTrilinear(texture_image<texelType> const* Levels, int LevelCount, vec<2, float, defaultp> const& UV, float Lod, wrap_mode Mode)
+	{
+		vec<4, float, defaultp> Result;
+		sampleTrilinearBatch(Levels, LevelCount, &UV, 1, Lod, Mode, &Result);
+		return Result;
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void sampleBilinearBatch(texture_image<texelType> const& Image, vec<2, float, defaultp> const* UVs, std::size_t Count, wrap_mode Mode, vec<4, float, defaultp>* Out)
+	{
+		detail::sample_bilinear_block(Image, UVs, Count, Mode, Out);
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void sampleTrilinearBatch(texture_image<texelType> const* Levels, int LevelCount, vec<2, float, defaultp> const* UVs, std::size_t Count, float Lod, wrap_mode Mode, vec<4, float, defaultp>* Out)
+	{
+		assert(LevelCount >= 1);
+
+		float const Clamped = clamp(Lod, 0.0f, static_cast<float>(LevelCount - 1));
+		int const Level0 = static_cast<int>(floor(Clamped));
+		int const Level1 = min(Level0 + 1, LevelCount - 1);
+		float const Weight = Clamped - static_cast<float>(Level0);
+
+		detail::sample_bilinear_block(Levels[Level0], UVs, Count, Mode, Out);
+		if(Level1 == Level0 || Weight <= 0.0f)
+			return;
+
+		std::size_t const BlockSize = 64;
+		vec<4, float, defaultp> Fine[BlockSize];
+		for(std::size_t Base = 0; Base < Count; Base += BlockSize)
+		{
+			std::size_t const n = Count - Base < BlockSize ? Count - Base : BlockSize;
+			detail::sample_bilinear_block(Levels[Level1], UVs + Base, n, Mode, Fine);
+			for(std::size_t i = 0; i < n; ++i)
+				Out[Base + i] = mix(Out[Base + i], Fine[i], Weight);
+		}
+	}
+
+	template<typename srcTexelType, typename dstTexelType>
+	GLM_FUNC_QUALIFIER void downsample(texture_image<srcTexelType> const& Source, texture_image<dstTexelType> const& Dest, mip_filter Filter, wrap_mode Mode)
+	{
+		detail::resample_taps TapsX, TapsY;
+		detail::compute_resample_taps(Source.width, Dest.width, Filter, Mode, TapsX);
+		detail::compute_resample_taps(Source.height, Dest.height, Filter, Mode, TapsY);
+
+		// Horizontal pass over every source row, then vertical pass into the destination
+		std::vector<vec<4, float, defaultp> > Rows(static_cast<std::size_t>(Dest.width) * static_cast<std::size_t>(Source.height), vec<4, float, defaultp>(0.0f));
+		for(int y = 0; y < Source.height; ++y)
+		for(int x = 0; x < Dest.width; ++x)
+		{
+			std::size_t const Offset = static_cast<std::size_t>(x * TapsX.TapCount);
+			vec<4, float, defaultp> Sum(0.0f);
+			for(std::size_t t = 0; t < static_cast<std::size_t>(TapsX.TapCount); ++t)
+				Sum += detail::load_texel(Source, TapsX.Coords[Offset + t], y) * TapsX.Weights[Offset + t];
+			Rows[static_cast<std::size_t>(y) * static_cast<std::size_t>(Dest.width) + static_cast<std::size_t>(x)] = Sum;
+		}
+
+		for(int y = 0; y < Dest.height; ++y)
+		{
+			std::size_t const Offset = static_cast<std::size_t>(y * TapsY.TapCount);
+			for(int x = 0; x < Dest.width; ++x)
+			{
+				vec<4, float, defaultp> Sum(0.0f);
+				for(std::size_t t = 0; t < static_cast<std::size_t>(TapsY.TapCount); ++t)
+					Sum += Rows[static_cast<std::size_t>(TapsY.Coords[Offset + t]) * static_cast<std::size_t>(Dest.width) + static_cast<std::size_t>(x)] * TapsY.Weights[Offset + t];
+				detail::texel_from_float(Sum, Dest.data[static_cast<std::size_t>(y) * static_cast<std::size_t>(Dest.width) + static_cast<std::size_t>(x)]);
+			}
+		}
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void generateMipmaps(texture_image<texelType> const* Levels, int LevelCount, mip_filter Filter, wrap_mode Mode)
+	{
+		for(int Level = 1; Level < LevelCount; ++Level)
+			downsample(Levels[Level - 1], Levels[Level], Filter, Mode);
+	}
+
+	GLM_FUNC_QUALIFIER vec<2, int, defaultp> mipmapLevelExtent(vec<2, int, defaultp> const& Extent, int Level)
+	{
+		return max(vec<2, int, defaultp>(Extent.x >> Level, Extent.y >> Level), vec<2, int, defaultp>(1));
+	}
+
+	GLM_FUNC_QUALIFIER std::size_t mipmapLevelOffset(vec<2, int, defaultp> const& Extent, int Level)
+	{
+		std::size_t Offset = 0;
+		for(int i = 0; i < Level; ++i)
+		{
+			vec<2, int, defaultp> const LevelExtent = mipmapLevelExtent(Extent, i);
+			Offset += static_cast<std::size_t>(LevelExtent.x) * static_cast<std::size_t>(LevelExtent.y);
+		}
+		return Offset;
+	}
+
+	GLM_FUNC_QUALIFIER std::size_t mipmapChainSize(vec<2, int, defaultp> const& Extent)
+	{
+		return mipmapLevelOffset(Extent, levels(Extent));
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void mipmapChainLevels(texelType* Chain, vec<2, int, defaultp> const& Extent, texture_image<texelType>* Levels)
+	{
+		int const LevelCount = levels(Extent);
+		std::size_t Offset = 0;
+		for(int i = 0; i < LevelCount; ++i)
+		{
+			vec<2, int, defaultp> const LevelExtent = mipmapLevelExtent(Extent, i);
+			Levels[i].data = Chain + Offset;
+			Levels[i].width = LevelExtent.x;
+			Levels[i].height = LevelExtent.y;
+			Offset += static_cast<std::size_t>(LevelExtent.x) * static_cast<std::size_t>(LevelExtent.y);
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void prepareMipmapLevel(vec<2, int, defaultp> const& Extent, int Level, bool SRGB, mipmap_level_filter& Filter)
+	{
+		Filter.sourceExtent = mipmapLevelExtent(Extent, Level - 1);
+		Filter.extent = mipmapLevelExtent(Extent, Level);
+		Filter.sourceOffset = mipmapLevelOffset(Extent, Level - 1);
+		Filter.offset = Filter.sourceOffset + static_cast<std::size_t>(Filter.sourceExtent.x) * static_cast<std::size_t>(Filter.sourceExtent.y);
+		Filter.srgb = SRGB;
+
+		detail::compute_resample_taps(Filter.sourceExtent.y, Filter.extent.y, mip_filter_box, wrap_clamp, Filter.tapsY);
+		if(Filter.sourceExtent.x == Filter.extent.x * 2)
+		{
+			Filter.tapsX.TapCount = 0;
+			Filter.tapsX.Coords.clear();
+			Filter.tapsX.Weights.clear();
+		}
+		else
+			detail::compute_resample_taps(Filter.sourceExtent.x, Filter.extent.x, mip_filter_box, wrap_clamp, Filter.tapsX);
+
+		detail::compute_srgb_table(SRGB, Filter.decodeTable);
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void downsampleMipmapRows(texelType* Chain, mipmap_level_filter const& Filter, int FirstRow, int RowCount, vec<4, float, defaultp>* Scratch)
+	{
+		vec<2, int, defaultp> const SrcExtent = Filter.sourceExtent;
+		vec<2, int, defaultp> const DstExtent = Filter.extent;
+		texelType const* Src = Chain + Filter.sourceOffset;
+		texelType* Dst = Chain + Filter.offset;
+		detail::resample_taps const& TapsX = Filter.tapsX;
+		detail::resample_taps const& TapsY = Filter.tapsY;
+		bool const EvenX = TapsX.TapCount == 0;
+		bool const SRGB = Filter.srgb;
+		detail::srgb_decoder const Decoder(Filter.decodeTable);
+
+		int const LastRow = min(FirstRow + RowCount, DstExtent.y);
+		for(int y = FirstRow; y < LastRow; ++y)
+		{
+			// Vertical reduction of the decoded source rows
+			std::fill(Scratch, Scratch + SrcExtent.x, vec<4, float, defaultp>(0.0f));
+			std::size_t const OffsetY = static_cast<std::size_t>(y * TapsY.TapCount);
+			for(std::size_t t = 0; t < static_cast<std::size_t>(TapsY.TapCount); ++t)
+			{
+				float const Weight = TapsY.Weights[OffsetY + t];
+				if(Weight <= 0.0f)
+					continue;
+				texelType const* Row = Src + static_cast<std::size_t>(TapsY.Coords[OffsetY + t]) * static_cast<std::size_t>(SrcExtent.x);
+				detail::accumulate_linear_row(Row, SrcExtent.x, Weight, Decoder, SRGB, Scratch);
+			}
+
+			// Horizontal reduction, then encoding
+			texelType* DstRow = Dst + static_cast<std::size_t>(y) * static_cast<std::size_t>(DstExtent.x);
+			for(int x = 0; x < DstExtent.x; ++x)
+			{
+				vec<4, float, defaultp> Color(0.0f);
+				if(EvenX)
+					Color = (Scratch[x * 2] + Scratch[x * 2 + 1]) * 0.5f;
+				else
+				{
+					std::size_t const OffsetX = static_cast<std::size_t>(x * TapsX.TapCount);
+					for(std::size_t t = 0; t < static_cast<std::size_t>(TapsX.TapCount); ++t)
+						Color += Scratch[TapsX.Coords[OffsetX + t]] * TapsX.Weights[OffsetX + t];
+				}
+
+				detail::texel_from_float(SRGB ? convertLinearToSRGB(Color) : Color, DstRow[x]);
+			}
+		}
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void downsampleMipmapRows(texelType* Chain, vec<2, int, defaultp> const& Extent, int Level, int FirstRow, int RowCount, bool SRGB)
+	{
+		mipmap_level_filter Filter;
+		prepareMipmapLevel(Extent, Level, SRGB, Filter);
+		std::vector<vec<4, float, defaultp> > Scratch(static_cast<std::size_t>(Filter.sourceExtent.x));
+		downsampleMipmapRows(Chain, Filter, FirstRow, RowCount, &Scratch[0]);
+	}
+
+	template<typename texelType>
+	GLM_FUNC_QUALIFIER void generateMipmapChain(texelType* Chain, vec<2, int, defaultp> const& Extent, bool SRGB)
+	{
+		int const TileRows = 32;
+
+		int const LevelCount = levels(Extent);
+		if(LevelCount < 2)
+			return;
+
+		// One filter per level and one scratch row, the widest one, for the whole chain
+		mipmap_level_filter Filter;
+		std::vector<vec<4, float, defaultp> > Scratch(static_cast<std::size_t>(Extent.x));
+		for(int Level = 1; Level < LevelCount; ++Level)
+		{
+			prepareMipmapLevel(Extent, Level, SRGB, Filter);
+			for(int Row = 0; Row < Filter.extent.y; Row += TileRows)
+				downsampleMipmapRows(Chain, Filter, Row, TileRows, &Scratch[0]);
+		}
+	}
+}//namespace glm
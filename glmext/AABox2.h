@@ -1,5 +1,8 @@
 #pragma once
 
+#include <glm/glm.hpp>
+#include <limits>
+
 namespace glm {
 
 /// Standalone axis aligned bounding box implemented built on top of GLM.
@@ -140,6 +143,31 @@ public:
   glm::vec<2, T> mMax;   ///< Maximum point.
 };
 
+template<class T>
+inline void aabox2_t<T>::extend(const aabox2_t& aabb)
+{
+    if (!aabb.isNull())
+    {
+        extend(aabb.mMin);
+        extend(aabb.mMax);
+    }
+}
+
+template<class T>
+inline bool aabox2_t<T>::overlaps(const aabox2_t& bb) const
+{
+    if (isNull() || bb.isNull())
+        return false;
+    return mMin.x <= bb.mMax.x && bb.mMin.x <= mMax.x &&
+           mMin.y <= bb.mMax.y && bb.mMin.y <= mMax.y;
+}
+
+template<class T>
+inline bool aabox2_t<T>::contains(const glm::vec<2, T>& pt) const
+{
+    return pt.x >= mMin.x && pt.x <= mMax.x && pt.y >= mMin.y && pt.y <= mMax.y;
+}
+
 template< class T >
 inline aabox2_t<T>& operator += (aabox2_t<T>& b1, const vec<2, T>& p)
 {
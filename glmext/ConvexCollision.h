@@ -0,0 +1,730 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+#include "AABox.h"
+#include "Sphere.h"
+#include "Plane.h"
+#include "ConvexHull.h"
+
+namespace glm
+{
+
+/**
+ * Describes an oriented box by its center, its axes and its half extents
+ * along each axis.
+ *
+ * @param T     the internal type used for the points
+ * @ingroup Types
+ */
+template<class T>
+class obox_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Constructs a box of size 0 at the origin, aligned with the world axes.
+    */
+   obox_t()
+      : mCenter( 0 ), mAxes( T(1) ), mHalfExtents( 0 )
+   {}
+
+   /**
+    * Constructs a box with the given center, axes and half extents.
+    *
+    * @param center       the center of the box
+    * @param axes         the orthonormal axes of the box, one per column
+    * @param halfExtents  the half size of the box along each of its axes
+    */
+   obox_t( const vec<3, T>& center, const mat<3, 3, T>& axes, const vec<3, T>& halfExtents )
+      : mCenter( center ), mAxes( axes ), mHalfExtents( halfExtents )
+   {}
+
+public:
+   vec<3, T> mCenter;
+   mat<3, 3, T> mAxes;
+   vec<3, T> mHalfExtents;
+};
+
+/**
+ * Describes a capsule, the points within a radius of the segment [mA, mB].
+ *
+ * @param T     the internal type used for the points
+ * @ingroup Types
+ */
+template<class T>
+class capsule_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Constructs a capsule of radius 0 at the origin.
+    */
+   capsule_t()
+      : mA( 0 ), mB( 0 ), mRadius( 0 )
+   {}
+
+   /**
+    * Constructs a capsule around the segment [a, b].
+    */
+   capsule_t( const vec<3, T>& a, const vec<3, T>& b, const T& radius )
+      : mA( a ), mB( b ), mRadius( radius )
+   {}
+
+public:
+   vec<3, T> mA;
+   vec<3, T> mB;
+   T mRadius;
+};
+
+/**
+ * A shape placed with a rotation and a translation, such as a convex hull
+ * of a rigid body: support points are computed in the shape space and
+ * transformed to world space.
+ *
+ * @param SHAPE  any shape with a support overload
+ * @param T      the internal type used for the points
+ * @ingroup Types
+ */
+template<class SHAPE, class T>
+class transformed_shape_t
+{
+public:
+   typedef T DataType;
+
+public:
+   transformed_shape_t( const SHAPE& shape, const mat<3, 3, T>& rotation, const vec<3, T>& translation )
+      : mShape( &shape ), mRotation( rotation ), mTranslation( translation )
+   {}
+
+public:
+   const SHAPE* mShape;
+   mat<3, 3, T> mRotation;
+   vec<3, T> mTranslation;
+};
+
+/**
+ * Support functions: the point of a convex shape furthest along a
+ * direction. Any shape with a support overload, found by argument dependent
+ * lookup, works with gjkDistance, epaPenetration and collideConvex.
+ */
+template< class T >
+inline vec<3, T> support( const sphere_t<T>& shape, const vec<3, T>& direction )
+{
+   const T directionLength = length( direction );
+   return directionLength > T(0) ? shape.getCenter() + direction * (shape.getRadius() / directionLength)
+                                 : shape.getCenter() + vec<3, T>( shape.getRadius(), 0, 0 );
+}
+
+template< class T >
+inline vec<3, T> support( const aabox_t<T>& shape, const vec<3, T>& direction )
+{
+   return mix( shape.getMin(), shape.getMax(), greaterThanEqual( direction, vec<3, T>( 0 ) ) );
+}
+
+template< class T >
+inline vec<3, T> support( const obox_t<T>& shape, const vec<3, T>& direction )
+{
+   vec<3, T> point = shape.mCenter;
+   for (int axis = 0; axis < 3; ++axis)
+      point += shape.mAxes[axis] * (dot( direction, shape.mAxes[axis] ) >= T(0) ? shape.mHalfExtents[axis] : -shape.mHalfExtents[axis]);
+   return point;
+}
+
+template< class T >
+inline vec<3, T> support( const capsule_t<T>& shape, const vec<3, T>& direction )
+{
+   const vec<3, T>& end = dot( direction, shape.mB - shape.mA ) >= T(0) ? shape.mB : shape.mA;
+   const T directionLength = length( direction );
+   return directionLength > T(0) ? end + direction * (shape.mRadius / directionLength) : end;
+}
+
+template< class T >
+inline vec<3, T> support( const convex_hull_t<T>& shape, const vec<3, T>& direction )
+{
+   size_t best = 0;
+   T bestDot = -std::numeric_limits<T>::max();
+   for (size_t i = 0; i < shape.mVertices.size(); ++i)
+   {
+      const T d = dot( shape.mVertices[i], direction );
+      if (d > bestDot)
+      {
+         bestDot = d;
+         best = i;
+      }
+   }
+   return shape.mVertices.empty() ? vec<3, T>( 0 ) : shape.mVertices[best];
+}
+
+template< class SHAPE, class T >
+inline vec<3, T> support( const transformed_shape_t<SHAPE, T>& shape, const vec<3, T>& direction )
+{
+   return shape.mRotation * support( *shape.mShape, transpose( shape.mRotation ) * direction ) + shape.mTranslation;
+}
+
+/**
+ * Vertex of a GJK simplex, a point of the Minkowski difference A - B with
+ * the support points it comes from and the direction they were queried
+ * along.
+ */
+template<class T>
+struct gjk_vertex_t
+{
+   vec<3, T> mA;
+   vec<3, T> mB;
+   vec<3, T> mW;
+   vec<3, T> mDirection;
+};
+
+/**
+ * GJK simplex, from a point to a tetrahedron, with the barycentric weights
+ * of the point closest to the origin.
+ */
+template<class T>
+struct gjk_simplex_t
+{
+   gjk_vertex_t<T> mVertices[4];
+   T mWeights[4];
+   int mCount;
+};
+
+/**
+ * Simplex cache of a pair of shapes, for warm starting GJK with the
+ * simplex of the previous frame.
+ *
+ * The cache keeps the support directions of the final simplex. The next
+ * query re-evaluates the supports along them with the current poses, which
+ * rebuilds a simplex close to the solution for shapes that moved a little,
+ * and GJK then converges in one or two iterations. Zero initialize a cache,
+ * or set mCount to 0, to start cold.
+ */
+template<class T>
+struct gjk_cache_t
+{
+   vec<3, T> mDirections[4];
+   int mCount;
+};
+
+/**
+ * Result of a convex collision query.
+ *
+ * mDistance is the separation distance, or minus the penetration depth when
+ * the shapes intersect and EPA ran. mPointA and mPointB are the closest
+ * points, or the deepest points, on each shape and mNormal the unit
+ * direction from A towards B: translating B by -mDistance * mNormal brings
+ * the shapes in touching contact.
+ */
+template<class T>
+struct gjk_result_t
+{
+   bool mIntersecting;
+   T mDistance;
+   vec<3, T> mPointA;
+   vec<3, T> mPointB;
+   vec<3, T> mNormal;
+   int mIterations;
+};
+
+/**
+ * Reduces a simplex to the feature closest to the origin and sets the
+ * barycentric weights of the closest point.
+ *
+ * The solver works on the vertex differences with dot products only, the
+ * Voronoi region tests of Ericson, "Real-Time Collision Detection", 5.1,
+ * and returns false when a tetrahedron contains the origin.
+ */
+template< class T >
+inline bool solveSimplex( gjk_simplex_t<T>& simplex )
+{
+   gjk_vertex_t<T>* v = simplex.mVertices;
+   T* weights = simplex.mWeights;
+   switch (simplex.mCount)
+   {
+   case 1:
+      weights[0] = T(1);
+      return true;
+
+   case 2:
+   {
+      const vec<3, T> ab = v[1].mW - v[0].mW;
+      const T denominator = dot( ab, ab );
+      const T t = denominator > T(0) ? -dot( v[0].mW, ab ) / denominator : T(0);
+      if (t <= T(0))
+      {
+         simplex.mCount = 1;
+         weights[0] = T(1);
+      }
+      else if (t >= T(1))
+      {
+         v[0] = v[1];
+         simplex.mCount = 1;
+         weights[0] = T(1);
+      }
+      else
+      {
+         weights[0] = T(1) - t;
+         weights[1] = t;
+      }
+      return true;
+   }
+
+   case 3:
+   {
+      const vec<3, T> a = v[0].mW, b = v[1].mW, c = v[2].mW;
+      const vec<3, T> ab = b - a, ac = c - a;
+      const T d1 = -dot( ab, a ), d2 = -dot( ac, a );
+      if (d1 <= T(0) && d2 <= T(0))
+      {
+         simplex.mCount = 1;
+         weights[0] = T(1);
+         return true;
+      }
+      const T d3 = -dot( ab, b ), d4 = -dot( ac, b );
+      if (d3 >= T(0) && d4 <= d3)
+      {
+         v[0] = v[1];
+         simplex.mCount = 1;
+         weights[0] = T(1);
+         return true;
+      }
+      const T vc = d1 * d4 - d3 * d2;
+      if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+      {
+         const T t = d1 / (d1 - d3);
+         simplex.mCount = 2;
+         weights[0] = T(1) - t;
+         weights[1] = t;
+         return true;
+      }
+      const T d5 = -dot( ab, c ), d6 = -dot( ac, c );
+      if (d6 >= T(0) && d5 <= d6)
+      {
+         v[0] = v[2];
+         simplex.mCount = 1;
+         weights[0] = T(1);
+         return true;
+      }
+      const T vb = d5 * d2 - d1 * d6;
+      if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+      {
+         const T t = d2 / (d2 - d6);
+         v[1] = v[2];
+         simplex.mCount = 2;
+         weights[0] = T(1) - t;
+         weights[1] = t;
+         return true;
+      }
+      const T va = d3 * d6 - d5 * d4;
+      if (va <= T(0) && d4 - d3 >= T(0) && d5 - d6 >= T(0))
+      {
+         const T t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+         v[0] = v[1];
+         v[1] = v[2];
+         simplex.mCount = 2;
+         weights[0] = T(1) - t;
+         weights[1] = t;
+         return true;
+      }
+      const T denominator = T(1) / (va + vb + vc);
+      weights[1] = vb * denominator;
+      weights[2] = vc * denominator;
+      weights[0] = T(1) - weights[1] - weights[2];
+      return true;
+   }
+
+   default:
+   {
+      // Closest point over the faces the origin is outside of
+      static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+      gjk_simplex_t<T> best;
+      best.mCount = 0;
+      T bestDistance = std::numeric_limits<T>::max();
+      for (int f = 0; f < 4; ++f)
+      {
+         const vec<3, T>& a = v[faces[f][0]].mW;
+         const vec<3, T> n = cross( v[faces[f][1]].mW - a, v[faces[f][2]].mW - a );
+         const T sideOrigin = -dot( n, a );
+         const T sideOpposite = dot( n, v[faces[f][3]].mW - a );
+         const T flat = std::numeric_limits<T>::epsilon() * T(1e3) * lensq( n ) * lensq( v[faces[f][3]].mW - a );
+         if (sideOrigin * sideOpposite >= T(0) && sideOpposite * sideOpposite > flat)
+            continue;
+
+         gjk_simplex_t<T> face;
+         face.mCount = 3;
+         for (int k = 0; k < 3; ++k)
+            face.mVertices[k] = v[faces[f][k]];
+         solveSimplex( face );
+         vec<3, T> closest( 0 );
+         for (int k = 0; k < face.mCount; ++k)
+            closest += face.mVertices[k].mW * face.mWeights[k];
+         const T distance = lensq( closest );
+         if (distance < bestDistance)
+         {
+            bestDistance = distance;
+            best = face;
+         }
+      }
+      if (best.mCount == 0)
+         return false;
+      simplex = best;
+      return true;
+   }
+   }
+}
+
+/**
+ * Computes the distance between two convex shapes with the GJK algorithm
+ * of Gilbert, Johnson and Keerthi.
+ *
+ * @param a         the first shape
+ * @param b         the second shape
+ * @param result    receives the distance, closest points and normal; when
+ *                  the shapes intersect only mIntersecting is meaningful
+ * @param simplex   receives the final simplex, the start of epaPenetration
+ * @param cache     the simplex cache of the pair for warm starting, or NULL
+ *
+ * @return  true if the shapes intersect
+ */
+template< class SHAPE_A, class SHAPE_B, class T >
+inline bool gjkDistance( const SHAPE_A& a, const SHAPE_B& b, gjk_result_t<T>& result,
+                         gjk_simplex_t<T>& simplex, gjk_cache_t<T>* cache = NULL )
+{
+   const int maxIterations = 64;
+   const T relativeTolerance = std::numeric_limits<T>::epsilon() * T(1e3);
+
+   simplex.mCount = 0;
+   const int cached = cache ? cache->mCount : 0;
+   for (int i = 0; i < std::max( cached, 1 ); ++i)
+   {
+      gjk_vertex_t<T>& vertex = simplex.mVertices[simplex.mCount];
+      vertex.mDirection = i < cached ? cache->mDirections[i] : vec<3, T>( 1, 0, 0 );
+      vertex.mA = support( a, vertex.mDirection );
+      vertex.mB = support( b, -vertex.mDirection );
+      vertex.mW = vertex.mA - vertex.mB;
+      bool duplicate = false;
+      for (int k = 0; k < simplex.mCount; ++k)
+         duplicate = duplicate || simplex.mVertices[k].mW == vertex.mW;
+      if (!duplicate)
+         ++simplex.mCount;
+   }
+
+   // The closest simplex so far, kept when an iteration makes no progress
+   result.mIntersecting = false;
+   gjk_simplex_t<T> best = simplex;
+   T bestDistanceSquared = std::numeric_limits<T>::max();
+   vec<3, T> v( 0 );
+   int iteration = 0;
+   for (; iteration < maxIterations; ++iteration)
+   {
+      if (!solveSimplex( simplex ))
+      {
+         result.mIntersecting = true;
+         break;
+      }
+      vec<3, T> closest( 0 );
+      T scale( 0 );
+      for (int k = 0; k < simplex.mCount; ++k)
+      {
+         closest += simplex.mVertices[k].mW * simplex.mWeights[k];
+         scale = max( scale, lensq( simplex.mVertices[k].mW ) );
+      }
+      const T distanceSquared = lensq( closest );
+      if (distanceSquared <= std::numeric_limits<T>::epsilon() * scale)
+      {
+         result.mIntersecting = true;
+         break;
+      }
+      if (distanceSquared >= bestDistanceSquared)
+         break;
+      best = simplex;
+      bestDistanceSquared = distanceSquared;
+      v = closest;
+
+      gjk_vertex_t<T>& vertex = simplex.mVertices[simplex.mCount];
+      vertex.mDirection = -v;
+      vertex.mA = support( a, vertex.mDirection );
+      vertex.mB = support( b, v );
+      vertex.mW = vertex.mA - vertex.mB;
+      if (distanceSquared - dot( v, vertex.mW ) <= relativeTolerance * distanceSquared)
+         break;
+      bool duplicate = false;
+      for (int k = 0; k < simplex.mCount; ++k)
+         duplicate = duplicate || simplex.mVertices[k].mW == vertex.mW;
+      if (duplicate)
+         break;
+      ++simplex.mCount;
+   }
+   result.mIterations = iteration;
+   if (!result.mIntersecting)
+      simplex = best;
+
+   if (cache)
+   {
+      cache->mCount = simplex.mCount;
+      for (int k = 0; k < simplex.mCount; ++k)
+         cache->mDirections[k] = simplex.mVertices[k].mDirection;
+   }
+
+   result.mPointA = vec<3, T>( 0 );
+   result.mPointB = vec<3, T>( 0 );
+   for (int k = 0; k < simplex.mCount && !result.mIntersecting; ++k)
+   {
+      result.mPointA += simplex.mVertices[k].mA * simplex.mWeights[k];
+      result.mPointB += simplex.mVertices[k].mB * simplex.mWeights[k];
+   }
+   result.mDistance = result.mIntersecting ? T(0) : length( v );
+   result.mNormal = result.mIntersecting || result.mDistance <= T(0) ? vec<3, T>( 0 ) : -v / result.mDistance;
+   return result.mIntersecting;
+}
+
+/**
+ * Computes the penetration depth of two intersecting convex shapes with
+ * the expanding polytope algorithm, starting from the simplex returned by
+ * gjkDistance. Simplices with less than 4 vertices, for touching shapes,
+ * are first grown into a tetrahedron.
+ *
+ * @param a        the first shape
+ * @param b        the second shape
+ * @param simplex  the final simplex of gjkDistance for the same shapes
+ * @param result   receives the depth, as a negative mDistance, the deepest points and the normal
+ */
+template< class SHAPE_A, class SHAPE_B, class T >
+inline void epaPenetration( const SHAPE_A& a, const SHAPE_B& b, const gjk_simplex_t<T>& simplex, gjk_result_t<T>& result )
+{
+   const int maxIterations = 128;
+   const T relativeTolerance = max( sqrt( std::numeric_limits<T>::epsilon() ), static_cast<T>(1e-4) );
+
+   std::vector< gjk_vertex_t<T> > vertices( simplex.mVertices, simplex.mVertices + simplex.mCount );
+   T scale( 0 );
+   for (size_t i = 0; i < vertices.size(); ++i)
+      scale = max( scale, length( vertices[i].mW ) );
+   const T tolerance = relativeTolerance * scale;
+
+   // Grows the simplex into a tetrahedron, querying support points off its span
+   const vec<3, T> axes[3] = { vec<3, T>( 1, 0, 0 ), vec<3, T>( 0, 1, 0 ), vec<3, T>( 0, 0, 1 ) };
+   for (int attempt = 0; attempt < 12 && vertices.size() < 4; ++attempt)
+   {
+      vec<3, T> direction;
+      if (vertices.size() == 1)
+         direction = axes[attempt % 3] * (attempt % 6 < 3 ? T(1) : T(-1));
+      else if (vertices.size() == 2)
+      {
+         const vec<3, T> line = vertices[1].mW - vertices[0].mW;
+         direction = cross( line, axes[attempt % 3] );
+         if (attempt % 6 >= 3)
+            direction = -direction;
+      }
+      else
+      {
+         direction = cross( vertices[1].mW - vertices[0].mW, vertices[2].mW - vertices[0].mW );
+         if (attempt % 2)
+            direction = -direction;
+      }
+      if (lensq( direction ) <= T(0))
+         continue;
+
+      gjk_vertex_t<T> vertex;
+      vertex.mDirection = direction;
+      vertex.mA = support( a, direction );
+      vertex.mB = support( b, -direction );
+      vertex.mW = vertex.mA - vertex.mB;
+      const vec<3, T> offset = vertex.mW - vertices[0].mW;
+      T off;
+      if (vertices.size() == 1)
+         off = length( offset );
+      else if (vertices.size() == 2)
+         off = length( cross( offset, normalize( vertices[1].mW - vertices[0].mW ) ) );
+      else
+         off = abs( dot( offset, normalize( direction ) ) );
+      if (off > tolerance)
+         vertices.push_back( vertex );
+   }
+
+   result.mIntersecting = true;
+   result.mIterations = 0;
+   if (vertices.size() < 4)
+   {
+      // Flat shapes: touching contact without depth
+      result.mDistance = T(0);
+      result.mPointA = vertices[0].mA;
+      result.mPointB = vertices[0].mB;
+      result.mNormal = vec<3, T>( 0 );
+      return;
+   }
+
+   struct Face
+   {
+      void setPlane( const std::vector< gjk_vertex_t<T> >& polytope )
+      {
+         const vec<3, T>& p0 = polytope[mVertices[0]].mW;
+         const vec<3, T> n = cross( polytope[mVertices[1]].mW - p0, polytope[mVertices[2]].mW - p0 );
+         const T nLength = length( n );
+         mNormal = nLength > T(0) ? n / nLength : vec<3, T>( 0 );
+         mDistance = nLength > T(0) ? dot( mNormal, p0 ) : std::numeric_limits<T>::max();
+      }
+
+      uint32_t mVertices[3];
+      vec<3, T> mNormal;
+      T mDistance;
+   };
+   std::vector<Face> faces;
+   const vec<3, T> interior = (vertices[0].mW + vertices[1].mW + vertices[2].mW + vertices[3].mW) / T(4);
+   const uint32_t tetrahedron[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+   for (int f = 0; f < 4; ++f)
+   {
+      Face face;
+      std::copy( tetrahedron[f], tetrahedron[f] + 3, face.mVertices );
+      if (dot( cross( vertices[face.mVertices[1]].mW - vertices[face.mVertices[0]].mW,
+                      vertices[face.mVertices[2]].mW - vertices[face.mVertices[0]].mW ),
+               vertices[face.mVertices[0]].mW - interior ) < T(0))
+         std::swap( face.mVertices[1], face.mVertices[2] );
+      face.setPlane( vertices );
+      faces.push_back( face );
+   }
+
+   std::vector<uint32_t> edges;
+   size_t closest = 0;
+   int iteration = 0;
+   for (; iteration < maxIterations; ++iteration)
+   {
+      closest = 0;
+      for (size_t f = 1; f < faces.size(); ++f)
+         if (faces[f].mDistance < faces[closest].mDistance)
+            closest = f;
+
+      gjk_vertex_t<T> vertex;
+      vertex.mDirection = faces[closest].mNormal;
+      vertex.mA = support( a, vertex.mDirection );
+      vertex.mB = support( b, -vertex.mDirection );
+      vertex.mW = vertex.mA - vertex.mB;
+      if (dot( vertex.mW, faces[closest].mNormal ) - faces[closest].mDistance <= tolerance)
+         break;
+
+      // Removes the faces seen from the new vertex, keeping their boundary
+      const uint32_t index = static_cast<uint32_t>(vertices.size());
+      vertices.push_back( vertex );
+      edges.clear();
+      for (size_t f = 0; f < faces.size();)
+      {
+         if (dot( faces[f].mNormal, vertex.mW - vertices[faces[f].mVertices[0]].mW ) <= T(0))
+         {
+            ++f;
+            continue;
+         }
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t e0 = faces[f].mVertices[k], e1 = faces[f].mVertices[(k + 1) % 3];
+            bool shared = false;
+            for (size_t e = 0; e < edges.size(); e += 2)
+               if (edges[e] == e1 && edges[e + 1] == e0)
+               {
+                  edges.erase( edges.begin() + static_cast<std::ptrdiff_t>(e), edges.begin() + static_cast<std::ptrdiff_t>(e) + 2 );
+                  shared = true;
+                  break;
+               }
+            if (!shared)
+            {
+               edges.push_back( e0 );
+               edges.push_back( e1 );
+            }
+         }
+         faces[f] = faces.back();
+         faces.pop_back();
+      }
+      for (size_t e = 0; e < edges.size(); e += 2)
+      {
+         Face face;
+         face.mVertices[0] = edges[e];
+         face.mVertices[1] = edges[e + 1];
+         face.mVertices[2] = index;
+         face.setPlane( vertices );
+         faces.push_back( face );
+      }
+   }
+   result.mIterations = iteration;
+   closest = 0;
+   for (size_t f = 1; f < faces.size(); ++f)
+      if (faces[f].mDistance < faces[closest].mDistance)
+         closest = f;
+
+   // Deepest points from the projection of the origin on the closest face
+   const Face& face = faces[closest];
+   const gjk_vertex_t<T>& v0 = vertices[face.mVertices[0]];
+   const gjk_vertex_t<T>& v1 = vertices[face.mVertices[1]];
+   const gjk_vertex_t<T>& v2 = vertices[face.mVertices[2]];
+   const vec<3, T> p = face.mNormal * face.mDistance;
+   const vec<3, T> e0 = v1.mW - v0.mW, e1 = v2.mW - v0.mW, e2 = p - v0.mW;
+   const T d00 = dot( e0, e0 ), d01 = dot( e0, e1 ), d11 = dot( e1, e1 );
+   const T d20 = dot( e2, e0 ), d21 = dot( e2, e1 );
+   const T denominator = d00 * d11 - d01 * d01;
+   const T w1 = denominator != T(0) ? (d11 * d20 - d01 * d21) / denominator : T(0);
+   const T w2 = denominator != T(0) ? (d00 * d21 - d01 * d20) / denominator : T(0);
+   const T w0 = T(1) - w1 - w2;
+   result.mPointA = v0.mA * w0 + v1.mA * w1 + v2.mA * w2;
+   result.mPointB = v0.mB * w0 + v1.mB * w1 + v2.mB * w2;
+   result.mDistance = -face.mDistance;
+   result.mNormal = face.mNormal;
+}
+
+/**
+ * Full convex collision query: the separation distance with gjkDistance,
+ * then the penetration depth with epaPenetration when the shapes
+ * intersect.
+ *
+ * @return  true if the shapes intersect
+ */
+template< class SHAPE_A, class SHAPE_B, class T >
+inline bool collideConvex( const SHAPE_A& a, const SHAPE_B& b, gjk_result_t<T>& result, gjk_cache_t<T>* cache = NULL )
+{
+   gjk_simplex_t<T> simplex;
+   if (!gjkDistance( a, b, result, simplex, cache ))
+      return false;
+   const int iterations = result.mIterations;
+   epaPenetration( a, b, simplex, result );
+   result.mIterations += iterations;
+   return true;
+}
+
+/**
+ * Runs collideConvex over a list of pairs, such as the output of a broad
+ * phase. Pair i tests shapesA[pairs[2 * i]] against
+ * shapesB[pairs[2 * i + 1]]; both arrays may be the same.
+ *
+ * Pairs are independent, so disjoint pair ranges may run on different
+ * threads.
+ *
+ * @param caches   one simplex cache per pair, kept from frame to frame, or NULL
+ * @param results  receives one result per pair
+ *
+ * @return  the number of intersecting pairs
+ */
+template< class SHAPE_A, class SHAPE_B, class T >
+inline size_t collideConvexBatch( const SHAPE_A* shapesA, const SHAPE_B* shapesB, const uint32_t* pairs, size_t pairCount,
+                                  gjk_cache_t<T>* caches, gjk_result_t<T>* results )
+{
+   size_t intersecting = 0;
+   for (size_t i = 0; i < pairCount; ++i)
+      if (collideConvex( shapesA[pairs[2 * i]], shapesB[pairs[2 * i + 1]], results[i], caches ? caches + i : NULL ))
+         ++intersecting;
+   return intersecting;
+}
+
+// --- helper types --- //
+typedef obox_t<float>          oboxf;
+typedef obox_t<double>         oboxd;
+typedef capsule_t<float>       capsulef;
+typedef capsule_t<double>      capsuled;
+typedef gjk_cache_t<float>     gjk_cachef;
+typedef gjk_cache_t<double>    gjk_cached;
+typedef gjk_result_t<float>    gjk_resultf;
+typedef gjk_result_t<double>   gjk_resultd;
+
+}
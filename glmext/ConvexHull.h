@@ -0,0 +1,580 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+#include "Plane.h"
+
+namespace glm
+{
+
+/**
+ * Convex hull of a point set: triangles over the hull vertices and the
+ * plane of each triangle.
+ *
+ * Triangles are counter clockwise seen from outside and the plane normals
+ * point outside, so a point p is inside the hull when
+ * mPlanes[f].distanceTo( p ) <= 0 for all faces f.
+ *
+ * @param T     the internal type used for the positions
+ * @ingroup Types
+ */
+template<class T>
+class convex_hull_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Removes all vertices and faces, keeping the storage.
+    */
+   void clear()
+   {
+      mVertices.clear();
+      mSourceIndices.clear();
+      mIndices.clear();
+      mPlanes.clear();
+   }
+
+   /**
+    * Gets the number of triangular faces.
+    */
+   size_t getFaceCount() const
+   {
+      return mIndices.size() / 3;
+   }
+
+   /**
+    * Tests if a point is inside the hull, up to the given tolerance.
+    */
+   bool contains( const vec<3, T>& point, const T& tolerance ) const
+   {
+      for (size_t f = 0; f < mPlanes.size(); ++f)
+         if (mPlanes[f].distanceTo( point ) > tolerance)
+            return false;
+      return true;
+   }
+
+public:
+   /** The hull vertices. */
+   std::vector< vec<3, T> > mVertices;
+
+   /** The index of each hull vertex in the input points. */
+   std::vector<uint32_t> mSourceIndices;
+
+   /** Three indices into mVertices per face. */
+   std::vector<uint32_t> mIndices;
+
+   /** The plane of each face. */
+   std::vector< plane_t<T> > mPlanes;
+};
+
+/**
+ * Quickhull convex hull builder (Barber, Dobkin and Huhdanpaa).
+ *
+ * The hull is kept as a half-edge mesh. Faces and half-edges live in
+ * pooled arrays with free lists, and the points outside of each face are
+ * chained through a per point array, so reusing a builder for several
+ * point sets does not allocate once its arrays are large enough.
+ *
+ * A point is outside a face when it is further than getTolerance() from
+ * the face plane, the tolerance scaling with the magnitude of the input
+ * coordinates to absorb rounding. Points within the tolerance of the hull
+ * are dropped.
+ *
+ * Building runs in three steps: begin() finds the initial tetrahedron,
+ * partitionPoints() assigns the points to its faces and build() grows the
+ * hull. The partition is the only pass over all of the points; calls on
+ * disjoint ranges write disjoint entries and may run on different threads
+ * for large inputs. computeConvexHull chains the three steps.
+ *
+ * @param T     the internal type used for the positions
+ * @ingroup Types
+ */
+template<class T>
+class quickhull_t
+{
+public:
+   typedef T DataType;
+
+public:
+   quickhull_t()
+      : mPoints( NULL ), mCount( 0 ), mTolerance( 0 )
+   {}
+
+   /**
+    * Starts a hull: computes the tolerance and the initial tetrahedron.
+    *
+    * @param points  the input points, must stay valid until build returns
+    * @param count   the number of points
+    *
+    * @return  false if the points are coplanar within the tolerance, the hull has no volume
+    */
+   bool begin( const vec<3, T>* points, size_t count )
+   {
+      mPoints = points;
+      mCount = count;
+      mEdges.clear();
+      mFaces.clear();
+      mFreeEdges.clear();
+      mFreeFaces.clear();
+      mPointFace.assign( count, none() );
+      mPointDistance.assign( count, T(0) );
+      std::fill( mInitialVertices, mInitialVertices + 4, mCount );
+      if (count < 4)
+         return false;
+
+      // Extreme points along each axis
+      size_t extremes[6] = { 0, 0, 0, 0, 0, 0 };
+      for (size_t i = 1; i < count; ++i)
+         for (int axis = 0; axis < 3; ++axis)
+         {
+            if (points[i][axis] < points[extremes[2 * axis]][axis])
+               extremes[2 * axis] = i;
+            if (points[i][axis] > points[extremes[2 * axis + 1]][axis])
+               extremes[2 * axis + 1] = i;
+         }
+      vec<3, T> magnitude( 0 );
+      for (int axis = 0; axis < 3; ++axis)
+         magnitude[axis] = std::max( abs( points[extremes[2 * axis]][axis] ), abs( points[extremes[2 * axis + 1]][axis] ) );
+      mTolerance = T(3) * std::numeric_limits<T>::epsilon() * (magnitude.x + magnitude.y + magnitude.z);
+
+      // The widest axis gives the first edge, then the farthest point from its line and from their plane
+      int widest = 0;
+      for (int axis = 1; axis < 3; ++axis)
+         if (points[extremes[2 * axis + 1]][axis] - points[extremes[2 * axis]][axis] >
+             points[extremes[2 * widest + 1]][widest] - points[extremes[2 * widest]][widest])
+            widest = axis;
+      size_t v[4] = { extremes[2 * widest], extremes[2 * widest + 1], 0, 0 };
+      const vec<3, T> p0 = points[v[0]];
+      const vec<3, T> lineDirection = points[v[1]] - p0;
+      if (lensq( lineDirection ) <= mTolerance * mTolerance)
+         return false;
+
+      T best( 0 );
+      for (size_t i = 0; i < count; ++i)
+      {
+         const T d = lensq( cross( points[i] - p0, lineDirection ) );
+         if (d > best)
+         {
+            best = d;
+            v[2] = i;
+         }
+      }
+      vec<3, T> normal = cross( lineDirection, points[v[2]] - p0 );
+      const T normalLength = length( normal );
+      if (normalLength <= mTolerance * length( lineDirection ))
+         return false;
+      normal /= normalLength;
+
+      best = T(0);
+      for (size_t i = 0; i < count; ++i)
+      {
+         const T d = abs( dot( points[i] - p0, normal ) );
+         if (d > best)
+         {
+            best = d;
+            v[3] = i;
+         }
+      }
+      if (best <= mTolerance)
+         return false;
+
+      // Orient (v0, v1, v2) so that v3 lies below it
+      if (dot( points[v[3]] - p0, normal ) > T(0))
+         std::swap( v[1], v[2] );
+      const uint32_t a = static_cast<uint32_t>(v[0]), b = static_cast<uint32_t>(v[1]);
+      const uint32_t c = static_cast<uint32_t>(v[2]), d = static_cast<uint32_t>(v[3]);
+      const uint32_t faces[4] = { addFace( a, b, c ), addFace( a, d, b ), addFace( b, d, c ), addFace( c, d, a ) };
+      for (int i = 0; i < 4; ++i)
+         for (int j = 0; j < 4; ++j)
+            if (i != j)
+               linkFaces( faces[i], faces[j] );
+      mInitialVertices[0] = a;
+      mInitialVertices[1] = b;
+      mInitialVertices[2] = c;
+      mInitialVertices[3] = d;
+      return true;
+   }
+
+   /**
+    * Assigns the points [first, first + count) to the tetrahedron face they
+    * are the furthest outside of. Evaluates the 4 face planes for blocks of
+    * 16 points at a time.
+    */
+   void partitionPoints( size_t first, size_t count )
+   {
+      if (mFaces.empty())
+         return;
+      const size_t blockSize = 16;
+      const size_t last = std::min( first + count, mCount );
+      for (size_t base = first; base < last; base += blockSize)
+      {
+         const size_t n = std::min( blockSize, last - base );
+         T best[blockSize];
+         uint32_t bestFace[blockSize];
+         for (size_t i = 0; i < n; ++i)
+         {
+            best[i] = mTolerance;
+            bestFace[i] = none();
+         }
+         for (uint32_t f = 0; f < 4; ++f)
+         {
+            const vec<3, T> normal = mFaces[f].mPlane.getNormal();
+            const T offset = mFaces[f].mPlane.getOffset();
+            for (size_t i = 0; i < n; ++i)
+            {
+               const T d = dot( normal, mPoints[base + i] ) - offset;
+               bestFace[i] = d > best[i] ? f : bestFace[i];
+               best[i] = max( d, best[i] );
+            }
+         }
+         for (size_t i = 0; i < n; ++i)
+            if (!isInitialVertex( base + i ))
+            {
+               mPointFace[base + i] = bestFace[i];
+               mPointDistance[base + i] = best[i];
+            }
+      }
+   }
+
+   /**
+    * Grows the hull from the partitioned points and writes it to hull.
+    */
+   void build( convex_hull_t<T>& hull )
+   {
+      hull.clear();
+      if (mFaces.empty())
+         return;
+
+      mPointNext.assign( mCount, none() );
+      for (size_t i = 0; i < mCount; ++i)
+         if (!isInitialVertex( i ) && mPointFace[i] != none())
+            addOutsidePoint( mPointFace[i], static_cast<uint32_t>(i), mPointDistance[i] );
+
+      std::vector<uint32_t> pending;
+      for (uint32_t f = 0; f < 4; ++f)
+         pending.push_back( f );
+      std::vector<uint32_t> visible, horizon, orphans, created;
+      std::vector<Frame> frames;
+
+      while (!pending.empty())
+      {
+         const uint32_t start = pending.back();
+         pending.pop_back();
+         if (!mFaces[start].mAlive || mFaces[start].mOutside == none())
+            continue;
+         const uint32_t eye = mFaces[start].mFarthest;
+         const vec<3, T> eyePoint = mPoints[eye];
+
+         // Visible faces and the horizon, counter clockwise seen from the eye
+         visible.clear();
+         horizon.clear();
+         mFaces[start].mAlive = false;
+         visible.push_back( start );
+         frames.clear();
+         frames.push_back( Frame( mFaces[start].mEdge, mFaces[start].mEdge, false ) );
+         while (!frames.empty())
+         {
+            Frame& frame = frames.back();
+            if (frame.mStarted && frame.mEdge == frame.mStop)
+            {
+               frames.pop_back();
+               continue;
+            }
+            frame.mStarted = true;
+            const uint32_t edge = frame.mEdge;
+            frame.mEdge = mEdges[edge].mNext;
+
+            const uint32_t twin = mEdges[edge].mTwin;
+            const uint32_t neighbor = mEdges[twin].mFace;
+            if (!mFaces[neighbor].mAlive)
+               continue;
+            if (mFaces[neighbor].mPlane.distanceTo( eyePoint ) > mTolerance)
+            {
+               mFaces[neighbor].mAlive = false;
+               visible.push_back( neighbor );
+               frames.push_back( Frame( mEdges[twin].mNext, twin, true ) );
+            }
+            else
+               horizon.push_back( edge );
+         }
+
+         // Points outside of the visible faces, the eye excepted
+         orphans.clear();
+         for (size_t i = 0; i < visible.size(); ++i)
+            for (uint32_t p = mFaces[visible[i]].mOutside; p != none(); p = mPointNext[p])
+               if (p != eye)
+                  orphans.push_back( p );
+
+         // Horizon edges, read before their faces are recycled
+         const size_t horizonCount = horizon.size();
+         std::vector<uint32_t>& horizonData = mScratch;
+         horizonData.resize( 3 * horizonCount );
+         for (size_t i = 0; i < horizonCount; ++i)
+         {
+            const uint32_t edge = horizon[i];
+            horizonData[3 * i] = mEdges[edge].mVertex;
+            horizonData[3 * i + 1] = mEdges[mEdges[edge].mNext].mVertex;
+            horizonData[3 * i + 2] = mEdges[edge].mTwin;
+         }
+         for (size_t i = 0; i < visible.size(); ++i)
+            releaseFace( visible[i] );
+
+         // Cone of new faces from the horizon to the eye
+         created.clear();
+         for (size_t i = 0; i < horizonCount; ++i)
+         {
+            const uint32_t face = addFace( horizonData[3 * i], horizonData[3 * i + 1], eye );
+            const uint32_t edge = mFaces[face].mEdge;
+            mEdges[edge].mTwin = horizonData[3 * i + 2];
+            mEdges[horizonData[3 * i + 2]].mTwin = edge;
+            created.push_back( face );
+         }
+         for (size_t i = 0; i < horizonCount; ++i)
+         {
+            // Consecutive horizon edges chain, b -> eye of a face is the twin of eye -> a of the next one
+            const uint32_t toEye = mEdges[mFaces[created[i]].mEdge].mNext;
+            const uint32_t fromEye = mEdges[mEdges[mFaces[created[(i + 1) % horizonCount]].mEdge].mNext].mNext;
+            mEdges[toEye].mTwin = fromEye;
+            mEdges[fromEye].mTwin = toEye;
+         }
+
+         // Orphans go to the new face they are the furthest outside of, or are inside
+         for (size_t i = 0; i < orphans.size(); ++i)
+         {
+            const vec<3, T>& point = mPoints[orphans[i]];
+            T best = mTolerance;
+            uint32_t bestFace = none();
+            for (size_t f = 0; f < created.size(); ++f)
+            {
+               const T d = mFaces[created[f]].mPlane.distanceTo( point );
+               if (d > best)
+               {
+                  best = d;
+                  bestFace = created[f];
+               }
+            }
+            if (bestFace != none())
+               addOutsidePoint( bestFace, orphans[i], best );
+         }
+         pending.insert( pending.end(), created.begin(), created.end() );
+      }
+
+      // Compact output
+      std::vector<uint32_t>& remap = mScratch;
+      remap.assign( mCount, none() );
+      for (uint32_t f = 0; f < mFaces.size(); ++f)
+      {
+         if (!mFaces[f].mAlive)
+            continue;
+         uint32_t edge = mFaces[f].mEdge;
+         for (int k = 0; k < 3; ++k, edge = mEdges[edge].mNext)
+         {
+            const uint32_t v = mEdges[edge].mVertex;
+            if (remap[v] == none())
+            {
+               remap[v] = static_cast<uint32_t>(hull.mVertices.size());
+               hull.mVertices.push_back( mPoints[v] );
+               hull.mSourceIndices.push_back( v );
+            }
+            hull.mIndices.push_back( remap[v] );
+         }
+         hull.mPlanes.push_back( mFaces[f].mPlane );
+      }
+   }
+
+   /**
+    * Gets the distance under which points are considered on a face plane.
+    */
+   const T& getTolerance() const
+   {
+      return mTolerance;
+   }
+
+private:
+   struct HalfEdge
+   {
+      uint32_t mVertex;   // origin point
+      uint32_t mNext;
+      uint32_t mTwin;
+      uint32_t mFace;
+   };
+
+   struct Face
+   {
+      Face()
+         : mEdge( 0 ), mOutside( 0 ), mFarthest( 0 ), mFarthestDistance( 0 ), mAlive( false ),
+           mPlane( vec<3, T>( 0 ), T(0) )
+      {}
+
+      uint32_t mEdge;
+      uint32_t mOutside;    // head of the outside point list
+      uint32_t mFarthest;
+      T mFarthestDistance;
+      bool mAlive;
+      plane_t<T> mPlane;
+   };
+
+   struct Frame
+   {
+      Frame( uint32_t edge, uint32_t stop, bool started )
+         : mEdge( edge ), mStop( stop ), mStarted( started )
+      {}
+
+      uint32_t mEdge;
+      uint32_t mStop;
+      bool mStarted;
+   };
+
+   static uint32_t none()
+   {
+      return std::numeric_limits<uint32_t>::max();
+   }
+
+   bool isInitialVertex( size_t i ) const
+   {
+      return i == mInitialVertices[0] || i == mInitialVertices[1] || i == mInitialVertices[2] || i == mInitialVertices[3];
+   }
+
+   uint32_t allocateEdge()
+   {
+      if (!mFreeEdges.empty())
+      {
+         const uint32_t edge = mFreeEdges.back();
+         mFreeEdges.pop_back();
+         return edge;
+      }
+      mEdges.push_back( HalfEdge() );
+      return static_cast<uint32_t>(mEdges.size() - 1);
+   }
+
+   uint32_t addFace( uint32_t a, uint32_t b, uint32_t c )
+   {
+      uint32_t face;
+      if (!mFreeFaces.empty())
+      {
+         face = mFreeFaces.back();
+         mFreeFaces.pop_back();
+      }
+      else
+      {
+         mFaces.push_back( Face() );
+         face = static_cast<uint32_t>(mFaces.size() - 1);
+      }
+      const uint32_t vertices[3] = { a, b, c };
+      uint32_t edges[3];
+      for (int k = 0; k < 3; ++k)
+         edges[k] = allocateEdge();
+      for (int k = 0; k < 3; ++k)
+      {
+         mEdges[edges[k]].mVertex = vertices[k];
+         mEdges[edges[k]].mNext = edges[(k + 1) % 3];
+         mEdges[edges[k]].mTwin = none();
+         mEdges[edges[k]].mFace = face;
+      }
+
+      const vec<3, T>& pa = mPoints[a];
+      const vec<3, T>& pb = mPoints[b];
+      const vec<3, T>& pc = mPoints[c];
+      vec<3, T> normal = cross( pb - pa, pc - pa );
+      const T normalLength = length( normal );
+      normal = normalLength > T(0) ? normal / normalLength : vec<3, T>( 0 );
+
+      Face& f = mFaces[face];
+      f.mEdge = edges[0];
+      f.mOutside = none();
+      f.mFarthest = none();
+      f.mFarthestDistance = T(0);
+      f.mAlive = true;
+      f.mPlane.setNormal( normal );
+      f.mPlane.setOffset( dot( normal, (pa + pb + pc) / T(3) ) );
+      return face;
+   }
+
+   void releaseFace( uint32_t face )
+   {
+      uint32_t edge = mFaces[face].mEdge;
+      for (int k = 0; k < 3; ++k, edge = mEdges[edge].mNext)
+         mFreeEdges.push_back( edge );
+      mFreeFaces.push_back( face );
+   }
+
+   /** Links the twin half-edges shared by two faces of the initial tetrahedron. */
+   void linkFaces( uint32_t f0, uint32_t f1 )
+   {
+      uint32_t e0 = mFaces[f0].mEdge;
+      for (int i = 0; i < 3; ++i, e0 = mEdges[e0].mNext)
+      {
+         uint32_t e1 = mFaces[f1].mEdge;
+         for (int j = 0; j < 3; ++j, e1 = mEdges[e1].mNext)
+            if (mEdges[e0].mVertex == mEdges[mEdges[e1].mNext].mVertex &&
+                mEdges[e1].mVertex == mEdges[mEdges[e0].mNext].mVertex)
+            {
+               mEdges[e0].mTwin = e1;
+               mEdges[e1].mTwin = e0;
+            }
+      }
+   }
+
+   void addOutsidePoint( uint32_t face, uint32_t point, const T& distance )
+   {
+      Face& f = mFaces[face];
+      mPointNext[point] = f.mOutside;
+      f.mOutside = point;
+      if (f.mFarthest == none() || distance > f.mFarthestDistance)
+      {
+         f.mFarthest = point;
+         f.mFarthestDistance = distance;
+      }
+   }
+
+private:
+   const vec<3, T>* mPoints;
+   size_t mCount;
+   T mTolerance;
+   size_t mInitialVertices[4];
+   std::vector<HalfEdge> mEdges;
+   std::vector<Face> mFaces;
+   std::vector<uint32_t> mFreeEdges;
+   std::vector<uint32_t> mFreeFaces;
+   std::vector<uint32_t> mPointFace;
+   std::vector<T> mPointDistance;
+   std::vector<uint32_t> mPointNext;
+   std::vector<uint32_t> mScratch;
+};
+
+/**
+ * Computes the convex hull of a point set with quickhull_t.
+ *
+ * @param points  the input points
+ * @param count   the number of points
+ * @param hull    receives the hull, empty when the points are coplanar
+ *
+ * @return  false if the points are coplanar, the hull has no volume
+ */
+template< class T >
+inline bool computeConvexHull( const vec<3, T>* points, size_t count, convex_hull_t<T>& hull )
+{
+   quickhull_t<T> builder;
+   if (!builder.begin( points, count ))
+   {
+      hull.clear();
+      return false;
+   }
+   builder.partitionPoints( 0, count );
+   builder.build( hull );
+   return true;
+}
+
+// --- helper types --- //
+typedef convex_hull_t<float>   convex_hullf;
+typedef convex_hull_t<double>  convex_hulld;
+typedef quickhull_t<float>     quickhullf;
+typedef quickhull_t<double>    quickhulld;
+
+}
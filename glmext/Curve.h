@@ -0,0 +1,602 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "AABox.h"
+
+namespace glm
+{
+
+/**
+ * Kinds of curve_t.
+ */
+enum CurveType
+{
+   CURVE_CATMULL_ROM,
+   CURVE_HERMITE,
+   CURVE_BEZIER,
+   CURVE_BSPLINE
+};
+
+/**
+ * A piecewise cubic 3D curve: Catmull-Rom, Hermite, Bezier or uniform
+ * B-spline, converted on construction to one polynomial a + b s + c s^2 +
+ * d s^3 per segment, s in [0, 1].
+ *
+ * The curve parameter u runs from 0 to getSegmentCount(), segment i covering
+ * [i, i + 1]. Each segment has a tight bounding box, grouped into a
+ * hierarchy for closest point queries, and a table of the arc length at
+ * ARC_SAMPLES steps per segment maps distances along the curve to
+ * parameters, for constant speed traversal.
+ *
+ * @param T     the internal type used for the positions
+ * @ingroup Types
+ */
+template<class T>
+class curve_t
+{
+public:
+   typedef T DataType;
+
+   /** Arc length table steps per segment. */
+   static const size_t ARC_SAMPLES = 16;
+
+   /** Batched evaluation block size. */
+   static const size_t BATCH = 16;
+
+   /** Initial samples per segment of the closest point search. */
+   static const size_t CLOSEST_SAMPLES = 8;
+
+public:
+   curve_t()
+      : mType( CURVE_CATMULL_ROM )
+   {}
+
+   /**
+    * Builds a Catmull-Rom spline through the points, with knots spaced by
+    * the distance between points raised to alpha: 0 uniform, 0.5
+    * centripetal (no cusps or self-intersections within a segment), 1
+    * chordal. Open curves are extended by reflecting the end points.
+    */
+   void setCatmullRom( const vec<3, T>* points, size_t count, bool closed = false, T alpha = T(0.5) )
+   {
+      mType = CURVE_CATMULL_ROM;
+      mCoefficients.clear();
+      if (count < 2)
+      {
+         finish();
+         return;
+      }
+      const size_t segments = closed ? count : count - 1;
+      for (size_t i = 0; i < segments; ++i)
+      {
+         const vec<3, T> p1 = points[i];
+         const vec<3, T> p2 = points[(i + 1) % count];
+         vec<3, T> p0, p3;
+         if (closed)
+         {
+            p0 = points[(i + count - 1) % count];
+            p3 = points[(i + 2) % count];
+         }
+         else
+         {
+            p0 = i > 0 ? points[i - 1] : p1 * T(2) - p2;
+            p3 = i + 2 < count ? points[i + 2] : p2 * T(2) - p1;
+         }
+
+         // Tangents of the non uniform parameterization, scaled to the segment
+         const T d01 = knotInterval( p0, p1, alpha );
+         const T d12 = knotInterval( p1, p2, alpha );
+         const T d23 = knotInterval( p2, p3, alpha );
+         const vec<3, T> m1 = ((p1 - p0) / d01 - (p2 - p0) / (d01 + d12) + (p2 - p1) / d12) * d12;
+         const vec<3, T> m2 = ((p2 - p1) / d12 - (p3 - p1) / (d12 + d23) + (p3 - p2) / d23) * d12;
+         addHermite( p1, m1, p2, m2 );
+      }
+      finish();
+   }
+
+   /**
+    * Builds a Hermite spline through the points with the given tangents.
+    */
+   void setHermite( const vec<3, T>* points, const vec<3, T>* tangents, size_t count )
+   {
+      mType = CURVE_HERMITE;
+      mCoefficients.clear();
+      for (size_t i = 0; i + 1 < count; ++i)
+         addHermite( points[i], tangents[i], points[i + 1], tangents[i + 1] );
+      finish();
+   }
+
+   /**
+    * Builds a piecewise cubic Bezier curve from 3 n + 1 control points,
+    * consecutive segments sharing their end point.
+    */
+   void setBezier( const vec<3, T>* controls, size_t count )
+   {
+      mType = CURVE_BEZIER;
+      mCoefficients.clear();
+      for (size_t i = 0; i + 3 < count; i += 3)
+      {
+         const vec<3, T>& b0 = controls[i];
+         const vec<3, T>& b1 = controls[i + 1];
+         const vec<3, T>& b2 = controls[i + 2];
+         const vec<3, T>& b3 = controls[i + 3];
+         mCoefficients.push_back( b0 );
+         mCoefficients.push_back( (b1 - b0) * T(3) );
+         mCoefficients.push_back( (b0 - b1 * T(2) + b2) * T(3) );
+         mCoefficients.push_back( b3 - b0 + (b1 - b2) * T(3) );
+      }
+      finish();
+   }
+
+   /**
+    * Builds a uniform cubic B-spline over the control points, which it
+    * approximates: count - 3 segments open, count closed.
+    */
+   void setBSpline( const vec<3, T>* controls, size_t count, bool closed = false )
+   {
+      mType = CURVE_BSPLINE;
+      mCoefficients.clear();
+      const size_t segments = closed ? (count >= 3 ? count : 0) : (count >= 4 ? count - 3 : 0);
+      for (size_t i = 0; i < segments; ++i)
+      {
+         const vec<3, T>& p0 = controls[i % count];
+         const vec<3, T>& p1 = controls[(i + 1) % count];
+         const vec<3, T>& p2 = controls[(i + 2) % count];
+         const vec<3, T>& p3 = controls[(i + 3) % count];
+         mCoefficients.push_back( (p0 + p1 * T(4) + p2) / T(6) );
+         mCoefficients.push_back( (p2 - p0) / T(2) );
+         mCoefficients.push_back( (p0 - p1 * T(2) + p2) / T(2) );
+         mCoefficients.push_back( (p3 - p0 + (p1 - p2) * T(3)) / T(6) );
+      }
+      finish();
+   }
+
+   CurveType getType() const
+   {
+      return mType;
+   }
+
+   size_t getSegmentCount() const
+   {
+      return mCoefficients.size() / 4;
+   }
+
+   /** The bounding box of segment i. */
+   const aabox_t<T>& getSegmentBounds( size_t i ) const
+   {
+      return mBounds[i];
+   }
+
+   /** The bounding box of the whole curve. */
+   aabox_t<T> getBounds() const
+   {
+      return mBounds.empty() ? aabox_t<T>() : mBounds.back();
+   }
+
+   /** The length of the curve, from the arc length table. */
+   T getLength() const
+   {
+      return mArcLengths.empty() ? T(0) : mArcLengths.back();
+   }
+
+   /**
+    * The position at parameter u, clamped to [0, getSegmentCount()].
+    */
+   vec<3, T> position( const T& u ) const
+   {
+      T s;
+      const vec<3, T>* c = segment( u, s );
+      return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+   }
+
+   /**
+    * The derivative with respect to u at parameter u.
+    */
+   vec<3, T> tangent( const T& u ) const
+   {
+      T s;
+      const vec<3, T>* c = segment( u, s );
+      return c[1] + s * (c[2] * T(2) + s * c[3] * T(3));
+   }
+
+   /**
+    * Evaluates the positions, and the tangents if not NULL, at count
+    * parameters. Blocks of BATCH parameters are split into segment and
+    * local parameter streams, then evaluated as structure of arrays loops
+    * the compiler can vectorize.
+    */
+   void evaluateBatch( const T* params, size_t count, vec<3, T>* positions, vec<3, T>* tangents ) const
+   {
+      if (mCoefficients.empty())
+         return;
+      T s[BATCH], c[4][3][BATCH], out[3][BATCH];
+      for (size_t first = 0; first < count; first += BATCH)
+      {
+         const size_t n = std::min( BATCH, count - first );
+         for (size_t i = 0; i < n; ++i)
+         {
+            const vec<3, T>* k = segment( params[first + i], s[i] );
+            for (int j = 0; j < 4; ++j)
+               for (int a = 0; a < 3; ++a)
+                  c[j][a][i] = k[j][a];
+         }
+         for (int a = 0; a < 3; ++a)
+            for (size_t i = 0; i < n; ++i)
+               out[a][i] = c[0][a][i] + s[i] * (c[1][a][i] + s[i] * (c[2][a][i] + s[i] * c[3][a][i]));
+         for (size_t i = 0; i < n; ++i)
+            positions[first + i] = vec<3, T>( out[0][i], out[1][i], out[2][i] );
+         if (tangents)
+         {
+            for (int a = 0; a < 3; ++a)
+               for (size_t i = 0; i < n; ++i)
+                  out[a][i] = c[1][a][i] + s[i] * (T(2) * c[2][a][i] + s[i] * T(3) * c[3][a][i]);
+            for (size_t i = 0; i < n; ++i)
+               tangents[first + i] = vec<3, T>( out[0][i], out[1][i], out[2][i] );
+         }
+      }
+   }
+
+   /**
+    * The arc length from the start of the curve to parameter u.
+    */
+   T distanceAt( const T& u ) const
+   {
+      if (mCoefficients.empty())
+         return T(0);
+      const T steps = static_cast<T>(ARC_SAMPLES);
+      const T clamped = glm::clamp( u, T(0), static_cast<T>(getSegmentCount()) );
+      const size_t k = std::min( static_cast<size_t>(clamped * steps), mArcLengths.size() - 2 );
+      return mArcLengths[k] + arcLength( static_cast<T>(k) / steps, clamped );
+   }
+
+   /**
+    * The parameter at the given arc length from the start of the curve,
+    * clamped to the curve: the table is searched, then refined by Newton
+    * steps on the arc length.
+    */
+   T parameterAt( const T& distance ) const
+   {
+      if (mCoefficients.empty())
+         return T(0);
+      const T steps = static_cast<T>(ARC_SAMPLES);
+      const T d = glm::clamp( distance, T(0), getLength() );
+      size_t k = static_cast<size_t>(std::upper_bound( mArcLengths.begin(), mArcLengths.end(), d ) - mArcLengths.begin());
+      k = std::min( k == 0 ? 0 : k - 1, mArcLengths.size() - 2 );
+
+      const T u0 = static_cast<T>(k) / steps, u1 = static_cast<T>(k + 1) / steps;
+      const T d0 = mArcLengths[k], d1 = mArcLengths[k + 1];
+      T u = d1 > d0 ? u0 + (u1 - u0) * (d - d0) / (d1 - d0) : u0;
+      for (int iteration = 0; iteration < 3; ++iteration)
+      {
+         const T speed = length( tangent( u ) );
+         if (!(speed > T(0)))
+            break;
+         u = glm::clamp( u - (d0 + arcLength( u0, u ) - d) / speed, u0, u1 );
+      }
+      return u;
+   }
+
+   /**
+    * Converts count arc lengths to parameters, see parameterAt.
+    */
+   void parameterAtBatch( const T* distances, size_t count, T* params ) const
+   {
+      for (size_t i = 0; i < count; ++i)
+         params[i] = parameterAt( distances[i] );
+   }
+
+   /**
+    * Samples count points evenly spaced along the curve, from its start to
+    * its end, with the unit tangents if not NULL.
+    */
+   void sampleUniform( size_t count, vec<3, T>* positions, vec<3, T>* tangents ) const
+   {
+      T params[BATCH], distances[BATCH];
+      const T step = count > 1 ? getLength() / static_cast<T>(count - 1) : T(0);
+      for (size_t first = 0; first < count; first += BATCH)
+      {
+         const size_t n = std::min( BATCH, count - first );
+         for (size_t i = 0; i < n; ++i)
+            distances[i] = step * static_cast<T>(first + i);
+         parameterAtBatch( distances, n, params );
+         evaluateBatch( params, n, positions + first, tangents ? tangents + first : NULL );
+         if (tangents)
+            for (size_t i = 0; i < n; ++i)
+            {
+               const T len = length( tangents[first + i] );
+               if (len > T(0))
+                  tangents[first + i] /= len;
+            }
+      }
+   }
+
+   /**
+    * Finds the point of the curve closest to p. The box hierarchy is
+    * descended nearest child first, skipping boxes farther than the best
+    * point found.
+    *
+    * @param p          the query point
+    * @param point      receives the closest point, if not NULL
+    * @param distance2  receives its squared distance to p, if not NULL
+    *
+    * @return  the parameter of the closest point
+    */
+   T closestPoint( const vec<3, T>& p, vec<3, T>* point = NULL, T* distance2 = NULL ) const
+   {
+      const size_t segments = getSegmentCount();
+      if (segments == 0)
+         return T(0);
+
+      // Stack of (level, box) pairs, at most one pending sibling per level
+      size_t stack[128][2];
+      size_t top = 0;
+      stack[top][0] = mLevelOffsets.size() - 2;
+      stack[top][1] = 0;
+      ++top;
+
+      T bestS = T(0), bestD2 = std::numeric_limits<T>::max();
+      size_t best = 0;
+      while (top > 0)
+      {
+         --top;
+         const size_t level = stack[top][0], index = stack[top][1];
+         if (boxDistance2( mBounds[mLevelOffsets[level] + index], p ) >= bestD2)
+            continue;
+         if (level == 0)
+         {
+            T s, d2;
+            closestOnSegment( index, p, s, d2 );
+            if (d2 < bestD2)
+            {
+               bestD2 = d2;
+               bestS = s;
+               best = index;
+            }
+            continue;
+         }
+
+         const size_t first = mLevelOffsets[level - 1];
+         const size_t child = 2 * index;
+         if (first + child + 1 < mLevelOffsets[level])
+         {
+            const bool swap = boxDistance2( mBounds[first + child + 1], p ) > boxDistance2( mBounds[first + child], p );
+            stack[top][0] = level - 1;
+            stack[top][1] = swap ? child + 1 : child;
+            ++top;
+            stack[top][0] = level - 1;
+            stack[top][1] = swap ? child : child + 1;
+            ++top;
+         }
+         else
+         {
+            stack[top][0] = level - 1;
+            stack[top][1] = child;
+            ++top;
+         }
+      }
+
+      const T u = static_cast<T>(best) + bestS;
+      if (point)
+         *point = position( u );
+      if (distance2)
+         *distance2 = bestD2;
+      return u;
+   }
+
+protected:
+   static T knotInterval( const vec<3, T>& a, const vec<3, T>& b, const T& alpha )
+   {
+      const T d = std::pow( dot( b - a, b - a ), alpha / T(2) );
+      return d > std::numeric_limits<T>::epsilon() ? d : T(1);
+   }
+
+   void addHermite( const vec<3, T>& p0, const vec<3, T>& m0, const vec<3, T>& p1, const vec<3, T>& m1 )
+   {
+      mCoefficients.push_back( p0 );
+      mCoefficients.push_back( m0 );
+      mCoefficients.push_back( (p1 - p0) * T(3) - m0 * T(2) - m1 );
+      mCoefficients.push_back( (p0 - p1) * T(2) + m0 + m1 );
+   }
+
+   /** Gets the coefficients of the segment of u, and the parameter within it. */
+   const vec<3, T>* segment( const T& u, T& s ) const
+   {
+      const size_t segments = getSegmentCount();
+      const T clamped = glm::clamp( u, T(0), static_cast<T>(segments) );
+      const size_t i = std::min( static_cast<size_t>(clamped), segments - 1 );
+      s = clamped - static_cast<T>(i);
+      return &mCoefficients[4 * i];
+   }
+
+   /** Computes the segment boxes and the arc length table. */
+   void finish()
+   {
+      const size_t segments = getSegmentCount();
+      mBounds.clear();
+      mBounds.reserve( 2 * segments );
+      for (size_t i = 0; i < segments; ++i)
+      {
+         const vec<3, T>* c = &mCoefficients[4 * i];
+         vec<3, T> lo = glm::min( c[0], c[0] + c[1] + c[2] + c[3] );
+         vec<3, T> hi = glm::max( c[0], c[0] + c[1] + c[2] + c[3] );
+
+         // Extrema where the derivative b + 2 c s + 3 d s^2 vanishes
+         for (int a = 0; a < 3; ++a)
+         {
+            T roots[2];
+            const int count = solveQuadratic( T(3) * c[3][a], T(2) * c[2][a], c[1][a], roots );
+            for (int r = 0; r < count; ++r)
+               if (roots[r] > T(0) && roots[r] < T(1))
+               {
+                  const T s = roots[r];
+                  const T v = c[0][a] + s * (c[1][a] + s * (c[2][a] + s * c[3][a]));
+                  lo[a] = glm::min( lo[a], v );
+                  hi[a] = glm::max( hi[a], v );
+               }
+         }
+         mBounds.push_back( aabox_t<T>( lo, hi ) );
+      }
+
+      // Levels of boxes over pairs of the level below, up to a single root
+      mLevelOffsets.assign( 1, 0 );
+      mLevelOffsets.push_back( segments );
+      while (segments > 0 && mLevelOffsets.back() - mLevelOffsets[mLevelOffsets.size() - 2] > 1)
+      {
+         const size_t first = mLevelOffsets[mLevelOffsets.size() - 2], end = mLevelOffsets.back();
+         for (size_t i = first; i < end; i += 2)
+         {
+            const size_t j = std::min( i + 1, end - 1 );
+            const vec<3, T> lo = glm::min( mBounds[i].mMin, mBounds[j].mMin );
+            const vec<3, T> hi = glm::max( mBounds[i].mMax, mBounds[j].mMax );
+            mBounds.push_back( aabox_t<T>( lo, hi ) );
+         }
+         mLevelOffsets.push_back( mBounds.size() );
+      }
+
+      mArcLengths.assign( 1, T(0) );
+      const T steps = static_cast<T>(ARC_SAMPLES);
+      for (size_t k = 0; k < segments * ARC_SAMPLES; ++k)
+         mArcLengths.push_back( mArcLengths.back() + arcLength( static_cast<T>(k) / steps, static_cast<T>(k + 1) / steps ) );
+   }
+
+   static int solveQuadratic( const T& a, const T& b, const T& c, T roots[2] )
+   {
+      if (std::abs( a ) <= std::numeric_limits<T>::epsilon() * (std::abs( b ) + std::abs( c )))
+      {
+         if (b == T(0))
+            return 0;
+         roots[0] = -c / b;
+         return 1;
+      }
+      const T disc = b * b - T(4) * a * c;
+      if (disc < T(0))
+         return 0;
+      const T q = -(b + (b < T(0) ? -std::sqrt( disc ) : std::sqrt( disc ))) / T(2);
+      roots[0] = q / a;
+      if (q == T(0))
+         return 1;
+      roots[1] = c / q;
+      return 2;
+   }
+
+   /** The arc length between parameters u0 and u1 of one segment, by 5 point Gauss-Legendre. */
+   T arcLength( const T& u0, const T& u1 ) const
+   {
+      static const T nodes[5] = { T(0), T(-0.5384693101056831), T(0.5384693101056831), T(-0.9061798459386640), T(0.9061798459386640) };
+      static const T weights[5] = { T(0.5688888888888889), T(0.4786286704993665), T(0.4786286704993665), T(0.2369268850561891), T(0.2369268850561891) };
+      if (!(u1 > u0))
+         return T(0);
+      T s0;
+      const vec<3, T>* c = segment( (u0 + u1) / T(2), s0 );
+      const T offset = static_cast<T>(&c[0] - &mCoefficients[0]) / T(4);
+      const T half = (u1 - u0) / T(2), middle = (u0 + u1) / T(2) - offset;
+      T sum = 0;
+      for (int i = 0; i < 5; ++i)
+      {
+         const T s = middle + half * nodes[i];
+         sum += weights[i] * length( c[1] + s * (c[2] * T(2) + s * c[3] * T(3)) );
+      }
+      return sum * half;
+   }
+
+   static T boxDistance2( const aabox_t<T>& box, const vec<3, T>& p )
+   {
+      const vec<3, T> d = glm::max( glm::max( box.mMin - p, p - box.mMax ), vec<3, T>( 0 ) );
+      return dot( d, d );
+   }
+
+   /**
+    * Samples segment i, then refines every local minimum of the samples by
+    * Newton steps on (C(s) - p).C'(s), bisecting when a step leaves its
+    * bracket.
+    */
+   void closestOnSegment( size_t i, const vec<3, T>& p, T& bestS, T& bestD2 ) const
+   {
+      const vec<3, T>* c = &mCoefficients[4 * i];
+      const T steps = static_cast<T>(CLOSEST_SAMPLES);
+      T samples[CLOSEST_SAMPLES + 1];
+      for (size_t k = 0; k <= CLOSEST_SAMPLES; ++k)
+      {
+         const T s = static_cast<T>(k) / steps;
+         const vec<3, T> d = c[0] + s * (c[1] + s * (c[2] + s * c[3])) - p;
+         samples[k] = dot( d, d );
+      }
+
+      bestS = T(0);
+      bestD2 = std::numeric_limits<T>::max();
+      for (size_t k = 0; k <= CLOSEST_SAMPLES; ++k)
+      {
+         if ((k > 0 && samples[k - 1] < samples[k]) || (k < CLOSEST_SAMPLES && samples[k + 1] < samples[k]))
+            continue;
+         if (samples[k] < bestD2)
+         {
+            bestD2 = samples[k];
+            bestS = static_cast<T>(k) / steps;
+         }
+
+         T lo = static_cast<T>(k > 0 ? k - 1 : 0) / steps;
+         T hi = static_cast<T>(std::min( k + 1, CLOSEST_SAMPLES )) / steps;
+         T s = static_cast<T>(k) / steps;
+         for (int iteration = 0; iteration < 16; ++iteration)
+         {
+            const vec<3, T> d = c[0] + s * (c[1] + s * (c[2] + s * c[3])) - p;
+            const vec<3, T> d1 = c[1] + s * (c[2] * T(2) + s * c[3] * T(3));
+            const vec<3, T> d2 = c[2] * T(2) + s * c[3] * T(6);
+            const T g = dot( d, d1 );
+            const T dg = dot( d1, d1 ) + dot( d, d2 );
+            if (g > T(0))
+               hi = s;
+            else
+               lo = s;
+            T next = dg > T(0) ? s - g / dg : lo;
+            if (!(next > lo && next < hi))
+               next = (lo + hi) / T(2);
+
+            const vec<3, T> e = c[0] + next * (c[1] + next * (c[2] + next * c[3])) - p;
+            const T e2 = dot( e, e );
+            if (e2 < bestD2)
+            {
+               bestD2 = e2;
+               bestS = next;
+            }
+            if (std::abs( next - s ) <= std::numeric_limits<T>::epsilon())
+               break;
+            s = next;
+         }
+      }
+   }
+
+protected:
+   CurveType mType;
+
+   /** Per segment, the coefficients a, b, c and d. */
+   std::vector< vec<3, T> > mCoefficients;
+
+   /** The segment boxes, followed by each level of the box hierarchy. */
+   std::vector< aabox_t<T> > mBounds;
+
+   /** The start of each level in mBounds, and the end of the last. */
+   std::vector<size_t> mLevelOffsets;
+
+   /** The arc length at u = k / ARC_SAMPLES, for k up to ARC_SAMPLES per segment. */
+   std::vector<T> mArcLengths;
+};
+
+template<class T>
+const size_t curve_t<T>::ARC_SAMPLES;
+
+template<class T>
+const size_t curve_t<T>::BATCH;
+
+template<class T>
+const size_t curve_t<T>::CLOSEST_SAMPLES;
+
+// --- helper types --- //
+typedef curve_t<float>    curvef;
+typedef curve_t<double>   curved;
+
+}
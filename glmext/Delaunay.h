@@ -0,0 +1,682 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Predicates.h"
+
+namespace glm
+{
+
+/**
+ * A range of points to triangulate, or the two halves of one to merge,
+ * see delaunay_t::splitTop.
+ */
+struct delaunay_task_t
+{
+   size_t mNode;
+   size_t mBegin;
+   size_t mEnd;
+   size_t mDepth;
+};
+
+/**
+ * 2D Delaunay triangulation, optionally constrained, of vec2 points.
+ *
+ * The triangulation is built by divide and conquer (Guibas and Stolfi,
+ * "Primitives for the Manipulation of General Subdivisions and the
+ * Computation of Voronoi Diagrams") on a quad-edge structure kept in flat
+ * arrays, with the exact orient2d and incircle predicates: degenerate
+ * inputs, collinear and cocircular points included, give a valid
+ * triangulation. Duplicate points are merged into one vertex.
+ *
+ * Constrained edges are inserted afterwards by flipping the edges they
+ * cross, then restoring the Delaunay property around them (Sloan, "A fast
+ * algorithm for generating constrained Delaunay triangulations").
+ *
+ * The recursion alternates vertical and horizontal cuts at the median
+ * (Dwyer, "A faster divide-and-conquer algorithm for constructing Delaunay
+ * triangulations"), which keeps the subproblems square on uniform inputs.
+ * The ranges below a given depth are independent, each owning the edge
+ * slots of its points. To build in parallel, call begin, splitTop,
+ * buildSubtree for each leaf task on any thread, then mergeSubtrees for the
+ * merge tasks in order, those of equal depth on any thread, and end.
+ *
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<class T>
+class delaunay_t
+{
+public:
+   typedef T DataType;
+
+   static const uint32_t INVALID = 0xffffffff;
+
+public:
+   /**
+    * Triangulates the given points.
+    */
+   void build( const vec<2, T>* points, size_t count )
+   {
+      begin( points, count );
+      const delaunay_task_t root = { 0, 0, mPoints.size(), 0 };
+      mFree.resize( 1 );
+      mHulls.resize( 1 );
+      buildSubtree( root );
+      end();
+   }
+
+   /**
+    * Starts a staged build: sorts and deduplicates the points and sizes the
+    * edge pool.
+    */
+   void begin( const vec<2, T>* points, size_t count )
+   {
+      mVertices.resize( count );
+      for (size_t i = 0; i < count; ++i)
+      {
+         mVertices[i].mPoint = points[i];
+         mVertices[i].mIndex = static_cast<uint32_t>(i);
+      }
+      std::sort( mVertices.begin(), mVertices.end(), AxisLess( 0 ) );
+
+      // Each input point refers to the input index of its first copy until end
+      size_t unique = 0;
+      mVertexOf.resize( count );
+      for (size_t i = 0; i < count; ++i)
+      {
+         if (unique == 0 || mVertices[i].mPoint != mVertices[unique - 1].mPoint)
+            mVertices[unique++] = mVertices[i];
+         mVertexOf[mVertices[i].mIndex] = mVertices[unique - 1].mIndex;
+      }
+      mVertices.resize( unique );
+      mPoints.resize( unique );
+      mOriginal.resize( unique );
+
+      // A range of n points needs at most 3 n edges, plus n for the merge above it
+      const size_t quads = 4 * unique;
+      mNext.assign( 4 * quads, INVALID );
+      mOrg.assign( 2 * quads, INVALID );
+      mAlive.assign( quads, 0 );
+      mConstrained.assign( quads, 0 );
+      mVertexEdge.clear();
+      mFree.clear();
+      mHulls.clear();
+   }
+
+   /**
+    * Splits the points into subtrees down to the given depth.
+    *
+    * @param levels  the depth of the subtrees, 2^levels subtrees at most
+    * @param leaves  receives the subtrees to build with buildSubtree
+    * @param merges  receives the merges to run with mergeSubtrees, deepest first
+    */
+   void splitTop( size_t levels, std::vector<delaunay_task_t>& leaves, std::vector<delaunay_task_t>& merges )
+   {
+      leaves.clear();
+      merges.clear();
+      mFree.assign( (size_t(2) << levels) - 1, std::vector<uint32_t>() );
+      mHulls.assign( mFree.size(), std::make_pair( INVALID, INVALID ) );
+      splitNode( 0, 0, mPoints.size(), 0, levels, leaves, merges );
+      std::stable_sort( merges.begin(), merges.end(), DeeperFirst() );
+   }
+
+   /**
+    * Triangulates the points of a leaf task.
+    */
+   void buildSubtree( const delaunay_task_t& task )
+   {
+      std::vector<uint32_t>& freeQuads = mFree[task.mNode];
+      freeQuads.clear();
+      for (size_t q = 4 * task.mEnd; q > 4 * task.mBegin; --q)
+         freeQuads.push_back( static_cast<uint32_t>(q - 1) );
+      const int axis = static_cast<int>(task.mDepth & 1);
+      if (task.mEnd - task.mBegin >= 2)
+         divide( task.mBegin, task.mEnd, axis, task.mDepth ? 1 - axis : axis, freeQuads,
+                 mHulls[task.mNode].first, mHulls[task.mNode].second );
+      else
+         place( task.mBegin, task.mEnd );
+   }
+
+   /**
+    * Merges the triangulations of the two children of a merge task.
+    */
+   void mergeSubtrees( const delaunay_task_t& task )
+   {
+      const size_t left = 2 * task.mNode + 1, right = 2 * task.mNode + 2;
+      std::vector<uint32_t>& freeQuads = mFree[task.mNode];
+      freeQuads.swap( mFree[left] );
+      freeQuads.insert( freeQuads.end(), mFree[right].begin(), mFree[right].end() );
+      std::vector<uint32_t>().swap( mFree[right] );
+
+      uint32_t ldo = mHulls[left].first, ldi = mHulls[left].second;
+      uint32_t rdi = mHulls[right].first, rdo = mHulls[right].second;
+      merge( ldo, ldi, rdi, rdo, freeQuads );
+      if (task.mDepth)
+         findExtremes( ldo, rdo, static_cast<int>((task.mDepth - 1) & 1) );
+      mHulls[task.mNode] = std::make_pair( ldo, rdo );
+   }
+
+   /**
+    * Finishes a build: indexes an edge out of each vertex.
+    */
+   void end()
+   {
+      std::vector<uint32_t> vertex( mVertexOf.size(), INVALID );
+      for (size_t i = 0; i < mOriginal.size(); ++i)
+         vertex[mOriginal[i]] = static_cast<uint32_t>(i);
+      for (size_t i = 0; i < mVertexOf.size(); ++i)
+         mVertexOf[i] = vertex[mVertexOf[i]];
+      std::vector<BuildVertex>().swap( mVertices );
+
+      std::vector< std::vector<uint32_t> >().swap( mFree );
+      mVertexEdge.assign( mPoints.size(), INVALID );
+      for (uint32_t q = 0; q < mAlive.size(); ++q)
+         if (mAlive[q])
+         {
+            mVertexEdge[org( 4 * q )] = 4 * q;
+            mVertexEdge[org( 4 * q + 2 )] = 4 * q + 2;
+         }
+   }
+
+   /**
+    * Forces the segment between two input points to be made of triangulation
+    * edges. A segment passing through other points is split at them.
+    *
+    * @param a  the index of the first point in the input array
+    * @param b  the index of the second point in the input array
+    *
+    * @return  false when the segment crosses a constrained edge, which is left in place
+    */
+   bool insertConstraint( uint32_t a, uint32_t b )
+   {
+      uint32_t from = mVertexOf[a];
+      const uint32_t to = mVertexOf[b];
+      while (from != to)
+      {
+         uint32_t reached;
+         if (!insertSegment( from, to, reached ))
+            return false;
+         from = reached;
+      }
+      return true;
+   }
+
+   /**
+    * Gets the number of distinct points.
+    */
+   size_t getVertexCount() const
+   {
+      return mPoints.size();
+   }
+
+   /**
+    * Appends the triangles, three input point indices each in counter
+    * clockwise order, to indices.
+    *
+    * @return  the number of triangles
+    */
+   size_t getTriangles( std::vector<uint32_t>& indices ) const
+   {
+      size_t count = 0;
+      for (uint32_t e = 0; e < mNext.size(); e += 2)
+      {
+         if (!mAlive[e >> 2] || !isTriangle( e ))
+            continue;
+         const uint32_t e1 = lnext( e ), e2 = lnext( e1 );
+         if (e1 < e || e2 < e)
+            continue;
+         indices.push_back( mOriginal[org( e )] );
+         indices.push_back( mOriginal[org( e1 )] );
+         indices.push_back( mOriginal[org( e2 )] );
+         ++count;
+      }
+      return count;
+   }
+
+   /**
+    * Appends the edges, two input point indices each, to indices.
+    *
+    * @param indices      receives the edges
+    * @param constrained  receives per edge 1 when constrained, 0 otherwise, if not NULL
+    *
+    * @return  the number of edges
+    */
+   size_t getEdges( std::vector<uint32_t>& indices, std::vector<uint8_t>* constrained = NULL ) const
+   {
+      size_t count = 0;
+      for (uint32_t q = 0; q < mAlive.size(); ++q)
+      {
+         if (!mAlive[q])
+            continue;
+         indices.push_back( mOriginal[org( 4 * q )] );
+         indices.push_back( mOriginal[org( 4 * q + 2 )] );
+         if (constrained)
+            constrained->push_back( mConstrained[q] );
+         ++count;
+      }
+      return count;
+   }
+
+protected:
+   // --- quad-edge navigation: edge e is rotation e & 3 of quad e >> 2 --- //
+   static uint32_t rot( uint32_t e ) { return (e & ~3u) | ((e + 1) & 3u); }
+   static uint32_t sym( uint32_t e ) { return e ^ 2u; }
+   static uint32_t rotInv( uint32_t e ) { return (e & ~3u) | ((e + 3) & 3u); }
+   uint32_t onext( uint32_t e ) const { return mNext[e]; }
+   uint32_t oprev( uint32_t e ) const { return rot( onext( rot( e ) ) ); }
+   uint32_t lnext( uint32_t e ) const { return rot( onext( rotInv( e ) ) ); }
+   uint32_t rprev( uint32_t e ) const { return onext( sym( e ) ); }
+   uint32_t org( uint32_t e ) const { return mOrg[(e >> 2) * 2 + ((e >> 1) & 1u)]; }
+   uint32_t dest( uint32_t e ) const { return org( sym( e ) ); }
+
+   void setEnds( uint32_t e, uint32_t origin, uint32_t destination )
+   {
+      mOrg[(e >> 2) * 2 + ((e >> 1) & 1u)] = origin;
+      mOrg[(e >> 2) * 2 + (((e >> 1) & 1u) ^ 1u)] = destination;
+   }
+
+   uint32_t makeEdge( uint32_t origin, uint32_t destination, std::vector<uint32_t>& freeQuads )
+   {
+      const uint32_t q = freeQuads.back();
+      freeQuads.pop_back();
+      const uint32_t e = 4 * q;
+      mNext[e] = e;
+      mNext[e + 1] = e + 3;
+      mNext[e + 2] = e + 2;
+      mNext[e + 3] = e + 1;
+      mAlive[q] = 1;
+      mConstrained[q] = 0;
+      setEnds( e, origin, destination );
+      return e;
+   }
+
+   void splice( uint32_t a, uint32_t b )
+   {
+      const uint32_t alpha = rot( onext( a ) ), beta = rot( onext( b ) );
+      std::swap( mNext[a], mNext[b] );
+      std::swap( mNext[alpha], mNext[beta] );
+   }
+
+   /** Adds an edge from the destination of a to the origin of b, a, e and b sharing their left face. */
+   uint32_t connect( uint32_t a, uint32_t b, std::vector<uint32_t>& freeQuads )
+   {
+      const uint32_t e = makeEdge( dest( a ), org( b ), freeQuads );
+      splice( e, lnext( a ) );
+      splice( sym( e ), b );
+      return e;
+   }
+
+   void deleteEdge( uint32_t e, std::vector<uint32_t>& freeQuads )
+   {
+      splice( e, oprev( e ) );
+      splice( sym( e ), oprev( sym( e ) ) );
+      mAlive[e >> 2] = 0;
+      freeQuads.push_back( e >> 2 );
+   }
+
+   /** Turns the diagonal e of the quadrilateral made of its two triangles. */
+   void swapEdge( uint32_t e )
+   {
+      const uint32_t a = oprev( e ), b = oprev( sym( e ) );
+      mVertexEdge[org( e )] = a;
+      mVertexEdge[dest( e )] = b;
+      splice( e, a );
+      splice( sym( e ), b );
+      splice( e, lnext( a ) );
+      splice( sym( e ), lnext( b ) );
+      setEnds( e, dest( a ), dest( b ) );
+   }
+
+   int orient( uint32_t a, uint32_t b, uint32_t c ) const
+   {
+      if (a == b || b == c || c == a)
+         return 0;
+      return predicateSign( orient2d( mPoints[a], mPoints[b], mPoints[c] ) );
+   }
+
+   bool inCircle( uint32_t a, uint32_t b, uint32_t c, uint32_t d ) const
+   {
+      if (d == a || d == b || d == c)
+         return false;
+      return incircle( mPoints[a], mPoints[b], mPoints[c], mPoints[d] ) > T(0);
+   }
+
+   bool rightOf( uint32_t x, uint32_t e ) const
+   {
+      return orient( x, dest( e ), org( e ) ) > 0;
+   }
+
+   bool leftOf( uint32_t x, uint32_t e ) const
+   {
+      return orient( x, org( e ), dest( e ) ) > 0;
+   }
+
+   /** True when the left face of e is a counter clockwise triangle, not the outer face. */
+   bool isTriangle( uint32_t e ) const
+   {
+      const uint32_t e1 = lnext( e );
+      return lnext( lnext( e1 ) ) == e && orient( org( e ), dest( e ), dest( e1 ) ) > 0;
+   }
+
+   /**
+    * Triangulates the points [begin, end), at least 2, cutting along the
+    * given axis, and gets the counter clockwise hull edge out of the first
+    * point in the order of the parent axis and the clockwise one out of the
+    * last.
+    */
+   void divide( size_t begin, size_t end, int axis, int parentAxis, std::vector<uint32_t>& freeQuads, uint32_t& ldo, uint32_t& rdo )
+   {
+      const size_t n = end - begin;
+      if (n > 3)
+      {
+         const size_t middle = begin + n / 2;
+         std::nth_element( mVertices.begin() + begin, mVertices.begin() + middle, mVertices.begin() + end, AxisLess( axis ) );
+         uint32_t ldi, rdi;
+         divide( begin, middle, 1 - axis, axis, freeQuads, ldo, ldi );
+         divide( middle, end, 1 - axis, axis, freeQuads, rdi, rdo );
+         merge( ldo, ldi, rdi, rdo, freeQuads );
+      }
+      else
+      {
+         std::sort( mVertices.begin() + begin, mVertices.begin() + end, AxisLess( axis ) );
+         place( begin, end );
+         const uint32_t s0 = static_cast<uint32_t>(begin);
+         if (n == 2)
+         {
+            ldo = makeEdge( s0, s0 + 1, freeQuads );
+            rdo = sym( ldo );
+         }
+         else
+         {
+            const uint32_t a = makeEdge( s0, s0 + 1, freeQuads );
+            const uint32_t b = makeEdge( s0 + 1, s0 + 2, freeQuads );
+            splice( sym( a ), b );
+            const int o = orient( s0, s0 + 1, s0 + 2 );
+            if (o < 0)
+            {
+               const uint32_t c = connect( b, a, freeQuads );
+               ldo = sym( c );
+               rdo = c;
+            }
+            else
+            {
+               if (o > 0)
+                  connect( b, a, freeQuads );
+               ldo = a;
+               rdo = sym( b );
+            }
+         }
+      }
+      if (parentAxis != axis)
+         findExtremes( ldo, rdo, parentAxis );
+   }
+
+   /** Fixes the vertices [begin, end) in their final order. */
+   void place( size_t begin, size_t end )
+   {
+      for (size_t i = begin; i < end; ++i)
+      {
+         mPoints[i] = mVertices[i].mPoint;
+         mOriginal[i] = mVertices[i].mIndex;
+      }
+   }
+
+   /**
+    * Walks the hull from the counter clockwise edge ldo to find the hull
+    * edges out of the first and last points in the order of the given axis.
+    */
+   void findExtremes( uint32_t& ldo, uint32_t& rdo, int axis ) const
+   {
+      uint32_t first = ldo, last = ldo, e = ldo;
+      do
+      {
+         if (AxisLess::less( mPoints[org( e )], mPoints[org( first )], axis ))
+            first = e;
+         if (AxisLess::less( mPoints[dest( last )], mPoints[dest( e )], axis ))
+            last = e;
+         e = rprev( e );
+      } while (e != ldo);
+      ldo = first;
+      rdo = sym( last );
+   }
+
+   /** Merges two adjacent triangulations, walking up from their lower common tangent. */
+   void merge( uint32_t& ldo, uint32_t ldi, uint32_t rdi, uint32_t& rdo, std::vector<uint32_t>& freeQuads )
+   {
+      for (;;)
+      {
+         if (leftOf( org( rdi ), ldi ))
+            ldi = lnext( ldi );
+         else if (rightOf( org( ldi ), rdi ))
+            rdi = rprev( rdi );
+         else
+            break;
+      }
+
+      uint32_t basel = connect( sym( rdi ), ldi, freeQuads );
+      if (org( ldi ) == org( ldo ))
+         ldo = sym( basel );
+      if (org( rdi ) == org( rdo ))
+         rdo = basel;
+
+      for (;;)
+      {
+         uint32_t lcand = onext( sym( basel ) );
+         if (rightOf( dest( lcand ), basel ))
+            while (inCircle( dest( basel ), org( basel ), dest( lcand ), dest( onext( lcand ) ) ))
+            {
+               const uint32_t t = onext( lcand );
+               deleteEdge( lcand, freeQuads );
+               lcand = t;
+            }
+
+         uint32_t rcand = oprev( basel );
+         if (rightOf( dest( rcand ), basel ))
+            while (inCircle( dest( basel ), org( basel ), dest( rcand ), dest( oprev( rcand ) ) ))
+            {
+               const uint32_t t = oprev( rcand );
+               deleteEdge( rcand, freeQuads );
+               rcand = t;
+            }
+
+         const bool lvalid = rightOf( dest( lcand ), basel );
+         const bool rvalid = rightOf( dest( rcand ), basel );
+         if (!lvalid && !rvalid)
+            break;
+         if (!lvalid || (rvalid && inCircle( dest( lcand ), org( lcand ), org( rcand ), dest( rcand ) )))
+            basel = connect( rcand, sym( basel ), freeQuads );
+         else
+            basel = connect( sym( basel ), sym( lcand ), freeQuads );
+      }
+   }
+
+   void splitNode( size_t node, size_t begin, size_t end, size_t depth, size_t levels,
+                   std::vector<delaunay_task_t>& leaves, std::vector<delaunay_task_t>& merges )
+   {
+      const delaunay_task_t task = { node, begin, end, depth };
+      if (depth == levels || end - begin < 4)
+      {
+         leaves.push_back( task );
+         return;
+      }
+      merges.push_back( task );
+      const size_t middle = begin + (end - begin) / 2;
+      std::nth_element( mVertices.begin() + begin, mVertices.begin() + middle, mVertices.begin() + end,
+                        AxisLess( static_cast<int>(depth & 1) ) );
+      splitNode( 2 * node + 1, begin, middle, depth + 1, levels, leaves, merges );
+      splitNode( 2 * node + 2, middle, end, depth + 1, levels, leaves, merges );
+   }
+
+   /** True when e crosses the open segment between vertices a and b. */
+   bool crosses( uint32_t e, uint32_t a, uint32_t b ) const
+   {
+      const uint32_t u = org( e ), w = dest( e );
+      if (u == a || u == b || w == a || w == b)
+         return false;
+      return orient( a, b, u ) * orient( a, b, w ) < 0 && orient( u, w, a ) * orient( u, w, b ) < 0;
+   }
+
+   /**
+    * Inserts the part of the constraint from a to b up to the first vertex
+    * on it, and gets that vertex.
+    */
+   bool insertSegment( uint32_t a, uint32_t b, uint32_t& reached )
+   {
+      // Finds the edge out of a along the segment, or the triangle it leaves a through
+      const uint32_t start = mVertexEdge[a];
+      uint32_t e = start, crossing = INVALID;
+      do
+      {
+         const uint32_t d = dest( e );
+         if (d == b || (orient( a, b, d ) == 0 && dot( mPoints[d] - mPoints[a], mPoints[b] - mPoints[a] ) > T(0)))
+         {
+            mConstrained[e >> 2] = 1;
+            reached = d;
+            return true;
+         }
+         if (isTriangle( e ) && orient( a, d, b ) > 0 && orient( a, dest( onext( e ) ), b ) < 0)
+            crossing = lnext( e );
+         e = onext( e );
+      } while (e != start && crossing == INVALID);
+      if (crossing == INVALID)
+         return false;
+
+      // Walks the triangles along the segment, collecting the edges it crosses
+      std::vector<uint32_t> queue( 1, crossing );
+      reached = b;
+      for (;;)
+      {
+         const uint32_t t = sym( crossing );
+         const uint32_t v = dest( lnext( t ) );
+         if (v == b)
+            break;
+         const int side = orient( a, b, v );
+         if (side == 0)
+         {
+            reached = v;
+            break;
+         }
+         crossing = orient( a, b, org( t ) ) != side ? lnext( lnext( t ) ) : lnext( t );
+         queue.push_back( crossing );
+      }
+      for (size_t i = 0; i < queue.size(); ++i)
+         if (mConstrained[queue[i] >> 2])
+            return false;
+
+      // Flips the crossing edges away, those in non convex quadrilaterals later
+      std::vector<uint32_t> created;
+      size_t head = 0, stalled = 0;
+      while (head < queue.size())
+      {
+         const uint32_t c = queue[head++];
+         const uint32_t r = dest( lnext( c ) ), s = dest( lnext( sym( c ) ) );
+         if (orient( r, s, org( c ) ) * orient( r, s, dest( c ) ) >= 0)
+         {
+            queue.push_back( c );
+            if (++stalled > queue.size() - head)
+               return false;
+            continue;
+         }
+         stalled = 0;
+         swapEdge( c );
+         if (crosses( c, a, reached ))
+            queue.push_back( c );
+         else
+            created.push_back( c );
+      }
+
+      e = mVertexEdge[a];
+      while (dest( e ) != reached)
+         e = onext( e );
+      mConstrained[e >> 2] = 1;
+
+      // Restores the Delaunay property of the new edges
+      for (bool swapped = true; swapped;)
+      {
+         swapped = false;
+         for (size_t i = 0; i < created.size(); ++i)
+         {
+            const uint32_t c = created[i];
+            if (mConstrained[c >> 2])
+               continue;
+            if (inCircle( org( c ), dest( c ), dest( lnext( c ) ), dest( lnext( sym( c ) ) ) ))
+            {
+               swapEdge( c );
+               swapped = true;
+            }
+         }
+      }
+      return true;
+   }
+
+   /** Orders by x then y along axis 0, by y then decreasing x along axis 1, the same order turned a quarter. */
+   struct BuildVertex
+   {
+      vec<2, T> mPoint;
+      uint32_t mIndex;
+   };
+
+   struct AxisLess
+   {
+      AxisLess( int axis )
+         : mAxis( axis )
+      {}
+
+      static bool less( const vec<2, T>& a, const vec<2, T>& b, int axis )
+      {
+         if (axis == 0)
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+         return a.y < b.y || (a.y == b.y && a.x > b.x);
+      }
+
+      bool operator()( const BuildVertex& a, const BuildVertex& b ) const
+      {
+         return less( a.mPoint, b.mPoint, mAxis );
+      }
+
+      int mAxis;
+   };
+
+   struct DeeperFirst
+   {
+      bool operator()( const delaunay_task_t& a, const delaunay_task_t& b ) const
+      {
+         return a.mDepth > b.mDepth;
+      }
+   };
+
+protected:
+   /** The distinct points with their input index, partitioned during a build. */
+   std::vector<BuildVertex> mVertices;
+
+   /** The distinct points in build order, their index in the input, and the vertex of each input point. */
+   std::vector< vec<2, T> > mPoints;
+   std::vector<uint32_t> mOriginal;
+   std::vector<uint32_t> mVertexOf;
+
+   /** Quad-edge storage: onext per directed edge, origin per primal edge, flags per quad. */
+   std::vector<uint32_t> mNext;
+   std::vector<uint32_t> mOrg;
+   std::vector<uint8_t> mAlive;
+   std::vector<uint8_t> mConstrained;
+
+   /** An edge out of each vertex, once built. */
+   std::vector<uint32_t> mVertexEdge;
+
+   /** Per task node, during a build: the free quads, and the hull edges out of the leftmost and rightmost points. */
+   std::vector< std::vector<uint32_t> > mFree;
+   std::vector< std::pair<uint32_t, uint32_t> > mHulls;
+};
+
+template<class T>
+const uint32_t delaunay_t<T>::INVALID;
+
+// --- helper types --- //
+typedef delaunay_t<float>    delaunayf;
+typedef delaunay_t<double>   delaunayd;
+
+}
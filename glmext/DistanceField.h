@@ -0,0 +1,722 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+#include "AABox.h"
+#include "Sphere.h"
+#include "Plane.h"
+
+namespace glm
+{
+
+/**
+ * Regular grid of signed distances, negative inside and positive outside.
+ *
+ * Voxel (x, y, z) is centered at origin + (x, y, z) * voxelSize and stored
+ * at x + dims.x * (y + dims.y * z): rows along x are contiguous and each
+ * slice along z is a contiguous block of rows. 2D fields, such as font
+ * glyphs, are grids with dims.z == 1.
+ *
+ * The functions working on grids come in two flavours: a whole grid one and
+ * a "Slices" one processing the slices [firstSlice, firstSlice + sliceCount).
+ * Calls on disjoint slice ranges touch disjoint voxels and may run on
+ * different threads.
+ *
+ * @param T     the internal type used for the distances and positions
+ * @ingroup Types
+ */
+template<class T>
+class sdf_grid_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Constructs an empty grid.
+    */
+   sdf_grid_t()
+      : mDims( 0 ), mOrigin( 0 ), mVoxelSize( 1 )
+   {}
+
+   /**
+    * Constructs a grid with the given resolution, all distances set to 0.
+    *
+    * @param dims       the number of voxels along each axis
+    * @param origin     the center of voxel (0, 0, 0)
+    * @param voxelSize  the distance between two neighbor voxel centers
+    */
+   sdf_grid_t( const ivec3& dims, const vec<3, T>& origin, const T& voxelSize )
+      : mDims( dims ), mOrigin( origin ), mVoxelSize( voxelSize ),
+        mValues( static_cast<size_t>(dims.x) * dims.y * dims.z, T(0) )
+   {}
+
+   /**
+    * Constructs a grid covering the given box, all distances set to 0.
+    *
+    * @param box        the region to cover
+    * @param voxelSize  the distance between two neighbor voxel centers
+    * @param padding    the number of voxels added outside of box on each side
+    */
+   sdf_grid_t( const aabox_t<T>& box, const T& voxelSize, int padding )
+      : mVoxelSize( voxelSize )
+   {
+      const vec<3, T> cells = ceil( extents( box ) / voxelSize );
+      mDims = ivec3( cells ) + 1 + 2 * padding;
+      mOrigin = box.getMin() - vec<3, T>( static_cast<T>(padding) * voxelSize );
+      mValues.assign( static_cast<size_t>(mDims.x) * mDims.y * mDims.z, T(0) );
+   }
+
+   /**
+    * Gets the number of voxels along each axis.
+    */
+   const ivec3& getDims() const
+   {
+      return mDims;
+   }
+
+   /**
+    * Gets the center of voxel (0, 0, 0).
+    */
+   const vec<3, T>& getOrigin() const
+   {
+      return mOrigin;
+   }
+
+   /**
+    * Gets the distance between two neighbor voxel centers.
+    */
+   const T& getVoxelSize() const
+   {
+      return mVoxelSize;
+   }
+
+   /**
+    * Gets the storage index of voxel (x, y, z).
+    */
+   size_t getIndex( int x, int y, int z ) const
+   {
+      return static_cast<size_t>(x) + static_cast<size_t>(mDims.x) *
+         (static_cast<size_t>(y) + static_cast<size_t>(mDims.y) * static_cast<size_t>(z));
+   }
+
+   /**
+    * Gets the center of voxel (x, y, z).
+    */
+   vec<3, T> getPosition( int x, int y, int z ) const
+   {
+      return mOrigin + vec<3, T>( T(x), T(y), T(z) ) * mVoxelSize;
+   }
+
+   /**
+    * Gets the box spanned by the voxel centers.
+    */
+   aabox_t<T> getBounds() const
+   {
+      return aabox_t<T>( mOrigin, getPosition( mDims.x - 1, mDims.y - 1, mDims.z - 1 ) );
+   }
+
+   T& operator()( int x, int y, int z )
+   {
+      return mValues[getIndex( x, y, z )];
+   }
+
+   const T& operator()( int x, int y, int z ) const
+   {
+      return mValues[getIndex( x, y, z )];
+   }
+
+   T* getData()
+   {
+      return mValues.empty() ? NULL : &mValues[0];
+   }
+
+   const T* getData() const
+   {
+      return mValues.empty() ? NULL : &mValues[0];
+   }
+
+public:
+   /**
+    * The number of voxels along each axis.
+    */
+   ivec3 mDims;
+
+   /**
+    * The center of voxel (0, 0, 0).
+    */
+   vec<3, T> mOrigin;
+
+   /**
+    * The distance between two neighbor voxel centers.
+    */
+   T mVoxelSize;
+
+   /**
+    * The distances, rows along x first.
+    */
+   std::vector<T> mValues;
+};
+
+/** @ingroup Distance
+ * @name Analytic signed distances
+ * @{
+ */
+
+template< class T >
+inline T signedDistance( const sphere_t<T>& sphere, const vec<3, T>& pt )
+{
+   return length( pt - sphere.getCenter() ) - sphere.getRadius();
+}
+
+template< class T >
+inline T signedDistance( const aabox_t<T>& box, const vec<3, T>& pt )
+{
+   const vec<3, T> q = abs( pt - middle( box ) ) - extents( box ) * static_cast<T>(0.5);
+   return length( max( q, vec<3, T>( 0 ) ) ) + min( max( q.x, max( q.y, q.z ) ), T(0) );
+}
+
+template< class T >
+inline T signedDistance( const plane_t<T>& plane, const vec<3, T>& pt )
+{
+   return plane.distanceTo( pt );
+}
+
+/**
+ * Computes the signed distance from shape to each of the given points.
+ *
+ * @param shape   a sphere_t, aabox_t or plane_t
+ * @param points  the count points to evaluate
+ * @param out     receives count distances
+ */
+template< class T, class SHAPE >
+inline void signedDistance( const SHAPE& shape, const vec<3, T>* points, size_t count, T* out )
+{
+   for (size_t i = 0; i < count; ++i)
+      out[i] = signedDistance( shape, points[i] );
+}
+
+/**
+ * Computes the signed distance from shape to count points starting at start
+ * and spaced by step along x. The terms that don't depend on x are hoisted
+ * out of the loop, leaving a straight line kernel the compiler vectorizes.
+ */
+template< class T >
+inline void signedDistanceRow( const sphere_t<T>& sphere, const vec<3, T>& start, const T& step, int count, T* out )
+{
+   const vec<3, T> d = start - sphere.getCenter();
+   const T dyz = d.y * d.y + d.z * d.z;
+   const T r = sphere.getRadius();
+   for (int i = 0; i < count; ++i)
+   {
+      const T dx = d.x + T(i) * step;
+      out[i] = sqrt( dx * dx + dyz ) - r;
+   }
+}
+
+template< class T >
+inline void signedDistanceRow( const aabox_t<T>& box, const vec<3, T>& start, const T& step, int count, T* out )
+{
+   const vec<3, T> half = extents( box ) * static_cast<T>(0.5);
+   const vec<3, T> d = start - middle( box );
+   const T qy = abs( d.y ) - half.y;
+   const T qz = abs( d.z ) - half.z;
+   const T oyz = sqr( max( qy, T(0) ) ) + sqr( max( qz, T(0) ) );
+   const T qyz = max( qy, qz );
+   for (int i = 0; i < count; ++i)
+   {
+      const T qx = abs( d.x + T(i) * step ) - half.x;
+      const T ox = max( qx, T(0) );
+      out[i] = sqrt( ox * ox + oyz ) + min( max( qx, qyz ), T(0) );
+   }
+}
+
+template< class T >
+inline void signedDistanceRow( const plane_t<T>& plane, const vec<3, T>& start, const T& step, int count, T* out )
+{
+   const T base = plane.distanceTo( start );
+   const T slope = plane.getNormal().x * step;
+   for (int i = 0; i < count; ++i)
+      out[i] = base + T(i) * slope;
+}
+
+/**
+ * Evaluates the signed distance from shape at the voxels of the given slices,
+ * one row at a time.
+ */
+template< class T, class SHAPE >
+inline void evaluateSignedDistanceSlices( const SHAPE& shape, sdf_grid_t<T>& grid, int firstSlice, int sliceCount )
+{
+   const int lastSlice = min( firstSlice + sliceCount, grid.mDims.z );
+   for (int z = firstSlice; z < lastSlice; ++z)
+      for (int y = 0; y < grid.mDims.y; ++y)
+         signedDistanceRow( shape, grid.getPosition( 0, y, z ), grid.mVoxelSize, grid.mDims.x, &grid( 0, y, z ) );
+}
+
+template< class T, class SHAPE >
+inline void evaluateSignedDistance( const SHAPE& shape, sdf_grid_t<T>& grid )
+{
+   evaluateSignedDistanceSlices( shape, grid, 0, grid.mDims.z );
+}
+
+/** @} */
+
+/** @ingroup Distance
+ * @name Grid sampling
+ * @{
+ */
+
+/**
+ * Trilinearly interpolates the distance at pt, clamped to the grid bounds.
+ */
+template< class T >
+inline T sampleDistance( const sdf_grid_t<T>& grid, const vec<3, T>& pt )
+{
+   const vec<3, T> maxCoord = vec<3, T>( max( grid.mDims - 1, ivec3( 0 ) ) );
+   const vec<3, T> coord = clamp( (pt - grid.mOrigin) / grid.mVoxelSize, vec<3, T>( 0 ), maxCoord );
+   const ivec3 i0 = min( ivec3( coord ), grid.mDims - 1 );
+   const ivec3 i1 = min( i0 + 1, grid.mDims - 1 );
+   const vec<3, T> f = coord - vec<3, T>( i0 );
+
+   const T c00 = mix( grid( i0.x, i0.y, i0.z ), grid( i1.x, i0.y, i0.z ), f.x );
+   const T c10 = mix( grid( i0.x, i1.y, i0.z ), grid( i1.x, i1.y, i0.z ), f.x );
+   const T c01 = mix( grid( i0.x, i0.y, i1.z ), grid( i1.x, i0.y, i1.z ), f.x );
+   const T c11 = mix( grid( i0.x, i1.y, i1.z ), grid( i1.x, i1.y, i1.z ), f.x );
+   return mix( mix( c00, c10, f.y ), mix( c01, c11, f.y ), f.z );
+}
+
+/**
+ * Estimates the distance gradient at pt by central differences, the
+ * unnormalized contact normal for collision queries.
+ */
+template< class T >
+inline vec<3, T> sampleGradient( const sdf_grid_t<T>& grid, const vec<3, T>& pt )
+{
+   const T h = grid.mVoxelSize;
+   vec<3, T> result;
+   for (int i = 0; i < 3; ++i)
+   {
+      vec<3, T> offset( 0 );
+      offset[i] = h;
+      result[i] = (sampleDistance( grid, pt + offset ) - sampleDistance( grid, pt - offset )) / (h + h);
+   }
+   return result;
+}
+
+/** @} */
+
+/** @ingroup Distance
+ * @name Euclidean distance transform
+ * @{
+ */
+
+/**
+ * Computes the exact squared distance transform of the sampled function f
+ * (Felzenszwalb and Huttenlocher, "Distance Transforms of Sampled Functions"):
+ * d[q] = min over p of (q - p)^2 + f[p]. Samples equal to
+ * std::numeric_limits<T>::max() are ignored, if all are ignored d is filled
+ * with that value.
+ *
+ * @param v    scratch storage for n indices
+ * @param z    scratch storage for n + 1 values
+ */
+template< class T >
+inline void distanceTransform1D( const T* f, int n, T* d, int* v, T* z )
+{
+   const T inf = std::numeric_limits<T>::max();
+
+   // Lower envelope of the parabolas rooted at the finite samples
+   int k = -1;
+   for (int q = 0; q < n; ++q)
+   {
+      if (f[q] == inf)
+         continue;
+      const T fq = f[q] + T(q) * T(q);
+      if (k < 0)
+      {
+         k = 0;
+         v[0] = q;
+         z[0] = -inf;
+         z[1] = inf;
+         continue;
+      }
+
+      T s = (fq - (f[v[k]] + T(v[k]) * T(v[k]))) / T(2 * (q - v[k]));
+      while (s <= z[k])
+      {
+         --k;
+         s = (fq - (f[v[k]] + T(v[k]) * T(v[k]))) / T(2 * (q - v[k]));
+      }
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = inf;
+   }
+
+   if (k < 0)
+   {
+      std::fill( d, d + n, inf );
+      return;
+   }
+
+   k = 0;
+   for (int q = 0; q < n; ++q)
+   {
+      while (z[k + 1] < T(q))
+         ++k;
+      d[q] = sqr( T(q - v[k]) ) + f[v[k]];
+   }
+}
+
+/**
+ * Gets the number of lines along axis in a grid of the given dimensions.
+ */
+inline int distanceTransformLineCount( const ivec3& dims, int axis )
+{
+   return dims[(axis + 1) % 3] * dims[(axis + 2) % 3];
+}
+
+/**
+ * Applies the 1D squared distance transform to the lines
+ * [firstLine, firstLine + lineCount) along axis of values, stored like
+ * sdf_grid_t voxels. Lines of the same pass are independent: disjoint line
+ * ranges may run on different threads, but each pass must complete before
+ * the next one starts.
+ */
+template< class T >
+inline void distanceTransformLines( T* values, const ivec3& dims, int axis, int firstLine, int lineCount )
+{
+   const int n = dims[axis];
+   const size_t strides[3] = { 1, static_cast<size_t>(dims.x), static_cast<size_t>(dims.x) * static_cast<size_t>(dims.y) };
+   const size_t stride = strides[axis];
+   const int inner = axis == 0 ? 1 : 0;
+   const int outer = axis == 2 ? 1 : 2;
+
+   std::vector<T> f( n ), d( n ), z( n + 1 );
+   std::vector<int> v( n );
+
+   const int lastLine = min( firstLine + lineCount, distanceTransformLineCount( dims, axis ) );
+   for (int line = firstLine; line < lastLine; ++line)
+   {
+      const size_t base = static_cast<size_t>(line % dims[inner]) * strides[inner] +
+                          static_cast<size_t>(line / dims[inner]) * strides[outer];
+      for (int i = 0; i < n; ++i)
+         f[i] = values[base + i * stride];
+      distanceTransform1D( &f[0], n, &d[0], &v[0], &z[0] );
+      for (int i = 0; i < n; ++i)
+         values[base + i * stride] = d[i];
+   }
+}
+
+/**
+ * Turns values, 0 at feature voxels and std::numeric_limits<T>::max()
+ * elsewhere, into exact squared Euclidean distances to the nearest feature,
+ * in voxel units. Axes with a single voxel are skipped so 2D grids cost two
+ * passes.
+ */
+template< class T >
+inline void distanceTransform( T* values, const ivec3& dims )
+{
+   for (int axis = 0; axis < 3; ++axis)
+      if (dims[axis] > 1)
+         distanceTransformLines( values, dims, axis, 0, distanceTransformLineCount( dims, axis ) );
+}
+
+/**
+ * Computes the signed distance field of a binary grid: mask is non zero at
+ * inside voxels. The surface is placed halfway between inside and outside
+ * voxel centers. Voxels with no voxel of the opposite kind get
+ * std::numeric_limits<T>::max() magnitude.
+ *
+ * @param mask   one value per voxel of grid, stored like its distances
+ * @param grid   receives the distances, its dimensions are left unchanged
+ */
+template< class T >
+inline void signedDistanceFromMask( const uint8_t* mask, sdf_grid_t<T>& grid )
+{
+   const T inf = std::numeric_limits<T>::max();
+   const size_t count = grid.mValues.size();
+
+   std::vector<T> inside( count );
+   T* outside = grid.getData();
+   for (size_t i = 0; i < count; ++i)
+   {
+      outside[i] = mask[i] ? T(0) : inf;
+      inside[i] = mask[i] ? inf : T(0);
+   }
+
+   distanceTransform( outside, grid.mDims );
+   distanceTransform( count ? &inside[0] : NULL, grid.mDims );
+
+   const T h = grid.mVoxelSize;
+   for (size_t i = 0; i < count; ++i)
+   {
+      if (mask[i])
+         outside[i] = inside[i] == inf ? -inf : -(sqrt( inside[i] ) - static_cast<T>(0.5)) * h;
+      else
+         outside[i] = outside[i] == inf ? inf : (sqrt( outside[i] ) - static_cast<T>(0.5)) * h;
+   }
+}
+
+/** @} */
+
+/** @ingroup Distance
+ * @name Mesh voxelization
+ * @{
+ */
+
+/**
+ * How meshToSignedDistance decides which voxels are inside the mesh.
+ */
+enum SdfSignMode
+{
+   SDF_SIGN_RAY_PARITY = 0,     /**< count crossings along x, needs a closed mesh, fast */
+   SDF_SIGN_WINDING_NUMBER = 1  /**< generalized winding number, tolerates holes, cost per voxel per triangle */
+};
+
+/**
+ * Computes the point of triangle abc closest to pt (Ericson, "Real-Time
+ * Collision Detection", 5.1.5).
+ */
+template< class T >
+inline vec<3, T> closestPointOnTriangle( const vec<3, T>& pt, const vec<3, T>& a, const vec<3, T>& b, const vec<3, T>& c )
+{
+   const vec<3, T> ab = b - a;
+   const vec<3, T> ac = c - a;
+   const vec<3, T> ap = pt - a;
+   const T d1 = dot( ab, ap );
+   const T d2 = dot( ac, ap );
+   if (d1 <= T(0) && d2 <= T(0))
+      return a;
+
+   const vec<3, T> bp = pt - b;
+   const T d3 = dot( ab, bp );
+   const T d4 = dot( ac, bp );
+   if (d3 >= T(0) && d4 <= d3)
+      return b;
+
+   const T vc = d1 * d4 - d3 * d2;
+   if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+      return a + ab * (d1 / (d1 - d3));
+
+   const vec<3, T> cp = pt - c;
+   const T d5 = dot( ab, cp );
+   const T d6 = dot( ac, cp );
+   if (d6 >= T(0) && d5 <= d6)
+      return c;
+
+   const T vb = d5 * d2 - d1 * d6;
+   if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+      return a + ac * (d2 / (d2 - d6));
+
+   const T va = d3 * d6 - d5 * d4;
+   if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+      return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+   const T denom = T(1) / (va + vb + vc);
+   return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+/**
+ * Lowers the distance magnitude of the voxels of the given slices lying
+ * within bandWidth voxels of a triangle to their exact unsigned distance to
+ * the mesh. Voxels outside of the band are left unchanged, the grid is
+ * expected to be filled with std::numeric_limits<T>::max() beforehand.
+ *
+ * @param positions      the mesh vertices
+ * @param indices        three vertex indices per triangle
+ * @param triangleCount  the number of triangles
+ * @param bandWidth      the half width of the exact band, in voxels
+ */
+template< class T >
+inline void meshDistanceSlices( const vec<3, T>* positions, const uint32_t* indices, size_t triangleCount, const T& bandWidth,
+                                sdf_grid_t<T>& grid, int firstSlice, int sliceCount )
+{
+   const T invH = T(1) / grid.mVoxelSize;
+   const ivec3 lo( 0, 0, firstSlice );
+   const ivec3 hi( grid.mDims.x - 1, grid.mDims.y - 1, min( firstSlice + sliceCount, grid.mDims.z ) - 1 );
+
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      const vec<3, T>& a = positions[indices[3 * t + 0]];
+      const vec<3, T>& b = positions[indices[3 * t + 1]];
+      const vec<3, T>& c = positions[indices[3 * t + 2]];
+
+      const vec<3, T> boxMin = (min( a, min( b, c ) ) - grid.mOrigin) * invH - bandWidth;
+      const vec<3, T> boxMax = (max( a, max( b, c ) ) - grid.mOrigin) * invH + bandWidth;
+      const ivec3 v0 = max( ivec3( ceil( boxMin ) ), lo );
+      const ivec3 v1 = min( ivec3( floor( boxMax ) ), hi );
+
+      for (int z = v0.z; z <= v1.z; ++z)
+         for (int y = v0.y; y <= v1.y; ++y)
+            for (int x = v0.x; x <= v1.x; ++x)
+            {
+               const vec<3, T> pt = grid.getPosition( x, y, z );
+               const T dist = length( pt - closestPointOnTriangle( pt, a, b, c ) );
+               T& value = grid( x, y, z );
+               if (dist < value)
+                  value = dist;
+            }
+   }
+}
+
+/**
+ * Negates the distances of the voxels of the given slices lying inside the
+ * mesh. Distances are expected to be unsigned.
+ *
+ * With SDF_SIGN_RAY_PARITY, the crossings of the x axis rows with the
+ * triangles are collected and sorted per row, a voxel is inside when an odd
+ * number of crossings precedes it. Rows going exactly through an edge count
+ * it once thanks to a top-left style tie breaking rule.
+ */
+template< class T >
+inline void meshSignSlices( const vec<3, T>* positions, const uint32_t* indices, size_t triangleCount, SdfSignMode mode,
+                            sdf_grid_t<T>& grid, int firstSlice, int sliceCount )
+{
+   const int lastSlice = min( firstSlice + sliceCount, grid.mDims.z );
+   if (lastSlice <= firstSlice)
+      return;
+
+   if (mode == SDF_SIGN_WINDING_NUMBER)
+   {
+      const T fourPi = T(4) * pi<T>();
+      for (int z = firstSlice; z < lastSlice; ++z)
+         for (int y = 0; y < grid.mDims.y; ++y)
+            for (int x = 0; x < grid.mDims.x; ++x)
+            {
+               const vec<3, T> pt = grid.getPosition( x, y, z );
+               T solidAngle = T(0);
+               for (size_t t = 0; t < triangleCount; ++t)
+               {
+                  // Van Oosterom and Strackee solid angle of the triangle seen from pt
+                  const vec<3, T> a = positions[indices[3 * t + 0]] - pt;
+                  const vec<3, T> b = positions[indices[3 * t + 1]] - pt;
+                  const vec<3, T> c = positions[indices[3 * t + 2]] - pt;
+                  const T la = length( a ), lb = length( b ), lc = length( c );
+                  const T num = dot( a, cross( b, c ) );
+                  const T den = la * lb * lc + dot( a, b ) * lc + dot( b, c ) * la + dot( c, a ) * lb;
+                  solidAngle += T(2) * atan( num, den );
+               }
+               if (abs( solidAngle ) > fourPi * static_cast<T>(0.5))
+                  grid( x, y, z ) = -abs( grid( x, y, z ) );
+            }
+      return;
+   }
+
+   const T invH = T(1) / grid.mVoxelSize;
+   const int rowCount = grid.mDims.y * (lastSlice - firstSlice);
+   std::vector< std::vector<T> > crossings( rowCount );
+
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      // Triangle in voxel coordinates, oriented counter clockwise in the yz plane
+      vec<3, T> p[3];
+      for (int i = 0; i < 3; ++i)
+         p[i] = (positions[indices[3 * t + i]] - grid.mOrigin) * invH;
+
+      T area = (p[1].y - p[0].y) * (p[2].z - p[0].z) - (p[1].z - p[0].z) * (p[2].y - p[0].y);
+      if (area == T(0))
+         continue;
+      if (area < T(0))
+      {
+         std::swap( p[1], p[2] );
+         area = -area;
+      }
+
+      const int y0 = max( static_cast<int>(ceil( min( p[0].y, min( p[1].y, p[2].y ) ) )), 0 );
+      const int y1 = min( static_cast<int>(floor( max( p[0].y, max( p[1].y, p[2].y ) ) )), grid.mDims.y - 1 );
+      const int z0 = max( static_cast<int>(ceil( min( p[0].z, min( p[1].z, p[2].z ) ) )), firstSlice );
+      const int z1 = min( static_cast<int>(floor( max( p[0].z, max( p[1].z, p[2].z ) ) )), lastSlice - 1 );
+
+      for (int z = z0; z <= z1; ++z)
+         for (int y = y0; y <= y1; ++y)
+         {
+            T w[3];
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e)
+            {
+               const vec<3, T>& u = p[(e + 1) % 3];
+               const vec<3, T>& v = p[(e + 2) % 3];
+               const T dy = v.y - u.y;
+               const T dz = v.z - u.z;
+               w[e] = dy * (T(z) - u.z) - dz * (T(y) - u.y);
+               inside = w[e] > T(0) || (w[e] == T(0) && (dy > T(0) || (dy == T(0) && dz < T(0))));
+            }
+            if (!inside)
+               continue;
+
+            const T x = (w[0] * p[0].x + w[1] * p[1].x + w[2] * p[2].x) / area;
+            crossings[(z - firstSlice) * grid.mDims.y + y].push_back( x );
+         }
+   }
+
+   for (int row = 0; row < rowCount; ++row)
+   {
+      std::vector<T>& xs = crossings[row];
+      if (xs.empty())
+         continue;
+      std::sort( xs.begin(), xs.end() );
+
+      T* values = &grid( 0, row % grid.mDims.y, firstSlice + row / grid.mDims.y );
+      size_t next = 0;
+      for (int x = 0; x < grid.mDims.x; ++x)
+      {
+         while (next < xs.size() && xs[next] < T(x))
+            ++next;
+         if (next & 1)
+            values[x] = -abs( values[x] );
+      }
+   }
+}
+
+/**
+ * Builds the signed distance field of a triangle mesh, outward facing
+ * triangles being counter clockwise.
+ *
+ * Distances are exact within bandWidth voxels of the surface. Further away,
+ * they are the distance to the nearest voxel touching the surface, computed
+ * with distanceTransform, which is within one voxel of the exact value.
+ *
+ * @param positions      the mesh vertices
+ * @param indices        three vertex indices per triangle
+ * @param triangleCount  the number of triangles
+ * @param bandWidth      the half width of the exact band, in voxels, at least 1
+ * @param mode           how inside voxels are found
+ * @param grid           receives the distances, its dimensions are left unchanged
+ */
+template< class T >
+inline void meshToSignedDistance( const vec<3, T>* positions, const uint32_t* indices, size_t triangleCount,
+                                  const T& bandWidth, SdfSignMode mode, sdf_grid_t<T>& grid )
+{
+   const T inf = std::numeric_limits<T>::max();
+   const T h = grid.mVoxelSize;
+   const T band = max( bandWidth, T(1) );
+   std::fill( grid.mValues.begin(), grid.mValues.end(), inf );
+   meshDistanceSlices( positions, indices, triangleCount, band, grid, 0, grid.mDims.z );
+
+   // Far field from the voxels next to the surface
+   const size_t count = grid.mValues.size();
+   std::vector<T> far( count );
+   for (size_t i = 0; i < count; ++i)
+      far[i] = grid.mValues[i] <= h ? T(0) : inf;
+   if (count)
+      distanceTransform( &far[0], grid.mDims );
+   for (size_t i = 0; i < count; ++i)
+      if (grid.mValues[i] == inf && far[i] != inf)
+         grid.mValues[i] = max( sqrt( far[i] ) * h, band * h );
+
+   meshSignSlices( positions, indices, triangleCount, mode, grid, 0, grid.mDims.z );
+}
+
+/** @} */
+
+// --- helper types --- //
+typedef sdf_grid_t<float>   sdf_gridf;
+typedef sdf_grid_t<double>  sdf_gridd;
+
+}
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "AABox.h"
+
+namespace glm
+{
+
+/**
+ * A closed interval [lower, upper] with outward rounded arithmetic: the
+ * result of each operation contains the exact result for every choice of
+ * operands in the input intervals, so a computation done with intervals
+ * gives rigorous bounds, for conservative culling or robust ray traversal.
+ *
+ * The lower bound is stored negated. Both stored bounds of a result are then
+ * upper bounds, rounded in the same direction, so the two run the same
+ * instructions and, for double, share one SSE2 register. Instead of
+ * switching the rounding mode, each bound is computed in the default round
+ * to nearest mode and moved up by at least one ulp. This relies on IEEE
+ * arithmetic with gradual underflow: do not compile with -ffast-math or
+ * flush denormals to zero.
+ *
+ * Bounds may be infinite, as after a division by an interval containing
+ * zero; a product of zero and infinity, or a quotient of two infinities,
+ * counts as zero, so the results stay conservative. An interval must still
+ * contain a finite number: [inf, inf] and [-inf, -inf] are not supported.
+ *
+ * glm::vec<L, interval_t<T> > works as an interval vector with the usual
+ * vector operators, and with the dot and cross overloads below.
+ *
+ * @param T     the internal type used for the bounds
+ */
+template<class T>
+class interval_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Leaves the bounds uninitialized. The constructor is trivial so that
+    * glm::vec, which holds its components in unions, can hold intervals.
+    */
+   interval_t() = default;
+
+   /**
+    * Creates the interval [value, value].
+    */
+   interval_t( T value )
+      : mNegLower( -value ), mUpper( value )
+   {}
+
+   /**
+    * Creates the interval [lower, upper].
+    *
+    * @pre  lower <= upper
+    */
+   interval_t( T lower, T upper )
+      : mNegLower( -lower ), mUpper( upper )
+   {}
+
+   /**
+    * Creates the interval containing every number, the result of a division
+    * by an interval containing zero.
+    */
+   static interval_t entire()
+   {
+      return interval_t( -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() );
+   }
+
+   T getLower() const
+   {
+      return -mNegLower;
+   }
+
+   T getUpper() const
+   {
+      return mUpper;
+   }
+
+   /**
+    * Gets the midpoint, rounded to nearest.
+    */
+   T getMid() const
+   {
+      return ( mUpper - mNegLower ) * T( 0.5 );
+   }
+
+   /**
+    * Gets upper - lower, rounded to nearest.
+    */
+   T getWidth() const
+   {
+      return mUpper + mNegLower;
+   }
+
+   bool contains( T value ) const
+   {
+      return -mNegLower <= value && value <= mUpper;
+   }
+
+public:
+   /**
+    * The lower bound, negated.
+    */
+   T mNegLower;
+
+   /**
+    * The upper bound.
+    */
+   T mUpper;
+};
+
+/**
+ * The outward rounded operations on interval_t, on plain T.
+ */
+template<class T>
+struct interval_arithmetic_t
+{
+   /** Moves x, a result rounded to nearest, up by at least one ulp. */
+   static T up( T x )
+   {
+      return x + ( std::abs( x ) * std::numeric_limits<T>::epsilon() + std::numeric_limits<T>::min() );
+   }
+
+   static interval_t<T> add( const interval_t<T>& a, const interval_t<T>& b )
+   {
+      interval_t<T> r;
+      r.mNegLower = up( a.mNegLower + b.mNegLower );
+      r.mUpper = up( a.mUpper + b.mUpper );
+      return r;
+   }
+
+   static interval_t<T> sub( const interval_t<T>& a, const interval_t<T>& b )
+   {
+      interval_t<T> r;
+      r.mNegLower = up( a.mNegLower + b.mUpper );
+      r.mUpper = up( a.mUpper + b.mNegLower );
+      return r;
+   }
+
+   /** p, or zero when p is the NaN of 0 * inf or inf / inf. */
+   static T orZero( T p )
+   {
+      return p == p ? p : T( 0 );
+   }
+
+   /**
+    * The hull of the four endpoint products or quotients p0 to p3. The other
+    * endpoints bound the range where one of them is NaN, so it counts as
+    * zero.
+    */
+   static interval_t<T> hull( T p0, T p1, T p2, T p3 )
+   {
+      p0 = orZero( p0 );
+      p1 = orZero( p1 );
+      p2 = orZero( p2 );
+      p3 = orZero( p3 );
+      interval_t<T> r;
+      r.mNegLower = up( -std::min( std::min( p0, p1 ), std::min( p2, p3 ) ) );
+      r.mUpper = up( std::max( std::max( p0, p1 ), std::max( p2, p3 ) ) );
+      return r;
+   }
+
+   static interval_t<T> mul( const interval_t<T>& a, const interval_t<T>& b )
+   {
+      const T aLower = -a.mNegLower;
+      const T bLower = -b.mNegLower;
+      return hull( aLower * bLower, aLower * b.mUpper, a.mUpper * bLower, a.mUpper * b.mUpper );
+   }
+
+   static interval_t<T> div( const interval_t<T>& a, const interval_t<T>& b )
+   {
+      if (b.contains( T( 0 ) ))
+         return interval_t<T>::entire();
+      const T aLower = -a.mNegLower;
+      const T bLower = -b.mNegLower;
+      return hull( aLower / bLower, aLower / b.mUpper, a.mUpper / bLower, a.mUpper / b.mUpper );
+   }
+
+   /** The negative part of a is dropped. */
+   static interval_t<T> sqrt( const interval_t<T>& a )
+   {
+      interval_t<T> r;
+      r.mNegLower = up( -std::sqrt( std::max( -a.mNegLower, T( 0 ) ) ) );
+      r.mUpper = up( std::sqrt( std::max( a.mUpper, T( 0 ) ) ) );
+      return r;
+   }
+};
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+/**
+ * interval_t<double> held in one register as ( mNegLower, mUpper ).
+ */
+template<>
+struct interval_arithmetic_t<double>
+{
+   static __m128d load( const interval_t<double>& a )
+   {
+      return _mm_loadu_pd( &a.mNegLower );
+   }
+
+   static interval_t<double> store( __m128d v )
+   {
+      interval_t<double> r;
+      _mm_storeu_pd( &r.mNegLower, v );
+      return r;
+   }
+
+   /** Moves both lanes of v, rounded to nearest, up by at least one ulp. */
+   static __m128d up( __m128d v )
+   {
+      const __m128d magnitude = _mm_andnot_pd( _mm_set1_pd( -0.0 ), v );
+      const __m128d step = _mm_add_pd(
+         _mm_mul_pd( magnitude, _mm_set1_pd( std::numeric_limits<double>::epsilon() ) ),
+         _mm_set1_pd( std::numeric_limits<double>::min() ) );
+      return _mm_add_pd( v, step );
+   }
+
+   static interval_t<double> add( const interval_t<double>& a, const interval_t<double>& b )
+   {
+      return store( up( _mm_add_pd( load( a ), load( b ) ) ) );
+   }
+
+   static interval_t<double> sub( const interval_t<double>& a, const interval_t<double>& b )
+   {
+      const __m128d bv = load( b );
+      return store( up( _mm_add_pd( load( a ), _mm_shuffle_pd( bv, bv, 1 ) ) ) );
+   }
+
+   /**
+    * The hull of the products or quotients p = ( aLower o bLower, aLower o
+    * bUpper ) and q = ( aUpper o bLower, aUpper o bUpper ), NaN lanes
+    * counting as zero.
+    */
+   static interval_t<double> hull( __m128d p, __m128d q )
+   {
+      p = _mm_and_pd( p, _mm_cmpord_pd( p, p ) );
+      q = _mm_and_pd( q, _mm_cmpord_pd( q, q ) );
+      const __m128d sign = _mm_set1_pd( -0.0 );
+      const __m128d high = _mm_max_pd( p, q );
+      const __m128d low = _mm_max_pd( _mm_xor_pd( p, sign ), _mm_xor_pd( q, sign ) );
+      return store( up( _mm_max_pd( _mm_unpacklo_pd( low, high ), _mm_unpackhi_pd( low, high ) ) ) );
+   }
+
+   static interval_t<double> mul( const interval_t<double>& a, const interval_t<double>& b )
+   {
+      const __m128d bv = _mm_xor_pd( load( b ), _mm_set_sd( -0.0 ) );
+      return hull( _mm_mul_pd( _mm_set1_pd( -a.mNegLower ), bv ), _mm_mul_pd( _mm_set1_pd( a.mUpper ), bv ) );
+   }
+
+   static interval_t<double> div( const interval_t<double>& a, const interval_t<double>& b )
+   {
+      if (b.contains( 0.0 ))
+         return interval_t<double>::entire();
+      const __m128d bv = _mm_xor_pd( load( b ), _mm_set_sd( -0.0 ) );
+      return hull( _mm_div_pd( _mm_set1_pd( -a.mNegLower ), bv ), _mm_div_pd( _mm_set1_pd( a.mUpper ), bv ) );
+   }
+
+   /** The negative part of a is dropped. */
+   static interval_t<double> sqrt( const interval_t<double>& a )
+   {
+      const __m128d sign = _mm_set_sd( -0.0 );
+      const __m128d bounds = _mm_max_pd( _mm_xor_pd( load( a ), sign ), _mm_setzero_pd() );
+      return store( up( _mm_xor_pd( _mm_sqrt_pd( bounds ), sign ) ) );
+   }
+};
+#endif
+
+/** @ingroup Interval interval_t
+ * @name interval_t Operators
+ * @{
+ */
+
+template<class T>
+inline interval_t<T> operator-( const interval_t<T>& a )
+{
+   interval_t<T> r;
+   r.mNegLower = a.mUpper;
+   r.mUpper = a.mNegLower;
+   return r;
+}
+
+template<class T>
+inline interval_t<T> operator+( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return interval_arithmetic_t<T>::add( a, b );
+}
+
+template<class T>
+inline interval_t<T> operator-( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return interval_arithmetic_t<T>::sub( a, b );
+}
+
+template<class T>
+inline interval_t<T> operator*( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return interval_arithmetic_t<T>::mul( a, b );
+}
+
+/**
+ * Returns interval_t::entire() when b contains zero.
+ */
+template<class T>
+inline interval_t<T> operator/( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return interval_arithmetic_t<T>::div( a, b );
+}
+
+template<class T>
+inline interval_t<T>& operator+=( interval_t<T>& a, const interval_t<T>& b )
+{
+   return a = a + b;
+}
+
+template<class T>
+inline interval_t<T>& operator-=( interval_t<T>& a, const interval_t<T>& b )
+{
+   return a = a - b;
+}
+
+template<class T>
+inline interval_t<T>& operator*=( interval_t<T>& a, const interval_t<T>& b )
+{
+   return a = a * b;
+}
+
+template<class T>
+inline interval_t<T>& operator/=( interval_t<T>& a, const interval_t<T>& b )
+{
+   return a = a / b;
+}
+
+/**
+ * Bounds the square root over the non negative part of a.
+ */
+template<class T>
+inline interval_t<T> sqrt( const interval_t<T>& a )
+{
+   return interval_arithmetic_t<T>::sqrt( a );
+}
+
+/**
+ * True if every number of a is less than every number of b.
+ */
+template<class T>
+inline bool certainlyLess( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return a.getUpper() < b.getLower();
+}
+
+/**
+ * True if every number of a is greater than every number of b.
+ */
+template<class T>
+inline bool certainlyGreater( const interval_t<T>& a, const interval_t<T>& b )
+{
+   return a.getLower() > b.getUpper();
+}
+
+template<length_t L, class T, qualifier Q>
+inline interval_t<T> dot( const vec<L, interval_t<T>, Q>& a, const vec<L, interval_t<T>, Q>& b )
+{
+   interval_t<T> r = a[0] * b[0];
+   for (length_t i = 1; i < L; ++i)
+      r += a[i] * b[i];
+   return r;
+}
+
+template<class T, qualifier Q>
+inline vec<3, interval_t<T>, Q> cross( const vec<3, interval_t<T>, Q>& a, const vec<3, interval_t<T>, Q>& b )
+{
+   return vec<3, interval_t<T>, Q>(
+      a.y * b.z - a.z * b.y,
+      a.z * b.x - a.x * b.z,
+      a.x * b.y - a.y * b.x );
+}
+/** @} */
+
+/**
+ * Converts a box to the interval vector of its extent on each axis. An empty
+ * box gives intervals with lower > upper.
+ */
+template<class T>
+inline vec<3, interval_t<T> > toIntervals( const aabox_t<T>& box )
+{
+   return vec<3, interval_t<T> >(
+      interval_t<T>( box.getMin().x, box.getMax().x ),
+      interval_t<T>( box.getMin().y, box.getMax().y ),
+      interval_t<T>( box.getMin().z, box.getMax().z ) );
+}
+
+/**
+ * Converts an interval vector to the box it spans, the empty box if any of
+ * the intervals has lower > upper.
+ */
+template<class T, qualifier Q>
+inline aabox_t<T> toAABox( const vec<3, interval_t<T>, Q>& v )
+{
+   const glm::vec<3, T> min( v.x.getLower(), v.y.getLower(), v.z.getLower() );
+   const glm::vec<3, T> max( v.x.getUpper(), v.y.getUpper(), v.z.getUpper() );
+   if (min.x > max.x || min.y > max.y || min.z > max.z)
+      return aabox_t<T>();
+   return aabox_t<T>( min, max );
+}
+
+// --- helper types --- //
+typedef interval_t<float>              intervalf;
+typedef interval_t<double>             intervald;
+typedef vec<2, interval_t<float> >     interval2f;
+typedef vec<3, interval_t<float> >     interval3f;
+typedef vec<4, interval_t<float> >     interval4f;
+typedef vec<2, interval_t<double> >    interval2d;
+typedef vec<3, interval_t<double> >    interval3d;
+typedef vec<4, interval_t<double> >    interval4d;
+
+}
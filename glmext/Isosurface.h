@@ -0,0 +1,541 @@
+#pragma once
+
+// Uses GLM_GTX_matrix_factorisation: define GLM_ENABLE_EXPERIMENTAL before
+// including this header.
+#include <glm/glm.hpp>
+#include <glm/gtx/matrix_factorisation.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "DistanceField.h"
+
+namespace glm
+{
+
+/**
+ * Isosurface extraction methods.
+ *
+ * Marching cubes places the vertices on the grid edges crossing the surface,
+ * dual contouring places one vertex per crossed cell, minimizing the
+ * quadratic error function of the edge crossings, which keeps sharp
+ * features.
+ */
+enum IsoMethod
+{
+   ISO_MARCHING_CUBES,
+   ISO_DUAL_CONTOURING
+};
+
+/**
+ * Indexed triangle mesh produced by the isosurface extraction.
+ *
+ * The extraction appends to the arrays, so a mesh reserved once and cleared
+ * between chunks is reused without allocating. mKeys identifies the source
+ * of each vertex in the grid, the crossed edge for marching cubes and the
+ * cell for dual contouring, and lets mergeIsosurfaceChunks weld the
+ * vertices shared by neighbor chunks.
+ *
+ * Triangles are counter clockwise seen from the side where the field is
+ * greater than the iso value, outside for distance fields, and the normals
+ * follow the field gradient.
+ *
+ * @param T     the internal type used for the positions
+ * @ingroup Types
+ */
+template<class T>
+class iso_mesh_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Removes all vertices and triangles, keeping the storage.
+    */
+   void clear()
+   {
+      mPositions.clear();
+      mNormals.clear();
+      mKeys.clear();
+      mIndices.clear();
+   }
+
+   /**
+    * Preallocates storage for the given number of vertices and indices.
+    */
+   void reserve( size_t vertexCount, size_t indexCount )
+   {
+      mPositions.reserve( vertexCount );
+      mNormals.reserve( vertexCount );
+      mKeys.reserve( vertexCount );
+      mIndices.reserve( indexCount );
+   }
+
+public:
+   std::vector< vec<3, T> > mPositions;
+   std::vector< vec<3, T> > mNormals;
+   std::vector<uint64_t> mKeys;
+   std::vector<uint32_t> mIndices;
+};
+
+/**
+ * Marching cubes triangle table: the crossed cube edges of each triangle,
+ * for the 256 sign configurations of the cube corners.
+ *
+ * Corner c is at (c & 1, (c >> 1) & 1, c >> 2) and bit c of the
+ * configuration is set when the corner is below the iso value. Edge e runs
+ * along axis e / 4 from the corner getCubeEdgeCorner( e ).
+ *
+ * Instead of the classic hand written table, the triangles are derived from
+ * the cube faces: on each face the crossings are joined so that the below
+ * corners are cut apart, the face segments are chained into loops and each
+ * loop is fanned. The face rule only depends on the 4 corners of the face,
+ * so neighbor cells agree on their shared face and the surface has no
+ * cracks, including on ambiguous faces.
+ */
+struct marching_cubes_table_t
+{
+   uint8_t mCount[256];
+   uint8_t mEdges[256][30];
+
+   marching_cubes_table_t()
+   {
+      // Corners of each face, counter clockwise seen from outside the cube
+      static const int faces[6][4] = {
+         { 0, 4, 6, 2 }, { 1, 3, 7, 5 },
+         { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+         { 0, 2, 3, 1 }, { 4, 5, 7, 6 } };
+
+      for (int cubeCase = 0; cubeCase < 256; ++cubeCase)
+      {
+         // next[e] is the crossed edge following e along its loop
+         int next[12];
+         std::fill( next, next + 12, -1 );
+         for (int f = 0; f < 6; ++f)
+         {
+            int crossings[4];
+            bool rising[4];
+            int count = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+               const int a = faces[f][i];
+               const int b = faces[f][(i + 1) % 4];
+               const bool belowA = (cubeCase >> a & 1) != 0;
+               const bool belowB = (cubeCase >> b & 1) != 0;
+               if (belowA != belowB)
+               {
+                  crossings[count] = getCubeEdge( a, b );
+                  rising[count] = belowA;
+                  ++count;
+               }
+            }
+            // Crossings alternate, join each rising one to the falling one before it
+            for (int i = 0; i < count; ++i)
+               if (rising[i])
+                  next[crossings[i]] = crossings[(i + count - 1) % count];
+         }
+
+         bool visited[12] = { false };
+         int written = 0;
+         for (int start = 0; start < 12; ++start)
+         {
+            if (next[start] < 0 || visited[start])
+               continue;
+            int loop[12];
+            int length = 0;
+            for (int e = start; !visited[e]; e = next[e])
+            {
+               visited[e] = true;
+               loop[length++] = e;
+            }
+            // Clip ears whose closing diagonal does not lie on a cube face, a
+            // diagonal on a face would not match the segments of the neighbor cell
+            while (length > 3)
+            {
+               int ear = 0;
+               for (int i = 0; i < length; ++i)
+                  if ((getCubeEdgeFaces( loop[(i + length - 1) % length] ) & getCubeEdgeFaces( loop[(i + 1) % length] )) == 0)
+                  {
+                     ear = i;
+                     break;
+                  }
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[(ear + length - 1) % length]);
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[(ear + 1) % length]);
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[ear]);
+               std::copy( loop + ear + 1, loop + length, loop + ear );
+               --length;
+            }
+            if (length == 3)
+            {
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[0]);
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[2]);
+               mEdges[cubeCase][written++] = static_cast<uint8_t>(loop[1]);
+            }
+         }
+         mCount[cubeCase] = static_cast<uint8_t>(written);
+      }
+   }
+
+   /**
+    * Gets the edge joining the cube corners a and b.
+    */
+   static int getCubeEdge( int a, int b )
+   {
+      const int axis = (a ^ b) == 1 ? 0 : ((a ^ b) == 2 ? 1 : 2);
+      const int low = std::min( a, b );
+      const int index = axis == 0 ? low >> 1 : (axis == 1 ? (low & 1) | (low >> 2) << 1 : low & 3);
+      return axis * 4 + index;
+   }
+
+   /**
+    * Gets the faces edge e lies on, bit 2 * axis + side for the face at
+    * coordinate side along axis.
+    */
+   static int getCubeEdgeFaces( int e )
+   {
+      const int axis = e >> 2;
+      const int corner = getCubeEdgeCorner( e );
+      int faces = 0;
+      for (int b = 0; b < 3; ++b)
+         if (b != axis)
+            faces |= 1 << (2 * b + (corner >> b & 1));
+      return faces;
+   }
+
+   /**
+    * Gets the cube corner edge e starts from, the other end is one step
+    * along axis e / 4.
+    */
+   static int getCubeEdgeCorner( int e )
+   {
+      const int axis = e >> 2;
+      const int index = e & 3;
+      return axis == 0 ? index << 1 : (axis == 1 ? (index & 1) | (index >> 1) << 2 : index);
+   }
+};
+
+/**
+ * Gets the shared marching cubes table, built on first use.
+ */
+inline const marching_cubes_table_t& getMarchingCubesTable()
+{
+   static const marching_cubes_table_t table;
+   return table;
+}
+
+/**
+ * Gradient of a grid at voxel (x, y, z), central differences inside the
+ * grid and one sided differences on its border.
+ */
+template< class T >
+inline vec<3, T> gridGradient( const sdf_grid_t<T>& grid, int x, int y, int z )
+{
+   const ivec3& dims = grid.getDims();
+   const ivec3 p( x, y, z );
+   vec<3, T> gradient( 0 );
+   for (int axis = 0; axis < 3; ++axis)
+   {
+      ivec3 lo = p, hi = p;
+      lo[axis] = std::max( p[axis] - 1, 0 );
+      hi[axis] = std::min( p[axis] + 1, dims[axis] - 1 );
+      if (hi[axis] > lo[axis])
+         gradient[axis] = (grid( hi.x, hi.y, hi.z ) - grid( lo.x, lo.y, lo.z )) /
+            (static_cast<T>(hi[axis] - lo[axis]) * grid.getVoxelSize());
+   }
+   return gradient;
+}
+
+/**
+ * Interpolates the iso value crossing on the grid edge starting at voxel p
+ * along axis.
+ *
+ * @param position  receives the crossing position
+ * @param normal    receives the normalized gradient at the crossing, 0 where the gradient vanishes
+ */
+template< class T >
+inline void isoEdgeCrossing( const sdf_grid_t<T>& grid, const T& isoValue, const ivec3& p, int axis,
+                             vec<3, T>& position, vec<3, T>& normal )
+{
+   ivec3 q = p;
+   ++q[axis];
+   const T va = grid( p.x, p.y, p.z );
+   const T vb = grid( q.x, q.y, q.z );
+   const T t = vb != va ? clamp( (isoValue - va) / (vb - va), T(0), T(1) ) : T(0.5);
+   position = mix( grid.getPosition( p.x, p.y, p.z ), grid.getPosition( q.x, q.y, q.z ), t );
+   normal = mix( gridGradient( grid, p.x, p.y, p.z ), gridGradient( grid, q.x, q.y, q.z ), t );
+   const T normalLength = length( normal );
+   normal = normalLength > T(0) ? normal / normalLength : vec<3, T>( 0 );
+}
+
+/**
+ * Dual contouring vertex of cell (x, y, z), the cell spanning voxels
+ * (x, y, z) to (x + 1, y + 1, z + 1).
+ *
+ * Minimizes the quadratic error function sum( dot( n_i, v - p_i )^2 ) of
+ * the edge crossings p_i and their normals n_i, solving the regularized
+ * normal equations with the QR factorisation of gtx/matrix_factorisation.
+ * The regularization pulls the directions the crossings leave free, along
+ * flat surfaces and edges, towards the mean crossing. The result is clamped
+ * into the cell.
+ */
+template< class T >
+inline void isoCellVertex( const sdf_grid_t<T>& grid, const T& isoValue, int x, int y, int z,
+                           vec<3, T>& position, vec<3, T>& normal )
+{
+   const T regularization = static_cast<T>(0.05);
+   vec<3, T> points[12], normals[12];
+   int count = 0;
+   for (int e = 0; e < 12; ++e)
+   {
+      const int c = marching_cubes_table_t::getCubeEdgeCorner( e );
+      const ivec3 p( x + (c & 1), y + ((c >> 1) & 1), z + (c >> 2) );
+      ivec3 q = p;
+      ++q[e >> 2];
+      if ((grid( p.x, p.y, p.z ) < isoValue) == (grid( q.x, q.y, q.z ) < isoValue))
+         continue;
+      isoEdgeCrossing( grid, isoValue, p, e >> 2, points[count], normals[count] );
+      ++count;
+   }
+
+   vec<3, T> massPoint( 0 );
+   normal = vec<3, T>( 0 );
+   for (int i = 0; i < count; ++i)
+   {
+      massPoint += points[i];
+      normal += normals[i];
+   }
+   massPoint /= static_cast<T>(std::max( count, 1 ));
+   const T normalLength = length( normal );
+   normal = normalLength > T(0) ? normal / normalLength : vec<3, T>( 0 );
+
+   // (AtA + r I) v = Atb, relative to the mass point
+   mat<3, 3, T> ata( regularization );
+   vec<3, T> atb( 0 );
+   for (int i = 0; i < count; ++i)
+   {
+      ata += outerProduct( normals[i], normals[i] );
+      atb += normals[i] * dot( normals[i], points[i] - massPoint );
+   }
+   mat<3, 3, T> q, r;
+   qr_decompose( ata, q, r );
+   const vec<3, T> rhs = transpose( q ) * atb;
+   vec<3, T> offset( 0 );
+   for (int i = 2; i >= 0; --i)
+   {
+      T sum = rhs[i];
+      for (int j = i + 1; j < 3; ++j)
+         sum -= r[j][i] * offset[j];
+      offset[i] = abs( r[i][i] ) > std::numeric_limits<T>::epsilon() ? sum / r[i][i] : T(0);
+   }
+   position = clamp( massPoint + offset, grid.getPosition( x, y, z ), grid.getPosition( x + 1, y + 1, z + 1 ) );
+}
+
+/**
+ * Extracts the isosurface of the cells [cellMin, cellMax) of a scalar grid,
+ * such as a distance field or densities filled from glm::perlin or
+ * glm::simplex, and appends it to mesh. Cell (x, y, z) spans voxels
+ * (x, y, z) to (x + 1, y + 1, z + 1), so a grid has dims - 1 cells.
+ *
+ * Marching cubes walks the chunk slice by slice and keeps the vertices of
+ * the crossed edges of the current and next slices in caches indexed by
+ * edge, so the cells sharing an edge share its vertex. Dual contouring
+ * emits one quad per crossed edge owned by the chunk, computing the
+ * vertices of the cells around it, including the ring of cells just outside
+ * of the chunk, once.
+ *
+ * Calls on different chunks read the grid and write different meshes, so
+ * they may run on different threads; mergeIsosurfaceChunks then welds the
+ * vertices duplicated on the chunk borders.
+ *
+ * @param grid      the scalar field
+ * @param isoValue  the value of the surface
+ * @param method    marching cubes or dual contouring
+ * @param cellMin   the first cell of the chunk
+ * @param cellMax   one past the last cell of the chunk, clamped to the grid
+ * @param mesh      the mesh to append to
+ */
+template< class T >
+inline void extractIsosurfaceChunk( const sdf_grid_t<T>& grid, const T& isoValue, IsoMethod method,
+                                    const ivec3& cellMin, const ivec3& cellMax, iso_mesh_t<T>& mesh )
+{
+   const uint32_t none = std::numeric_limits<uint32_t>::max();
+   const ivec3& dims = grid.getDims();
+   const ivec3 lo = max( cellMin, ivec3( 0 ) );
+   const ivec3 hi = min( cellMax, dims - 1 );
+   if (lo.x >= hi.x || lo.y >= hi.y || lo.z >= hi.z)
+      return;
+
+   vec<3, T> position, normal;
+   if (method == ISO_MARCHING_CUBES)
+   {
+      const marching_cubes_table_t& table = getMarchingCubesTable();
+      const int sx = hi.x - lo.x + 1;
+      const int sy = hi.y - lo.y + 1;
+
+      // Vertices of the x and y edges of the bottom [0] and top [1] slices of the cell layer, and of its z edges
+      std::vector<uint32_t> xEdges[2], yEdges[2], zEdges;
+      xEdges[0].assign( static_cast<size_t>(sx - 1) * sy, none );
+      yEdges[0].assign( static_cast<size_t>(sx) * (sy - 1), none );
+      for (int z = lo.z; z < hi.z; ++z)
+      {
+         xEdges[1].assign( static_cast<size_t>(sx - 1) * sy, none );
+         yEdges[1].assign( static_cast<size_t>(sx) * (sy - 1), none );
+         zEdges.assign( static_cast<size_t>(sx) * sy, none );
+         for (int y = lo.y; y < hi.y; ++y)
+            for (int x = lo.x; x < hi.x; ++x)
+            {
+               int cubeCase = 0;
+               for (int c = 0; c < 8; ++c)
+                  if (grid( x + (c & 1), y + ((c >> 1) & 1), z + (c >> 2) ) < isoValue)
+                     cubeCase |= 1 << c;
+               if (cubeCase == 0 || cubeCase == 255)
+                  continue;
+
+               for (int i = 0; i < table.mCount[cubeCase]; ++i)
+               {
+                  const int e = table.mEdges[cubeCase][i];
+                  const int axis = e >> 2;
+                  const int c = marching_cubes_table_t::getCubeEdgeCorner( e );
+                  const int cx = x - lo.x + (c & 1);
+                  const int cy = y - lo.y + ((c >> 1) & 1);
+                  const int cz = c >> 2;
+                  uint32_t* slot;
+                  if (axis == 0)
+                     slot = &xEdges[cz][static_cast<size_t>(cx) + static_cast<size_t>(sx - 1) * cy];
+                  else if (axis == 1)
+                     slot = &yEdges[cz][static_cast<size_t>(cx) + static_cast<size_t>(sx) * cy];
+                  else
+                     slot = &zEdges[static_cast<size_t>(cx) + static_cast<size_t>(sx) * cy];
+
+                  if (*slot == none)
+                  {
+                     const ivec3 p( lo.x + cx, lo.y + cy, z + cz );
+                     isoEdgeCrossing( grid, isoValue, p, axis, position, normal );
+                     *slot = static_cast<uint32_t>(mesh.mPositions.size());
+                     mesh.mPositions.push_back( position );
+                     mesh.mNormals.push_back( normal );
+                     mesh.mKeys.push_back( static_cast<uint64_t>(grid.getIndex( p.x, p.y, p.z )) * 3 + axis );
+                  }
+                  mesh.mIndices.push_back( *slot );
+               }
+            }
+         xEdges[0].swap( xEdges[1] );
+         yEdges[0].swap( yEdges[1] );
+      }
+      return;
+   }
+
+   // Cells of the chunk and of the ring around it
+   const ivec3 ringLo = max( lo - 1, ivec3( 0 ) );
+   const ivec3 ringHi = min( hi + 1, dims - 1 );
+   const ivec3 ringDims = ringHi - ringLo;
+   std::vector<uint32_t> cellVertices( static_cast<size_t>(ringDims.x) * ringDims.y * ringDims.z, none );
+
+   for (int axis = 0; axis < 3; ++axis)
+   {
+      const int u = (axis + 1) % 3;
+      const int w = (axis + 2) % 3;
+      ivec3 du( 0 ), dw( 0 );
+      du[u] = 1;
+      dw[w] = 1;
+      for (int z = lo.z; z < hi.z; ++z)
+         for (int y = lo.y; y < hi.y; ++y)
+            for (int x = lo.x; x < hi.x; ++x)
+            {
+               const ivec3 p( x, y, z );
+               if (p[u] == 0 || p[w] == 0)
+                  continue;
+               ivec3 q = p;
+               ++q[axis];
+               const bool rising = grid( p.x, p.y, p.z ) < isoValue;
+               if (rising == (grid( q.x, q.y, q.z ) < isoValue))
+                  continue;
+
+               // The 4 cells around the edge, counter clockwise around the axis
+               const ivec3 cells[4] = { p - du - dw, p - dw, p, p - du };
+               uint32_t quad[4];
+               for (int k = 0; k < 4; ++k)
+               {
+                  const ivec3 local = cells[k] - ringLo;
+                  uint32_t& slot = cellVertices[static_cast<size_t>(local.x) +
+                     static_cast<size_t>(ringDims.x) * (static_cast<size_t>(local.y) + static_cast<size_t>(ringDims.y) * local.z)];
+                  if (slot == none)
+                  {
+                     isoCellVertex( grid, isoValue, cells[k].x, cells[k].y, cells[k].z, position, normal );
+                     slot = static_cast<uint32_t>(mesh.mPositions.size());
+                     mesh.mPositions.push_back( position );
+                     mesh.mNormals.push_back( normal );
+                     mesh.mKeys.push_back( static_cast<uint64_t>(grid.getIndex( cells[k].x, cells[k].y, cells[k].z )) );
+                  }
+                  quad[k] = slot;
+               }
+               if (!rising)
+                  std::swap( quad[1], quad[3] );
+               const uint32_t triangles[6] = { quad[0], quad[1], quad[2], quad[0], quad[2], quad[3] };
+               mesh.mIndices.insert( mesh.mIndices.end(), triangles, triangles + 6 );
+            }
+   }
+}
+
+/**
+ * Extracts the isosurface of a whole grid into mesh, replacing its content,
+ * see extractIsosurfaceChunk.
+ */
+template< class T >
+inline void extractIsosurface( const sdf_grid_t<T>& grid, const T& isoValue, IsoMethod method, iso_mesh_t<T>& mesh )
+{
+   mesh.clear();
+   extractIsosurfaceChunk( grid, isoValue, method, ivec3( 0 ), grid.getDims() - 1, mesh );
+}
+
+/**
+ * Concatenates the meshes of the chunks of a grid, extracted with the same
+ * method, welding the vertices with the same key.
+ *
+ * @param chunks  the chunk meshes
+ * @param count   the number of chunks
+ * @param result  receives the merged mesh, must not be one of the chunks
+ */
+template< class T >
+inline void mergeIsosurfaceChunks( const iso_mesh_t<T>* chunks, size_t count, iso_mesh_t<T>& result )
+{
+   size_t vertexCount = 0, indexCount = 0;
+   for (size_t i = 0; i < count; ++i)
+   {
+      vertexCount += chunks[i].mPositions.size();
+      indexCount += chunks[i].mIndices.size();
+   }
+   result.clear();
+   result.reserve( vertexCount, indexCount );
+
+   std::unordered_map<uint64_t, uint32_t> welded;
+   welded.reserve( vertexCount );
+   std::vector<uint32_t> remap;
+   for (size_t i = 0; i < count; ++i)
+   {
+      const iso_mesh_t<T>& chunk = chunks[i];
+      remap.resize( chunk.mPositions.size() );
+      for (size_t v = 0; v < chunk.mPositions.size(); ++v)
+      {
+         const std::pair<std::unordered_map<uint64_t, uint32_t>::iterator, bool> inserted =
+            welded.insert( std::make_pair( chunk.mKeys[v], static_cast<uint32_t>(result.mPositions.size()) ) );
+         if (inserted.second)
+         {
+            result.mPositions.push_back( chunk.mPositions[v] );
+            result.mNormals.push_back( chunk.mNormals[v] );
+            result.mKeys.push_back( chunk.mKeys[v] );
+         }
+         remap[v] = inserted.first->second;
+      }
+      for (size_t k = 0; k < chunk.mIndices.size(); ++k)
+         result.mIndices.push_back( remap[chunk.mIndices[k]] );
+   }
+}
+
+// --- helper types --- //
+typedef iso_mesh_t<float>   iso_meshf;
+typedef iso_mesh_t<double>  iso_meshd;
+
+}
@@ -0,0 +1,464 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace glm
+{
+
+/** Iteration schemes for k-means, all giving the same assignments as Lloyd's. */
+enum KMeansMethod
+{
+   /** Full scan of the centroids for every point. */
+   KMEANS_LLOYD,
+   /** One upper and one lower bound per point, cheap for small k. */
+   KMEANS_HAMERLY,
+   /** One upper and k lower bounds per point, prunes most for large k. */
+   KMEANS_ELKAN
+};
+
+/**
+ * k-means parameters.
+ */
+struct kmeans_params_t
+{
+   kmeans_params_t()
+      : mMethod( KMEANS_HAMERLY ), mMaxIterations( 100 ), mSeed( 1 )
+   {}
+
+   KMeansMethod mMethod;
+   int mMaxIterations;
+
+   /** Seed of the k-means++ initialization. */
+   unsigned int mSeed;
+};
+
+/**
+ * Sums of the points assigned to each cluster during one assignment pass.
+ *
+ * Each thread running kmeansAssignRange fills its own accumulator; the
+ * accumulators are merged by kmeansUpdate. Sums are kept in double so that
+ * float data does not lose precision over many points.
+ */
+template<length_t L>
+struct kmeans_accumulator_t
+{
+   void reset( size_t k )
+   {
+      mSums.assign( k, vec<L, double>( 0 ) );
+      mCounts.assign( k, 0 );
+      mChanged = 0;
+   }
+
+   std::vector< vec<L, double> > mSums;
+   std::vector<size_t> mCounts;
+
+   /** Number of points whose cluster changed. */
+   size_t mChanged;
+};
+
+/**
+ * Clustering state: the centroids, the assignments and, for Hamerly and
+ * Elkan, the distance bounds of the points and the centroid data they use.
+ *
+ * The bounds are Euclidean distances; assignments compare squared
+ * distances, as glm::distance2.
+ *
+ * @param L     the dimension of the points
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<length_t L, class T>
+class kmeans_state_t
+{
+public:
+   typedef T DataType;
+
+public:
+   kmeans_state_t()
+      : mMethod( KMEANS_LLOYD ), mBounded( false ), mMaxShift( 0 ), mSecondMaxShift( 0 ), mArgMaxShift( 0 )
+   {}
+
+   /**
+    * Starts a clustering from the given centroids.
+    *
+    * @param centroids  the initial centroids
+    * @param k          the number of centroids
+    * @param count      the number of points to cluster
+    * @param method     the iteration scheme
+    */
+   void reset( const vec<L, T>* centroids, size_t k, size_t count, KMeansMethod method )
+   {
+      mMethod = method;
+      mCentroids.assign( centroids, centroids + k );
+      mAssignments.assign( count, 0 );
+      mUpper.assign( method == KMEANS_LLOYD ? 0 : count, T(0) );
+      mLower.assign( method == KMEANS_LLOYD ? 0 : method == KMEANS_HAMERLY ? count : count * k, T(0) );
+      mShifts.assign( k, T(0) );
+      mMaxShift = mSecondMaxShift = T(0);
+      mArgMaxShift = 0;
+      mBounded = false;
+      prepareCentroids();
+   }
+
+   size_t getClusterCount() const
+   {
+      return mCentroids.size();
+   }
+
+   /**
+    * Refreshes the centroid data used by the assignments: the per axis
+    * copies of the centroids and the distances between them.
+    */
+   void prepareCentroids()
+   {
+      const size_t k = mCentroids.size();
+      for (length_t a = 0; a < L; ++a)
+      {
+         mCentroidCoords[a].resize( k );
+         for (size_t j = 0; j < k; ++j)
+            mCentroidCoords[a][j] = mCentroids[j][a];
+      }
+      if (mMethod == KMEANS_LLOYD)
+         return;
+
+      // Half the distance from each centroid to its nearest other one, and all pairs for Elkan
+      mHalfNearest.assign( k, std::numeric_limits<T>::max() );
+      if (mMethod == KMEANS_ELKAN)
+         mHalfDistances.assign( k * k, T(0) );
+      for (size_t i = 0; i < k; ++i)
+         for (size_t j = i + 1; j < k; ++j)
+         {
+            const T half = length( mCentroids[i] - mCentroids[j] ) / T(2);
+            mHalfNearest[i] = min( mHalfNearest[i], half );
+            mHalfNearest[j] = min( mHalfNearest[j], half );
+            if (mMethod == KMEANS_ELKAN)
+               mHalfDistances[i * k + j] = mHalfDistances[j * k + i] = half;
+         }
+   }
+
+public:
+   KMeansMethod mMethod;
+   std::vector< vec<L, T> > mCentroids;
+   std::vector<uint32_t> mAssignments;
+
+   /** True once the bounds hold, after the first assignment pass. */
+   bool mBounded;
+
+   /** Upper bound on the distance of each point to its centroid. */
+   std::vector<T> mUpper;
+
+   /** Lower bounds on the distances to the other centroids: one per point for Hamerly, k for Elkan. */
+   std::vector<T> mLower;
+
+   /** Distance moved by each centroid at the last update, and the two largest moves. */
+   std::vector<T> mShifts;
+   T mMaxShift;
+   T mSecondMaxShift;
+   size_t mArgMaxShift;
+
+   std::vector<T> mCentroidCoords[L];
+   std::vector<T> mHalfNearest;
+   std::vector<T> mHalfDistances;
+};
+
+/**
+ * Picks k initial centroids among the points with k-means++: each new
+ * centroid is drawn with probability proportional to the squared distance
+ * to the nearest centroid already picked.
+ *
+ * The draws come from a local std::minstd_rand seeded with seed, so the
+ * same seed gives the same centroids, without touching std::rand's state,
+ * and concurrent calls are independent.
+ *
+ * @param points     the points
+ * @param count      the number of points
+ * @param k          the number of centroids, at most count
+ * @param seed       the seed
+ * @param centroids  receives the centroids, room for k
+ */
+template< length_t L, class T >
+inline void kmeansPlusPlus( const vec<L, T>* points, size_t count, size_t k, unsigned int seed, vec<L, T>* centroids )
+{
+   if (count == 0 || k == 0)
+      return;
+   std::minstd_rand engine( seed );
+   std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+   const size_t first = std::min( static_cast<size_t>(uniform( engine ) * static_cast<double>(count)), count - 1 );
+   centroids[0] = points[first];
+
+   std::vector<T> nearest2( count, std::numeric_limits<T>::max() );
+   for (size_t c = 1; c < k; ++c)
+   {
+      double total = 0.0;
+      const vec<L, T> last = centroids[c - 1];
+      for (size_t i = 0; i < count; ++i)
+      {
+         const vec<L, T> d = points[i] - last;
+         nearest2[i] = min( nearest2[i], dot( d, d ) );
+         total += static_cast<double>(nearest2[i]);
+      }
+
+      // All points on the centroids already picked: repeat the last one
+      size_t pick = count - 1;
+      if (total > 0.0)
+      {
+         const double target = uniform( engine ) * total;
+         double sum = 0.0;
+         for (size_t i = 0; i < count; ++i)
+         {
+            sum += static_cast<double>(nearest2[i]);
+            if (sum > target && nearest2[i] > T(0))
+            {
+               pick = i;
+               break;
+            }
+         }
+         while (nearest2[pick] == T(0))
+            --pick;
+      }
+      centroids[c] = points[pick];
+   }
+}
+
+/**
+ * Finds the nearest and second nearest centroids of a point, from squared
+ * distances to all of the centroids computed as a loop over the per axis
+ * centroid arrays, which the compiler vectorizes.
+ */
+template< length_t L, class T >
+inline void kmeansNearestTwo( const kmeans_state_t<L, T>& state, const vec<L, T>& point, std::vector<T>& distances2,
+                              size_t& best, T& best2, T& second2 )
+{
+   const size_t k = state.getClusterCount();
+   distances2.assign( k, T(0) );
+   T* d2 = &distances2[0];
+   for (length_t a = 0; a < L; ++a)
+   {
+      const T* c = &state.mCentroidCoords[a][0];
+      const T p = point[a];
+      for (size_t j = 0; j < k; ++j)
+         d2[j] += (c[j] - p) * (c[j] - p);
+   }
+
+   best = 0;
+   best2 = std::numeric_limits<T>::max();
+   second2 = std::numeric_limits<T>::max();
+   for (size_t j = 0; j < k; ++j)
+   {
+      if (d2[j] < best2)
+      {
+         second2 = best2;
+         best2 = d2[j];
+         best = j;
+      }
+      else if (d2[j] < second2)
+         second2 = d2[j];
+   }
+}
+
+/**
+ * Assigns the points [first, first + count) to their nearest centroids and
+ * adds them to an accumulator.
+ *
+ * Hamerly and Elkan first loosen the bounds of each point by the centroid
+ * moves of the last update, and only compute the distances the bounds
+ * cannot rule out. Each point only touches its own assignment and bounds, so
+ * calls on disjoint ranges, each with its own accumulator, may run on
+ * different threads.
+ *
+ * @param points       the points
+ * @param first        the first point to assign
+ * @param count        the number of points to assign
+ * @param state        the clustering state
+ * @param accumulator  receives the sums of the assigned points, reset to the cluster count beforehand
+ */
+template< length_t L, class T >
+inline void kmeansAssignRange( const vec<L, T>* points, size_t first, size_t count,
+                               kmeans_state_t<L, T>& state, kmeans_accumulator_t<L>& accumulator )
+{
+   const size_t k = state.getClusterCount();
+   std::vector<T> distances2;
+   for (size_t i = first; i < first + count; ++i)
+   {
+      const vec<L, T>& p = points[i];
+      size_t assigned = state.mAssignments[i];
+      const size_t previous = assigned;
+
+      if (state.mMethod == KMEANS_LLOYD || !state.mBounded)
+      {
+         T best2, second2;
+         kmeansNearestTwo( state, p, distances2, assigned, best2, second2 );
+         if (state.mMethod == KMEANS_HAMERLY)
+         {
+            state.mUpper[i] = sqrt( best2 );
+            state.mLower[i] = k > 1 ? sqrt( second2 ) : std::numeric_limits<T>::max();
+         }
+         else if (state.mMethod == KMEANS_ELKAN)
+         {
+            state.mUpper[i] = sqrt( best2 );
+            for (size_t j = 0; j < k; ++j)
+               state.mLower[i * k + j] = sqrt( distances2[j] );
+         }
+      }
+      else if (state.mMethod == KMEANS_HAMERLY)
+      {
+         T& upper = state.mUpper[i];
+         T& lower = state.mLower[i];
+         upper += state.mShifts[assigned];
+         lower -= assigned == state.mArgMaxShift ? state.mSecondMaxShift : state.mMaxShift;
+         const T bound = max( state.mHalfNearest[assigned], lower );
+         if (upper > bound)
+         {
+            upper = length( p - state.mCentroids[assigned] );
+            if (upper > bound)
+            {
+               T best2, second2;
+               kmeansNearestTwo( state, p, distances2, assigned, best2, second2 );
+               upper = sqrt( best2 );
+               lower = k > 1 ? sqrt( second2 ) : std::numeric_limits<T>::max();
+            }
+         }
+      }
+      else
+      {
+         T& upper = state.mUpper[i];
+         T* lower = &state.mLower[i * k];
+         upper += state.mShifts[assigned];
+         for (size_t j = 0; j < k; ++j)
+            lower[j] = max( lower[j] - state.mShifts[j], T(0) );
+         if (upper > state.mHalfNearest[assigned])
+         {
+            bool stale = true;
+            for (size_t j = 0; j < k; ++j)
+            {
+               if (j == assigned || upper <= lower[j] || upper <= state.mHalfDistances[assigned * k + j])
+                  continue;
+               if (stale)
+               {
+                  upper = lower[assigned] = length( p - state.mCentroids[assigned] );
+                  stale = false;
+                  if (upper <= lower[j] || upper <= state.mHalfDistances[assigned * k + j])
+                     continue;
+               }
+               lower[j] = length( p - state.mCentroids[j] );
+               if (lower[j] < upper)
+               {
+                  assigned = j;
+                  upper = lower[j];
+               }
+            }
+         }
+      }
+
+      state.mAssignments[i] = static_cast<uint32_t>(assigned);
+      accumulator.mSums[assigned] += vec<L, double>( p );
+      ++accumulator.mCounts[assigned];
+      accumulator.mChanged += assigned != previous ? 1 : 0;
+   }
+}
+
+/**
+ * Merges the accumulators of an assignment pass, moves the centroids to the
+ * means of their points and prepares the next pass. A centroid left without
+ * points stays in place.
+ *
+ * @param state             the clustering state
+ * @param accumulators      the accumulators of the pass
+ * @param accumulatorCount  the number of accumulators
+ *
+ * @return  the number of points whose cluster changed during the pass
+ */
+template< length_t L, class T >
+inline size_t kmeansUpdate( kmeans_state_t<L, T>& state, const kmeans_accumulator_t<L>* accumulators, size_t accumulatorCount )
+{
+   const size_t k = state.getClusterCount();
+   size_t changed = 0;
+   state.mMaxShift = state.mSecondMaxShift = T(0);
+   state.mArgMaxShift = 0;
+   for (size_t j = 0; j < k; ++j)
+   {
+      vec<L, double> sum( 0 );
+      size_t n = 0;
+      for (size_t a = 0; a < accumulatorCount; ++a)
+      {
+         sum += accumulators[a].mSums[j];
+         n += accumulators[a].mCounts[j];
+      }
+      T shift( 0 );
+      if (n > 0)
+      {
+         const vec<L, T> centroid( sum / static_cast<double>(n) );
+         shift = length( centroid - state.mCentroids[j] );
+         state.mCentroids[j] = centroid;
+      }
+      state.mShifts[j] = shift;
+      if (shift > state.mMaxShift)
+      {
+         state.mSecondMaxShift = state.mMaxShift;
+         state.mMaxShift = shift;
+         state.mArgMaxShift = j;
+      }
+      else if (shift > state.mSecondMaxShift)
+         state.mSecondMaxShift = shift;
+   }
+   for (size_t a = 0; a < accumulatorCount; ++a)
+      changed += accumulators[a].mChanged;
+
+   state.mBounded = state.mMethod != KMEANS_LLOYD;
+   state.prepareCentroids();
+   return changed;
+}
+
+/**
+ * Clusters the points into k clusters: k-means++ initialization, then
+ * assignment passes and updates until no point changes cluster.
+ *
+ * This runs every pass in one call; to spread a pass over threads, call
+ * kmeansAssignRange on chunks of the points with one accumulator per
+ * thread, then kmeansUpdate on all of the accumulators.
+ *
+ * @param points  the points
+ * @param count   the number of points
+ * @param k       the number of clusters, at most count
+ * @param params  the parameters
+ * @param state   receives the centroids and assignments
+ *
+ * @return  the number of passes run
+ */
+template< length_t L, class T >
+inline int kmeans( const vec<L, T>* points, size_t count, size_t k, const kmeans_params_t& params, kmeans_state_t<L, T>& state )
+{
+   k = std::min( k, count );
+   std::vector< vec<L, T> > centroids( k );
+   if (k > 0)
+      kmeansPlusPlus( points, count, k, params.mSeed, &centroids[0] );
+   state.reset( k == 0 ? NULL : &centroids[0], k, count, params.mMethod );
+   if (k == 0)
+      return 0;
+
+   kmeans_accumulator_t<L> accumulator;
+   int pass = 0;
+   while (pass < params.mMaxIterations)
+   {
+      accumulator.reset( k );
+      kmeansAssignRange( points, 0, count, state, accumulator );
+      ++pass;
+      // The first pass counts the points leaving cluster 0, so always run a second one
+      if (kmeansUpdate( state, &accumulator, 1 ) == 0 && pass > 1)
+         break;
+   }
+   return pass;
+}
+
+// --- helper types --- //
+typedef kmeans_state_t<3, float>    kmeans_state3f;
+typedef kmeans_state_t<4, float>    kmeans_state4f;
+typedef kmeans_state_t<3, double>   kmeans_state3d;
+typedef kmeans_state_t<4, double>   kmeans_state4d;
+
+}
@@ -0,0 +1,504 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace glm
+{
+
+/**
+ * A subtree of a k-d tree left to build, see kd_tree_t::splitTop.
+ */
+struct kd_build_task_t
+{
+   size_t mNode;
+   size_t mBegin;
+   size_t mEnd;
+};
+
+/**
+ * Results of batched radius queries, see kd_tree_t::radiusSearchBatch.
+ *
+ * The results of query q are mIndices[mOffsets[q] .. mOffsets[q + 1]), with
+ * the squared distances at the same positions in mDistances2. Keep one per
+ * thread: batches append to it.
+ */
+template<class T>
+struct kd_radius_result_t
+{
+   void clear()
+   {
+      mOffsets.assign( 1, 0 );
+      mIndices.clear();
+      mDistances2.clear();
+   }
+
+   size_t getQueryCount() const
+   {
+      return mOffsets.empty() ? 0 : mOffsets.size() - 1;
+   }
+
+   std::vector<size_t> mOffsets;
+   std::vector<uint32_t> mIndices;
+   std::vector<T> mDistances2;
+};
+
+/**
+ * Static k-d tree over vec<L, T> points.
+ *
+ * The tree has no pointers: the points are reordered so that every node
+ * covers a contiguous range, node ranges follow from median splits, and the
+ * split planes live in arrays indexed like a binary heap, children of node
+ * i being 2 i + 1 and 2 i + 2. The reordered points are stored one array per
+ * axis, and leaves of at most getLeafSize() points are scanned 16 points at
+ * a time with loops the compiler vectorizes.
+ *
+ * The two halves of a split never share a point, so subtrees may be built
+ * on different threads: beginBuild, splitTop, buildSubtree for each task,
+ * then endBuild. The queries are const and may run concurrently.
+ *
+ * @param L     the dimension of the points
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<length_t L, class T>
+class kd_tree_t
+{
+public:
+   typedef T DataType;
+
+   /** Number of points scanned per step of a leaf. */
+   static const size_t SCAN_BLOCK = 16;
+
+public:
+   /**
+    * Constructs an empty tree.
+    */
+   kd_tree_t()
+      : mLeafSize( 16 )
+   {}
+
+   /**
+    * Builds the tree over a copy of the given points.
+    *
+    * @param points    the points
+    * @param count     the number of points
+    * @param leafSize  the maximum number of points per leaf
+    */
+   void build( const vec<L, T>* points, size_t count, size_t leafSize = 16 )
+   {
+      beginBuild( points, count, leafSize );
+      buildNode( 0, 0, count, std::numeric_limits<size_t>::max(), NULL );
+      endBuild();
+   }
+
+   /**
+    * Starts a staged build: copies the points and sizes the split arrays.
+    */
+   void beginBuild( const vec<L, T>* points, size_t count, size_t leafSize = 16 )
+   {
+      mLeafSize = std::max( leafSize, size_t(1) );
+      mSource.assign( points, points + count );
+      mIndices.resize( count );
+      for (size_t i = 0; i < count; ++i)
+         mIndices[i] = static_cast<uint32_t>(i);
+
+      // Ranges halve at each level, the larger half rounding up
+      size_t nodes = 0;
+      for (size_t size = count, levelNodes = 1; size > mLeafSize; size = (size + 1) / 2, levelNodes *= 2)
+         nodes += levelNodes;
+      mSplitValues.assign( nodes, T(0) );
+      mSplitAxes.assign( nodes, 0 );
+   }
+
+   /**
+    * Splits the top levels of the tree, and gets the subtrees below them.
+    *
+    * @param levels  the number of levels to split, 2^levels subtrees at most
+    * @param tasks   receives the subtrees, to pass to buildSubtree
+    */
+   void splitTop( size_t levels, std::vector<kd_build_task_t>& tasks )
+   {
+      tasks.clear();
+      buildNode( 0, 0, mSource.size(), levels, &tasks );
+   }
+
+   /**
+    * Builds a subtree found by splitTop. Different subtrees may be built on
+    * different threads.
+    */
+   void buildSubtree( const kd_build_task_t& task )
+   {
+      buildNode( task.mNode, task.mBegin, task.mEnd, std::numeric_limits<size_t>::max(), NULL );
+   }
+
+   /**
+    * Finishes a staged build once all of the subtrees are built.
+    */
+   void endBuild()
+   {
+      for (length_t a = 0; a < L; ++a)
+      {
+         mCoords[a].resize( mIndices.size() );
+         for (size_t i = 0; i < mIndices.size(); ++i)
+            mCoords[a][i] = mSource[mIndices[i]][a];
+      }
+      std::vector< vec<L, T> >().swap( mSource );
+   }
+
+   /**
+    * Gets the number of points.
+    */
+   size_t size() const
+   {
+      return mIndices.size();
+   }
+
+   /**
+    * Gets the maximum number of points per leaf.
+    */
+   size_t getLeafSize() const
+   {
+      return mLeafSize;
+   }
+
+   /**
+    * Gets point i, in tree order.
+    */
+   vec<L, T> getPoint( size_t i ) const
+   {
+      vec<L, T> point;
+      for (length_t a = 0; a < L; ++a)
+         point[a] = mCoords[a][i];
+      return point;
+   }
+
+   /**
+    * Gets the index in the input array of point i, in tree order.
+    */
+   uint32_t getIndex( size_t i ) const
+   {
+      return mIndices[i];
+   }
+
+   /**
+    * Finds the point closest to query within a radius.
+    *
+    * @param query            the query point
+    * @param maxDistance2     the squared search radius, infinite by default
+    * @param nearestDistance2 receives the squared distance to the nearest point, if not NULL
+    *
+    * @return  the index in the input array of the nearest point, or std::numeric_limits<uint32_t>::max() if none is within the radius
+    */
+   uint32_t nearest( const vec<L, T>& query, T maxDistance2 = std::numeric_limits<T>::max(), T* nearestDistance2 = NULL ) const
+   {
+      const size_t found = findNearest( query, maxDistance2, nearestDistance2 );
+      return found < size() ? mIndices[found] : std::numeric_limits<uint32_t>::max();
+   }
+
+   /**
+    * Same as nearest, but returns the position of the point in tree order,
+    * or size() if none is within the radius.
+    */
+   size_t findNearest( const vec<L, T>& query, T maxDistance2 = std::numeric_limits<T>::max(), T* nearestDistance2 = NULL ) const
+   {
+      Nearest found( size(), maxDistance2 );
+      if (size() > 0)
+         searchNode( 0, 0, size(), query, found );
+      if (nearestDistance2)
+         *nearestDistance2 = found.mBestDistance2;
+      return found.mBest;
+   }
+
+   /**
+    * Finds the k points closest to query within a radius.
+    *
+    * @param query         the query point
+    * @param k             the number of neighbours to find
+    * @param indices       receives the input indices of the neighbours, nearest first, room for k
+    * @param distances2    receives the squared distances of the neighbours, room for k
+    * @param maxDistance2  the squared search radius, infinite by default
+    *
+    * @return  the number of neighbours found, k unless fewer points are within the radius
+    */
+   size_t knearest( const vec<L, T>& query, size_t k, uint32_t* indices, T* distances2,
+                    T maxDistance2 = std::numeric_limits<T>::max() ) const
+   {
+      KNearest found( k, indices, distances2, maxDistance2 );
+      if (size() > 0 && k > 0)
+         searchNode( 0, 0, size(), query, found );
+      for (size_t i = 0; i < found.mCount; ++i)
+         indices[i] = mIndices[indices[i]];
+      return found.mCount;
+   }
+
+   /**
+    * Finds all of the points within a radius of query, in no particular
+    * order, and appends them to the output arrays.
+    *
+    * @param query       the query point
+    * @param radius2     the squared radius, inclusive
+    * @param indices     receives the input indices of the points
+    * @param distances2  receives the squared distances of the points, if not NULL
+    *
+    * @return  the number of points found
+    */
+   size_t radiusSearch( const vec<L, T>& query, const T& radius2, std::vector<uint32_t>& indices,
+                        std::vector<T>* distances2 = NULL ) const
+   {
+      Radius found( radius2, indices, distances2 );
+      const size_t first = indices.size();
+      if (size() > 0)
+         searchNode( 0, 0, size(), query, found );
+      for (size_t i = first; i < indices.size(); ++i)
+         indices[i] = mIndices[indices[i]];
+      return indices.size() - first;
+   }
+
+   /**
+    * Runs knearest for the queries [first, first + count).
+    *
+    * The results of query q go to indices, distances2 and counts at q * k and
+    * q: calls on disjoint ranges write disjoint slots and may run on
+    * different threads.
+    */
+   void knearestBatch( const vec<L, T>* queries, size_t first, size_t count, size_t k,
+                       uint32_t* indices, T* distances2, size_t* counts,
+                       T maxDistance2 = std::numeric_limits<T>::max() ) const
+   {
+      for (size_t q = first; q < first + count; ++q)
+         counts[q] = knearest( queries[q], k, indices + q * k, distances2 + q * k, maxDistance2 );
+   }
+
+   /**
+    * Runs radiusSearch for the queries [first, first + count), appending the
+    * results to a per thread buffer; a cleared buffer then holds the results
+    * of query first + j as its query j.
+    */
+   void radiusSearchBatch( const vec<L, T>* queries, size_t first, size_t count, const T& radius2,
+                           kd_radius_result_t<T>& result ) const
+   {
+      if (result.mOffsets.empty())
+         result.mOffsets.push_back( 0 );
+      for (size_t q = first; q < first + count; ++q)
+      {
+         radiusSearch( queries[q], radius2, result.mIndices, &result.mDistances2 );
+         result.mOffsets.push_back( result.mIndices.size() );
+      }
+   }
+
+protected:
+   /** Best point so far of a nearest query. */
+   struct Nearest
+   {
+      Nearest( size_t none, T maxDistance2 )
+         : mBest( none ), mBestDistance2( maxDistance2 )
+      {}
+
+      T getBound() const
+      {
+         return mBestDistance2;
+      }
+
+      void add( size_t i, T distance2 )
+      {
+         if (distance2 < mBestDistance2)
+         {
+            mBestDistance2 = distance2;
+            mBest = i;
+         }
+      }
+
+      size_t mBest;
+      T mBestDistance2;
+   };
+
+   /** Sorted best points so far of a knearest query, kept in its output arrays. */
+   struct KNearest
+   {
+      KNearest( size_t k, uint32_t* indices, T* distances2, T maxDistance2 )
+         : mK( k ), mCount( 0 ), mIndices( indices ), mDistances2( distances2 ), mMaxDistance2( maxDistance2 )
+      {}
+
+      T getBound() const
+      {
+         return mCount < mK ? mMaxDistance2 : mDistances2[mCount - 1];
+      }
+
+      void add( size_t i, T distance2 )
+      {
+         if (!(distance2 < getBound()))
+            return;
+         size_t slot = mCount < mK ? mCount++ : mK - 1;
+         for (; slot > 0 && mDistances2[slot - 1] > distance2; --slot)
+         {
+            mIndices[slot] = mIndices[slot - 1];
+            mDistances2[slot] = mDistances2[slot - 1];
+         }
+         mIndices[slot] = static_cast<uint32_t>(i);
+         mDistances2[slot] = distance2;
+      }
+
+      size_t mK;
+      size_t mCount;
+      uint32_t* mIndices;
+      T* mDistances2;
+      T mMaxDistance2;
+   };
+
+   /** Points found so far of a radiusSearch query. */
+   struct Radius
+   {
+      Radius( T radius2, std::vector<uint32_t>& indices, std::vector<T>* distances2 )
+         : mRadius2( radius2 ), mIndices( &indices ), mDistances2( distances2 )
+      {}
+
+      T getBound() const
+      {
+         return mRadius2;
+      }
+
+      void add( size_t i, T distance2 )
+      {
+         if (distance2 > mRadius2)
+            return;
+         mIndices->push_back( static_cast<uint32_t>(i) );
+         if (mDistances2)
+            mDistances2->push_back( distance2 );
+      }
+
+      T mRadius2;
+      std::vector<uint32_t>* mIndices;
+      std::vector<T>* mDistances2;
+   };
+
+   /**
+    * Visits the points of a subtree that may be within the bound of the
+    * result, which gets the points with add.
+    */
+   template<class RESULT>
+   void searchNode( size_t node, size_t begin, size_t end, const vec<L, T>& query, RESULT& result ) const
+   {
+      if (end - begin <= mLeafSize || node >= mSplitAxes.size())
+      {
+         scanLeaf( begin, end, query, result );
+         return;
+      }
+
+      const size_t middle = begin + (end - begin) / 2;
+      const T offset = query[mSplitAxes[node]] - mSplitValues[node];
+      if (offset < T(0))
+      {
+         searchNode( 2 * node + 1, begin, middle, query, result );
+         if (offset * offset <= result.getBound())
+            searchNode( 2 * node + 2, middle, end, query, result );
+      }
+      else
+      {
+         searchNode( 2 * node + 2, middle, end, query, result );
+         if (offset * offset <= result.getBound())
+            searchNode( 2 * node + 1, begin, middle, query, result );
+      }
+   }
+
+   /** Computes the squared distances of a leaf, a block at a time, then hands them to the result. */
+   template<class RESULT>
+   void scanLeaf( size_t begin, size_t end, const vec<L, T>& query, RESULT& result ) const
+   {
+      T distances2[SCAN_BLOCK];
+      for (size_t base = begin; base < end; base += SCAN_BLOCK)
+      {
+         const size_t n = std::min( SCAN_BLOCK, end - base );
+         for (size_t i = 0; i < n; ++i)
+            distances2[i] = T(0);
+         for (length_t a = 0; a < L; ++a)
+         {
+            const T* coords = &mCoords[a][base];
+            const T q = query[a];
+            for (size_t i = 0; i < n; ++i)
+               distances2[i] += (coords[i] - q) * (coords[i] - q);
+         }
+         for (size_t i = 0; i < n; ++i)
+            result.add( base + i, distances2[i] );
+      }
+   }
+
+   /**
+    * Splits the range of a node and recurses, down to the leaves or, when
+    * tasks is given, down to the given depth where the subtrees become tasks.
+    */
+   void buildNode( size_t node, size_t begin, size_t end, size_t depth, std::vector<kd_build_task_t>* tasks )
+   {
+      if (end - begin <= mLeafSize || node >= mSplitAxes.size())
+         return;
+      if (tasks && depth == 0)
+      {
+         const kd_build_task_t task = { node, begin, end };
+         tasks->push_back( task );
+         return;
+      }
+
+      // Median split along the widest axis of the range
+      vec<L, T> lo = mSource[mIndices[begin]], hi = lo;
+      for (size_t i = begin + 1; i < end; ++i)
+      {
+         lo = min( lo, mSource[mIndices[i]] );
+         hi = max( hi, mSource[mIndices[i]] );
+      }
+      length_t axis = 0;
+      for (length_t a = 1; a < L; ++a)
+         if (hi[a] - lo[a] > hi[axis] - lo[axis])
+            axis = a;
+
+      const size_t middle = begin + (end - begin) / 2;
+      std::nth_element( mIndices.begin() + static_cast<std::ptrdiff_t>(begin),
+                        mIndices.begin() + static_cast<std::ptrdiff_t>(middle),
+                        mIndices.begin() + static_cast<std::ptrdiff_t>(end), AxisLess( mSource, axis ) );
+
+      mSplitAxes[node] = static_cast<uint8_t>(axis);
+      mSplitValues[node] = mSource[mIndices[middle]][axis];
+      buildNode( 2 * node + 1, begin, middle, depth - 1, tasks );
+      buildNode( 2 * node + 2, middle, end, depth - 1, tasks );
+   }
+
+   struct AxisLess
+   {
+      AxisLess( const std::vector< vec<L, T> >& points, length_t axis )
+         : mPoints( &points ), mAxis( axis )
+      {}
+
+      bool operator()( uint32_t a, uint32_t b ) const
+      {
+         return (*mPoints)[a][mAxis] < (*mPoints)[b][mAxis];
+      }
+
+      const std::vector< vec<L, T> >* mPoints;
+      length_t mAxis;
+   };
+
+protected:
+   size_t mLeafSize;
+
+   /** Coordinates of the points in tree order, one array per axis. */
+   std::vector<T> mCoords[L];
+   std::vector<uint32_t> mIndices;
+   std::vector<T> mSplitValues;
+   std::vector<uint8_t> mSplitAxes;
+
+   /** Input points, during a build. */
+   std::vector< vec<L, T> > mSource;
+};
+
+template<length_t L, class T>
+const size_t kd_tree_t<L, T>::SCAN_BLOCK;
+
+// --- helper types --- //
+typedef kd_tree_t<2, float>    kd_tree2f;
+typedef kd_tree_t<3, float>    kd_tree3f;
+typedef kd_tree_t<2, double>   kd_tree2d;
+typedef kd_tree_t<3, double>   kd_tree3d;
+
+}
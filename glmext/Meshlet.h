@@ -0,0 +1,373 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+#include "AABox.h"
+#include "Sphere.h"
+#include "Plane.h"
+#include "Frustum.h"
+
+namespace glm
+{
+
+/**
+ * Describes one meshlet, a small cluster of triangles rendered and culled as
+ * a unit. The meshlet uses mVertexCount entries of the meshlet vertex array
+ * starting at mVertexOffset, which hold indices into the mesh vertices, and
+ * mTriangleCount triangles of the meshlet triangle array starting at
+ * mTriangleOffset, each made of three local vertex indices.
+ *
+ * Meshlets, their vertex and triangle arrays and their bounds are plain flat
+ * arrays without pointers, so they can be written to a file as is and
+ * memory mapped back.
+ *
+ * @ingroup Types
+ */
+struct meshlet_t
+{
+   uint32_t mVertexOffset;
+   uint32_t mTriangleOffset;
+   uint32_t mVertexCount;
+   uint32_t mTriangleCount;
+};
+
+/**
+ * Culling bounds of a meshlet.
+ *
+ * The normal cone holds the normals of all the meshlet triangles: the meshlet
+ * is entirely back facing for a camera at pos when
+ * dot( normalize( mConeApex - pos ), mConeAxis ) >= mConeCutoff. Meshlets
+ * whose normals span a half space or more get a cutoff of 1 and are never
+ * considered back facing.
+ *
+ * @param T     the internal type used for the bounds
+ * @ingroup Types
+ */
+template<class T>
+struct meshlet_bounds_t
+{
+   typedef T DataType;
+
+   sphere_t<T> mSphere;
+   aabox_t<T> mBox;
+   vec<3, T> mConeApex;
+   vec<3, T> mConeAxis;
+   T mConeCutoff;
+};
+
+/**
+ * Flat storage of the meshlets of a mesh.
+ *
+ * @param T     the internal type used for the bounds
+ * @ingroup Types
+ */
+template<class T>
+class meshlet_set_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * The meshlets.
+    */
+   std::vector<meshlet_t> mMeshlets;
+
+   /**
+    * The bounds of each meshlet.
+    */
+   std::vector< meshlet_bounds_t<T> > mBounds;
+
+   /**
+    * The mesh vertex indices referenced by the meshlets.
+    */
+   std::vector<uint32_t> mVertices;
+
+   /**
+    * Three local vertex indices per meshlet triangle.
+    */
+   std::vector<uint8_t> mTriangles;
+};
+
+/**
+ * Computes the bounds of the given triangles. The sphere is the one of
+ * Ritter, "An Efficient Bounding Sphere", the normal cone the one of
+ * meshoptimizer's meshopt_computeClusterBounds.
+ *
+ * @param positions      the mesh vertices
+ * @param indices        three vertex indices per triangle
+ * @param triangleCount  the number of triangles
+ */
+template< class T >
+inline meshlet_bounds_t<T> computeMeshletBounds( const vec<3, T>* positions, const uint32_t* indices, size_t triangleCount )
+{
+   meshlet_bounds_t<T> result;
+
+   // Box and sphere
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+      result.mBox += positions[indices[i]];
+
+   vec<3, T> pmin[3], pmax[3];
+   for (int axis = 0; axis < 3; ++axis)
+      pmin[axis] = pmax[axis] = positions[indices[0]];
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+   {
+      const vec<3, T>& p = positions[indices[i]];
+      for (int axis = 0; axis < 3; ++axis)
+      {
+         if (p[axis] < pmin[axis][axis]) pmin[axis] = p;
+         if (p[axis] > pmax[axis][axis]) pmax[axis] = p;
+      }
+   }
+
+   int spread = 0;
+   for (int axis = 1; axis < 3; ++axis)
+      if (lensq( pmax[axis] - pmin[axis] ) > lensq( pmax[spread] - pmin[spread] ))
+         spread = axis;
+
+   vec<3, T> center = (pmin[spread] + pmax[spread]) * static_cast<T>(0.5);
+   T radius = length( pmax[spread] - pmin[spread] ) * static_cast<T>(0.5);
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+   {
+      const vec<3, T>& p = positions[indices[i]];
+      const T dist = length( p - center );
+      if (dist > radius)
+      {
+         const T grown = (radius + dist) * static_cast<T>(0.5);
+         center += (p - center) * ((grown - radius) / dist);
+         radius = grown;
+      }
+   }
+   result.mSphere.setCenter( center );
+   result.mSphere.setRadius( radius );
+
+   // Normal cone
+   std::vector< vec<3, T> > normals;
+   normals.reserve( triangleCount );
+   vec<3, T> axis( 0 );
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      const vec<3, T>& p0 = positions[indices[3 * t]];
+      const vec<3, T> n = cross( positions[indices[3 * t + 1]] - p0, positions[indices[3 * t + 2]] - p0 );
+      const T len = length( n );
+      if (len <= T(0))
+         continue;
+      normals.push_back( n / len );
+      axis += normals.back();
+   }
+
+   result.mConeApex = center;
+   result.mConeAxis = vec<3, T>( 0 );
+   result.mConeCutoff = T(1);
+   const T axisLength = length( axis );
+   if (normals.empty() || axisLength <= T(0))
+      return result;
+   axis /= axisLength;
+
+   T minDot = T(1);
+   for (size_t t = 0; t < normals.size(); ++t)
+      minDot = min( minDot, dot( normals[t], axis ) );
+   result.mConeAxis = axis;
+   if (minDot <= static_cast<T>(0.1))
+      return result;
+
+   // Move the apex back along the axis until every triangle plane is in front of it
+   T maxT = T(0);
+   size_t n = 0;
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      const vec<3, T>& p0 = positions[indices[3 * t]];
+      const vec<3, T> normal = cross( positions[indices[3 * t + 1]] - p0, positions[indices[3 * t + 2]] - p0 );
+      if (length( normal ) <= T(0))
+         continue;
+      const vec<3, T>& unit = normals[n++];
+      maxT = max( maxT, dot( center - p0, unit ) / dot( axis, unit ) );
+   }
+   result.mConeApex = center - axis * maxT;
+   result.mConeCutoff = sqrt( T(1) - minDot * minDot );
+   return result;
+}
+
+/**
+ * Splits an indexed triangle mesh into meshlets of at most maxVertices
+ * vertices and maxTriangles triangles.
+ *
+ * Meshlets grow greedily: the next triangle is the neighbor of the meshlet
+ * adding the fewest new vertices, ties going to the triangle closest to the
+ * meshlet center, then to the lowest triangle index. When the meshlet has no
+ * neighbor left the next meshlet starts at the first unused triangle. The
+ * result only depends on the input.
+ *
+ * @param positions      the mesh vertices
+ * @param vertexCount    the number of vertices
+ * @param indices        three vertex indices per triangle
+ * @param triangleCount  the number of triangles
+ * @param maxVertices    the vertex limit of a meshlet, at most 256
+ * @param maxTriangles   the triangle limit of a meshlet
+ * @param result         receives the meshlets and their bounds
+ */
+template< class T >
+inline void buildMeshlets( const vec<3, T>* positions, size_t vertexCount, const uint32_t* indices, size_t triangleCount,
+                           size_t maxVertices, size_t maxTriangles, meshlet_set_t<T>& result )
+{
+   const uint32_t none = std::numeric_limits<uint32_t>::max();
+   maxVertices = min( max( maxVertices, size_t(3) ), size_t(256) );
+   maxTriangles = max( maxTriangles, size_t(1) );
+
+   result.mMeshlets.clear();
+   result.mBounds.clear();
+   result.mVertices.clear();
+   result.mTriangles.clear();
+
+   // Triangles around each vertex, in compressed rows
+   std::vector<uint32_t> adjacencyOffsets( vertexCount + 1, 0 );
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+      ++adjacencyOffsets[indices[i] + 1];
+   for (size_t v = 0; v < vertexCount; ++v)
+      adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+   std::vector<uint32_t> adjacency( triangleCount * 3 );
+   {
+      std::vector<uint32_t> fill( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+      for (size_t i = 0; i < triangleCount * 3; ++i)
+         adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+   }
+
+   std::vector< vec<3, T> > centroids( triangleCount );
+   for (size_t t = 0; t < triangleCount; ++t)
+      centroids[t] = (positions[indices[3 * t]] + positions[indices[3 * t + 1]] + positions[indices[3 * t + 2]]) / T(3);
+
+   std::vector<uint8_t> used( triangleCount, 0 );
+   std::vector<uint32_t> localIndex( vertexCount, none );
+   std::vector<uint32_t> candidates;
+   std::vector<uint32_t> meshletIndices;
+   size_t nextSeed = 0;
+
+   for (;;)
+   {
+      while (nextSeed < triangleCount && used[nextSeed])
+         ++nextSeed;
+      if (nextSeed == triangleCount)
+         break;
+
+      meshlet_t meshlet;
+      meshlet.mVertexOffset = static_cast<uint32_t>(result.mVertices.size());
+      meshlet.mTriangleOffset = static_cast<uint32_t>(result.mTriangles.size() / 3);
+      meshlet.mVertexCount = 0;
+      meshlet.mTriangleCount = 0;
+      meshletIndices.clear();
+      candidates.clear();
+
+      vec<3, T> centroidSum( 0 );
+      uint32_t triangle = static_cast<uint32_t>(nextSeed);
+      while (triangle != none)
+      {
+         // Add the triangle
+         used[triangle] = 1;
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t v = indices[3 * triangle + k];
+            if (localIndex[v] == none)
+            {
+               localIndex[v] = meshlet.mVertexCount++;
+               result.mVertices.push_back( v );
+               candidates.insert( candidates.end(), adjacency.begin() + adjacencyOffsets[v], adjacency.begin() + adjacencyOffsets[v + 1] );
+            }
+            result.mTriangles.push_back( static_cast<uint8_t>(localIndex[v]) );
+            meshletIndices.push_back( v );
+         }
+         ++meshlet.mTriangleCount;
+         centroidSum += centroids[triangle];
+
+         if (meshlet.mTriangleCount == maxTriangles)
+            break;
+
+         // Pick the best neighbor that still fits
+         const vec<3, T> center = centroidSum / static_cast<T>(meshlet.mTriangleCount);
+         triangle = none;
+         int bestNew = 4;
+         T bestDistance = T(0);
+         size_t alive = 0;
+         for (size_t i = 0; i < candidates.size(); ++i)
+         {
+            const uint32_t t = candidates[i];
+            if (used[t])
+               continue;
+            candidates[alive++] = t;
+
+            int added = 0;
+            for (int k = 0; k < 3; ++k)
+               added += localIndex[indices[3 * t + k]] == none;
+            if (meshlet.mVertexCount + added > maxVertices)
+               continue;
+
+            const T distance = lensq( centroids[t] - center );
+            if (added < bestNew || (added == bestNew && (distance < bestDistance || (distance == bestDistance && t < triangle))))
+            {
+               triangle = t;
+               bestNew = added;
+               bestDistance = distance;
+            }
+         }
+         candidates.resize( alive );
+      }
+
+      for (uint32_t i = 0; i < meshlet.mVertexCount; ++i)
+         localIndex[result.mVertices[meshlet.mVertexOffset + i]] = none;
+
+      result.mMeshlets.push_back( meshlet );
+      result.mBounds.push_back( computeMeshletBounds( positions, &meshletIndices[0], meshlet.mTriangleCount ) );
+   }
+}
+
+/**
+ * Culls count meshlets against a view frustum and their normal cones, and
+ * writes the indices of the potentially visible ones to visible.
+ *
+ * The frustum planes face outwards, as built by frustum_t. Writes are done
+ * unconditionally and the output cursor advanced by the test result, so the
+ * loop has no data dependent branch.
+ *
+ * @param bounds          the bounds of each meshlet
+ * @param count           the number of meshlets
+ * @param frustum         the view frustum, in the space of the bounds
+ * @param cameraPosition  the position of the camera, in the space of the bounds
+ * @param visible         receives up to count meshlet indices
+ *
+ * @return  the number of visible meshlets
+ */
+template< class T >
+inline size_t cullMeshlets( const meshlet_bounds_t<T>* bounds, size_t count, const frustum_t<T>& frustum,
+                            const vec<3, T>& cameraPosition, uint32_t* visible )
+{
+   size_t result = 0;
+   for (size_t i = 0; i < count; ++i)
+   {
+      const meshlet_bounds_t<T>& b = bounds[i];
+      const vec<3, T>& center = b.mSphere.mCenter;
+      const T radius = b.mSphere.mRadius;
+
+      bool inside = true;
+      for (int p = 0; p < 6; ++p)
+         inside &= frustum.mPlanes[p].distanceTo( center ) <= radius;
+
+      const vec<3, T> view = b.mConeApex - cameraPosition;
+      const T viewLength = length( view );
+      const bool backFacing = b.mConeCutoff < T(1) && dot( view, b.mConeAxis ) >= b.mConeCutoff * viewLength;
+
+      visible[result] = static_cast<uint32_t>(i);
+      result += inside && !backFacing;
+   }
+   return result;
+}
+
+// --- helper types --- //
+typedef meshlet_bounds_t<float>   meshlet_boundsf;
+typedef meshlet_bounds_t<double>  meshlet_boundsd;
+typedef meshlet_set_t<float>      meshlet_setf;
+typedef meshlet_set_t<double>     meshlet_setd;
+
+}
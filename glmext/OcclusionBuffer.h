@@ -0,0 +1,463 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_projection.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+#include "AABox.h"
+#include "Plane.h"
+#include "Frustum.h"
+
+namespace glm
+{
+
+/**
+ * An occluder triangle after projection: window x and y, and depth in z.
+ */
+template<class T>
+struct occluder_triangle_t
+{
+   vec<3, T> mVertices[3];
+};
+
+/**
+ * Depth-only buffer for software occlusion culling, with a hierarchical
+ * depth (Hi-Z) pyramid.
+ *
+ * Depths follow the zero to one convention of projectZO: 0 at the near
+ * plane, 1 at the far plane, the buffer cleared to 1. Level 0 holds the
+ * nearest occluder depth per pixel; each texel of level l + 1 holds the
+ * farthest depth of the 2x2 texels below it, so a box whose nearest depth
+ * lies behind a texel covering its screen bounds is hidden.
+ *
+ * The screen is split in tiles of TILE_SIZE pixels. binOccluders sorts the
+ * occluder triangles into the tiles they overlap; each tile is then
+ * rasterized, along with its part of the lower pyramid levels, independently
+ * of the others by rasterizeOcclusionTile, so tiles may run on different
+ * threads. finishOcclusionBuffer builds the few levels above the tiles.
+ *
+ * @param T     the internal type used for the depths
+ * @ingroup Types
+ */
+template<class T>
+class occlusion_buffer_t
+{
+public:
+   typedef T DataType;
+
+   static const int TILE_SHIFT = 5;
+   static const int TILE_SIZE = 1 << TILE_SHIFT;
+
+public:
+   occlusion_buffer_t()
+      : mWidth( 0 ), mHeight( 0 )
+   {}
+
+   /**
+    * Resizes the buffer, clearing the occluders.
+    *
+    * @param width   the width in pixels
+    * @param height  the height in pixels
+    */
+   void resize( int width, int height )
+   {
+      mWidth = std::max( width, 1 );
+      mHeight = std::max( height, 1 );
+      int levels = 1;
+      while ((getLevelWidth( levels - 1 ) > 1) || (getLevelHeight( levels - 1 ) > 1))
+         ++levels;
+      mLevels.resize( static_cast<size_t>(levels) );
+      for (int l = 0; l < levels; ++l)
+         mLevels[static_cast<size_t>(l)].assign( static_cast<size_t>(getLevelWidth( l ) * getLevelHeight( l )), T(1) );
+      mBins.resize( static_cast<size_t>(getTileCountX() * getTileCountY()) );
+      clearOccluders();
+   }
+
+   /**
+    * Removes the binned occluders, to start a new frame.
+    */
+   void clearOccluders()
+   {
+      mTriangles.clear();
+      for (size_t i = 0; i < mBins.size(); ++i)
+         mBins[i].clear();
+   }
+
+   int getWidth() const
+   {
+      return mWidth;
+   }
+
+   int getHeight() const
+   {
+      return mHeight;
+   }
+
+   int getTileCountX() const
+   {
+      return (mWidth + TILE_SIZE - 1) >> TILE_SHIFT;
+   }
+
+   int getTileCountY() const
+   {
+      return (mHeight + TILE_SIZE - 1) >> TILE_SHIFT;
+   }
+
+   int getTileCount() const
+   {
+      return getTileCountX() * getTileCountY();
+   }
+
+   int getLevelCount() const
+   {
+      return static_cast<int>(mLevels.size());
+   }
+
+   int getLevelWidth( int level ) const
+   {
+      return std::max( (mWidth + (1 << level) - 1) >> level, 1 );
+   }
+
+   int getLevelHeight( int level ) const
+   {
+      return std::max( (mHeight + (1 << level) - 1) >> level, 1 );
+   }
+
+   /**
+    * Gets the depth of texel (x, y) of a level, row 0 at the bottom as for
+    * window coordinates.
+    */
+   T getDepth( int level, int x, int y ) const
+   {
+      return mLevels[static_cast<size_t>(level)][static_cast<size_t>(y * getLevelWidth( level ) + x)];
+   }
+
+public:
+   int mWidth;
+   int mHeight;
+
+   /** The Hi-Z pyramid, level 0 being the depth buffer. */
+   std::vector< std::vector<T> > mLevels;
+
+   /** Projected occluder triangles, and the indices of those overlapping each tile. */
+   std::vector< occluder_triangle_t<T> > mTriangles;
+   std::vector< std::vector<uint32_t> > mBins;
+};
+
+/**
+ * Clips, projects and bins occluder triangles into the tiles of an
+ * occlusion buffer.
+ *
+ * Triangles are clipped against the near plane in clip space, then mapped
+ * to window coordinates as projectZO does. Both windings are kept: occluders
+ * only need to cover the screen, not to face the camera.
+ *
+ * @param buffer          the occlusion buffer
+ * @param positions       the occluder vertex positions
+ * @param indices         three vertex indices per triangle
+ * @param triangleCount   the number of triangles
+ * @param projModel       the combined matrix proj * model, zero to one depth
+ */
+template< class T >
+inline void binOccluders( occlusion_buffer_t<T>& buffer, const vec<3, T>* positions, const uint32_t* indices,
+                          size_t triangleCount, const mat<4, 4, T>& projModel )
+{
+   const T width = static_cast<T>(buffer.mWidth);
+   const T height = static_cast<T>(buffer.mHeight);
+   const int tilesX = buffer.getTileCountX();
+   const int tilesY = buffer.getTileCountY();
+
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      vec<4, T> clip[3];
+      for (int k = 0; k < 3; ++k)
+         clip[k] = projModel * vec<4, T>( positions[indices[3 * t + k]], T(1) );
+
+      // Sutherland-Hodgman against the near plane z >= 0, at most 4 vertices
+      vec<4, T> polygon[4];
+      int count = 0;
+      for (int k = 0; k < 3; ++k)
+      {
+         const vec<4, T>& a = clip[k];
+         const vec<4, T>& b = clip[(k + 1) % 3];
+         if (a.z >= T(0))
+            polygon[count++] = a;
+         if ((a.z >= T(0)) != (b.z >= T(0)))
+            polygon[count++] = mix( a, b, a.z / (a.z - b.z) );
+      }
+      if (count < 3)
+         continue;
+
+      vec<3, T> window[4];
+      for (int k = 0; k < count; ++k)
+      {
+         const T w = max( polygon[k].w, std::numeric_limits<T>::min() );
+         window[k] = vec<3, T>( (polygon[k].x / w * T(0.5) + T(0.5)) * width,
+                                (polygon[k].y / w * T(0.5) + T(0.5)) * height,
+                                polygon[k].z / w );
+      }
+
+      for (int f = 1; f + 1 < count; ++f)
+      {
+         occluder_triangle_t<T> triangle;
+         triangle.mVertices[0] = window[0];
+         triangle.mVertices[1] = window[f];
+         triangle.mVertices[2] = window[f + 1];
+         const vec<3, T> lo = min( min( window[0], window[f] ), window[f + 1] );
+         const vec<3, T> hi = max( max( window[0], window[f] ), window[f + 1] );
+         if (hi.x < T(0) || hi.y < T(0) || lo.x >= width || lo.y >= height || lo.z >= T(1))
+            continue;
+
+         const int tx0 = static_cast<int>(max( lo.x, T(0) )) >> occlusion_buffer_t<T>::TILE_SHIFT;
+         const int ty0 = static_cast<int>(max( lo.y, T(0) )) >> occlusion_buffer_t<T>::TILE_SHIFT;
+         const int tx1 = std::min( static_cast<int>(min( hi.x, width - T(1) )) >> occlusion_buffer_t<T>::TILE_SHIFT, tilesX - 1 );
+         const int ty1 = std::min( static_cast<int>(min( hi.y, height - T(1) )) >> occlusion_buffer_t<T>::TILE_SHIFT, tilesY - 1 );
+         const uint32_t index = static_cast<uint32_t>(buffer.mTriangles.size());
+         buffer.mTriangles.push_back( triangle );
+         for (int ty = ty0; ty <= ty1; ++ty)
+            for (int tx = tx0; tx <= tx1; ++tx)
+               buffer.mBins[static_cast<size_t>(ty * tilesX + tx)].push_back( index );
+      }
+   }
+}
+
+/**
+ * Clears one tile of an occlusion buffer, rasterizes the occluders binned
+ * into it, and builds its part of the Hi-Z levels up to the tile size.
+ *
+ * Pixels are covered when their center is inside the triangle. Edge
+ * functions and depths are evaluated along each row by a branch free loop
+ * the compiler vectorizes.
+ *
+ * @param buffer  the occlusion buffer
+ * @param tile    the tile index, less than getTileCount()
+ */
+template< class T >
+inline void rasterizeOcclusionTile( occlusion_buffer_t<T>& buffer, int tile )
+{
+   const int size = occlusion_buffer_t<T>::TILE_SIZE;
+   const int width = buffer.mWidth;
+   const int x0 = (tile % buffer.getTileCountX()) * size;
+   const int y0 = (tile / buffer.getTileCountX()) * size;
+   const int x1 = std::min( x0 + size, buffer.mWidth );
+   const int y1 = std::min( y0 + size, buffer.mHeight );
+   T* depth = &buffer.mLevels[0][0];
+
+   for (int y = y0; y < y1; ++y)
+      std::fill( depth + y * width + x0, depth + y * width + x1, T(1) );
+
+   const std::vector<uint32_t>& bin = buffer.mBins[static_cast<size_t>(tile)];
+   for (size_t b = 0; b < bin.size(); ++b)
+   {
+      const occluder_triangle_t<T>& triangle = buffer.mTriangles[bin[b]];
+      vec<3, T> v0 = triangle.mVertices[0];
+      vec<3, T> v1 = triangle.mVertices[1];
+      vec<3, T> v2 = triangle.mVertices[2];
+      T area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+      if (area == T(0))
+         continue;
+      if (area < T(0))
+      {
+         std::swap( v1, v2 );
+         area = -area;
+      }
+
+      const vec<3, T> lo = min( min( v0, v1 ), v2 );
+      const vec<3, T> hi = max( max( v0, v1 ), v2 );
+      const int bx0 = std::max( x0, static_cast<int>(floor( lo.x )) );
+      const int by0 = std::max( y0, static_cast<int>(floor( lo.y )) );
+      const int bx1 = std::min( x1, static_cast<int>(ceil( hi.x )) + 1 );
+      const int by1 = std::min( y1, static_cast<int>(ceil( hi.y )) + 1 );
+      if (bx0 >= bx1 || by0 >= by1)
+         continue;
+
+      // Edge i is opposite vertex i: e(p) = a x + b y + c, positive inside
+      const vec<3, T> ea( v1.y - v2.y, v2.y - v0.y, v0.y - v1.y );
+      const vec<3, T> eb( v2.x - v1.x, v0.x - v2.x, v1.x - v0.x );
+      const vec<3, T> ec( v1.x * v2.y - v2.x * v1.y, v2.x * v0.y - v0.x * v2.y, v0.x * v1.y - v1.x * v0.y );
+
+      // Depth plane z = dzdx x + dzdy y + zc, from the barycentrics e / area
+      const T dzdx = (ea.x * v0.z + ea.y * v1.z + ea.z * v2.z) / area;
+      const T dzdy = (eb.x * v0.z + eb.y * v1.z + eb.z * v2.z) / area;
+      const T zc = (ec.x * v0.z + ec.y * v1.z + ec.z * v2.z) / area;
+
+      const int n = bx1 - bx0;
+      const T px = static_cast<T>(bx0) + T(0.5);
+      for (int y = by0; y < by1; ++y)
+      {
+         const T py = static_cast<T>(y) + T(0.5);
+         const T e0 = ea.x * px + eb.x * py + ec.x;
+         const T e1 = ea.y * px + eb.y * py + ec.y;
+         const T e2 = ea.z * px + eb.z * py + ec.z;
+         const T z = dzdx * px + dzdy * py + zc;
+         T* row = depth + y * width + bx0;
+         for (int i = 0; i < n; ++i)
+         {
+            const T fi = static_cast<T>(i);
+            const bool inside = (e0 + ea.x * fi >= T(0)) & (e1 + ea.y * fi >= T(0)) & (e2 + ea.z * fi >= T(0));
+            const T zi = z + dzdx * fi;
+            row[i] = inside && zi < row[i] ? zi : row[i];
+         }
+      }
+   }
+
+   // Farthest depth of the 2x2 texels below, within the tile
+   for (int l = 1; l <= occlusion_buffer_t<T>::TILE_SHIFT && l < buffer.getLevelCount(); ++l)
+   {
+      const int lw = buffer.getLevelWidth( l );
+      const int lh = buffer.getLevelHeight( l );
+      const int pw = buffer.getLevelWidth( l - 1 );
+      const int ph = buffer.getLevelHeight( l - 1 );
+      const T* below = &buffer.mLevels[static_cast<size_t>(l - 1)][0];
+      T* level = &buffer.mLevels[static_cast<size_t>(l)][0];
+      for (int y = y0 >> l; y < std::min( (y0 + size) >> l, lh ); ++y)
+         for (int x = x0 >> l; x < std::min( (x0 + size) >> l, lw ); ++x)
+         {
+            const int cx = std::min( 2 * x + 1, pw - 1 );
+            const int cy = std::min( 2 * y + 1, ph - 1 );
+            level[y * lw + x] = max( max( below[2 * y * pw + 2 * x], below[2 * y * pw + cx] ),
+                                     max( below[cy * pw + 2 * x], below[cy * pw + cx] ) );
+         }
+   }
+}
+
+/**
+ * Builds the Hi-Z levels above the tile size, once every tile is
+ * rasterized.
+ */
+template< class T >
+inline void finishOcclusionBuffer( occlusion_buffer_t<T>& buffer )
+{
+   for (int l = occlusion_buffer_t<T>::TILE_SHIFT + 1; l < buffer.getLevelCount(); ++l)
+   {
+      const int lw = buffer.getLevelWidth( l );
+      const int lh = buffer.getLevelHeight( l );
+      const int pw = buffer.getLevelWidth( l - 1 );
+      const int ph = buffer.getLevelHeight( l - 1 );
+      const T* below = &buffer.mLevels[static_cast<size_t>(l - 1)][0];
+      T* level = &buffer.mLevels[static_cast<size_t>(l)][0];
+      for (int y = 0; y < lh; ++y)
+         for (int x = 0; x < lw; ++x)
+         {
+            const int cx = std::min( 2 * x + 1, pw - 1 );
+            const int cy = std::min( 2 * y + 1, ph - 1 );
+            level[y * lw + x] = max( max( below[2 * y * pw + 2 * x], below[2 * y * pw + cx] ),
+                                     max( below[cy * pw + 2 * x], below[cy * pw + cx] ) );
+         }
+   }
+}
+
+/**
+ * Rasterizes all of the tiles then finishes the buffer, on the calling
+ * thread. To spread the work, call rasterizeOcclusionTile for each tile on
+ * any thread, then finishOcclusionBuffer.
+ */
+template< class T >
+inline void rasterizeOccluders( occlusion_buffer_t<T>& buffer )
+{
+   for (int tile = 0; tile < buffer.getTileCount(); ++tile)
+      rasterizeOcclusionTile( buffer, tile );
+   finishOcclusionBuffer( buffer );
+}
+
+/**
+ * Tests a box against an occlusion buffer.
+ *
+ * The corners are mapped with projectBatchZO; their screen bounds select the
+ * pyramid level where they span at most 2x2 texels, and the box is hidden
+ * when its nearest depth lies behind all of those texels. Boxes crossing
+ * the near plane are never hidden; boxes entirely off screen always are.
+ *
+ * @param buffer     the occlusion buffer, rasterized and finished
+ * @param box        the box, in the space of projModel
+ * @param projModel  the combined matrix proj * model used for the occluders
+ *
+ * @return  true when the box is hidden behind the occluders
+ */
+template< class T >
+inline bool isOccluded( const occlusion_buffer_t<T>& buffer, const aabox_t<T>& box, const mat<4, 4, T>& projModel )
+{
+   vec<3, T> corners[8];
+   getCorners( box, corners );
+   for (int k = 0; k < 8; ++k)
+   {
+      const vec<4, T> clip = projModel * vec<4, T>( corners[k], T(1) );
+      if (clip.z < T(0) || clip.w <= T(0))
+         return false;
+   }
+
+   const vec<4, T> viewport( T(0), T(0), static_cast<T>(buffer.mWidth), static_cast<T>(buffer.mHeight) );
+   projectBatchZO( corners, corners, 8, projModel, viewport );
+   vec<3, T> lo = corners[0], hi = corners[0];
+   for (int k = 1; k < 8; ++k)
+   {
+      lo = min( lo, corners[k] );
+      hi = max( hi, corners[k] );
+   }
+   if (hi.x < T(0) || hi.y < T(0) || lo.x >= viewport.z || lo.y >= viewport.w)
+      return true;
+
+   const int x0 = static_cast<int>(max( lo.x, T(0) ));
+   const int y0 = static_cast<int>(max( lo.y, T(0) ));
+   const int x1 = std::min( static_cast<int>(hi.x), buffer.mWidth - 1 );
+   const int y1 = std::min( static_cast<int>(hi.y), buffer.mHeight - 1 );
+   int level = 0;
+   while (level + 1 < buffer.getLevelCount() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+      ++level;
+
+   for (int y = y0 >> level; y <= y1 >> level; ++y)
+      for (int x = x0 >> level; x <= x1 >> level; ++x)
+         if (!(lo.z > buffer.getDepth( level, x, y )))
+            return false;
+   return true;
+}
+
+/**
+ * Culls the boxes [first, first + count) against a view frustum and an
+ * occlusion buffer, and writes the indices of the potentially visible ones
+ * to visible, from position 0.
+ *
+ * The buffer is only read, so calls on disjoint ranges with their own
+ * outputs may run on different threads.
+ *
+ * @param buffer     the occlusion buffer, rasterized and finished
+ * @param frustum    the view frustum of projModel, planes facing outwards as built by frustum_t
+ * @param projModel  the combined matrix proj * model used for the occluders
+ * @param boxes      the boxes
+ * @param first      the first box to test
+ * @param count      the number of boxes to test
+ * @param visible    receives up to count box indices
+ *
+ * @return  the number of visible boxes
+ */
+template< class T >
+inline size_t cullOccludees( const occlusion_buffer_t<T>& buffer, const frustum_t<T>& frustum, const mat<4, 4, T>& projModel,
+                             const aabox_t<T>* boxes, size_t first, size_t count, uint32_t* visible )
+{
+   size_t result = 0;
+   for (size_t i = first; i < first + count; ++i)
+   {
+      const aabox_t<T>& box = boxes[i];
+      const vec<3, T> center = (box.getMin() + box.getMax()) * T(0.5);
+      const vec<3, T> half = (box.getMax() - box.getMin()) * T(0.5);
+
+      bool inside = true;
+      for (int p = 0; p < 6 && inside; ++p)
+      {
+         const vec<3, T>& n = frustum.mPlanes[p].getNormal();
+         inside = frustum.mPlanes[p].distanceTo( center ) <= dot( abs( n ), half );
+      }
+      if (inside && !isOccluded( buffer, box, projModel ))
+         visible[result++] = static_cast<uint32_t>(i);
+   }
+   return result;
+}
+
+// --- helper types --- //
+typedef occlusion_buffer_t<float>    occlusion_bufferf;
+typedef occlusion_buffer_t<double>   occlusion_bufferd;
+
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/noise.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace glm
+{
+
+/**
+ * Particle storage in structure of arrays layout.
+ *
+ * Positions and velocities are kept as one array per component, so the
+ * integration loops run on plain arrays of T that the compiler vectorizes.
+ * Colors, only copied around by the simulation, stay vec4s. A particle dies
+ * when its age reaches its lifetime; compactParticles then removes it.
+ *
+ * @param T     the internal type used for the particle state
+ * @ingroup Types
+ */
+template<class T>
+class particle_system_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Gets the number of particles, dead ones included until the next
+    * compaction.
+    */
+   size_t size() const
+   {
+      return mAges.size();
+   }
+
+   /**
+    * Preallocates storage for the given number of particles.
+    */
+   void reserve( size_t count )
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         mPositions[c].reserve( count );
+         mVelocities[c].reserve( count );
+      }
+      mColors.reserve( count );
+      mAges.reserve( count );
+      mLifetimes.reserve( count );
+   }
+
+   /**
+    * Removes all particles, keeping the storage.
+    */
+   void clear()
+   {
+      resize( 0 );
+   }
+
+   /**
+    * Adds a particle of age 0.
+    *
+    * @param position  the initial position
+    * @param velocity  the initial velocity
+    * @param color     the color
+    * @param lifetime  the age at which the particle dies
+    */
+   void emit( const vec<3, T>& position, const vec<3, T>& velocity, const vec<4, T>& color, const T& lifetime )
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         mPositions[c].push_back( position[c] );
+         mVelocities[c].push_back( velocity[c] );
+      }
+      mColors.push_back( color );
+      mAges.push_back( T(0) );
+      mLifetimes.push_back( lifetime );
+   }
+
+   /**
+    * Gets the position of particle i.
+    */
+   vec<3, T> getPosition( size_t i ) const
+   {
+      return vec<3, T>( mPositions[0][i], mPositions[1][i], mPositions[2][i] );
+   }
+
+   /**
+    * Gets the velocity of particle i.
+    */
+   vec<3, T> getVelocity( size_t i ) const
+   {
+      return vec<3, T>( mVelocities[0][i], mVelocities[1][i], mVelocities[2][i] );
+   }
+
+   /**
+    * Resizes all of the channels to count particles.
+    */
+   void resize( size_t count )
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         mPositions[c].resize( count );
+         mVelocities[c].resize( count );
+      }
+      mColors.resize( count );
+      mAges.resize( count );
+      mLifetimes.resize( count );
+   }
+
+public:
+   /** Position and velocity components, x, y and z arrays. */
+   std::vector<T> mPositions[3];
+   std::vector<T> mVelocities[3];
+
+   std::vector< vec<4, T> > mColors;
+   std::vector<T> mAges;
+   std::vector<T> mLifetimes;
+};
+
+/**
+ * Forces applied by updateParticles.
+ *
+ * The curl noise is the curl of a vector potential made of three
+ * glm::simplex fields (Bridson et al., "Curl-Noise for Procedural Fluid
+ * Flow"): a divergence free turbulence that swirls particles around
+ * without making them bunch up. The field scrolls through the noise at
+ * mCurlSpeed, animated by mTime.
+ */
+template<class T>
+struct particle_forces_t
+{
+   particle_forces_t()
+      : mGravity( 0 ), mDrag( 0 ), mCurlStrength( 0 ), mCurlFrequency( 1 ), mCurlSpeed( 0 ), mTime( 0 )
+   {}
+
+   vec<3, T> mGravity;
+
+   /** Linear drag coefficient: velocities decay as exp( -mDrag * t ). */
+   T mDrag;
+
+   T mCurlStrength;
+   T mCurlFrequency;
+   T mCurlSpeed;
+   T mTime;
+};
+
+/**
+ * Curl of the simplex noise vector potential at a point, see
+ * particle_forces_t. The partial derivatives use central differences of
+ * the 3D glm::simplex, cheaper than the 4D one.
+ */
+template< class T >
+inline vec<3, T> curlNoise( const vec<3, T>& point, const T& time )
+{
+   const T h = static_cast<T>(1e-2);
+   // Decorrelates the potential components; time scrolls each of them along its own direction
+   const vec<3, T> offsets[3] = { vec<3, T>( 0 ), vec<3, T>( T(31.416), T(-47.853), T(12.793) ), vec<3, T>( T(-71.179), T(23.911), T(-56.234) ) };
+   const vec<3, T> drifts[3] = { vec<3, T>( T(0.6), T(0.8), T(0) ), vec<3, T>( T(0), T(0.6), T(0.8) ), vec<3, T>( T(0.8), T(0), T(0.6) ) };
+
+   // d[c][axis]: derivative of potential component c along axis
+   T d[3][3];
+   for (int c = 0; c < 3; ++c)
+   {
+      const vec<3, T> p = point + offsets[c] + drifts[c] * time;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+         vec<3, T> step( 0 );
+         step[axis] = h;
+         d[c][axis] = (simplex( p + step ) - simplex( p - step )) / (T(2) * h);
+      }
+   }
+   return vec<3, T>( d[2][1] - d[1][2], d[0][2] - d[2][0], d[1][0] - d[0][1] );
+}
+
+/**
+ * Advances the particles [first, first + count) by one semi-implicit Euler
+ * step: the forces update the velocities, the new velocities the positions,
+ * and the ages grow by dt.
+ *
+ * Particles are processed in blocks of 16: the curl noise, when enabled, is
+ * evaluated per particle into a block of accelerations, then the
+ * integration runs as branch free loops over the component arrays. Calls on
+ * disjoint ranges touch disjoint particles and may run on different
+ * threads.
+ *
+ * @param particles  the particles
+ * @param first      the first particle to update
+ * @param count      the number of particles to update
+ * @param forces     the forces
+ * @param dt         the time step
+ */
+template< class T >
+inline void updateParticles( particle_system_t<T>& particles, size_t first, size_t count,
+                             const particle_forces_t<T>& forces, const T& dt )
+{
+   const size_t blockSize = 16;
+   const size_t last = std::min( first + count, particles.size() );
+   const T damping = exp( -forces.mDrag * dt );
+   const bool curl = forces.mCurlStrength != T(0);
+   const T noiseTime = forces.mTime * forces.mCurlSpeed;
+
+   T* px = particles.mPositions[0].empty() ? NULL : &particles.mPositions[0][0];
+   T* py = particles.mPositions[1].empty() ? NULL : &particles.mPositions[1][0];
+   T* pz = particles.mPositions[2].empty() ? NULL : &particles.mPositions[2][0];
+   T* vx = particles.mVelocities[0].empty() ? NULL : &particles.mVelocities[0][0];
+   T* vy = particles.mVelocities[1].empty() ? NULL : &particles.mVelocities[1][0];
+   T* vz = particles.mVelocities[2].empty() ? NULL : &particles.mVelocities[2][0];
+   T* ages = particles.mAges.empty() ? NULL : &particles.mAges[0];
+
+   T ax[blockSize], ay[blockSize], az[blockSize];
+   for (size_t base = first; base < last; base += blockSize)
+   {
+      const size_t n = std::min( blockSize, last - base );
+      for (size_t i = 0; i < n; ++i)
+      {
+         ax[i] = forces.mGravity.x;
+         ay[i] = forces.mGravity.y;
+         az[i] = forces.mGravity.z;
+      }
+      if (curl)
+         for (size_t i = 0; i < n; ++i)
+         {
+            const vec<3, T> p( px[base + i], py[base + i], pz[base + i] );
+            const vec<3, T> a = curlNoise( p * forces.mCurlFrequency, noiseTime ) * forces.mCurlStrength;
+            ax[i] += a.x;
+            ay[i] += a.y;
+            az[i] += a.z;
+         }
+
+      T* bx = px + base;
+      T* by = py + base;
+      T* bz = pz + base;
+      T* wx = vx + base;
+      T* wy = vy + base;
+      T* wz = vz + base;
+      T* age = ages + base;
+      for (size_t i = 0; i < n; ++i)
+      {
+         wx[i] = (wx[i] + ax[i] * dt) * damping;
+         wy[i] = (wy[i] + ay[i] * dt) * damping;
+         wz[i] = (wz[i] + az[i] * dt) * damping;
+         bx[i] += wx[i] * dt;
+         by[i] += wy[i] * dt;
+         bz[i] += wz[i] * dt;
+         age[i] += dt;
+      }
+   }
+}
+
+/**
+ * Counts the live particles of [first, first + count).
+ */
+template< class T >
+inline size_t countLiveParticles( const particle_system_t<T>& particles, size_t first, size_t count )
+{
+   size_t live = 0;
+   const size_t last = std::min( first + count, particles.size() );
+   for (size_t i = first; i < last; ++i)
+      live += particles.mAges[i] < particles.mLifetimes[i] ? 1 : 0;
+   return live;
+}
+
+/**
+ * Removes the dead particles, keeping the order of the live ones, and
+ * returns the number of particles left.
+ *
+ * The compaction is branch free: every particle is written at the output
+ * cursor, which only advances past live ones, so the loop does not
+ * mispredict on random deaths.
+ */
+template< class T >
+inline size_t compactParticles( particle_system_t<T>& particles )
+{
+   const size_t count = particles.size();
+   size_t written = 0;
+   for (size_t i = 0; i < count; ++i)
+   {
+      const size_t live = particles.mAges[i] < particles.mLifetimes[i] ? 1 : 0;
+      for (int c = 0; c < 3; ++c)
+      {
+         particles.mPositions[c][written] = particles.mPositions[c][i];
+         particles.mVelocities[c][written] = particles.mVelocities[c][i];
+      }
+      particles.mColors[written] = particles.mColors[i];
+      particles.mAges[written] = particles.mAges[i];
+      particles.mLifetimes[written] = particles.mLifetimes[i];
+      written += live;
+   }
+   particles.resize( written );
+   return written;
+}
+
+/**
+ * Copies the live particles of [first, first + count) to destination,
+ * starting at particle offset, and returns the number copied.
+ *
+ * This is the parallel form of compactParticles: count the live particles
+ * of each chunk with countLiveParticles, resize destination to the total,
+ * then copy each chunk at the prefix sum of the counts before it. The
+ * chunks write disjoint ranges and may run on different threads.
+ */
+template< class T >
+inline size_t compactParticleRange( const particle_system_t<T>& source, size_t first, size_t count,
+                                    particle_system_t<T>& destination, size_t offset )
+{
+   const size_t last = std::min( first + count, source.size() );
+   size_t written = offset;
+   for (size_t i = first; i < last; ++i)
+   {
+      if (!(source.mAges[i] < source.mLifetimes[i]))
+         continue;
+      for (int c = 0; c < 3; ++c)
+      {
+         destination.mPositions[c][written] = source.mPositions[c][i];
+         destination.mVelocities[c][written] = source.mVelocities[c][i];
+      }
+      destination.mColors[written] = source.mColors[i];
+      destination.mAges[written] = source.mAges[i];
+      destination.mLifetimes[written] = source.mLifetimes[i];
+      ++written;
+   }
+   return written - offset;
+}
+
+// --- helper types --- //
+typedef particle_system_t<float>    particle_systemf;
+typedef particle_system_t<double>   particle_systemd;
+typedef particle_forces_t<float>    particle_forcesf;
+typedef particle_forces_t<double>   particle_forcesd;
+
+}
@@ -0,0 +1,1453 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "AABox2.h"
+#include "Predicates.h"
+
+namespace glm
+{
+
+/**
+ * A 2D polygon as a set of closed rings in one flat point array, filled by
+ * the even-odd rule: outer rings, holes, and islands in holes.
+ *
+ * Ring r is mPoints[mRingOffsets[r] .. mRingOffsets[r + 1]), the closing
+ * edge being implicit, and mRingBounds[r] is its box. Rings may touch at
+ * vertices but must not cross each other or themselves.
+ *
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<class T>
+struct polygon_t
+{
+   typedef T DataType;
+
+   void clear()
+   {
+      mPoints.clear();
+      mRingOffsets.assign( 1, 0 );
+      mRingBounds.clear();
+      mBounds.setNull();
+   }
+
+   /**
+    * Appends a ring of count points, in any orientation.
+    */
+   void addRing( const vec<2, T>* points, size_t count )
+   {
+      if (mRingOffsets.empty())
+         mRingOffsets.push_back( 0 );
+      aabox2_t<T> bounds;
+      for (size_t i = 0; i < count; ++i)
+      {
+         mPoints.push_back( points[i] );
+         bounds.extend( points[i] );
+      }
+      mRingOffsets.push_back( mPoints.size() );
+      mRingBounds.push_back( bounds );
+      mBounds.extend( bounds );
+   }
+
+   size_t getRingCount() const
+   {
+      return mRingOffsets.empty() ? 0 : mRingOffsets.size() - 1;
+   }
+
+   size_t getRingSize( size_t ring ) const
+   {
+      return mRingOffsets[ring + 1] - mRingOffsets[ring];
+   }
+
+   /** The index of the point after point i, within its ring r. */
+   size_t nextInRing( size_t ring, size_t i ) const
+   {
+      return i + 1 == mRingOffsets[ring + 1] ? mRingOffsets[ring] : i + 1;
+   }
+
+   std::vector< vec<2, T> > mPoints;
+   std::vector<size_t> mRingOffsets;
+   std::vector< aabox2_t<T> > mRingBounds;
+   aabox2_t<T> mBounds;
+};
+
+/**
+ * Operations of polygon_clipper_t.
+ */
+enum PolygonBoolean
+{
+   POLYGON_UNION,
+   POLYGON_INTERSECTION,
+   POLYGON_DIFFERENCE
+};
+
+/**
+ * Twice the signed area of a ring, positive when counter clockwise.
+ */
+template< class T >
+inline T ringArea2( const polygon_t<T>& polygon, size_t ring )
+{
+   T area = 0;
+   for (size_t i = polygon.mRingOffsets[ring]; i < polygon.mRingOffsets[ring + 1]; ++i)
+   {
+      const vec<2, T>& a = polygon.mPoints[i];
+      const vec<2, T>& b = polygon.mPoints[polygon.nextInRing( ring, i )];
+      area += a.x * b.y - a.y * b.x;
+   }
+   return area;
+}
+
+/**
+ * Point location in a polygon_t. The ring boxes are bucketed into a uniform
+ * grid so that a query only visits the rings around it, and each ring's
+ * edges into horizontal bands so that it only crosses the edges of one band.
+ *
+ * The polygon must outlive the index and not change after build.
+ *
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<class T>
+class polygon_index_t
+{
+public:
+   typedef T DataType;
+
+   static const size_t EDGES_PER_BAND = 4;
+
+public:
+   polygon_index_t()
+      : mPolygon( NULL )
+      , mGridSize( 0 )
+   {}
+
+   void build( const polygon_t<T>& polygon )
+   {
+      mPolygon = &polygon;
+      const size_t rings = polygon.getRingCount();
+      mRingBands.assign( 1, 0 );
+      mBandScales.resize( rings );
+      mBandOffsets.assign( 1, 0 );
+      mBandEdges.clear();
+      buildGrid();
+      for (size_t r = 0; r < rings; ++r)
+      {
+         // About EDGES_PER_BAND edges per band, fewer bands when the edges span many
+         const size_t edges = polygon.getRingSize( r );
+         const T height = polygon.mRingBounds[r].mMax.y - polygon.mRingBounds[r].mMin.y;
+         T span = 0;
+         for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1]; ++i)
+            span += std::abs( polygon.mPoints[polygon.nextInRing( r, i )].y - polygon.mPoints[i].y );
+         size_t bands = std::max<size_t>( 1, edges / EDGES_PER_BAND );
+         if (span > T(0))
+            bands = std::max<size_t>( 1, std::min( bands, static_cast<size_t>(T(EDGES_PER_BAND * edges) * height / span) ) );
+         mBandScales[r] = height > T(0) ? static_cast<T>(bands) / height : T(0);
+         const size_t first = mBandOffsets.size() - 1;
+         mRingBands.push_back( first + bands );
+
+         // Counts, then scatters the edges into the bands they span
+         mBandOffsets.resize( first + bands + 1, 0 );
+         for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1]; ++i)
+         {
+            size_t lo, hi;
+            edgeBands( r, i, lo, hi );
+            for (size_t b = lo; b <= hi; ++b)
+               ++mBandOffsets[first + b + 1];
+         }
+         for (size_t b = first; b < first + bands; ++b)
+            mBandOffsets[b + 1] += mBandOffsets[b];
+         mBandEdges.resize( mBandOffsets[first + bands] );
+         std::vector<size_t> cursor( mBandOffsets.begin() + static_cast<std::ptrdiff_t>(first), mBandOffsets.end() - 1 );
+         for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1]; ++i)
+         {
+            size_t lo, hi;
+            edgeBands( r, i, lo, hi );
+            for (size_t b = lo; b <= hi; ++b)
+               mBandEdges[cursor[b]++] = static_cast<uint32_t>(i);
+         }
+      }
+   }
+
+   /**
+    * Locates a point against one ring.
+    *
+    * @return  1 inside, 0 outside, -1 on the boundary
+    */
+   int locateInRing( size_t ring, const vec<2, T>& p ) const
+   {
+      const polygon_t<T>& polygon = *mPolygon;
+      if (!polygon.mRingBounds[ring].contains( p ))
+         return 0;
+      const size_t band = mRingBands[ring] + bandOf( ring, p.y );
+      bool inside = false;
+      for (size_t k = mBandOffsets[band]; k < mBandOffsets[band + 1]; ++k)
+      {
+         const size_t i = mBandEdges[k];
+         const vec<2, T>& a = polygon.mPoints[i];
+         const vec<2, T>& b = polygon.mPoints[polygon.nextInRing( ring, i )];
+         if ((a.y > p.y) != (b.y > p.y))
+         {
+            const int o = predicateSign( orient2d( a, b, p ) );
+            if (o == 0)
+               return -1;
+            if ((o > 0) == (b.y > a.y))
+               inside = !inside;
+         }
+         else if ((a.y == p.y || b.y == p.y) && orient2d( a, b, p ) == T(0)
+                  && p.x >= glm::min( a.x, b.x ) && p.x <= glm::max( a.x, b.x ))
+            return -1;
+      }
+      return inside ? 1 : 0;
+   }
+
+   /**
+    * Locates a point against the polygon, by the even-odd rule.
+    *
+    * @return  1 inside, 0 outside, -1 on the boundary
+    */
+   int locate( const vec<2, T>& p ) const
+   {
+      if (!mPolygon->mBounds.contains( p ))
+         return 0;
+      int inside = 0;
+      const size_t cell = cellOf( p );
+      for (size_t k = mCellOffsets[cell]; k < mCellOffsets[cell + 1]; ++k)
+      {
+         const int location = locateInRing( mCellRings[k], p );
+         if (location < 0)
+            return -1;
+         inside ^= location;
+      }
+      return inside;
+   }
+
+   /**
+    * Gets the nesting depth of each ring, even for outer rings and odd for
+    * holes, and the ring directly containing each, or the ring count when none.
+    */
+   void computeNesting( std::vector<uint32_t>& depths, std::vector<size_t>& parents ) const
+   {
+      const polygon_t<T>& polygon = *mPolygon;
+      const size_t rings = polygon.getRingCount();
+      depths.assign( rings, 0 );
+      parents.assign( rings, rings );
+      std::vector<T> areas( rings );
+      for (size_t r = 0; r < rings; ++r)
+         areas[r] = std::abs( ringArea2( polygon, r ) );
+      for (size_t r = 0; r < rings; ++r)
+      {
+         const aabox2_t<T>& bounds = polygon.mRingBounds[r];
+         const size_t cell = cellOf( bounds.mMin );
+         for (size_t k = mCellOffsets[cell]; k < mCellOffsets[cell + 1]; ++k)
+         {
+            const size_t s = mCellRings[k];
+            const aabox2_t<T>& other = polygon.mRingBounds[s];
+            if (s == r || areas[s] < areas[r] || !other.contains( bounds.mMin ) || !other.contains( bounds.mMax ))
+               continue;
+
+            // Rings may touch: uses the first vertex of r off the boundary of s
+            int location = -1;
+            for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1] && location < 0; ++i)
+               location = locateInRing( s, polygon.mPoints[i] );
+            if (location != 1)
+               continue;
+            ++depths[r];
+            if (parents[r] == rings || areas[s] < areas[parents[r]])
+               parents[r] = s;
+         }
+      }
+   }
+
+protected:
+   void buildGrid()
+   {
+      const polygon_t<T>& polygon = *mPolygon;
+      const size_t rings = polygon.getRingCount();
+      mGridSize = std::max<size_t>( 1, static_cast<size_t>(std::sqrt( static_cast<double>(rings) )) );
+      const vec<2, T> extent = polygon.mBounds.isNull() ? vec<2, T>( 0 ) : polygon.mBounds.extents();
+      for (int a = 0; a < 2; ++a)
+         mGridScale[a] = extent[a] > T(0) ? static_cast<T>(mGridSize) / extent[a] : T(0);
+
+      mCellOffsets.assign( mGridSize * mGridSize + 1, 0 );
+      for (int pass = 0; pass < 2; ++pass)
+      {
+         if (pass == 1)
+         {
+            for (size_t c = 0; c < mGridSize * mGridSize; ++c)
+               mCellOffsets[c + 1] += mCellOffsets[c];
+            mCellRings.resize( mCellOffsets.back() );
+         }
+         std::vector<size_t> cursor( mCellOffsets.begin(), mCellOffsets.end() - 1 );
+         for (size_t r = 0; r < rings; ++r)
+         {
+            if (polygon.mRingBounds[r].isNull())
+               continue;
+            size_t lo[2], hi[2];
+            for (int a = 0; a < 2; ++a)
+            {
+               lo[a] = cellCoordinate( a, polygon.mRingBounds[r].mMin[a] );
+               hi[a] = cellCoordinate( a, polygon.mRingBounds[r].mMax[a] );
+            }
+            for (size_t y = lo[1]; y <= hi[1]; ++y)
+               for (size_t x = lo[0]; x <= hi[0]; ++x)
+               {
+                  if (pass == 0)
+                     ++mCellOffsets[y * mGridSize + x + 1];
+                  else
+                     mCellRings[cursor[y * mGridSize + x]++] = static_cast<uint32_t>(r);
+               }
+         }
+      }
+   }
+
+   size_t cellCoordinate( int axis, const T& value ) const
+   {
+      const T offset = (value - mPolygon->mBounds.mMin[axis]) * mGridScale[axis];
+      if (!(offset > T(0)))
+         return 0;
+      return std::min( static_cast<size_t>(offset), mGridSize - 1 );
+   }
+
+   size_t cellOf( const vec<2, T>& p ) const
+   {
+      return cellCoordinate( 1, p.y ) * mGridSize + cellCoordinate( 0, p.x );
+   }
+
+   size_t bandOf( size_t ring, const T& y ) const
+   {
+      const size_t bands = mRingBands[ring + 1] - mRingBands[ring];
+      const T offset = (y - mPolygon->mRingBounds[ring].mMin.y) * mBandScales[ring];
+      if (!(offset > T(0)))
+         return 0;
+      return std::min( static_cast<size_t>(offset), bands - 1 );
+   }
+
+   void edgeBands( size_t ring, size_t i, size_t& lo, size_t& hi ) const
+   {
+      const T y0 = mPolygon->mPoints[i].y, y1 = mPolygon->mPoints[mPolygon->nextInRing( ring, i )].y;
+      lo = bandOf( ring, glm::min( y0, y1 ) );
+      hi = bandOf( ring, glm::max( y0, y1 ) );
+   }
+
+protected:
+   const polygon_t<T>* mPolygon;
+
+   /** Per grid cell, its first entry in mCellRings, and the sentinel; entries are rings whose box meets the cell. */
+   size_t mGridSize;
+   T mGridScale[2];
+   std::vector<size_t> mCellOffsets;
+   std::vector<uint32_t> mCellRings;
+
+   /** Per ring, its first band, and the sentinel. */
+   std::vector<size_t> mRingBands;
+   std::vector<T> mBandScales;
+
+   /** Per band, its first entry in mBandEdges, and the sentinel; entries are edge start points. */
+   std::vector<size_t> mBandOffsets;
+   std::vector<uint32_t> mBandEdges;
+};
+
+template<class T>
+const size_t polygon_index_t<T>::EDGES_PER_BAND;
+
+/**
+ * Ear clipping triangulation of polygons with holes, after the earcut
+ * library: holes are bridged into their outer ring, ears are clipped with a
+ * z-order hash of the vertices on large rings, and rings that get stuck are
+ * cured of local self-intersections, then split along a valid diagonal.
+ * Orientation tests use the exact orient2d predicate.
+ *
+ * Keep one per thread and reuse it: the scratch memory is kept.
+ *
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<class T>
+class ear_clipper_t
+{
+public:
+   typedef T DataType;
+
+   /** Rings with more vertices than this are clipped with the z-order hash. */
+   static const size_t HASH_THRESHOLD = 80;
+
+public:
+   /**
+    * Appends the triangles of a polygon to indices, three indices into
+    * polygon.mPoints each, in counter clockwise order.
+    *
+    * @return  the number of triangles
+    */
+   size_t triangulate( const polygon_t<T>& polygon, std::vector<uint32_t>& indices )
+   {
+      const size_t before = indices.size();
+      const size_t rings = polygon.getRingCount();
+      mPolygon = &polygon;
+      if (rings > 1)
+      {
+         mIndex.build( polygon );
+         mIndex.computeNesting( mDepths, mParents );
+      }
+      else
+      {
+         mDepths.assign( rings, 0 );
+         mParents.assign( rings, rings );
+      }
+
+      for (size_t r = 0; r < rings; ++r)
+      {
+         if (mDepths[r] & 1)
+            continue;
+         mNodes.clear();
+         mHoles.clear();
+         uint32_t outer = linkRing( r, true );
+         if (outer == NIL || next( outer ) == prev( outer ))
+            continue;
+         for (size_t h = 0; h < rings; ++h)
+         {
+            if (mParents[h] != r || !(mDepths[h] & 1))
+               continue;
+            const uint32_t list = linkRing( h, false );
+            if (list == NIL)
+               continue;
+            if (list == next( list ))
+               mNodes[list].mSteiner = true;
+            mHoles.push_back( leftmost( list ) );
+         }
+         if (!mHoles.empty())
+            outer = eliminateHoles( outer );
+
+         mInvSize = T(0);
+         if (mNodes.size() > HASH_THRESHOLD)
+         {
+            const aabox2_t<T>& bounds = polygon.mRingBounds[r];
+            const T size = glm::max( bounds.mMax.x - bounds.mMin.x, bounds.mMax.y - bounds.mMin.y );
+            mMin = bounds.mMin;
+            mInvSize = size > T(0) ? T(32767) / size : T(0);
+         }
+         earcutLinked( outer, indices, 0 );
+      }
+      return (indices.size() - before) / 3;
+   }
+
+protected:
+   static const uint32_t NIL = 0xffffffff;
+
+   struct Node
+   {
+      uint32_t mIndex;
+      vec<2, T> mPoint;
+      uint32_t mPrev, mNext;
+      uint32_t mPrevZ, mNextZ;
+      uint32_t mZ;
+      bool mSteiner;
+   };
+
+   uint32_t prev( uint32_t n ) const { return mNodes[n].mPrev; }
+   uint32_t next( uint32_t n ) const { return mNodes[n].mNext; }
+   const vec<2, T>& point( uint32_t n ) const { return mNodes[n].mPoint; }
+
+   bool equals( uint32_t a, uint32_t b ) const
+   {
+      return point( a ) == point( b );
+   }
+
+   int turn( uint32_t a, uint32_t b, uint32_t c ) const
+   {
+      return predicateSign( orient2d( point( a ), point( b ), point( c ) ) );
+   }
+
+   static bool inTriangle( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c, const vec<2, T>& p )
+   {
+      return orient2d( c, a, p ) >= T(0) && orient2d( a, b, p ) >= T(0) && orient2d( b, c, p ) >= T(0);
+   }
+
+   uint32_t insertNode( uint32_t index, uint32_t last )
+   {
+      const uint32_t n = static_cast<uint32_t>(mNodes.size());
+      Node node;
+      node.mIndex = index;
+      node.mPoint = mPolygon->mPoints[index];
+      node.mPrevZ = node.mNextZ = NIL;
+      node.mZ = 0;
+      node.mSteiner = false;
+      if (last == NIL)
+      {
+         node.mPrev = node.mNext = n;
+         mNodes.push_back( node );
+      }
+      else
+      {
+         node.mPrev = last;
+         node.mNext = mNodes[last].mNext;
+         mNodes.push_back( node );
+         mNodes[mNodes[last].mNext].mPrev = n;
+         mNodes[last].mNext = n;
+      }
+      return n;
+   }
+
+   void removeNode( uint32_t n )
+   {
+      const Node& node = mNodes[n];
+      mNodes[node.mNext].mPrev = node.mPrev;
+      mNodes[node.mPrev].mNext = node.mNext;
+      if (node.mPrevZ != NIL)
+         mNodes[node.mPrevZ].mNextZ = node.mNextZ;
+      if (node.mNextZ != NIL)
+         mNodes[node.mNextZ].mPrevZ = node.mPrevZ;
+   }
+
+   /** Links a ring counter clockwise for an outer ring, clockwise for a hole. */
+   uint32_t linkRing( size_t ring, bool counterClockwise )
+   {
+      const size_t begin = mPolygon->mRingOffsets[ring], end = mPolygon->mRingOffsets[ring + 1];
+      uint32_t last = NIL;
+      if (counterClockwise == (ringArea2( *mPolygon, ring ) > T(0)))
+         for (size_t i = begin; i < end; ++i)
+            last = insertNode( static_cast<uint32_t>(i), last );
+      else
+         for (size_t i = end; i > begin; --i)
+            last = insertNode( static_cast<uint32_t>(i - 1), last );
+      if (last != NIL && equals( last, next( last ) ))
+      {
+         removeNode( last );
+         last = next( last );
+      }
+      return last;
+   }
+
+   /** Removes duplicate and collinear points between start and end. */
+   uint32_t filterPoints( uint32_t start, uint32_t end )
+   {
+      if (start == NIL)
+         return start;
+      if (end == NIL)
+         end = start;
+      uint32_t p = start;
+      bool again;
+      do
+      {
+         again = false;
+         if (!mNodes[p].mSteiner && (equals( p, next( p ) ) || turn( prev( p ), p, next( p ) ) == 0))
+         {
+            removeNode( p );
+            p = end = prev( p );
+            if (p == next( p ))
+               break;
+            again = true;
+         }
+         else
+            p = next( p );
+      } while (again || p != end);
+      return end;
+   }
+
+   void earcutLinked( uint32_t ear, std::vector<uint32_t>& indices, int pass )
+   {
+      if (ear == NIL)
+         return;
+      if (pass == 0 && mInvSize > T(0))
+         indexCurve( ear );
+
+      uint32_t stop = ear;
+      while (prev( ear ) != next( ear ))
+      {
+         const uint32_t p = prev( ear ), n = next( ear );
+         if (mInvSize > T(0) ? isEarHashed( ear ) : isEar( ear ))
+         {
+            indices.push_back( mNodes[p].mIndex );
+            indices.push_back( mNodes[ear].mIndex );
+            indices.push_back( mNodes[n].mIndex );
+            removeNode( ear );
+            ear = stop = next( n );
+            continue;
+         }
+         ear = n;
+         if (ear == stop)
+         {
+            if (pass == 0)
+               earcutLinked( filterPoints( ear, NIL ), indices, 1 );
+            else if (pass == 1)
+               earcutLinked( cureLocalIntersections( filterPoints( ear, NIL ), indices ), indices, 2 );
+            else
+               splitEarcut( ear, indices );
+            break;
+         }
+      }
+   }
+
+   bool isEar( uint32_t ear ) const
+   {
+      const uint32_t a = prev( ear ), c = next( ear );
+      if (turn( a, ear, c ) <= 0)
+         return false;
+      const vec<2, T> lo = glm::min( glm::min( point( a ), point( ear ) ), point( c ) );
+      const vec<2, T> hi = glm::max( glm::max( point( a ), point( ear ) ), point( c ) );
+      for (uint32_t p = next( c ); p != a; p = next( p ))
+         if (blocksEar( a, ear, c, p, lo, hi ))
+            return false;
+      return true;
+   }
+
+   bool isEarHashed( uint32_t ear ) const
+   {
+      const uint32_t a = prev( ear ), c = next( ear );
+      if (turn( a, ear, c ) <= 0)
+         return false;
+      const vec<2, T> lo = glm::min( glm::min( point( a ), point( ear ) ), point( c ) );
+      const vec<2, T> hi = glm::max( glm::max( point( a ), point( ear ) ), point( c ) );
+      const uint32_t minZ = zOrder( lo ), maxZ = zOrder( hi );
+
+      // Scans the z-order neighbours both ways within the triangle's z range
+      uint32_t p = mNodes[ear].mPrevZ, n = mNodes[ear].mNextZ;
+      while (p != NIL && mNodes[p].mZ >= minZ && n != NIL && mNodes[n].mZ <= maxZ)
+      {
+         if (p != a && p != c && blocksEar( a, ear, c, p, lo, hi ))
+            return false;
+         p = mNodes[p].mPrevZ;
+         if (n != a && n != c && blocksEar( a, ear, c, n, lo, hi ))
+            return false;
+         n = mNodes[n].mNextZ;
+      }
+      for (; p != NIL && mNodes[p].mZ >= minZ; p = mNodes[p].mPrevZ)
+         if (p != a && p != c && blocksEar( a, ear, c, p, lo, hi ))
+            return false;
+      for (; n != NIL && mNodes[n].mZ <= maxZ; n = mNodes[n].mNextZ)
+         if (n != a && n != c && blocksEar( a, ear, c, n, lo, hi ))
+            return false;
+      return true;
+   }
+
+   /** True when the reflex vertex p lies in the ear a, b, c. */
+   bool blocksEar( uint32_t a, uint32_t b, uint32_t c, uint32_t p, const vec<2, T>& lo, const vec<2, T>& hi ) const
+   {
+      const vec<2, T>& q = point( p );
+      return q.x >= lo.x && q.x <= hi.x && q.y >= lo.y && q.y <= hi.y && q != point( a )
+          && inTriangle( point( a ), point( b ), point( c ), q ) && turn( prev( p ), p, next( p ) ) <= 0;
+   }
+
+   uint32_t cureLocalIntersections( uint32_t start, std::vector<uint32_t>& indices )
+   {
+      uint32_t p = start;
+      do
+      {
+         const uint32_t a = prev( p ), b = next( next( p ) );
+         if (!equals( a, b ) && intersects( a, p, next( p ), b ) && locallyInside( a, b ) && locallyInside( b, a ))
+         {
+            indices.push_back( mNodes[a].mIndex );
+            indices.push_back( mNodes[p].mIndex );
+            indices.push_back( mNodes[b].mIndex );
+            removeNode( p );
+            removeNode( next( p ) );
+            p = start = b;
+         }
+         p = next( p );
+      } while (p != start);
+      return filterPoints( p, NIL );
+   }
+
+   void splitEarcut( uint32_t start, std::vector<uint32_t>& indices )
+   {
+      uint32_t a = start;
+      do
+      {
+         for (uint32_t b = next( next( a ) ); b != prev( a ); b = next( b ))
+            if (mNodes[a].mIndex != mNodes[b].mIndex && isValidDiagonal( a, b ))
+            {
+               uint32_t c = splitPolygon( a, b );
+               a = filterPoints( a, next( a ) );
+               c = filterPoints( c, next( c ) );
+               earcutLinked( a, indices, 0 );
+               earcutLinked( c, indices, 0 );
+               return;
+            }
+         a = next( a );
+      } while (a != start);
+   }
+
+   uint32_t eliminateHoles( uint32_t outer )
+   {
+      std::sort( mHoles.begin(), mHoles.end(), LeftmostFirst( mNodes ) );
+      for (size_t i = 0; i < mHoles.size(); ++i)
+      {
+         const uint32_t bridge = findHoleBridge( mHoles[i], outer );
+         if (bridge == NIL)
+            continue;
+         const uint32_t bridgeReverse = splitPolygon( bridge, mHoles[i] );
+         filterPoints( bridgeReverse, next( bridgeReverse ) );
+         outer = filterPoints( bridge, next( bridge ) );
+      }
+      return outer;
+   }
+
+   /** Finds the outer vertex to connect the leftmost vertex of a hole to. */
+   uint32_t findHoleBridge( uint32_t hole, uint32_t outer ) const
+   {
+      const vec<2, T> h = point( hole );
+      T qx = -std::numeric_limits<T>::max();
+      uint32_t m = NIL, p = outer;
+
+      // Casts a ray left from the hole and takes the endpoint of the nearest edge hit with the lesser x
+      do
+      {
+         const vec<2, T>& a = point( p );
+         const vec<2, T>& b = point( next( p ) );
+         if (h.y <= a.y && h.y >= b.y && b.y != a.y)
+         {
+            const T x = a.x + (h.y - a.y) * (b.x - a.x) / (b.y - a.y);
+            if (x <= h.x && x > qx)
+            {
+               qx = x;
+               m = a.x < b.x ? p : next( p );
+               if (x == h.x)
+                  return m;
+            }
+         }
+         p = next( p );
+      } while (p != outer);
+      if (m == NIL)
+         return NIL;
+
+      // Prefers the reflex vertex in the triangle hole, hit, m of least angle to the ray
+      const uint32_t stop = m;
+      const vec<2, T> mp = point( m );
+      const vec<2, T> t0( h.y < mp.y ? h.x : qx, h.y ), t2( h.y < mp.y ? qx : h.x, h.y );
+      T tanMin = std::numeric_limits<T>::max();
+      p = m;
+      do
+      {
+         const vec<2, T>& q = point( p );
+         if (h.x >= q.x && q.x >= mp.x && h.x != q.x && inTriangle( t0, mp, t2, q ))
+         {
+            const T tanCur = std::abs( h.y - q.y ) / (h.x - q.x);
+            if (locallyInside( p, hole )
+                && (tanCur < tanMin || (tanCur == tanMin && (q.x > point( m ).x || (q.x == point( m ).x && sectorContainsSector( m, p ))))))
+            {
+               m = p;
+               tanMin = tanCur;
+            }
+         }
+         p = next( p );
+      } while (p != stop);
+      return m;
+   }
+
+   bool sectorContainsSector( uint32_t m, uint32_t p ) const
+   {
+      return turn( prev( m ), m, prev( p ) ) > 0 && turn( next( p ), m, next( m ) ) > 0;
+   }
+
+   uint32_t leftmost( uint32_t start ) const
+   {
+      uint32_t p = start, left = start;
+      do
+      {
+         if (point( p ).x < point( left ).x || (point( p ).x == point( left ).x && point( p ).y < point( left ).y))
+            left = p;
+         p = next( p );
+      } while (p != start);
+      return left;
+   }
+
+   bool isValidDiagonal( uint32_t a, uint32_t b ) const
+   {
+      if (mNodes[next( a )].mIndex == mNodes[b].mIndex || mNodes[prev( a )].mIndex == mNodes[b].mIndex || intersectsPolygon( a, b ))
+         return false;
+      if (locallyInside( a, b ) && locallyInside( b, a ) && middleInside( a, b )
+          && (turn( prev( a ), a, prev( b ) ) != 0 || turn( a, prev( b ), b ) != 0))
+         return true;
+      return equals( a, b ) && turn( prev( a ), a, next( a ) ) < 0 && turn( prev( b ), b, next( b ) ) < 0;
+   }
+
+   bool onSegment( uint32_t p, uint32_t q, uint32_t r ) const
+   {
+      return point( q ).x <= glm::max( point( p ).x, point( r ).x ) && point( q ).x >= glm::min( point( p ).x, point( r ).x )
+          && point( q ).y <= glm::max( point( p ).y, point( r ).y ) && point( q ).y >= glm::min( point( p ).y, point( r ).y );
+   }
+
+   bool intersects( uint32_t p1, uint32_t q1, uint32_t p2, uint32_t q2 ) const
+   {
+      const int o1 = turn( p1, q1, p2 ), o2 = turn( p1, q1, q2 );
+      const int o3 = turn( p2, q2, p1 ), o4 = turn( p2, q2, q1 );
+      if (o1 != o2 && o3 != o4)
+         return true;
+      return (o1 == 0 && onSegment( p1, p2, q1 )) || (o2 == 0 && onSegment( p1, q2, q1 ))
+          || (o3 == 0 && onSegment( p2, p1, q2 )) || (o4 == 0 && onSegment( p2, q1, q2 ));
+   }
+
+   bool intersectsPolygon( uint32_t a, uint32_t b ) const
+   {
+      const uint32_t ia = mNodes[a].mIndex, ib = mNodes[b].mIndex;
+      uint32_t p = a;
+      do
+      {
+         const uint32_t ip = mNodes[p].mIndex, in = mNodes[next( p )].mIndex;
+         if (ip != ia && in != ia && ip != ib && in != ib && intersects( p, next( p ), a, b ))
+            return true;
+         p = next( p );
+      } while (p != a);
+      return false;
+   }
+
+   bool locallyInside( uint32_t a, uint32_t b ) const
+   {
+      if (turn( prev( a ), a, next( a ) ) > 0)
+         return turn( a, b, next( a ) ) <= 0 && turn( a, prev( a ), b ) <= 0;
+      return turn( a, b, prev( a ) ) > 0 || turn( a, next( a ), b ) > 0;
+   }
+
+   bool middleInside( uint32_t a, uint32_t b ) const
+   {
+      const vec<2, T> m = (point( a ) + point( b )) / T(2);
+      bool inside = false;
+      uint32_t p = a;
+      do
+      {
+         const vec<2, T>& u = point( p );
+         const vec<2, T>& v = point( next( p ) );
+         if ((u.y > m.y) != (v.y > m.y) && v.y != u.y && m.x < (v.x - u.x) * (m.y - u.y) / (v.y - u.y) + u.x)
+            inside = !inside;
+         p = next( p );
+      } while (p != a);
+      return inside;
+   }
+
+   /** Links a to b with a bridge, duplicating both, and gets the copy of b. */
+   uint32_t splitPolygon( uint32_t a, uint32_t b )
+   {
+      const uint32_t a2 = insertNode( mNodes[a].mIndex, NIL );
+      const uint32_t b2 = insertNode( mNodes[b].mIndex, NIL );
+      const uint32_t an = next( a ), bp = prev( b );
+      mNodes[a].mNext = b;
+      mNodes[b].mPrev = a;
+      mNodes[a2].mNext = an;
+      mNodes[an].mPrev = a2;
+      mNodes[b2].mNext = a2;
+      mNodes[a2].mPrev = b2;
+      mNodes[bp].mNext = b2;
+      mNodes[b2].mPrev = bp;
+      return b2;
+   }
+
+   uint32_t zOrder( const vec<2, T>& p ) const
+   {
+      uint32_t x = static_cast<uint32_t>(glm::clamp( (p.x - mMin.x) * mInvSize, T(0), T(32767) ));
+      uint32_t y = static_cast<uint32_t>(glm::clamp( (p.y - mMin.y) * mInvSize, T(0), T(32767) ));
+      x = (x | (x << 8)) & 0x00FF00FFu;
+      x = (x | (x << 4)) & 0x0F0F0F0Fu;
+      x = (x | (x << 2)) & 0x33333333u;
+      x = (x | (x << 1)) & 0x55555555u;
+      y = (y | (y << 8)) & 0x00FF00FFu;
+      y = (y | (y << 4)) & 0x0F0F0F0Fu;
+      y = (y | (y << 2)) & 0x33333333u;
+      y = (y | (y << 1)) & 0x55555555u;
+      return x | (y << 1);
+   }
+
+   /** Links the ring in z-order through mPrevZ and mNextZ. */
+   void indexCurve( uint32_t start )
+   {
+      uint32_t p = start;
+      do
+      {
+         Node& node = mNodes[p];
+         if (node.mZ == 0)
+            node.mZ = zOrder( node.mPoint );
+         node.mPrevZ = node.mPrev;
+         node.mNextZ = node.mNext;
+         p = node.mNext;
+      } while (p != start);
+      mNodes[mNodes[p].mPrevZ].mNextZ = NIL;
+      mNodes[p].mPrevZ = NIL;
+      sortLinked( p );
+   }
+
+   /** Merge sort of the z-order list, after Simon Tatham. */
+   void sortLinked( uint32_t list )
+   {
+      size_t inSize = 1, merges;
+      do
+      {
+         uint32_t p = list, tail = NIL;
+         list = NIL;
+         merges = 0;
+         while (p != NIL)
+         {
+            ++merges;
+            uint32_t q = p;
+            size_t pSize = 0;
+            for (size_t i = 0; i < inSize && q != NIL; ++i)
+            {
+               ++pSize;
+               q = mNodes[q].mNextZ;
+            }
+            size_t qSize = inSize;
+            while (pSize > 0 || (qSize > 0 && q != NIL))
+            {
+               uint32_t e;
+               if (pSize != 0 && (qSize == 0 || q == NIL || mNodes[p].mZ <= mNodes[q].mZ))
+               {
+                  e = p;
+                  p = mNodes[p].mNextZ;
+                  --pSize;
+               }
+               else
+               {
+                  e = q;
+                  q = mNodes[q].mNextZ;
+                  --qSize;
+               }
+               if (tail != NIL)
+                  mNodes[tail].mNextZ = e;
+               else
+                  list = e;
+               mNodes[e].mPrevZ = tail;
+               tail = e;
+            }
+            p = q;
+         }
+         mNodes[tail].mNextZ = NIL;
+         inSize *= 2;
+      } while (merges > 1);
+   }
+
+   struct LeftmostFirst
+   {
+      LeftmostFirst( const std::vector<Node>& nodes )
+         : mNodes( nodes )
+      {}
+
+      bool operator()( uint32_t a, uint32_t b ) const
+      {
+         const vec<2, T>& p = mNodes[a].mPoint;
+         const vec<2, T>& q = mNodes[b].mPoint;
+         return p.x < q.x || (p.x == q.x && p.y < q.y);
+      }
+
+      const std::vector<Node>& mNodes;
+   };
+
+protected:
+   const polygon_t<T>* mPolygon;
+   polygon_index_t<T> mIndex;
+   std::vector<uint32_t> mDepths;
+   std::vector<size_t> mParents;
+   std::vector<Node> mNodes;
+   std::vector<uint32_t> mHoles;
+   vec<2, T> mMin;
+   T mInvSize;
+};
+
+template<class T>
+const size_t ear_clipper_t<T>::HASH_THRESHOLD;
+
+template<class T>
+const uint32_t ear_clipper_t<T>::NIL;
+
+/**
+ * Boolean operations between two polygon_t.
+ *
+ * The edges of both polygons are split where they meet, each piece is kept
+ * or dropped depending on which side of the other polygon it lies, and the
+ * kept pieces are linked back into rings. Rings whose boxes miss the other
+ * polygon, or that meet no edge of it, are classified as a whole, so
+ * overlays of many small rings stay cheap. Results have their outer rings
+ * counter clockwise and their holes clockwise; rings of the result touching
+ * at a vertex are kept separate.
+ *
+ * Keep one per thread and reuse it: the scratch memory is kept.
+ *
+ * @param T     the internal type used for the coordinates
+ * @ingroup Types
+ */
+template<class T>
+class polygon_clipper_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Computes a op b into result, replacing its rings.
+    */
+   void compute( const polygon_t<T>& a, const polygon_t<T>& b, PolygonBoolean op, polygon_t<T>& result )
+   {
+      result.clear();
+      mOperation = op;
+      mPolygons[0] = &a;
+      mPolygons[1] = &b;
+      for (int k = 0; k < 2; ++k)
+      {
+         mIndices[k].build( *mPolygons[k] );
+         mIndices[k].computeNesting( mDepths, mParents );
+         const polygon_t<T>& polygon = *mPolygons[k];
+         mReversed[k].resize( polygon.getRingCount() );
+         mTouched[k].assign( polygon.getRingCount(), 0 );
+         for (size_t r = 0; r < polygon.getRingCount(); ++r)
+            mReversed[k][r] = ((mDepths[r] & 1) == 0) != (ringArea2( polygon, r ) > T(0));
+      }
+
+      findIntersections();
+
+      // Rings that meet nothing are inside or outside the other polygon as a whole
+      for (int k = 0; k < 2; ++k)
+      {
+         const polygon_t<T>& polygon = *mPolygons[k];
+         for (size_t r = 0; r < polygon.getRingCount(); ++r)
+         {
+            if (mTouched[k][r] || polygon.getRingSize( r ) < 3)
+               continue;
+            const bool inside = mIndices[1 - k].locate( polygon.mPoints[polygon.mRingOffsets[r]] ) == 1;
+            int direction = keep( k, inside );
+            if (direction == 0)
+               continue;
+            if (mReversed[k][r])
+               direction = -direction;
+            mRing.clear();
+            if (direction > 0)
+               mRing.assign( polygon.mPoints.begin() + static_cast<std::ptrdiff_t>(polygon.mRingOffsets[r]),
+                             polygon.mPoints.begin() + static_cast<std::ptrdiff_t>(polygon.mRingOffsets[r + 1]) );
+            else
+               mRing.assign( polygon.mPoints.rbegin() + static_cast<std::ptrdiff_t>(polygon.mPoints.size() - polygon.mRingOffsets[r + 1]),
+                             polygon.mPoints.rbegin() + static_cast<std::ptrdiff_t>(polygon.mPoints.size() - polygon.mRingOffsets[r]) );
+            result.addRing( &mRing[0], mRing.size() );
+         }
+      }
+
+      splitEdges();
+      selectPieces();
+      linkPieces( result );
+   }
+
+protected:
+   /** A piece of a split edge, oriented with the interior of its polygon on its left. */
+   struct Piece
+   {
+      vec<2, T> mFrom;
+      vec<2, T> mTo;
+   };
+
+   struct Split
+   {
+      uint32_t mEdge;
+      vec<2, T> mPoint;
+   };
+
+   struct Candidate
+   {
+      T mMinX;
+      uint32_t mEdge;
+      uint8_t mPolygon;
+
+      bool operator<( const Candidate& other ) const
+      {
+         return mMinX < other.mMinX;
+      }
+   };
+
+   static bool pointLess( const vec<2, T>& a, const vec<2, T>& b )
+   {
+      return a.x < b.x || (a.x == b.x && a.y < b.y);
+   }
+
+   /**
+    * Whether to keep an edge piece of polygon k inside or outside the other
+    * polygon: 1 as is, -1 reversed, 0 dropped.
+    */
+   int keep( int k, bool inside ) const
+   {
+      switch (mOperation)
+      {
+      case POLYGON_UNION:
+         return inside ? 0 : 1;
+      case POLYGON_INTERSECTION:
+         return inside ? 1 : 0;
+      default:
+         if (k == 0)
+            return inside ? 0 : 1;
+         return inside ? -1 : 0;
+      }
+   }
+
+   size_t ringOf( int k, size_t i ) const
+   {
+      const std::vector<size_t>& offsets = mPolygons[k]->mRingOffsets;
+      return static_cast<size_t>(std::upper_bound( offsets.begin(), offsets.end(), i ) - offsets.begin()) - 1;
+   }
+
+   void edgeEnds( int k, size_t i, vec<2, T>& from, vec<2, T>& to ) const
+   {
+      const polygon_t<T>& polygon = *mPolygons[k];
+      from = polygon.mPoints[i];
+      to = polygon.mPoints[polygon.nextInRing( ringOf( k, i ), i )];
+   }
+
+   /** Sweeps the edges of both polygons along x, splitting them where they meet. */
+   void findIntersections()
+   {
+      mSplits[0].clear();
+      mSplits[1].clear();
+      mCandidates.clear();
+      const polygon_t<T>* polygons[2] = { mPolygons[0], mPolygons[1] };
+      if (!polygons[0]->mBounds.overlaps( polygons[1]->mBounds ))
+         return;
+
+      for (int k = 0; k < 2; ++k)
+      {
+         const polygon_t<T>& polygon = *polygons[k];
+         const aabox2_t<T>& other = polygons[1 - k]->mBounds;
+         for (size_t r = 0; r < polygon.getRingCount(); ++r)
+         {
+            if (!polygon.mRingBounds[r].overlaps( other ))
+               continue;
+            for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1]; ++i)
+            {
+               const vec<2, T>& p = polygon.mPoints[i];
+               const vec<2, T>& q = polygon.mPoints[polygon.nextInRing( r, i )];
+               aabox2_t<T> edge;
+               edge.extend( p );
+               edge.extend( q );
+               if (!edge.overlaps( other ))
+                  continue;
+               const Candidate candidate = { glm::min( p.x, q.x ), static_cast<uint32_t>(i), static_cast<uint8_t>(k) };
+               mCandidates.push_back( candidate );
+            }
+         }
+      }
+      std::sort( mCandidates.begin(), mCandidates.end() );
+
+      mActive[0].clear();
+      mActive[1].clear();
+      for (size_t c = 0; c < mCandidates.size(); ++c)
+      {
+         const Candidate& candidate = mCandidates[c];
+         const int k = candidate.mPolygon;
+         vec<2, T> p, q;
+         edgeEnds( k, candidate.mEdge, p, q );
+         std::vector<uint32_t>& others = mActive[1 - k];
+         size_t kept = 0;
+         for (size_t j = 0; j < others.size(); ++j)
+         {
+            vec<2, T> u, v;
+            edgeEnds( 1 - k, others[j], u, v );
+            if (glm::max( u.x, v.x ) < candidate.mMinX)
+               continue;
+            others[kept++] = others[j];
+            if (glm::max( u.y, v.y ) < glm::min( p.y, q.y ) || glm::max( p.y, q.y ) < glm::min( u.y, v.y ))
+               continue;
+            if (k == 0)
+               intersectEdges( candidate.mEdge, p, q, others[j], u, v );
+            else
+               intersectEdges( others[j], u, v, candidate.mEdge, p, q );
+         }
+         others.resize( kept );
+         mActive[k].push_back( candidate.mEdge );
+      }
+   }
+
+   /** True when p lies strictly between the ends of the segment a, b, known collinear with it. */
+   static bool strictlyBetween( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& p )
+   {
+      if (p == a || p == b)
+         return false;
+      return a.x != b.x ? (glm::min( a.x, b.x ) < p.x && p.x < glm::max( a.x, b.x ))
+                        : (glm::min( a.y, b.y ) < p.y && p.y < glm::max( a.y, b.y ));
+   }
+
+   void addSplit( int k, uint32_t edge, const vec<2, T>& p )
+   {
+      const Split split = { edge, p };
+      mSplits[k].push_back( split );
+   }
+
+   void intersectEdges( uint32_t ea, const vec<2, T>& a0, const vec<2, T>& a1,
+                        uint32_t eb, const vec<2, T>& b0, const vec<2, T>& b1 )
+   {
+      const int o1 = predicateSign( orient2d( a0, a1, b0 ) ), o2 = predicateSign( orient2d( a0, a1, b1 ) );
+      const int o3 = predicateSign( orient2d( b0, b1, a0 ) ), o4 = predicateSign( orient2d( b0, b1, a1 ) );
+      if (o1 * o2 > 0 || o3 * o4 > 0)
+         return;
+
+      bool met = false;
+      if (o1 == 0 && o2 == 0)
+      {
+         // Collinear: splits each at the ends of the other inside it
+         const vec<2, T> lo = glm::max( glm::min( a0, a1 ), glm::min( b0, b1 ) );
+         const vec<2, T> hi = glm::min( glm::max( a0, a1 ), glm::max( b0, b1 ) );
+         if (lo.x > hi.x || lo.y > hi.y)
+            return;
+         const vec<2, T> ends[2][2] = { { a0, a1 }, { b0, b1 } };
+         for (int k = 0; k < 2; ++k)
+            for (int j = 0; j < 2; ++j)
+               if (strictlyBetween( ends[1 - k][0], ends[1 - k][1], ends[k][j] ))
+                  addSplit( 1 - k, k == 0 ? eb : ea, ends[k][j] );
+         met = true;
+      }
+      else if (o1 == 0 || o2 == 0 || o3 == 0 || o4 == 0)
+      {
+         // An end of one lies on the other
+         if (o1 == 0 && strictlyBetween( a0, a1, b0 ))
+            addSplit( 0, ea, b0 );
+         if (o2 == 0 && strictlyBetween( a0, a1, b1 ))
+            addSplit( 0, ea, b1 );
+         if (o3 == 0 && strictlyBetween( b0, b1, a0 ))
+            addSplit( 1, eb, a0 );
+         if (o4 == 0 && strictlyBetween( b0, b1, a1 ))
+            addSplit( 1, eb, a1 );
+         met = true;
+      }
+      else
+      {
+         const vec<2, T> da = a1 - a0, db = b1 - b0, d0 = b0 - a0;
+         const T t = glm::clamp( (d0.x * db.y - d0.y * db.x) / (da.x * db.y - da.y * db.x), T(0), T(1) );
+         const vec<2, T> p = a0 + da * t;
+         if (p != a0 && p != a1)
+            addSplit( 0, ea, p );
+         if (p != b0 && p != b1)
+            addSplit( 1, eb, p );
+         met = true;
+      }
+      if (met)
+      {
+         mTouched[0][ringOf( 0, ea )] = 1;
+         mTouched[1][ringOf( 1, eb )] = 1;
+      }
+   }
+
+   struct SplitOrder
+   {
+      bool operator()( const Split& a, const Split& b ) const
+      {
+         return a.mEdge < b.mEdge || (a.mEdge == b.mEdge && pointLess( a.mPoint, b.mPoint ));
+      }
+   };
+
+   /** Cuts the edges of the touched rings into pieces, oriented interior on the left. */
+   void splitEdges()
+   {
+      for (int k = 0; k < 2; ++k)
+      {
+         const polygon_t<T>& polygon = *mPolygons[k];
+         std::vector<Split>& splits = mSplits[k];
+         std::sort( splits.begin(), splits.end(), SplitOrder() );
+         mPieces[k].clear();
+         size_t s = 0;
+         for (size_t r = 0; r < polygon.getRingCount(); ++r)
+         {
+            if (!mTouched[k][r])
+               continue;
+            for (size_t i = polygon.mRingOffsets[r]; i < polygon.mRingOffsets[r + 1]; ++i)
+            {
+               vec<2, T> from = polygon.mPoints[i], to = polygon.mPoints[polygon.nextInRing( r, i )];
+               while (s < splits.size() && splits[s].mEdge < i)
+                  ++s;
+               mPoints.assign( 1, from );
+               for (; s < splits.size() && splits[s].mEdge == i; ++s)
+                  mPoints.push_back( splits[s].mPoint );
+               mPoints.push_back( to );
+
+               // The splits are in x, y order: puts them in edge order, duplicates together
+               std::sort( mPoints.begin() + 1, mPoints.end() - 1, pointLess );
+               if (pointLess( to, from ))
+                  std::reverse( mPoints.begin() + 1, mPoints.end() - 1 );
+               for (size_t j = 0; j + 1 < mPoints.size(); ++j)
+               {
+                  if (mPoints[j] == mPoints[j + 1])
+                     continue;
+                  Piece piece = { mPoints[j], mPoints[j + 1] };
+                  if (mReversed[k][r])
+                     std::swap( piece.mFrom, piece.mTo );
+                  mPieces[k].push_back( piece );
+               }
+            }
+         }
+      }
+   }
+
+   struct PieceKeyLess
+   {
+      bool operator()( const Piece& a, const Piece& b ) const
+      {
+         const vec<2, T> alo = pointLess( a.mFrom, a.mTo ) ? a.mFrom : a.mTo, ahi = pointLess( a.mFrom, a.mTo ) ? a.mTo : a.mFrom;
+         const vec<2, T> blo = pointLess( b.mFrom, b.mTo ) ? b.mFrom : b.mTo, bhi = pointLess( b.mFrom, b.mTo ) ? b.mTo : b.mFrom;
+         return pointLess( alo, blo ) || (alo == blo && pointLess( ahi, bhi ));
+      }
+   };
+
+   /** Keeps the pieces on the right side of the other polygon, and one of each shared pair. */
+   void selectPieces()
+   {
+      mKept.clear();
+      std::sort( mPieces[1].begin(), mPieces[1].end(), PieceKeyLess() );
+      mShared.assign( mPieces[1].size(), 0 );
+      for (int k = 0; k < 2; ++k)
+         for (size_t i = 0; i < mPieces[k].size(); ++i)
+         {
+            const Piece& piece = mPieces[k][i];
+            if (k == 0)
+            {
+               typename std::vector<Piece>::const_iterator it
+                  = std::lower_bound( mPieces[1].begin(), mPieces[1].end(), piece, PieceKeyLess() );
+               if (it != mPieces[1].end() && !PieceKeyLess()( piece, *it ))
+               {
+                  // Both boundaries run along this piece
+                  mShared[static_cast<size_t>(it - mPieces[1].begin())] = 1;
+                  const bool same = it->mFrom == piece.mFrom;
+                  const bool kept = mOperation == POLYGON_DIFFERENCE ? !same : same;
+                  if (kept)
+                     mKept.push_back( piece );
+                  continue;
+               }
+            }
+            else if (mShared[i])
+               continue;
+
+            const int location = mIndices[1 - k].locate( (piece.mFrom + piece.mTo) / T(2) );
+            const int direction = keep( k, location == 1 );
+            if (direction > 0)
+               mKept.push_back( piece );
+            else if (direction < 0)
+            {
+               const Piece reversed = { piece.mTo, piece.mFrom };
+               mKept.push_back( reversed );
+            }
+         }
+   }
+
+   /**
+    * True when w comes before w2 turning clockwise around v from the
+    * direction of p, the direction of p itself coming last.
+    */
+   static bool turnsBefore( const vec<2, T>& v, const vec<2, T>& p, const vec<2, T>& w, const vec<2, T>& w2 )
+   {
+      const int hw = sweepHalf( v, p, w ), hw2 = sweepHalf( v, p, w2 );
+      if (hw != hw2)
+         return hw < hw2;
+      return orient2d( v, w, w2 ) < T(0);
+   }
+
+   /** 0 for directions clockwise from v, p by less than a half turn, 1 for a half turn or more, 2 for v, p itself. */
+   static int sweepHalf( const vec<2, T>& v, const vec<2, T>& p, const vec<2, T>& w )
+   {
+      const int o = predicateSign( orient2d( v, p, w ) );
+      if (o < 0)
+         return 0;
+      if (o > 0)
+         return 1;
+      return dot( w - v, p - v ) > T(0) ? 2 : 1;
+   }
+
+   struct PieceFromLess
+   {
+      bool operator()( const Piece& a, const Piece& b ) const
+      {
+         return pointLess( a.mFrom, b.mFrom );
+      }
+   };
+
+   /** Links the kept pieces into rings, turning the most to the right at shared vertices. */
+   void linkPieces( polygon_t<T>& result )
+   {
+      std::sort( mKept.begin(), mKept.end(), PieceFromLess() );
+      mUsed.assign( mKept.size(), 0 );
+      for (size_t start = 0; start < mKept.size(); ++start)
+      {
+         if (mUsed[start])
+            continue;
+         mRing.clear();
+         size_t e = start;
+         bool closed = false;
+         for (;;)
+         {
+            mUsed[e] = 1;
+            mRing.push_back( mKept[e].mFrom );
+            const vec<2, T>& v = mKept[e].mTo;
+            const vec<2, T>& back = mKept[e].mFrom;
+
+            // Among the unused pieces out of v, and the first piece when back at its start
+            const Piece key = { v, v };
+            size_t best = mKept.size();
+            typename std::vector<Piece>::const_iterator it = std::lower_bound( mKept.begin(), mKept.end(), key, PieceFromLess() );
+            for (; it != mKept.end() && it->mFrom == v; ++it)
+            {
+               const size_t c = static_cast<size_t>(it - mKept.begin());
+               if (mUsed[c] && c != start)
+                  continue;
+               if (best == mKept.size() || turnsBefore( v, back, it->mTo, mKept[best].mTo ))
+                  best = c;
+            }
+            closed = best == start;
+            if (best == mKept.size() || closed)
+               break;
+            e = best;
+         }
+
+         // Kept pieces always form closed walks; an open chain means inconsistent pieces, dropped in release builds
+         assert( closed );
+         if (closed && mRing.size() >= 3)
+            result.addRing( &mRing[0], mRing.size() );
+      }
+   }
+
+protected:
+   PolygonBoolean mOperation;
+   const polygon_t<T>* mPolygons[2];
+   polygon_index_t<T> mIndices[2];
+   std::vector<uint32_t> mDepths;
+   std::vector<size_t> mParents;
+   std::vector<uint8_t> mReversed[2];
+   std::vector<uint8_t> mTouched[2];
+   std::vector<Candidate> mCandidates;
+   std::vector<uint32_t> mActive[2];
+   std::vector<Split> mSplits[2];
+   std::vector< vec<2, T> > mPoints;
+   std::vector<Piece> mPieces[2];
+   std::vector<uint8_t> mShared;
+   std::vector<Piece> mKept;
+   std::vector<uint8_t> mUsed;
+   std::vector< vec<2, T> > mRing;
+};
+
+/**
+ * Triangulates polygons [first, first + count), appending to indices[i] for
+ * polygon i. Independent ranges may run on different threads.
+ */
+template< class T >
+inline void triangulatePolygons( const polygon_t<T>* polygons, size_t first, size_t count, std::vector<uint32_t>* indices )
+{
+   ear_clipper_t<T> clipper;
+   for (size_t i = first; i < first + count; ++i)
+      clipper.triangulate( polygons[i], indices[i] );
+}
+
+/**
+ * Computes a[i] op b[i] into results[i] for i in [first, first + count).
+ * Independent ranges may run on different threads.
+ */
+template< class T >
+inline void clipPolygons( const polygon_t<T>* a, const polygon_t<T>* b, size_t first, size_t count, PolygonBoolean op,
+                          polygon_t<T>* results )
+{
+   polygon_clipper_t<T> clipper;
+   for (size_t i = first; i < first + count; ++i)
+      clipper.compute( a[i], b[i], op, results[i] );
+}
+
+// --- helper types --- //
+typedef polygon_t<float>            polygonf;
+typedef polygon_t<double>           polygond;
+typedef polygon_index_t<float>      polygon_indexf;
+typedef polygon_index_t<double>     polygon_indexd;
+typedef ear_clipper_t<float>        ear_clipperf;
+typedef ear_clipper_t<double>       ear_clipperd;
+typedef polygon_clipper_t<float>    polygon_clipperf;
+typedef polygon_clipper_t<double>   polygon_clipperd;
+
+}
@@ -0,0 +1,500 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace glm
+{
+
+/**
+ * Error free floating point transforms and expansion arithmetic, after
+ * Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+ * Geometric Predicates".
+ *
+ * An expansion is an array of floating point numbers of increasing
+ * magnitude whose exact sum is the value represented; the last component
+ * has the sign of the whole. Everything here relies on IEEE round to even
+ * arithmetic in the precision of T: do not compile with -ffast-math.
+ */
+template<class T>
+struct predicate_arithmetic_t
+{
+   /** 2^-p, half the machine epsilon. */
+   static T epsilon()
+   {
+      return std::numeric_limits<T>::epsilon() / T(2);
+   }
+
+   /** 2^ceil(p / 2) + 1, splits a number into two halves of p / 2 bits. */
+   static T splitter()
+   {
+      return static_cast<T>(std::ldexp( 1.0, (std::numeric_limits<T>::digits + 1) / 2 ) + 1.0);
+   }
+
+   /** x + y = a + b exactly, x being the rounded sum, when |a| >= |b|. */
+   static void fastTwoSum( T a, T b, T& x, T& y )
+   {
+      x = a + b;
+      const T bVirtual = x - a;
+      y = b - bVirtual;
+   }
+
+   /** x + y = a + b exactly, x being the rounded sum. */
+   static void twoSum( T a, T b, T& x, T& y )
+   {
+      x = a + b;
+      const T bVirtual = x - a;
+      const T aVirtual = x - bVirtual;
+      y = (a - aVirtual) + (b - bVirtual);
+   }
+
+   /** x + y = a - b exactly, x being the rounded difference. */
+   static void twoDiff( T a, T b, T& x, T& y )
+   {
+      x = a - b;
+      const T bVirtual = a - x;
+      const T aVirtual = x + bVirtual;
+      y = (a - aVirtual) + (bVirtual - b);
+   }
+
+   static void split( T a, T& high, T& low )
+   {
+      const T c = splitter() * a;
+      const T big = c - a;
+      high = c - big;
+      low = a - high;
+   }
+
+   /** x + y = a * b exactly, x being the rounded product. */
+   static void twoProduct( T a, T b, T& x, T& y )
+   {
+      T aHigh, aLow, bHigh, bLow;
+      split( a, aHigh, aLow );
+      split( b, bHigh, bLow );
+      x = a * b;
+      const T err1 = x - aHigh * bHigh;
+      const T err2 = err1 - aLow * bHigh;
+      const T err3 = err2 - aHigh * bLow;
+      y = aLow * bLow - err3;
+   }
+
+   /**
+    * h = e + f, dropping zero components; h must not alias e or f and needs
+    * room for elength + flength components.
+    *
+    * @return  the length of h, at least 1
+    */
+   static int sum( const T* e, int elength, const T* f, int flength, T* h )
+   {
+      int ei = 0, fi = 0, hi = 0;
+      T enow = elength > 0 ? e[0] : T(0);
+      T fnow = flength > 0 ? f[0] : T(0);
+      T q, qNew, hh;
+
+      // Merges the components by increasing magnitude
+      if (fi >= flength || (ei < elength && (fnow > enow) == (fnow > -enow)))
+      {
+         q = enow;
+         enow = ++ei < elength ? e[ei] : T(0);
+      }
+      else
+      {
+         q = fnow;
+         fnow = ++fi < flength ? f[fi] : T(0);
+      }
+      if (ei < elength && fi < flength)
+      {
+         if ((fnow > enow) == (fnow > -enow))
+         {
+            fastTwoSum( enow, q, qNew, hh );
+            enow = ++ei < elength ? e[ei] : T(0);
+         }
+         else
+         {
+            fastTwoSum( fnow, q, qNew, hh );
+            fnow = ++fi < flength ? f[fi] : T(0);
+         }
+         q = qNew;
+         if (hh != T(0))
+            h[hi++] = hh;
+         while (ei < elength && fi < flength)
+         {
+            if ((fnow > enow) == (fnow > -enow))
+            {
+               twoSum( q, enow, qNew, hh );
+               enow = ++ei < elength ? e[ei] : T(0);
+            }
+            else
+            {
+               twoSum( q, fnow, qNew, hh );
+               fnow = ++fi < flength ? f[fi] : T(0);
+            }
+            q = qNew;
+            if (hh != T(0))
+               h[hi++] = hh;
+         }
+      }
+      while (ei < elength)
+      {
+         twoSum( q, enow, qNew, hh );
+         enow = ++ei < elength ? e[ei] : T(0);
+         q = qNew;
+         if (hh != T(0))
+            h[hi++] = hh;
+      }
+      while (fi < flength)
+      {
+         twoSum( q, fnow, qNew, hh );
+         fnow = ++fi < flength ? f[fi] : T(0);
+         q = qNew;
+         if (hh != T(0))
+            h[hi++] = hh;
+      }
+      if (q != T(0) || hi == 0)
+         h[hi++] = q;
+      return hi;
+   }
+
+   /**
+    * h = e * b, dropping zero components; h must not alias e and needs room
+    * for 2 * elength components.
+    *
+    * @return  the length of h, at least 1
+    */
+   static int scale( const T* e, int elength, T b, T* h )
+   {
+      T q, hh, product1, product0, s;
+      int hi = 0;
+      twoProduct( e[0], b, q, hh );
+      if (hh != T(0))
+         h[hi++] = hh;
+      for (int i = 1; i < elength; ++i)
+      {
+         twoProduct( e[i], b, product1, product0 );
+         twoSum( q, product0, s, hh );
+         if (hh != T(0))
+            h[hi++] = hh;
+         fastTwoSum( product1, s, q, hh );
+         if (hh != T(0))
+            h[hi++] = hh;
+      }
+      if (q != T(0) || hi == 0)
+         h[hi++] = q;
+      return hi;
+   }
+
+   /**
+    * h = e * f for a short f, as the sum of e scaled by each component of f;
+    * h needs room for 2 * elength * flength components.
+    *
+    * @return  the length of h
+    */
+   static int product( const T* e, int elength, const T* f, int flength, T* h )
+   {
+      T scaled[64], partial[2][512];
+      int length = scale( e, elength, f[0], partial[0] );
+      int current = 0;
+      for (int i = 1; i < flength; ++i)
+      {
+         const int scaledLength = scale( e, elength, f[i], scaled );
+         length = sum( partial[current], length, scaled, scaledLength, partial[1 - current] );
+         current = 1 - current;
+      }
+      std::copy( partial[current], partial[current] + length, h );
+      return length;
+   }
+};
+
+/**
+ * Exact sign of the 4x4 determinant with rows (x, y, z, 1), where z is
+ * given per point as an expansion: orient3d with z the third coordinate,
+ * incircle with z the lifted x^2 + y^2. The Laplace expansion along the
+ * (x, y) and (z, 1) column pairs keeps every term a short expansion.
+ */
+template< class T >
+inline T exactLiftedDeterminant( const T x[4], const T y[4], const T* const z[4], const int zLength[4] )
+{
+   typedef predicate_arithmetic_t<T> arith;
+
+   // Row pairs (i, j) of the (x, y) minors, the complementary (z, 1) minors and the Laplace signs
+   static const int pairs[6][4] = { { 0, 1, 2, 3 }, { 0, 2, 1, 3 }, { 0, 3, 1, 2 }, { 1, 2, 0, 3 }, { 1, 3, 0, 2 }, { 2, 3, 0, 1 } };
+   static const int signs[6] = { 1, -1, 1, 1, -1, 1 };
+
+   T total[2][1024];
+   int totalLength = 0, current = 0;
+   for (int p = 0; p < 6; ++p)
+   {
+      const int i = pairs[p][0], j = pairs[p][1], k = pairs[p][2], l = pairs[p][3];
+
+      // x_i y_j - x_j y_i as a 4 component expansion
+      T a[2], b[2], minor[4];
+      arith::twoProduct( x[i], y[j], a[1], a[0] );
+      arith::twoProduct( -x[j], y[i], b[1], b[0] );
+      const int minorLength = arith::sum( a, 2, b, 2, minor );
+
+      // z_k - z_l
+      T negated[16], difference[32];
+      for (int c = 0; c < zLength[l]; ++c)
+         negated[c] = -z[l][c];
+      const int differenceLength = arith::sum( z[k], zLength[k], negated, zLength[l], difference );
+
+      T term[256];
+      int termLength = arith::product( difference, differenceLength, minor, minorLength, term );
+      if (signs[p] < 0)
+         for (int c = 0; c < termLength; ++c)
+            term[c] = -term[c];
+
+      if (totalLength == 0)
+      {
+         std::copy( term, term + termLength, total[current] );
+         totalLength = termLength;
+      }
+      else
+      {
+         totalLength = arith::sum( total[current], totalLength, term, termLength, total[1 - current] );
+         current = 1 - current;
+      }
+   }
+   return total[current][totalLength - 1];
+}
+
+/**
+ * Exact orient2d, see orient2d.
+ */
+template< class T >
+inline T orient2dExact( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c )
+{
+   typedef predicate_arithmetic_t<T> arith;
+
+   // ax by - ax cy + bx cy - bx ay + cx ay - cx by, each product exact as two components
+   const T factors[6][2] = { { a.x, b.y }, { -a.x, c.y }, { b.x, c.y }, { -b.x, a.y }, { c.x, a.y }, { -c.x, b.y } };
+   T total[2][12];
+   int length = 0, current = 0;
+   for (int t = 0; t < 6; ++t)
+   {
+      T term[2];
+      arith::twoProduct( factors[t][0], factors[t][1], term[1], term[0] );
+      length = arith::sum( total[current], length, term, 2, total[1 - current] );
+      current = 1 - current;
+   }
+   return total[current][length - 1];
+}
+
+/**
+ * Orientation of three points: positive when a, b and c are in counter
+ * clockwise order, negative when clockwise, zero when collinear.
+ *
+ * The value is twice the signed area of the triangle, computed in floating
+ * point; when it is too close to zero for its sign to be certain, the
+ * predicate falls back to exact arithmetic, and the sign is always exact.
+ */
+template< class T >
+inline T orient2d( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c )
+{
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const T left = (a.x - c.x) * (b.y - c.y);
+   const T right = (a.y - c.y) * (b.x - c.x);
+   const T det = left - right;
+   const T bound = (T(3) + T(16) * eps) * eps * (std::abs( left ) + std::abs( right ));
+   if (det > bound || -det > bound)
+      return det;
+   return orient2dExact( a, b, c );
+}
+
+/**
+ * Exact orient3d, see orient3d.
+ */
+template< class T >
+inline T orient3dExact( const vec<3, T>& a, const vec<3, T>& b, const vec<3, T>& c, const vec<3, T>& d )
+{
+   const T x[4] = { a.x, b.x, c.x, d.x };
+   const T y[4] = { a.y, b.y, c.y, d.y };
+   const T* const z[4] = { &a.z, &b.z, &c.z, &d.z };
+   const int zLength[4] = { 1, 1, 1, 1 };
+   return exactLiftedDeterminant( x, y, z, zLength );
+}
+
+/**
+ * Orientation of a point against the plane of a triangle: positive when d
+ * lies below the plane through a, b and c, below meaning that a, b and c
+ * appear counter clockwise when seen from above; negative above, zero when
+ * coplanar. This is Shewchuk's convention, the determinant of the rows
+ * a - d, b - d and c - d.
+ *
+ * Filtered like orient2d: the sign is always exact.
+ */
+template< class T >
+inline T orient3d( const vec<3, T>& a, const vec<3, T>& b, const vec<3, T>& c, const vec<3, T>& d )
+{
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const vec<3, T> ad = a - d, bd = b - d, cd = c - d;
+   const T bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+   const T cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+   const T adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+   const T det = ad.z * (bdxcdy - cdxbdy) + bd.z * (cdxady - adxcdy) + cd.z * (adxbdy - bdxady);
+   const T permanent = (std::abs( bdxcdy ) + std::abs( cdxbdy )) * std::abs( ad.z ) + (std::abs( cdxady ) + std::abs( adxcdy )) * std::abs( bd.z )
+                     + (std::abs( adxbdy ) + std::abs( bdxady )) * std::abs( cd.z );
+   const T bound = (T(7) + T(56) * eps) * eps * permanent;
+   if (det > bound || -det > bound)
+      return det;
+   return orient3dExact( a, b, c, d );
+}
+
+/**
+ * Exact incircle, see incircle.
+ */
+template< class T >
+inline T incircleExact( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c, const vec<2, T>& d )
+{
+   typedef predicate_arithmetic_t<T> arith;
+   const vec<2, T> points[4] = { a, b, c, d };
+   T x[4], y[4], lifts[4][4];
+   const T* z[4];
+   int zLength[4];
+   for (int i = 0; i < 4; ++i)
+   {
+      x[i] = points[i].x;
+      y[i] = points[i].y;
+      T xx[2], yy[2];
+      arith::twoProduct( x[i], x[i], xx[1], xx[0] );
+      arith::twoProduct( y[i], y[i], yy[1], yy[0] );
+      zLength[i] = arith::sum( xx, 2, yy, 2, lifts[i] );
+      z[i] = lifts[i];
+   }
+   return exactLiftedDeterminant( x, y, z, zLength );
+}
+
+/**
+ * Position of a point against the circle through three points: positive
+ * when d lies inside the circle through a, b and c, these being in counter
+ * clockwise order, negative outside, zero on the circle. The sign flips when
+ * a, b and c are clockwise.
+ *
+ * Filtered like orient2d: the sign is always exact.
+ */
+template< class T >
+inline T incircle( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c, const vec<2, T>& d )
+{
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const vec<2, T> ad = a - d, bd = b - d, cd = c - d;
+   const T bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+   const T cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+   const T adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+   const T aLift = ad.x * ad.x + ad.y * ad.y;
+   const T bLift = bd.x * bd.x + bd.y * bd.y;
+   const T cLift = cd.x * cd.x + cd.y * cd.y;
+   const T det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+   const T permanent = (std::abs( bdxcdy ) + std::abs( cdxbdy )) * aLift + (std::abs( cdxady ) + std::abs( adxcdy )) * bLift
+                     + (std::abs( adxbdy ) + std::abs( bdxady )) * cLift;
+   const T bound = (T(10) + T(96) * eps) * eps * permanent;
+   if (det > bound || -det > bound)
+      return det;
+   return incircleExact( a, b, c, d );
+}
+
+/** Sign of a predicate value as -1, 0 or 1. */
+template< class T >
+inline int predicateSign( const T& value )
+{
+   return (value > T(0)) - (value < T(0));
+}
+
+/**
+ * Classifies points against the line through a and b: signs[i] receives
+ * the sign of orient2d( a, b, points[i] ), 1 on the left.
+ *
+ * The filter runs over blocks of 16 points in a branch free loop the
+ * compiler vectorizes; only the points it cannot decide go through the
+ * exact arithmetic.
+ */
+template< class T >
+inline void orient2dBatch( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>* points, size_t count, int* signs )
+{
+   const size_t blockSize = 16;
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const T errorBound = (T(3) + T(16) * eps) * eps;
+   T det[blockSize], bound[blockSize];
+   for (size_t base = 0; base < count; base += blockSize)
+   {
+      const size_t n = std::min( blockSize, count - base );
+      for (size_t i = 0; i < n; ++i)
+      {
+         const vec<2, T>& c = points[base + i];
+         const T left = (a.x - c.x) * (b.y - c.y);
+         const T right = (a.y - c.y) * (b.x - c.x);
+         det[i] = left - right;
+         bound[i] = errorBound * (std::abs( left ) + std::abs( right ));
+      }
+      for (size_t i = 0; i < n; ++i)
+         signs[base + i] = std::abs( det[i] ) > bound[i] ? predicateSign( det[i] ) : predicateSign( orient2dExact( a, b, points[base + i] ) );
+   }
+}
+
+/**
+ * Classifies points against the plane through a, b and c: signs[i]
+ * receives the sign of orient3d( a, b, c, points[i] ). Filtered by blocks
+ * as orient2dBatch.
+ */
+template< class T >
+inline void orient3dBatch( const vec<3, T>& a, const vec<3, T>& b, const vec<3, T>& c, const vec<3, T>* points, size_t count, int* signs )
+{
+   const size_t blockSize = 16;
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const T errorBound = (T(7) + T(56) * eps) * eps;
+   T det[blockSize], bound[blockSize];
+   for (size_t base = 0; base < count; base += blockSize)
+   {
+      const size_t n = std::min( blockSize, count - base );
+      for (size_t i = 0; i < n; ++i)
+      {
+         const vec<3, T>& d = points[base + i];
+         const vec<3, T> ad = a - d, bd = b - d, cd = c - d;
+         const T bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+         const T cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+         const T adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+         det[i] = ad.z * (bdxcdy - cdxbdy) + bd.z * (cdxady - adxcdy) + cd.z * (adxbdy - bdxady);
+         bound[i] = errorBound * ((std::abs( bdxcdy ) + std::abs( cdxbdy )) * std::abs( ad.z ) + (std::abs( cdxady ) + std::abs( adxcdy )) * std::abs( bd.z )
+                                  + (std::abs( adxbdy ) + std::abs( bdxady )) * std::abs( cd.z ));
+      }
+      for (size_t i = 0; i < n; ++i)
+         signs[base + i] = std::abs( det[i] ) > bound[i] ? predicateSign( det[i] ) : predicateSign( orient3dExact( a, b, c, points[base + i] ) );
+   }
+}
+
+/**
+ * Classifies points against the circle through a, b and c: signs[i]
+ * receives the sign of incircle( a, b, c, points[i] ). Filtered by blocks
+ * as orient2dBatch.
+ */
+template< class T >
+inline void incircleBatch( const vec<2, T>& a, const vec<2, T>& b, const vec<2, T>& c, const vec<2, T>* points, size_t count, int* signs )
+{
+   const size_t blockSize = 16;
+   const T eps = predicate_arithmetic_t<T>::epsilon();
+   const T errorBound = (T(10) + T(96) * eps) * eps;
+   T det[blockSize], bound[blockSize];
+   for (size_t base = 0; base < count; base += blockSize)
+   {
+      const size_t n = std::min( blockSize, count - base );
+      for (size_t i = 0; i < n; ++i)
+      {
+         const vec<2, T>& d = points[base + i];
+         const vec<2, T> ad = a - d, bd = b - d, cd = c - d;
+         const T bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+         const T cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+         const T adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+         const T aLift = ad.x * ad.x + ad.y * ad.y;
+         const T bLift = bd.x * bd.x + bd.y * bd.y;
+         const T cLift = cd.x * cd.x + cd.y * cd.y;
+         det[i] = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+         bound[i] = errorBound * ((std::abs( bdxcdy ) + std::abs( cdxbdy )) * aLift + (std::abs( cdxady ) + std::abs( adxcdy )) * bLift
+                                  + (std::abs( adxbdy ) + std::abs( bdxady )) * cLift);
+      }
+      for (size_t i = 0; i < n; ++i)
+         signs[base + i] = std::abs( det[i] ) > bound[i] ? predicateSign( det[i] ) : predicateSign( incircleExact( a, b, c, points[base + i] ) );
+   }
+}
+
+}
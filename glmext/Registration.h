@@ -0,0 +1,440 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "KdTree.h"
+
+namespace glm
+{
+
+/**
+ * Singular value decomposition of a 3x3 matrix, a = u * diag( s ) * transpose( v ),
+ * by one sided Jacobi rotations (Hestenes).
+ *
+ * Column pairs of a are rotated until orthogonal; the column lengths are then
+ * the singular values, sorted in decreasing order. u and v are orthogonal; when
+ * a is rank deficient the columns of u for zero singular values are completed
+ * to an orthonormal basis.
+ *
+ * @param a       the matrix to decompose
+ * @param u       receives the left singular vectors, as columns
+ * @param s       receives the singular values
+ * @param v       receives the right singular vectors, as columns
+ * @param sweeps  the maximum number of sweeps over the column pairs
+ */
+template< class T >
+inline void svd3Jacobi( const mat<3, 3, T>& a, mat<3, 3, T>& u, vec<3, T>& s, mat<3, 3, T>& v, int sweeps = 12 )
+{
+   const T eps = std::numeric_limits<T>::epsilon();
+   u = a;
+   v = mat<3, 3, T>( T(1) );
+   for (int sweep = 0; sweep < sweeps; ++sweep)
+   {
+      bool rotated = false;
+      for (int p = 0; p < 2; ++p)
+         for (int q = p + 1; q < 3; ++q)
+         {
+            const T alpha = dot( u[p], u[p] );
+            const T beta = dot( u[q], u[q] );
+            const T gamma = dot( u[p], u[q] );
+            if (abs( gamma ) <= eps * sqrt( alpha * beta ) || gamma == T(0))
+               continue;
+            rotated = true;
+            const T zeta = (beta - alpha) / (T(2) * gamma);
+            const T t = (zeta < T(0) ? T(-1) : T(1)) / (abs( zeta ) + sqrt( T(1) + zeta * zeta ));
+            const T c = T(1) / sqrt( T(1) + t * t );
+            const T sn = c * t;
+            const vec<3, T> up = u[p], vp = v[p];
+            u[p] = c * up - sn * u[q];
+            u[q] = sn * up + c * u[q];
+            v[p] = c * vp - sn * v[q];
+            v[q] = sn * vp + c * v[q];
+         }
+      if (!rotated)
+         break;
+   }
+
+   for (int i = 0; i < 3; ++i)
+      s[i] = length( u[i] );
+
+   // Sort decreasing, keeping the columns of u and v paired
+   for (int i = 0; i < 2; ++i)
+      for (int j = 2; j > i; --j)
+         if (s[j] > s[j - 1])
+         {
+            std::swap( s[j], s[j - 1] );
+            std::swap( u[j], u[j - 1] );
+            std::swap( v[j], v[j - 1] );
+         }
+
+   const T tiny = eps * max( s[0], std::numeric_limits<T>::min() ) * T(8);
+   for (int i = 0; i < 3; ++i)
+   {
+      if (s[i] > tiny)
+      {
+         u[i] /= s[i];
+         continue;
+      }
+      // Complete the basis: orthogonal to the previous columns
+      if (i == 2)
+         u[2] = cross( u[0], u[1] );
+      else
+      {
+         vec<3, T> axis( 0 );
+         const vec<3, T> n = i == 0 ? vec<3, T>( 0 ) : u[0];
+         axis[abs( n.x ) < abs( n.y ) ? (abs( n.x ) < abs( n.z ) ? 0 : 2) : (abs( n.y ) < abs( n.z ) ? 1 : 2)] = T(1);
+         u[i] = normalize( axis - n * dot( axis, n ) );
+      }
+      s[i] = T(0);
+   }
+}
+
+/**
+ * Finds the rigid transform, rotation then translation, that best maps the
+ * source points onto the target points in the weighted least squares sense
+ * (Kabsch). Reflections are excluded: the rotation always has determinant 1.
+ *
+ * @param source       the source points
+ * @param target       the target points, paired with the source ones
+ * @param weights      the weights of the pairs, or NULL for unit weights
+ * @param count        the number of pairs
+ * @param rotation     receives the rotation
+ * @param translation  receives the translation
+ *
+ * @return  false when the total weight is zero, leaving the transform to identity
+ */
+template< class T >
+inline bool kabsch( const vec<3, T>* source, const vec<3, T>* target, const T* weights, size_t count,
+                    mat<3, 3, T>& rotation, vec<3, T>& translation )
+{
+   rotation = mat<3, 3, T>( T(1) );
+   translation = vec<3, T>( 0 );
+
+   T total( 0 );
+   vec<3, T> sourceCenter( 0 ), targetCenter( 0 );
+   for (size_t i = 0; i < count; ++i)
+   {
+      const T w = weights ? weights[i] : T(1);
+      total += w;
+      sourceCenter += w * source[i];
+      targetCenter += w * target[i];
+   }
+   if (!(total > T(0)))
+      return false;
+   sourceCenter /= total;
+   targetCenter /= total;
+
+   // h = sum of w (s - cs) (t - ct)^T
+   mat<3, 3, T> h( T(0) );
+   for (size_t i = 0; i < count; ++i)
+   {
+      const T w = weights ? weights[i] : T(1);
+      h += outerProduct( w * (source[i] - sourceCenter), target[i] - targetCenter );
+   }
+
+   mat<3, 3, T> u, v;
+   vec<3, T> s;
+   svd3Jacobi( h, u, s, v );
+   mat<3, 3, T> d( T(1) );
+   d[2][2] = determinant( v * transpose( u ) ) < T(0) ? T(-1) : T(1);
+   rotation = v * d * transpose( u );
+   translation = targetCenter - rotation * sourceCenter;
+   return true;
+}
+
+/** Robust kernels for the ICP residuals. */
+enum RobustKernel
+{
+   ROBUST_NONE,
+   /** Unit weight up to the scale, then scale / r. */
+   ROBUST_HUBER,
+   /** (1 - (r / scale)^2)^2 up to the scale, then 0. */
+   ROBUST_TUKEY
+};
+
+/**
+ * Gets the weight of a residual under a robust kernel.
+ *
+ * @param kernel    the kernel
+ * @param residual  the absolute residual
+ * @param scale     the kernel scale
+ */
+template< class T >
+inline T robustWeight( RobustKernel kernel, const T& residual, const T& scale )
+{
+   switch (kernel)
+   {
+   case ROBUST_HUBER:
+      return residual <= scale ? T(1) : scale / residual;
+   case ROBUST_TUKEY:
+   {
+      if (residual >= scale)
+         return T(0);
+      const T x = residual / scale;
+      return (T(1) - x * x) * (T(1) - x * x);
+   }
+   default:
+      return T(1);
+   }
+}
+
+/**
+ * ICP parameters.
+ */
+template<class T>
+struct icp_params_t
+{
+   icp_params_t()
+      : mMaxIterations( 30 ), mMaxCorrespondenceDistance( std::numeric_limits<T>::max() ),
+        mTolerance( static_cast<T>(1e-6) ), mPointToPlane( false ), mKernel( ROBUST_NONE ), mKernelScale( 1 )
+   {}
+
+   int mMaxIterations;
+
+   /** Source points farther than this from their nearest target point are not matched. */
+   T mMaxCorrespondenceDistance;
+
+   /** Stops when the RMS error changes by less than this between iterations. */
+   T mTolerance;
+
+   /** Minimizes the distances to the target tangent planes, needs the target normals. */
+   bool mPointToPlane;
+
+   RobustKernel mKernel;
+   T mKernelScale;
+};
+
+/**
+ * ICP result: the transform maps the source points onto the target.
+ */
+template<class T>
+struct icp_result_t
+{
+   icp_result_t()
+      : mRotation( T(1) ), mTranslation( 0 ), mRmsError( 0 ), mIterations( 0 ), mCorrespondences( 0 )
+   {}
+
+   mat<3, 3, T> mRotation;
+   vec<3, T> mTranslation;
+
+   /** RMS of the residuals of the last correspondences, before the robust weights. */
+   T mRmsError;
+
+   int mIterations;
+   size_t mCorrespondences;
+};
+
+/**
+ * Matches the source points [first, first + count), moved by a rigid
+ * transform, to their nearest target points.
+ *
+ * Each point only writes its own slot, so calls on disjoint ranges may run on
+ * different threads: this is the expensive part of an ICP iteration.
+ *
+ * @param target          the k-d tree over the target points
+ * @param source          the source points
+ * @param first           the first source point to match
+ * @param count           the number of source points to match
+ * @param rotation        the rotation applied to the source points
+ * @param translation     the translation applied to the source points
+ * @param maxDistance     the maximum correspondence distance
+ * @param matches         receives, per source point, the tree order position of its target point, or target.size() if none
+ */
+template< class T >
+inline void findCorrespondences( const kd_tree_t<3, T>& target, const vec<3, T>* source, size_t first, size_t count,
+                                 const mat<3, 3, T>& rotation, const vec<3, T>& translation, const T& maxDistance,
+                                 size_t* matches )
+{
+   const T maxDistance2 = maxDistance < sqrt( std::numeric_limits<T>::max() ) ? maxDistance * maxDistance : std::numeric_limits<T>::max();
+   for (size_t i = first; i < first + count; ++i)
+      matches[i] = target.findNearest( rotation * source[i] + translation, maxDistance2 );
+}
+
+/**
+ * Solves one linearized point to plane step: the small rotation, as a
+ * rotation vector, and translation minimizing the weighted sum of
+ * ((p + r x p + t - q) . n)^2 over the pairs.
+ *
+ * @return  false when the normal equations are singular
+ */
+template< class T >
+inline bool solvePointToPlane( const vec<3, T>* points, const vec<3, T>* targets, const vec<3, T>* normals,
+                               const T* weights, size_t count, vec<3, T>& rotationVector, vec<3, T>& translation )
+{
+   // Normal equations a x = b of the 6 unknowns, rows augmented with b
+   T a[6][7] = {};
+   for (size_t i = 0; i < count; ++i)
+   {
+      const vec<3, T> c = cross( points[i], normals[i] );
+      const T j[6] = { c.x, c.y, c.z, normals[i].x, normals[i].y, normals[i].z };
+      const T r = dot( targets[i] - points[i], normals[i] );
+      const T w = weights ? weights[i] : T(1);
+      for (int row = 0; row < 6; ++row)
+      {
+         for (int col = row; col < 6; ++col)
+            a[row][col] += w * j[row] * j[col];
+         a[row][6] += w * j[row] * r;
+      }
+   }
+   for (int row = 1; row < 6; ++row)
+      for (int col = 0; col < row; ++col)
+         a[row][col] = a[col][row];
+
+   // Gaussian elimination with partial pivoting
+   T scale( 0 );
+   for (int row = 0; row < 6; ++row)
+      scale = max( scale, abs( a[row][row] ) );
+   for (int k = 0; k < 6; ++k)
+   {
+      int pivot = k;
+      for (int row = k + 1; row < 6; ++row)
+         if (abs( a[row][k] ) > abs( a[pivot][k] ))
+            pivot = row;
+      if (!(abs( a[pivot][k] ) > scale * std::numeric_limits<T>::epsilon() * T(64)))
+         return false;
+      for (int col = 0; col < 7; ++col)
+         std::swap( a[k][col], a[pivot][col] );
+      for (int row = k + 1; row < 6; ++row)
+      {
+         const T f = a[row][k] / a[k][k];
+         for (int col = k; col < 7; ++col)
+            a[row][col] -= f * a[k][col];
+      }
+   }
+   T x[6];
+   for (int k = 5; k >= 0; --k)
+   {
+      T sum = a[k][6];
+      for (int col = k + 1; col < 6; ++col)
+         sum -= a[k][col] * x[col];
+      x[k] = sum / a[k][k];
+   }
+   rotationVector = vec<3, T>( x[0], x[1], x[2] );
+   translation = vec<3, T>( x[3], x[4], x[5] );
+   return true;
+}
+
+/**
+ * Runs the transform update of one ICP iteration from the correspondences
+ * found by findCorrespondences, and returns the RMS residual of the matched
+ * pairs, measured before the update.
+ *
+ * @param target         the k-d tree over the target points
+ * @param targetNormals  the unit normals of the target points, in input order, for point to plane
+ * @param source         the source points
+ * @param sourceCount    the number of source points
+ * @param matches        the correspondences
+ * @param params         the parameters
+ * @param result         holds the current transform, receives the updated one
+ */
+template< class T >
+inline T icpUpdate( const kd_tree_t<3, T>& target, const vec<3, T>* targetNormals,
+                    const vec<3, T>* source, size_t sourceCount, const size_t* matches,
+                    const icp_params_t<T>& params, icp_result_t<T>& result )
+{
+   std::vector< vec<3, T> > points, targets, normals;
+   std::vector<T> weights;
+   points.reserve( sourceCount );
+   targets.reserve( sourceCount );
+   weights.reserve( sourceCount );
+   const bool pointToPlane = params.mPointToPlane && targetNormals;
+   if (pointToPlane)
+      normals.reserve( sourceCount );
+
+   T sum2( 0 );
+   for (size_t i = 0; i < sourceCount; ++i)
+   {
+      if (matches[i] >= target.size())
+         continue;
+      const vec<3, T> p = result.mRotation * source[i] + result.mTranslation;
+      const vec<3, T> q = target.getPoint( matches[i] );
+      const vec<3, T>& n = pointToPlane ? targetNormals[target.getIndex( matches[i] )] : q;
+      const T residual = pointToPlane ? abs( dot( q - p, n ) ) : distance( p, q );
+      sum2 += residual * residual;
+      points.push_back( p );
+      targets.push_back( q );
+      weights.push_back( robustWeight( params.mKernel, residual, params.mKernelScale ) );
+      if (pointToPlane)
+         normals.push_back( n );
+   }
+   result.mCorrespondences = points.size();
+   if (points.empty())
+      return T(0);
+
+   mat<3, 3, T> rotation;
+   vec<3, T> translation;
+   bool solved;
+   if (pointToPlane)
+   {
+      vec<3, T> rotationVector( T(0) );
+      solved = solvePointToPlane( &points[0], &targets[0], &normals[0], &weights[0], points.size(), rotationVector, translation );
+      const T angle = length( rotationVector );
+      rotation = angle > T(0) ? mat3_cast( angleAxis( angle, rotationVector / angle ) ) : mat<3, 3, T>( T(1) );
+   }
+   else
+      solved = kabsch( &points[0], &targets[0], &weights[0], points.size(), rotation, translation );
+
+   // The increment applies to the moved points: compose it after the current transform
+   if (solved)
+   {
+      result.mRotation = rotation * result.mRotation;
+      result.mTranslation = rotation * result.mTranslation + translation;
+   }
+   return sqrt( sum2 / static_cast<T>(points.size()) );
+}
+
+/**
+ * Aligns the source points onto the target points with iterative closest
+ * points.
+ *
+ * Each iteration matches the moved source points to their nearest target
+ * points with findCorrespondences, weights the residuals with the robust
+ * kernel, then updates the transform: in closed form with kabsch, or with one
+ * linearized point to plane step. The transform starts from the one in
+ * result.
+ *
+ * The correspondence search runs in one call over all points; to spread it
+ * over threads, run the iterations yourself with findCorrespondences on
+ * chunks of the source points followed by icpUpdate.
+ *
+ * @param target         the k-d tree over the target points
+ * @param targetNormals  the unit normals of the target points, in input order, for point to plane
+ * @param source         the source points
+ * @param sourceCount    the number of source points
+ * @param params         the parameters
+ * @param result         holds the initial transform, receives the final one
+ */
+template< class T >
+inline void alignICP( const kd_tree_t<3, T>& target, const vec<3, T>* targetNormals,
+                      const vec<3, T>* source, size_t sourceCount,
+                      const icp_params_t<T>& params, icp_result_t<T>& result )
+{
+   std::vector<size_t> matches( sourceCount );
+   T previous = std::numeric_limits<T>::max();
+   result.mIterations = 0;
+   if (sourceCount == 0 || target.size() == 0)
+      return;
+   for (int iteration = 0; iteration < params.mMaxIterations; ++iteration)
+   {
+      findCorrespondences( target, source, 0, sourceCount, result.mRotation, result.mTranslation,
+                           params.mMaxCorrespondenceDistance, &matches[0] );
+      result.mRmsError = icpUpdate( target, targetNormals, source, sourceCount, &matches[0], params, result );
+      result.mIterations = iteration + 1;
+      if (result.mCorrespondences == 0 || abs( previous - result.mRmsError ) < params.mTolerance)
+         break;
+      previous = result.mRmsError;
+   }
+}
+
+// --- helper types --- //
+typedef icp_params_t<float>    icp_paramsf;
+typedef icp_params_t<double>   icp_paramsd;
+typedef icp_result_t<float>    icp_resultf;
+typedef icp_result_t<double>   icp_resultd;
+
+}
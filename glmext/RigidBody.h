@@ -0,0 +1,474 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Units.h"
+
+namespace glm
+{
+
+/**
+ * Rigid body state in structure of arrays layout: body i is entry i of
+ * every array, so the per body passes stream through contiguous vec3,
+ * quaternion and mat3 arrays.
+ *
+ * Bodies with a zero inverse mass are static: the integrator and the
+ * solver never move them.
+ *
+ * The per body functions come in ranges [first, first + count). Calls on
+ * disjoint ranges touch disjoint bodies and may run on different threads.
+ *
+ * @param T     the internal type used for the body state
+ * @ingroup Types
+ */
+template<class T>
+class rigid_body_set_t
+{
+public:
+   typedef T DataType;
+
+public:
+   /**
+    * Gets the number of bodies.
+    */
+   size_t size() const
+   {
+      return mPositions.size();
+   }
+
+   /**
+    * Removes all bodies, keeping the storage.
+    */
+   void clear()
+   {
+      mPositions.clear();
+      mOrientations.clear();
+      mLinearVelocities.clear();
+      mAngularVelocities.clear();
+      mForces.clear();
+      mTorques.clear();
+      mInverseMasses.clear();
+      mInverseInertiasLocal.clear();
+      mInverseInertiasWorld.clear();
+   }
+
+   /**
+    * Adds a body at rest.
+    *
+    * @param position      the center of mass
+    * @param orientation   the rotation from body space to world space
+    * @param mass          the mass, 0 for a static body
+    * @param inertia       the inertia tensor about the center of mass, in body space
+    *
+    * @return  the index of the body
+    */
+   uint32_t addBody( const vec<3, T>& position, const qua<T>& orientation, const T& mass, const mat<3, 3, T>& inertia )
+   {
+      const bool dynamic = mass > T(0);
+      mPositions.push_back( position );
+      mOrientations.push_back( normalize( orientation ) );
+      mLinearVelocities.push_back( vec<3, T>( 0 ) );
+      mAngularVelocities.push_back( vec<3, T>( 0 ) );
+      mForces.push_back( vec<3, T>( 0 ) );
+      mTorques.push_back( vec<3, T>( 0 ) );
+      mInverseMasses.push_back( dynamic ? T(1) / mass : T(0) );
+      mInverseInertiasLocal.push_back( dynamic ? inverse( inertia ) : mat<3, 3, T>( T(0) ) );
+      const mat<3, 3, T> rotation = mat3_cast( mOrientations.back() );
+      mInverseInertiasWorld.push_back( rotation * mInverseInertiasLocal.back() * transpose( rotation ) );
+      return static_cast<uint32_t>(mPositions.size() - 1);
+   }
+
+public:
+   std::vector< vec<3, T> > mPositions;
+   std::vector< qua<T> > mOrientations;
+   std::vector< vec<3, T> > mLinearVelocities;
+   std::vector< vec<3, T> > mAngularVelocities;
+
+   /** Forces and torques accumulated until the next integrateVelocities, which clears them. */
+   std::vector< vec<3, T> > mForces;
+   std::vector< vec<3, T> > mTorques;
+
+   std::vector<T> mInverseMasses;
+   std::vector< mat<3, 3, T> > mInverseInertiasLocal;
+
+   /** The inverse inertia tensors rotated to world space, see updateWorldInertias. */
+   std::vector< mat<3, 3, T> > mInverseInertiasWorld;
+};
+
+/**
+ * Inertia tensor of a solid box.
+ *
+ * @param mass         the mass of the box
+ * @param halfExtents  the half size of the box along each axis
+ */
+template< class T >
+inline mat<3, 3, T> boxInertia( const T& mass, const vec<3, T>& halfExtents )
+{
+   const vec<3, T> s = halfExtents * halfExtents;
+   const T k = mass / T(3);
+   mat<3, 3, T> result( T(0) );
+   result[0][0] = k * (s.y + s.z);
+   result[1][1] = k * (s.x + s.z);
+   result[2][2] = k * (s.x + s.y);
+   return result;
+}
+
+/**
+ * Inertia tensor of a solid sphere.
+ */
+template< class T >
+inline mat<3, 3, T> sphereInertia( const T& mass, const T& radius )
+{
+   return mat<3, 3, T>( T(2) / T(5) * mass * radius * radius );
+}
+
+/**
+ * Rotates the inverse inertia tensors of the bodies [first, first + count)
+ * to world space: R * I^-1 * R^T, R the orientation matrix.
+ */
+template< class T >
+inline void updateWorldInertias( rigid_body_set_t<T>& bodies, size_t first, size_t count )
+{
+   if (count == 0)
+      return;
+   const qua<T>* orientations = &bodies.mOrientations[0];
+   const mat<3, 3, T>* local = &bodies.mInverseInertiasLocal[0];
+   mat<3, 3, T>* world = &bodies.mInverseInertiasWorld[0];
+   for (size_t i = first; i < first + count; ++i)
+   {
+      const mat<3, 3, T> rotation = mat3_cast( orientations[i] );
+      world[i] = rotation * local[i] * transpose( rotation );
+   }
+}
+
+/**
+ * First half of a semi-implicit Euler step: applies gravity and the
+ * accumulated forces and torques to the velocities of the bodies
+ * [first, first + count), then clears the accumulators.
+ *
+ * @param gravity  the gravity acceleration
+ * @param dt       the time step
+ */
+template< class T >
+inline void integrateVelocities( rigid_body_set_t<T>& bodies, size_t first, size_t count, const vec<3, T>& gravity, const T& dt )
+{
+   if (count == 0)
+      return;
+   vec<3, T>* linear = &bodies.mLinearVelocities[0];
+   vec<3, T>* angular = &bodies.mAngularVelocities[0];
+   vec<3, T>* forces = &bodies.mForces[0];
+   vec<3, T>* torques = &bodies.mTorques[0];
+   const T* inverseMasses = &bodies.mInverseMasses[0];
+   const mat<3, 3, T>* inverseInertias = &bodies.mInverseInertiasWorld[0];
+   for (size_t i = first; i < first + count; ++i)
+   {
+      const T dynamic = inverseMasses[i] > T(0) ? T(1) : T(0);
+      linear[i] += (gravity * dynamic + forces[i] * inverseMasses[i]) * dt;
+      angular[i] += (inverseInertias[i] * torques[i]) * dt;
+      forces[i] = vec<3, T>( 0 );
+      torques[i] = vec<3, T>( 0 );
+   }
+}
+
+/**
+ * Second half of a semi-implicit Euler step: moves the bodies
+ * [first, first + count) with their solved velocities, integrates the
+ * orientations with dq/dt = 1/2 * (0, w) * q followed by a
+ * renormalization, and updates the world space inverse inertias.
+ */
+template< class T >
+inline void integratePositions( rigid_body_set_t<T>& bodies, size_t first, size_t count, const T& dt )
+{
+   if (count == 0)
+      return;
+   vec<3, T>* positions = &bodies.mPositions[0];
+   qua<T>* orientations = &bodies.mOrientations[0];
+   const vec<3, T>* linear = &bodies.mLinearVelocities[0];
+   const vec<3, T>* angular = &bodies.mAngularVelocities[0];
+   const T halfDt = dt / T(2);
+   for (size_t i = first; i < first + count; ++i)
+   {
+      positions[i] += linear[i] * dt;
+      const qua<T> spin = qua<T>( T(0), angular[i].x, angular[i].y, angular[i].z ) * orientations[i];
+      orientations[i] = normalize( orientations[i] + spin * halfDt );
+   }
+   updateWorldInertias( bodies, first, count );
+}
+
+/**
+ * Contact point between two bodies and its solver state.
+ *
+ * The collision detection fills mBodyA, mBodyB, mPoint, mNormal, pointing
+ * from A towards B, and mPenetration, positive when the bodies overlap.
+ * A negative penetration makes a speculative contact: the bodies may close
+ * the gap during the step but not pass through each other.
+ * Keep mNormalImpulse and mTangentImpulses from the previous frame for
+ * persistent contacts to warm start the solver, or zero them.
+ */
+template<class T>
+struct contact_constraint_t
+{
+   uint32_t mBodyA;
+   uint32_t mBodyB;
+   vec<3, T> mPoint;
+   vec<3, T> mNormal;
+   T mPenetration;
+   T mFriction;
+
+   T mNormalImpulse;
+   T mTangentImpulses[2];
+
+   // Solver state, set by prepareContacts
+   vec<3, T> mOffsetA;
+   vec<3, T> mOffsetB;
+   vec<3, T> mTangents[2];
+   T mNormalMass;
+   T mTangentMasses[2];
+   T mBias;
+};
+
+/**
+ * Parameters of the contact solver.
+ */
+template<class T>
+struct contact_solver_params_t
+{
+   contact_solver_params_t()
+      : mBaumgarte( static_cast<T>(0.2) ), mSlop( static_cast<T>(0.005) ), mIterations( 10 ), mWarmStart( true )
+   {}
+
+   /** The fraction of the penetration resolved per step. */
+   T mBaumgarte;
+
+   /** The penetration allowed without correction, which keeps resting contacts stable. */
+   T mSlop;
+
+   int mIterations;
+   bool mWarmStart;
+};
+
+/**
+ * Sorts contacts into batches in which no two contacts share a dynamic
+ * body, by greedy graph coloring. Contacts of a batch can then be solved
+ * in any order, or in parallel, with the same result; the batches must
+ * still run one after the other.
+ *
+ * @param contacts      the contacts, reordered in place batch by batch
+ * @param count         the number of contacts
+ * @param bodies        the bodies, static ones may appear in every batch
+ * @param batchOffsets  receives the first contact of each batch followed by count
+ */
+template< class T >
+inline void colorContacts( contact_constraint_t<T>* contacts, size_t count, const rigid_body_set_t<T>& bodies,
+                           std::vector<uint32_t>& batchOffsets )
+{
+   batchOffsets.clear();
+   std::vector<uint32_t> stamps( bodies.size(), 0 );
+   std::vector<uint8_t> assigned( count, 0 );
+   std::vector< contact_constraint_t<T> > sorted;
+   sorted.reserve( count );
+
+   uint32_t batch = 0;
+   size_t firstPending = 0;
+   while (sorted.size() < count)
+   {
+      ++batch;
+      batchOffsets.push_back( static_cast<uint32_t>(sorted.size()) );
+      while (firstPending < count && assigned[firstPending])
+         ++firstPending;
+      for (size_t i = firstPending; i < count; ++i)
+      {
+         if (assigned[i])
+            continue;
+         const uint32_t a = contacts[i].mBodyA, b = contacts[i].mBodyB;
+         const bool dynamicA = bodies.mInverseMasses[a] > T(0);
+         const bool dynamicB = bodies.mInverseMasses[b] > T(0);
+         if ((dynamicA && stamps[a] == batch) || (dynamicB && stamps[b] == batch))
+            continue;
+         if (dynamicA)
+            stamps[a] = batch;
+         if (dynamicB)
+            stamps[b] = batch;
+         assigned[i] = 1;
+         sorted.push_back( contacts[i] );
+      }
+   }
+   batchOffsets.push_back( static_cast<uint32_t>(count) );
+   std::copy( sorted.begin(), sorted.end(), contacts );
+}
+
+/**
+ * Computes the contact offsets, tangents, effective masses and position
+ * bias of the contacts [first, first + count), and applies their warm
+ * start impulses when enabled.
+ *
+ * Warm starting writes the velocities of the dynamic bodies only, so with
+ * several threads prepare one batch of colorContacts at a time, like the
+ * solver.
+ */
+template< class T >
+inline void prepareContacts( rigid_body_set_t<T>& bodies, contact_constraint_t<T>* contacts, size_t first, size_t count,
+                             const T& dt, const contact_solver_params_t<T>& params )
+{
+   for (size_t i = first; i < first + count; ++i)
+   {
+      contact_constraint_t<T>& c = contacts[i];
+      const uint32_t a = c.mBodyA, b = c.mBodyB;
+      const T inverseMassA = bodies.mInverseMasses[a];
+      const T inverseMassB = bodies.mInverseMasses[b];
+      const mat<3, 3, T>& inverseInertiaA = bodies.mInverseInertiasWorld[a];
+      const mat<3, 3, T>& inverseInertiaB = bodies.mInverseInertiasWorld[b];
+      c.mOffsetA = c.mPoint - bodies.mPositions[a];
+      c.mOffsetB = c.mPoint - bodies.mPositions[b];
+
+      // Tangent basis, Duff et al. "Building an Orthonormal Basis, Revisited"
+      const vec<3, T>& n = c.mNormal;
+      const T sign = n.z >= T(0) ? T(1) : T(-1);
+      const T p = T(-1) / (sign + n.z);
+      const T q = n.x * n.y * p;
+      c.mTangents[0] = vec<3, T>( T(1) + sign * n.x * n.x * p, sign * q, -sign * n.x );
+      c.mTangents[1] = vec<3, T>( q, sign + n.y * n.y * p, -n.y );
+
+      const vec<3, T> axes[3] = { n, c.mTangents[0], c.mTangents[1] };
+      T masses[3];
+      for (int k = 0; k < 3; ++k)
+      {
+         const vec<3, T> ra = cross( c.mOffsetA, axes[k] );
+         const vec<3, T> rb = cross( c.mOffsetB, axes[k] );
+         const T k0 = inverseMassA + inverseMassB + dot( ra, inverseInertiaA * ra ) + dot( rb, inverseInertiaB * rb );
+         masses[k] = k0 > T(0) ? T(1) / k0 : T(0);
+      }
+      c.mNormalMass = masses[0];
+      c.mTangentMasses[0] = masses[1];
+      c.mTangentMasses[1] = masses[2];
+      c.mBias = c.mPenetration < T(0) ? c.mPenetration / dt : params.mBaumgarte / dt * max( c.mPenetration - params.mSlop, T(0) );
+
+      if (!params.mWarmStart)
+      {
+         c.mNormalImpulse = T(0);
+         c.mTangentImpulses[0] = T(0);
+         c.mTangentImpulses[1] = T(0);
+         continue;
+      }
+      const vec<3, T> impulse = n * c.mNormalImpulse + c.mTangents[0] * c.mTangentImpulses[0] + c.mTangents[1] * c.mTangentImpulses[1];
+      if (inverseMassA > T(0))
+      {
+         bodies.mLinearVelocities[a] -= impulse * inverseMassA;
+         bodies.mAngularVelocities[a] -= inverseInertiaA * cross( c.mOffsetA, impulse );
+      }
+      if (inverseMassB > T(0))
+      {
+         bodies.mLinearVelocities[b] += impulse * inverseMassB;
+         bodies.mAngularVelocities[b] += inverseInertiaB * cross( c.mOffsetB, impulse );
+      }
+   }
+}
+
+/**
+ * One sequential impulse iteration over the contacts [first, first + count):
+ * non penetration impulses clamped to push only, then Coulomb friction
+ * impulses clamped by the friction cone of the current normal impulse.
+ *
+ * Contacts of a batch of colorContacts touch different dynamic bodies, and
+ * static bodies are only read, so disjoint ranges of one batch may run on
+ * different threads.
+ */
+template< class T >
+inline void solveContactRange( rigid_body_set_t<T>& bodies, contact_constraint_t<T>* contacts, size_t first, size_t count )
+{
+   if (count == 0)
+      return;
+   vec<3, T>* linear = &bodies.mLinearVelocities[0];
+   vec<3, T>* angular = &bodies.mAngularVelocities[0];
+   const T* inverseMasses = &bodies.mInverseMasses[0];
+   const mat<3, 3, T>* inverseInertias = &bodies.mInverseInertiasWorld[0];
+   for (size_t i = first; i < first + count; ++i)
+   {
+      contact_constraint_t<T>& c = contacts[i];
+      const uint32_t a = c.mBodyA, b = c.mBodyB;
+
+      // Normal first, so friction sees this iteration's normal impulse
+      for (int k = 0; k < 3; ++k)
+      {
+         const vec<3, T>& axis = k == 0 ? c.mNormal : c.mTangents[k - 1];
+         const vec<3, T> relative = linear[b] + cross( angular[b], c.mOffsetB ) - linear[a] - cross( angular[a], c.mOffsetA );
+         const T speed = dot( relative, axis );
+         T delta;
+         if (k == 0)
+         {
+            const T previous = c.mNormalImpulse;
+            c.mNormalImpulse = max( previous + c.mNormalMass * (c.mBias - speed), T(0) );
+            delta = c.mNormalImpulse - previous;
+         }
+         else
+         {
+            const T limit = c.mFriction * c.mNormalImpulse;
+            const T previous = c.mTangentImpulses[k - 1];
+            c.mTangentImpulses[k - 1] = clamp( previous - c.mTangentMasses[k - 1] * speed, -limit, limit );
+            delta = c.mTangentImpulses[k - 1] - previous;
+         }
+         const vec<3, T> impulse = axis * delta;
+         if (inverseMasses[a] > T(0))
+         {
+            linear[a] -= impulse * inverseMasses[a];
+            angular[a] -= inverseInertias[a] * cross( c.mOffsetA, impulse );
+         }
+         if (inverseMasses[b] > T(0))
+         {
+            linear[b] += impulse * inverseMasses[b];
+            angular[b] += inverseInertias[b] * cross( c.mOffsetB, impulse );
+         }
+      }
+   }
+}
+
+/**
+ * Solves colored contacts: prepares them and runs params.mIterations
+ * sequential impulse iterations over the batches, in order.
+ *
+ * @param batchOffsets  the batches from colorContacts
+ */
+template< class T >
+inline void solveContacts( rigid_body_set_t<T>& bodies, contact_constraint_t<T>* contacts, const std::vector<uint32_t>& batchOffsets,
+                           const T& dt, const contact_solver_params_t<T>& params )
+{
+   if (batchOffsets.size() < 2)
+      return;
+   const size_t count = batchOffsets.back();
+   prepareContacts( bodies, contacts, 0, count, dt, params );
+   for (int iteration = 0; iteration < params.mIterations; ++iteration)
+      for (size_t batch = 0; batch + 1 < batchOffsets.size(); ++batch)
+         solveContactRange( bodies, contacts, batchOffsets[batch], batchOffsets[batch + 1] - batchOffsets[batch] );
+}
+
+/**
+ * Advances all of the bodies by one time step: velocity integration,
+ * contact solving and position integration.
+ *
+ * @param contacts      the contacts of the step, colored in place
+ * @param contactCount  the number of contacts
+ */
+template< class T >
+inline void stepRigidBodies( rigid_body_set_t<T>& bodies, contact_constraint_t<T>* contacts, size_t contactCount,
+                             const vec<3, T>& gravity, const T& dt, const contact_solver_params_t<T>& params )
+{
+   std::vector<uint32_t> batchOffsets;
+   integrateVelocities( bodies, 0, bodies.size(), gravity, dt );
+   colorContacts( contacts, contactCount, bodies, batchOffsets );
+   solveContacts( bodies, contacts, batchOffsets, dt, params );
+   integratePositions( bodies, 0, bodies.size(), dt );
+}
+
+// --- helper types --- //
+typedef rigid_body_set_t<float>            rigid_body_setf;
+typedef rigid_body_set_t<double>           rigid_body_setd;
+typedef contact_constraint_t<float>        contact_constraintf;
+typedef contact_constraint_t<double>       contact_constraintd;
+typedef contact_solver_params_t<float>     contact_solver_paramsf;
+typedef contact_solver_params_t<double>    contact_solver_paramsd;
+
+}
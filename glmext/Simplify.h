@@ -0,0 +1,581 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace glm
+{
+
+/**
+ * Quadric error metric of Garland and Heckbert, "Surface Simplification
+ * Using Quadric Error Metrics". The squared distance to a set of planes is
+ * the quadratic form v^T Q v with v = (x, y, z, 1) and Q a symmetric 4x4
+ * matrix, stored here as its 10 distinct coefficients.
+ *
+ * @param T     the internal type used for the coefficients
+ * @ingroup Types
+ */
+template<class T>
+class quadric_t
+{
+public:
+   typedef T DataType;
+
+   /**
+    * Indices of the coefficients of Q in mA, upper triangle row by row.
+    */
+   enum Coefficient
+   {
+      XX = 0, XY = 1, XZ = 2, XW = 3,
+      YY = 4, YZ = 5, YW = 6,
+      ZZ = 7, ZW = 8,
+      WW = 9
+   };
+
+public:
+   /**
+    * Constructs the null quadric.
+    */
+   quadric_t()
+   {
+      std::fill( mA, mA + 10, T(0) );
+   }
+
+   /**
+    * Constructs the quadric of a plane, such as plane_t, all points of which
+    * satisfy dot( pt, normal ) = offset.
+    *
+    * @param normal  the unit plane normal
+    * @param offset  the plane offset
+    * @param weight  the weight of the plane, typically the area of the triangle it comes from
+    */
+   quadric_t( const vec<3, T>& normal, const T& offset, const T& weight )
+   {
+      const T p[4] = { normal.x, normal.y, normal.z, -offset };
+      int k = 0;
+      for (int r = 0; r < 4; ++r)
+         for (int c = r; c < 4; ++c)
+            mA[k++] = p[r] * p[c] * weight;
+   }
+
+   quadric_t& operator+=( const quadric_t& q )
+   {
+      for (int i = 0; i < 10; ++i)
+         mA[i] += q.mA[i];
+      return *this;
+   }
+
+   /**
+    * Gets the sum of the weighted squared distances from pt to the planes.
+    */
+   T evaluate( const vec<3, T>& pt ) const
+   {
+      const T x = pt.x, y = pt.y, z = pt.z;
+      return x * (mA[XX] * x + T(2) * (mA[XY] * y + mA[XZ] * z + mA[XW])) +
+             y * (mA[YY] * y + T(2) * (mA[YZ] * z + mA[YW])) +
+             z * (mA[ZZ] * z + T(2) * mA[ZW]) + mA[WW];
+   }
+
+   /**
+    * Finds the point minimizing the error by inverting the upper 3x3 block
+    * of Q.
+    *
+    * @param result  receives the minimum
+    *
+    * @return  false if the block is singular, such as for a single plane or
+    *          parallel planes, in which case result is left unchanged
+    */
+   bool findMinimum( vec<3, T>& result ) const
+   {
+      const mat<3, 3, T> a(
+         mA[XX], mA[XY], mA[XZ],
+         mA[XY], mA[YY], mA[YZ],
+         mA[XZ], mA[YZ], mA[ZZ] );
+      const T det = determinant( a );
+      const T trace = mA[XX] + mA[YY] + mA[ZZ];
+      if (!(abs( det ) > static_cast<T>(1e-5) * trace * trace * trace))
+         return false;
+
+      result = inverse( a ) * -vec<3, T>( mA[XW], mA[YW], mA[ZW] );
+      return true;
+   }
+
+public:
+   /**
+    * The coefficients of Q, see Coefficient.
+    */
+   T mA[10];
+};
+
+template< class T >
+inline quadric_t<T> operator+( const quadric_t<T>& q1, const quadric_t<T>& q2 )
+{
+   quadric_t<T> result( q1 );
+   result += q2;
+   return result;
+}
+
+/**
+ * Greedy edge collapse simplifier driven by quadric errors.
+ *
+ * Candidate collapses live in a binary heap stored in one flat array and
+ * ordered by cost, then by vertex indices, so the result only depends on the
+ * input. Stale candidates are skipped lazily using per vertex version
+ * counters. Collapses that would flip a triangle or break the manifold link
+ * condition are rejected, open borders are kept in place by penalty quadrics
+ * and locked vertices never move.
+ *
+ * Most users call simplifyMesh or simplifyMeshClusters rather than this class.
+ *
+ * @param T     the internal type used for positions and errors
+ */
+template<class T>
+class mesh_simplifier_t
+{
+public:
+   /**
+    * Constructs a simplifier for the given mesh.
+    *
+    * @param positions    the vertex positions, collapsed vertices are moved in place
+    * @param vertexCount  the number of vertices
+    * @param locked       one flag per vertex, non zero for vertices that must not move, or NULL
+    * @param indices      three vertex indices per triangle
+    */
+   mesh_simplifier_t( vec<3, T>* positions, size_t vertexCount, const uint8_t* locked, const std::vector<uint32_t>& indices )
+      : mPositions( positions ), mLocked( locked ), mIndices( indices ),
+        mQuadrics( vertexCount ), mVersions( vertexCount, 0 ), mVertexTriangles( vertexCount ),
+        mTriangleAlive( indices.size() / 3, 1 ), mTriangleCount( indices.size() / 3 )
+   {
+      computeQuadrics();
+      for (size_t t = 0; t < mTriangleAlive.size(); ++t)
+         for (int k = 0; k < 3; ++k)
+            mVertexTriangles[mIndices[3 * t + k]].push_back( static_cast<uint32_t>(t) );
+
+      // Seed the heap with every edge once, in a deterministic order
+      std::vector<uint32_t> neighbors;
+      for (size_t v = 0; v < vertexCount; ++v)
+      {
+         gatherNeighbors( static_cast<uint32_t>(v), neighbors );
+         for (size_t i = 0; i < neighbors.size(); ++i)
+            if (neighbors[i] > v)
+               pushCandidate( static_cast<uint32_t>(v), neighbors[i] );
+      }
+   }
+
+   /**
+    * Collapses edges, cheapest first, until at most targetTriangleCount
+    * triangles remain or the cheapest collapse costs more than maxError.
+    *
+    * @return  the largest error of the performed collapses
+    */
+   T run( size_t targetTriangleCount, const T& maxError )
+   {
+      T result( 0 );
+      std::vector<uint32_t> neighbors;
+      while (mTriangleCount > targetTriangleCount && !mHeap.empty())
+      {
+         std::pop_heap( mHeap.begin(), mHeap.end(), CandidateGreater() );
+         const Candidate c = mHeap.back();
+         mHeap.pop_back();
+
+         if (c.mVersion0 != mVersions[c.mV0] || c.mVersion1 != mVersions[c.mV1])
+            continue;
+         if (c.mCost > maxError)
+            break;
+         if (!canCollapse( c.mV0, c.mV1, c.mTarget ))
+            continue;
+
+         collapse( c.mV0, c.mV1, c.mTarget );
+         result = max( result, c.mCost );
+
+         gatherNeighbors( c.mV0, neighbors );
+         for (size_t i = 0; i < neighbors.size(); ++i)
+            pushCandidate( c.mV0, neighbors[i] );
+      }
+      return result;
+   }
+
+   /**
+    * Gets the indices of the remaining triangles, in their original order.
+    */
+   void getIndices( std::vector<uint32_t>& result ) const
+   {
+      result.clear();
+      result.reserve( mTriangleCount * 3 );
+      for (size_t t = 0; t < mTriangleAlive.size(); ++t)
+         if (mTriangleAlive[t])
+            result.insert( result.end(), mIndices.begin() + 3 * t, mIndices.begin() + 3 * t + 3 );
+   }
+
+private:
+   struct Candidate
+   {
+      T mCost;
+      uint32_t mV0, mV1;
+      uint32_t mVersion0, mVersion1;
+      vec<3, T> mTarget;
+   };
+
+   struct CandidateGreater
+   {
+      bool operator()( const Candidate& a, const Candidate& b ) const
+      {
+         if (a.mCost != b.mCost)
+            return a.mCost > b.mCost;
+         if (a.mV0 != b.mV0)
+            return a.mV0 > b.mV0;
+         return a.mV1 > b.mV1;
+      }
+   };
+
+   bool isLocked( uint32_t v ) const
+   {
+      return mLocked && mLocked[v];
+   }
+
+   void computeQuadrics()
+   {
+      // Edges used by a single triangle are open borders
+      std::map< std::pair<uint32_t, uint32_t>, int > edgeUse;
+      for (size_t t = 0; t < mTriangleAlive.size(); ++t)
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t a = mIndices[3 * t + k], b = mIndices[3 * t + (k + 1) % 3];
+            ++edgeUse[std::make_pair( min( a, b ), max( a, b ) )];
+         }
+
+      for (size_t t = 0; t < mTriangleAlive.size(); ++t)
+      {
+         const uint32_t* tri = &mIndices[3 * t];
+         const vec<3, T>& p0 = mPositions[tri[0]];
+         const vec<3, T> n = cross( mPositions[tri[1]] - p0, mPositions[tri[2]] - p0 );
+         const T len = length( n );
+         if (len <= T(0))
+            continue;
+
+         const vec<3, T> normal = n / len;
+         const quadric_t<T> q( normal, dot( normal, p0 ), len * static_cast<T>(0.5) );
+         for (int k = 0; k < 3; ++k)
+            mQuadrics[tri[k]] += q;
+
+         // Border edges get a heavy plane orthogonal to the triangle through the edge
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t a = tri[k], b = tri[(k + 1) % 3];
+            if (edgeUse[std::make_pair( min( a, b ), max( a, b ) )] != 1)
+               continue;
+            const vec<3, T> edge = mPositions[b] - mPositions[a];
+            const T edgeLength = length( edge );
+            if (edgeLength <= T(0))
+               continue;
+            const vec<3, T> side = normalize( cross( edge, normal ) );
+            const quadric_t<T> border( side, dot( side, mPositions[a] ), edgeLength * edgeLength * T(100) );
+            mQuadrics[a] += border;
+            mQuadrics[b] += border;
+         }
+      }
+   }
+
+   void gatherNeighbors( uint32_t v, std::vector<uint32_t>& result ) const
+   {
+      result.clear();
+      const std::vector<uint32_t>& triangles = mVertexTriangles[v];
+      for (size_t i = 0; i < triangles.size(); ++i)
+      {
+         if (!mTriangleAlive[triangles[i]])
+            continue;
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t n = mIndices[3 * triangles[i] + k];
+            if (n != v)
+               result.push_back( n );
+         }
+      }
+      std::sort( result.begin(), result.end() );
+      result.erase( std::unique( result.begin(), result.end() ), result.end() );
+   }
+
+   void pushCandidate( uint32_t v0, uint32_t v1 )
+   {
+      // The locked end point, if any, is the one kept
+      if (isLocked( v0 ) && isLocked( v1 ))
+         return;
+      if (isLocked( v1 ) || (!isLocked( v0 ) && v1 < v0))
+         std::swap( v0, v1 );
+
+      const quadric_t<T> q = mQuadrics[v0] + mQuadrics[v1];
+      Candidate c;
+      c.mV0 = v0;
+      c.mV1 = v1;
+      c.mVersion0 = mVersions[v0];
+      c.mVersion1 = mVersions[v1];
+
+      if (isLocked( v0 ))
+         c.mTarget = mPositions[v0];
+      else if (!q.findMinimum( c.mTarget ))
+      {
+         // Best of the end points and the middle of the edge
+         const vec<3, T> options[3] = { mPositions[v0], mPositions[v1], (mPositions[v0] + mPositions[v1]) * static_cast<T>(0.5) };
+         c.mTarget = options[0];
+         for (int i = 1; i < 3; ++i)
+            if (q.evaluate( options[i] ) < q.evaluate( c.mTarget ))
+               c.mTarget = options[i];
+      }
+      c.mCost = max( q.evaluate( c.mTarget ), T(0) );
+
+      mHeap.push_back( c );
+      std::push_heap( mHeap.begin(), mHeap.end(), CandidateGreater() );
+   }
+
+   bool canCollapse( uint32_t v0, uint32_t v1, const vec<3, T>& target ) const
+   {
+      // Link condition: the only common neighbors are the apexes of the triangles sharing the edge
+      std::vector<uint32_t> n0, n1, common;
+      gatherNeighbors( v0, n0 );
+      gatherNeighbors( v1, n1 );
+      std::set_intersection( n0.begin(), n0.end(), n1.begin(), n1.end(), std::back_inserter( common ) );
+
+      // A new edge between locked vertices could duplicate an edge living outside of this mesh, such as in another cluster
+      if (isLocked( v0 ))
+         for (size_t i = 0; i < n1.size(); ++i)
+            if (n1[i] != v0 && isLocked( n1[i] ) && !std::binary_search( n0.begin(), n0.end(), n1[i] ))
+               return false;
+
+      size_t shared = 0;
+      for (int pass = 0; pass < 2; ++pass)
+      {
+         const uint32_t v = pass ? v1 : v0;
+         const std::vector<uint32_t>& triangles = mVertexTriangles[v];
+         for (size_t i = 0; i < triangles.size(); ++i)
+         {
+            const uint32_t t = triangles[i];
+            if (!mTriangleAlive[t])
+               continue;
+            const uint32_t* tri = &mIndices[3 * t];
+            const bool hasBoth = (tri[0] == v0 || tri[1] == v0 || tri[2] == v0) &&
+                                 (tri[0] == v1 || tri[1] == v1 || tri[2] == v1);
+            if (hasBoth)
+            {
+               shared += pass == 0;
+               continue;
+            }
+
+            // The triangle must not flip nor degenerate once v moves to target
+            vec<3, T> p[3];
+            for (int k = 0; k < 3; ++k)
+               p[k] = tri[k] == v ? target : mPositions[tri[k]];
+            const vec<3, T> before = cross( mPositions[tri[1]] - mPositions[tri[0]], mPositions[tri[2]] - mPositions[tri[0]] );
+            const vec<3, T> after = cross( p[1] - p[0], p[2] - p[0] );
+            if (dot( before, after ) <= T(0))
+               return false;
+         }
+      }
+      return common.size() == shared;
+   }
+
+   void collapse( uint32_t v0, uint32_t v1, const vec<3, T>& target )
+   {
+      std::vector<uint32_t>& triangles0 = mVertexTriangles[v0];
+      const std::vector<uint32_t>& triangles1 = mVertexTriangles[v1];
+      for (size_t i = 0; i < triangles1.size(); ++i)
+      {
+         const uint32_t t = triangles1[i];
+         if (!mTriangleAlive[t])
+            continue;
+         uint32_t* tri = &mIndices[3 * t];
+         if (tri[0] == v0 || tri[1] == v0 || tri[2] == v0)
+         {
+            mTriangleAlive[t] = 0;
+            --mTriangleCount;
+            continue;
+         }
+         for (int k = 0; k < 3; ++k)
+            if (tri[k] == v1)
+               tri[k] = v0;
+         triangles0.push_back( t );
+      }
+
+      // Drop the references to dead triangles while the list is being rewritten anyway
+      size_t alive = 0;
+      for (size_t i = 0; i < triangles0.size(); ++i)
+         if (mTriangleAlive[triangles0[i]])
+            triangles0[alive++] = triangles0[i];
+      triangles0.resize( alive );
+      mVertexTriangles[v1].clear();
+
+      mPositions[v0] = target;
+      mQuadrics[v0] += mQuadrics[v1];
+      ++mVersions[v0];
+      ++mVersions[v1];
+   }
+
+private:
+   vec<3, T>* mPositions;
+   const uint8_t* mLocked;
+   std::vector<uint32_t> mIndices;
+   std::vector< quadric_t<T> > mQuadrics;
+   std::vector<uint32_t> mVersions;
+   std::vector< std::vector<uint32_t> > mVertexTriangles;
+   std::vector<uint8_t> mTriangleAlive;
+   size_t mTriangleCount;
+   std::vector<Candidate> mHeap;
+};
+
+/**
+ * Simplifies a triangle mesh in place. Vertices kept by collapses are moved
+ * to their optimal position, removed vertices are left in positions but no
+ * longer referenced by indices.
+ *
+ * @param positions            the vertex positions
+ * @param vertexCount          the number of vertices
+ * @param indices              three vertex indices per triangle, replaced by the simplified triangles
+ * @param targetTriangleCount  the number of triangles to reach
+ * @param maxError             the largest quadric error a collapse may introduce
+ * @param locked               one flag per vertex, non zero for vertices that must not move, or NULL
+ *
+ * @return  the largest quadric error of the performed collapses
+ */
+template< class T >
+inline T simplifyMesh( vec<3, T>* positions, size_t vertexCount, std::vector<uint32_t>& indices,
+                       size_t targetTriangleCount, const T& maxError, const uint8_t* locked = NULL )
+{
+   mesh_simplifier_t<T> simplifier( positions, vertexCount, locked, indices );
+   const T result = simplifier.run( targetTriangleCount, maxError );
+   simplifier.getIndices( indices );
+   return result;
+}
+
+/**
+ * Splits a mesh into clusters for simplifyMeshCluster: triangles are binned
+ * by the grid cell of size cellSize containing their centroid, and vertices
+ * used by more than one cluster are locked so the clusters can be simplified
+ * independently without opening cracks between them.
+ *
+ * @param clusters  receives the indices of the triangles of each non empty cell, ordered by cell
+ * @param locked    receives one flag per vertex, non zero for the vertices shared by clusters
+ */
+template< class T >
+inline void buildSimplifyClusters( const vec<3, T>* positions, size_t vertexCount, const std::vector<uint32_t>& indices,
+                                   const T& cellSize, std::vector< std::vector<uint32_t> >& clusters,
+                                   std::vector<uint8_t>& locked )
+{
+   const uint32_t unused = std::numeric_limits<uint32_t>::max();
+   const size_t triangleCount = indices.size() / 3;
+
+   std::map< std::vector<int>, uint32_t > cells;
+   std::vector<uint32_t> triangleCell( triangleCount );
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      const vec<3, T> centroid = (positions[indices[3 * t]] + positions[indices[3 * t + 1]] + positions[indices[3 * t + 2]]) / T(3);
+      const ivec3 cell = ivec3( floor( centroid / cellSize ) );
+      std::vector<int> key( 3 );
+      key[0] = cell.x; key[1] = cell.y; key[2] = cell.z;
+      triangleCell[t] = cells.insert( std::make_pair( key, static_cast<uint32_t>(cells.size()) ) ).first->second;
+   }
+
+   // Number the clusters in cell order rather than discovery order
+   std::vector<uint32_t> order( cells.size() );
+   uint32_t rank = 0;
+   for (typename std::map< std::vector<int>, uint32_t >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+      order[it->second] = rank++;
+
+   clusters.assign( cells.size(), std::vector<uint32_t>() );
+   locked.assign( vertexCount, 0 );
+   std::vector<uint32_t> vertexCluster( vertexCount, unused );
+   for (size_t t = 0; t < triangleCount; ++t)
+   {
+      const uint32_t cluster = order[triangleCell[t]];
+      for (int k = 0; k < 3; ++k)
+      {
+         const uint32_t v = indices[3 * t + k];
+         clusters[cluster].push_back( v );
+         if (vertexCluster[v] == unused)
+            vertexCluster[v] = cluster;
+         else if (vertexCluster[v] != cluster)
+            locked[v] = 1;
+      }
+   }
+}
+
+/**
+ * Simplifies one cluster built by buildSimplifyClusters. The cluster vertices
+ * are copied to a compact local mesh, so the cost only depends on the
+ * cluster size. Distinct clusters write distinct vertices and indices and may
+ * be simplified on different threads.
+ *
+ * @param positions    the vertex positions of the whole mesh, unlocked cluster vertices are moved in place
+ * @param locked       the flags computed by buildSimplifyClusters
+ * @param indices      the indices of the cluster triangles, replaced by the simplified triangles
+ * @param ratio        the fraction of the cluster triangles to keep
+ * @param maxError     the largest quadric error a collapse may introduce
+ *
+ * @return  the largest quadric error of the performed collapses
+ */
+template< class T >
+inline T simplifyMeshCluster( vec<3, T>* positions, const std::vector<uint8_t>& locked, std::vector<uint32_t>& indices,
+                              const T& ratio, const T& maxError )
+{
+   std::vector<uint32_t> globals( indices );
+   std::sort( globals.begin(), globals.end() );
+   globals.erase( std::unique( globals.begin(), globals.end() ), globals.end() );
+
+   std::vector< vec<3, T> > localPositions( globals.size() );
+   std::vector<uint8_t> localLocked( globals.size() );
+   for (size_t i = 0; i < globals.size(); ++i)
+   {
+      localPositions[i] = positions[globals[i]];
+      localLocked[i] = locked[globals[i]];
+   }
+   for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = static_cast<uint32_t>(std::lower_bound( globals.begin(), globals.end(), indices[i] ) - globals.begin());
+
+   const size_t target = static_cast<size_t>(static_cast<T>(indices.size() / 3) * ratio);
+   const T result = globals.empty() ? T(0) :
+      simplifyMesh( &localPositions[0], localPositions.size(), indices, target, maxError, &localLocked[0] );
+
+   for (size_t i = 0; i < globals.size(); ++i)
+      if (!localLocked[i])
+         positions[globals[i]] = localPositions[i];
+   for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = globals[indices[i]];
+   return result;
+}
+
+/**
+ * Simplifies a large mesh cluster by cluster, see buildSimplifyClusters and
+ * simplifyMeshCluster, then concatenates the clusters. The vertices shared
+ * by clusters are kept, a final simplifyMesh pass over the result can remove
+ * them once the mesh is small enough.
+ *
+ * @return  the largest quadric error of the performed collapses
+ */
+template< class T >
+inline T simplifyMeshClusters( vec<3, T>* positions, size_t vertexCount, std::vector<uint32_t>& indices,
+                               const T& cellSize, const T& ratio, const T& maxError )
+{
+   std::vector< std::vector<uint32_t> > clusters;
+   std::vector<uint8_t> locked;
+   buildSimplifyClusters( positions, vertexCount, indices, cellSize, clusters, locked );
+
+   T result( 0 );
+   indices.clear();
+   for (size_t c = 0; c < clusters.size(); ++c)
+   {
+      result = max( result, simplifyMeshCluster( positions, locked, clusters[c], ratio, maxError ) );
+      indices.insert( indices.end(), clusters[c].begin(), clusters[c].end() );
+   }
+   return result;
+}
+
+// --- helper types --- //
+typedef quadric_t<float>            quadricf;
+typedef quadric_t<double>           quadricd;
+typedef mesh_simplifier_t<float>    mesh_simplifierf;
+typedef mesh_simplifier_t<double>   mesh_simplifierd;
+
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace glm
+{
+
+/**
+ * Post transform vertex cache efficiency of an index buffer, before and
+ * after optimizeVertexCache.
+ *
+ * The ACMR, average cache miss ratio, is the number of vertices transformed
+ * per triangle with a FIFO cache of the given size: 3 for no reuse at all,
+ * about 0.5 for a well ordered regular grid.
+ */
+struct vertex_cache_report_t
+{
+   float mACMRBefore;
+   float mACMRAfter;
+};
+
+/**
+ * Computes the ACMR of an index buffer with a FIFO cache of cacheSize
+ * vertices, see vertex_cache_report_t.
+ *
+ * @param indices      three vertex indices per triangle
+ * @param indexCount   the number of indices
+ * @param vertexCount  the number of vertices
+ * @param cacheSize    the number of vertices the cache holds
+ */
+inline float computeACMR( const uint32_t* indices, size_t indexCount, size_t vertexCount, size_t cacheSize )
+{
+   if (indexCount < 3)
+      return 0.0f;
+
+   // A vertex is cached while fewer than cacheSize misses happened since it was loaded
+   std::vector<size_t> loaded( vertexCount, 0 );
+   size_t misses = 0;
+   for (size_t i = 0; i < indexCount; ++i)
+   {
+      const uint32_t v = indices[i];
+      if (loaded[v] == 0 || misses + 1 - loaded[v] > cacheSize)
+         loaded[v] = ++misses;
+   }
+   return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+}
+
+/**
+ * Reorders triangles for the post transform vertex cache with the Tipsify
+ * algorithm of Sander, Nehab and Barczak, "Fast Triangle Reordering for
+ * Vertex Locality and Reduced Overdraw". The algorithm runs in linear time
+ * and memory: it fans around a vertex, then continues with the emitted
+ * vertex that will still be in the cache, falling back to recently used
+ * vertices and finally to the input order.
+ *
+ * @param indices      three vertex indices per triangle
+ * @param indexCount   the number of indices, a multiple of 3
+ * @param vertexCount  the number of vertices
+ * @param cacheSize    the number of vertices of the targeted FIFO cache, 16 to 32 suits most hardware
+ * @param destination  receives indexCount indices, must not alias indices
+ *
+ * @return  the ACMR of the input and output orders
+ */
+inline vertex_cache_report_t optimizeVertexCache( const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                                  size_t cacheSize, uint32_t* destination )
+{
+   const size_t triangleCount = indexCount / 3;
+   const uint32_t none = std::numeric_limits<uint32_t>::max();
+
+   // Triangles around each vertex, in compressed rows
+   std::vector<uint32_t> offsets( vertexCount + 1, 0 );
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+      ++offsets[indices[i] + 1];
+   for (size_t v = 0; v < vertexCount; ++v)
+      offsets[v + 1] += offsets[v];
+   std::vector<uint32_t> adjacency( triangleCount * 3 );
+   std::vector<uint32_t> live( vertexCount );
+   for (size_t v = 0; v < vertexCount; ++v)
+      live[v] = offsets[v + 1] - offsets[v];
+   {
+      std::vector<uint32_t> fill( offsets.begin(), offsets.end() - 1 );
+      for (size_t i = 0; i < triangleCount * 3; ++i)
+         adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+   }
+
+   std::vector<uint8_t> emitted( triangleCount, 0 );
+   std::vector<size_t> cacheTime( vertexCount, 0 );
+   std::vector<uint32_t> deadEnd;
+   deadEnd.reserve( triangleCount * 3 );
+   std::vector<uint32_t> candidates;
+   size_t time = cacheSize + 1;
+   size_t cursor = 0;
+   size_t written = 0;
+
+   uint32_t fan = none;
+   while (cursor < vertexCount && live[cursor] == 0)
+      ++cursor;
+   if (cursor < vertexCount)
+      fan = static_cast<uint32_t>(cursor);
+
+   while (fan != none)
+   {
+      // Emit all the remaining triangles around the fanning vertex
+      candidates.clear();
+      for (uint32_t a = offsets[fan]; a < offsets[fan + 1]; ++a)
+      {
+         const uint32_t t = adjacency[a];
+         if (emitted[t])
+            continue;
+         emitted[t] = 1;
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t v = indices[3 * t + k];
+            destination[written++] = v;
+            deadEnd.push_back( v );
+            candidates.push_back( v );
+            --live[v];
+            if (time - cacheTime[v] > cacheSize)
+               cacheTime[v] = time++;
+         }
+      }
+
+      // Next fanning vertex: the candidate that will still be cached once its own triangles are emitted, oldest first
+      fan = none;
+      size_t bestPriority = 0;
+      bool found = false;
+      for (size_t i = 0; i < candidates.size(); ++i)
+      {
+         const uint32_t v = candidates[i];
+         if (live[v] == 0)
+            continue;
+         size_t priority = 0;
+         if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+            priority = time - cacheTime[v];
+         if (!found || priority > bestPriority)
+         {
+            found = true;
+            bestPriority = priority;
+            fan = v;
+         }
+      }
+
+      // Dead end: most recently used vertex with triangles left, then input order
+      while (fan == none && !deadEnd.empty())
+      {
+         const uint32_t v = deadEnd.back();
+         deadEnd.pop_back();
+         if (live[v] > 0)
+            fan = v;
+      }
+      while (fan == none && cursor < vertexCount)
+      {
+         if (live[cursor] > 0)
+            fan = static_cast<uint32_t>(cursor);
+         else
+            ++cursor;
+      }
+   }
+
+   vertex_cache_report_t result;
+   result.mACMRBefore = computeACMR( indices, indexCount, vertexCount, cacheSize );
+   result.mACMRAfter = computeACMR( destination, indexCount, vertexCount, cacheSize );
+   return result;
+}
+
+/**
+ * Reorders clusters of triangles to reduce overdraw while keeping the vertex
+ * cache order produced by optimizeVertexCache.
+ *
+ * Clusters start at the triangles missing the cache for all of their
+ * vertices, so moving them around costs no cache efficiency. Without view
+ * directions, clusters are sorted by dot( clusterCenter - meshCenter,
+ * clusterNormal ), drawing the outer, front facing parts of a convex-ish
+ * mesh first for any viewpoint (Sander et al.). With view directions, the
+ * directions the camera looks along, clusters are sorted by their mean
+ * distance towards the viewer over the views they face.
+ *
+ * @param indices         three vertex indices per triangle, reordered in place
+ * @param indexCount      the number of indices
+ * @param positions       the vertex positions
+ * @param vertexCount     the number of vertices
+ * @param cacheSize       the cache size used with optimizeVertexCache
+ * @param viewDirections  the directions the camera looks along, or NULL
+ * @param viewCount       the number of view directions
+ */
+template< class T >
+inline void optimizeOverdraw( uint32_t* indices, size_t indexCount, const vec<3, T>* positions, size_t vertexCount,
+                              size_t cacheSize, const vec<3, T>* viewDirections = NULL, size_t viewCount = 0 )
+{
+   const size_t triangleCount = indexCount / 3;
+   if (triangleCount == 0)
+      return;
+
+   // Cluster boundaries
+   std::vector<uint32_t> clusterStarts;
+   {
+      std::vector<size_t> loaded( vertexCount, 0 );
+      size_t misses = 0;
+      for (size_t t = 0; t < triangleCount; ++t)
+      {
+         int triangleMisses = 0;
+         for (int k = 0; k < 3; ++k)
+         {
+            const uint32_t v = indices[3 * t + k];
+            if (loaded[v] == 0 || misses + 1 - loaded[v] > cacheSize)
+            {
+               loaded[v] = ++misses;
+               ++triangleMisses;
+            }
+         }
+         if (t == 0 || triangleMisses == 3)
+            clusterStarts.push_back( static_cast<uint32_t>(t) );
+      }
+   }
+   const size_t clusterCount = clusterStarts.size();
+   clusterStarts.push_back( static_cast<uint32_t>(triangleCount) );
+
+   vec<3, T> meshCenter( 0 );
+   for (size_t i = 0; i < triangleCount * 3; ++i)
+      meshCenter += positions[indices[i]];
+   meshCenter /= static_cast<T>(triangleCount * 3);
+
+   // Sort key of each cluster from its area weighted center and normal
+   std::vector< std::pair<T, uint32_t> > keys( clusterCount );
+   for (size_t c = 0; c < clusterCount; ++c)
+   {
+      vec<3, T> center( 0 ), normal( 0 );
+      T area( 0 );
+      for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+      {
+         const vec<3, T>& p0 = positions[indices[3 * t]];
+         const vec<3, T>& p1 = positions[indices[3 * t + 1]];
+         const vec<3, T>& p2 = positions[indices[3 * t + 2]];
+         const vec<3, T> n = cross( p1 - p0, p2 - p0 );
+         const T a = length( n );
+         center += (p0 + p1 + p2) * (a / T(3));
+         normal += n;
+         area += a;
+      }
+      center = area > T(0) ? center / area : positions[indices[3 * clusterStarts[c]]];
+      const T normalLength = length( normal );
+      if (normalLength > T(0))
+         normal /= normalLength;
+
+      T key( 0 );
+      if (viewCount == 0)
+         key = dot( center - meshCenter, normal );
+      else
+      {
+         size_t facing = 0;
+         for (size_t v = 0; v < viewCount; ++v)
+            if (dot( normal, viewDirections[v] ) < T(0))
+            {
+               key -= dot( center - meshCenter, viewDirections[v] );
+               ++facing;
+            }
+         key = facing ? key / static_cast<T>(facing) : -std::numeric_limits<T>::max();
+      }
+      keys[c] = std::make_pair( -key, static_cast<uint32_t>(c) );
+   }
+   std::sort( keys.begin(), keys.end() );
+
+   std::vector<uint32_t> source( indices, indices + triangleCount * 3 );
+   size_t written = 0;
+   for (size_t i = 0; i < clusterCount; ++i)
+   {
+      const uint32_t c = keys[i].second;
+      for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+         for (int k = 0; k < 3; ++k)
+            indices[written++] = source[3 * t + k];
+   }
+}
+
+/**
+ * Computes the vertex remap that orders vertices by first use in the index
+ * buffer, so vertex fetches walk memory linearly. Unreferenced vertices are
+ * mapped to std::numeric_limits<uint32_t>::max() and dropped.
+ *
+ * @param remap  receives vertexCount entries, the new index of each vertex
+ *
+ * @return  the number of referenced vertices, the size of the remapped vertex arrays
+ */
+inline size_t optimizeVertexFetchRemap( const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t* remap )
+{
+   std::fill( remap, remap + vertexCount, std::numeric_limits<uint32_t>::max() );
+   uint32_t next = 0;
+   for (size_t i = 0; i < indexCount; ++i)
+      if (remap[indices[i]] == std::numeric_limits<uint32_t>::max())
+         remap[indices[i]] = next++;
+   return next;
+}
+
+/**
+ * Applies a vertex remap to an index buffer in place.
+ */
+inline void remapIndexBuffer( uint32_t* indices, size_t indexCount, const uint32_t* remap )
+{
+   for (size_t i = 0; i < indexCount; ++i)
+      indices[i] = remap[indices[i]];
+}
+
+/**
+ * Applies a vertex remap to a vertex attribute array, such as vec3 positions
+ * or interleaved vertex structures. destination holds as many entries as
+ * optimizeVertexFetchRemap returned and must not alias source.
+ */
+template< class VERTEX >
+inline void remapVertexBuffer( const VERTEX* source, size_t vertexCount, const uint32_t* remap, VERTEX* destination )
+{
+   for (size_t v = 0; v < vertexCount; ++v)
+      if (remap[v] != std::numeric_limits<uint32_t>::max())
+         destination[remap[v]] = source[v];
+}
+
+}
@@ -1,13 +1,105 @@
 #include <glm/ext/matrix_relational.hpp>
 #include <glm/ext/matrix_projection.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <glm/ext/vector_relational.hpp>
 #include <glm/ext/vector_float4.hpp>
 #include <glm/ext/vector_float3.hpp>
+#include <cstddef>
+
+static int test_projectBatch()
+{
+	int Error = 0;
+
+	glm::mat4 const Model = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, -0.25f, -5.0f));
+	glm::mat4 const Proj = glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+	glm::vec4 const Viewport(10.0f, 20.0f, 640.0f, 480.0f);
+
+	glm::vec3 const Objs[] = {
+		glm::vec3(0.0f, 0.0f, 0.0f),
+		glm::vec3(1.0f, 1.0f, 1.0f),
+		glm::vec3(-1.0f, 0.5f, -2.0f),
+		glm::vec3(0.25f, -1.0f, 3.0f),
+		glm::vec3(2.0f, -0.5f, -10.0f)};
+	std::size_t const Count = sizeof(Objs) / sizeof(Objs[0]);
+
+	glm::vec3 WinsZO[Count];
+	glm::vec3 WinsNO[Count];
+	glm::projectBatchZO(Objs, WinsZO, Count, Proj * Model, Viewport);
+	glm::projectBatchNO(Objs, WinsNO, Count, Proj * Model, Viewport);
+
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Error += glm::all(glm::equal(WinsZO[i], glm::projectZO(Objs[i], Model, Proj, Viewport), 0.001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(WinsNO[i], glm::projectNO(Objs[i], Model, Proj, Viewport), 0.001f)) ? 0 : 1;
+	}
+
+	glm::mat4 const Inverse = glm::inverse(Proj * Model);
+	glm::vec3 ObjsZO[Count];
+	glm::vec3 ObjsNO[Count];
+	glm::unProjectBatchZO(WinsZO, ObjsZO, Count, Inverse, Viewport);
+	glm::unProjectBatchNO(WinsNO, ObjsNO, Count, Inverse, Viewport);
+
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Error += glm::all(glm::equal(ObjsZO[i], glm::unProjectZO(WinsZO[i], Model, Proj, Viewport), 0.001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(ObjsNO[i], glm::unProjectNO(WinsNO[i], Model, Proj, Viewport), 0.001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(ObjsZO[i], Objs[i], 0.001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(ObjsNO[i], Objs[i], 0.001f)) ? 0 : 1;
+	}
+
+	// In place projection
+	glm::vec3 InPlace[Count];
+	for(std::size_t i = 0; i < Count; ++i)
+		InPlace[i] = Objs[i];
+	glm::projectBatch(InPlace, InPlace, Count, Proj * Model, Viewport);
+	for(std::size_t i = 0; i < Count; ++i)
+		Error += glm::all(glm::equal(InPlace[i], glm::project(Objs[i], Model, Proj, Viewport), 0.001f)) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_projectVisible()
+{
+	int Error = 0;
+
+	glm::mat4 const Proj = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 10.0f);
+	glm::vec4 const Viewport(0.0f, 0.0f, 100.0f, 100.0f);
+
+	glm::vec3 const Objs[] = {
+		glm::vec3(0.0f, 0.0f, -5.0f),   // visible
+		glm::vec3(0.0f, 0.0f, 5.0f),    // behind the eye
+		glm::vec3(20.0f, 0.0f, -5.0f),  // right of the viewport
+		glm::vec3(0.0f, 0.0f, -50.0f),  // beyond the far plane
+		glm::vec3(-1.0f, 1.0f, -2.0f),  // visible
+		glm::vec3(0.0f, 0.0f, -0.5f)};  // before the near plane
+	std::size_t const Count = sizeof(Objs) / sizeof(Objs[0]);
+
+	glm::vec3 Wins[Count];
+	std::size_t Indices[Count];
+
+	std::size_t const VisibleZO = glm::projectVisibleZO(Objs, Count, Proj, Viewport, Wins, Indices);
+	Error += VisibleZO == 2 ? 0 : 1;
+	Error += Indices[0] == 0 && Indices[1] == 4 ? 0 : 1;
+	Error += glm::all(glm::equal(Wins[1], glm::projectZO(Objs[4], glm::mat4(1.0f), Proj, Viewport), 0.001f)) ? 0 : 1;
+
+	std::size_t const VisibleNO = glm::projectVisibleNO(Objs, Count, Proj, Viewport, Wins, static_cast<std::size_t*>(0));
+	Error += VisibleNO == 2 ? 0 : 1;
+	Error += glm::all(glm::equal(Wins[0], glm::projectNO(Objs[0], glm::mat4(1.0f), Proj, Viewport), 0.001f)) ? 0 : 1;
+
+	std::size_t const Visible = glm::projectVisible(Objs, Count, Proj, Viewport, Wins, Indices);
+	Error += Visible == 2 ? 0 : 1;
+
+	return Error;
+}
 
 int main()
 {
 	int Error = 0;
 
+	Error += test_projectBatch();
+	Error += test_projectVisible();
+
 	return Error;
 }
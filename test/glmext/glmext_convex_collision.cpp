@@ -0,0 +1,150 @@
+#include <glm/glm.hpp>
+#include <glmext/ConvexCollision.h>
+#include <cmath>
+#include <vector>
+
+static bool near(glm::dvec3 const& a, glm::dvec3 const& b, double Tolerance)
+{
+	return glm::length(a - b) < Tolerance;
+}
+
+// Checks a separated pair against its known distance and normal
+template<class SHAPE_A, class SHAPE_B>
+static int separated(SHAPE_A const& a, SHAPE_B const& b, double Distance, glm::dvec3 const& Normal)
+{
+	int Error = 0;
+
+	glm::gjk_result_t<double> Result;
+	Error += !glm::collideConvex(a, b, Result) ? 0 : 1;
+	Error += !Result.mIntersecting ? 0 : 1;
+	Error += std::abs(Result.mDistance - Distance) < 1e-6 ? 0 : 1;
+	Error += near(Result.mNormal, Normal, 1e-6) ? 0 : 1;
+	Error += near(Result.mPointB - Result.mPointA, Distance * Normal, 1e-6) ? 0 : 1;
+
+	return Error;
+}
+
+// Checks an intersecting pair against its known depth and normal, then
+// moves b out along the normal and expects the shapes to touch
+template<class SHAPE_A, class SHAPE_B>
+static int overlapping(SHAPE_A const& a, SHAPE_B const& b, double Depth, glm::dvec3 const& Normal, double Tolerance)
+{
+	int Error = 0;
+
+	glm::gjk_result_t<double> Result;
+	Error += glm::collideConvex(a, b, Result) ? 0 : 1;
+	Error += Result.mIntersecting ? 0 : 1;
+	Error += std::abs(Result.mDistance + Depth) < Tolerance ? 0 : 1;
+	Error += near(Result.mNormal, Normal, Tolerance) ? 0 : 1;
+	Error += std::abs(glm::dot(Result.mPointB - Result.mPointA, Normal) + Depth) < Tolerance ? 0 : 1;
+
+	glm::transformed_shape_t<SHAPE_B, double> const Moved(b, glm::dmat3(1.0), -Result.mDistance * Result.mNormal * 1.001);
+	glm::gjk_result_t<double> Apart;
+	glm::collideConvex(a, Moved, Apart);
+	Error += !Apart.mIntersecting && Apart.mDistance < 0.001 * Depth + Tolerance ? 0 : 1;
+
+	return Error;
+}
+
+static int test_spheres()
+{
+	int Error = 0;
+
+	glm::sphere_t<double> const a(glm::dvec3(0.0), 1.0);
+	Error += separated(a, glm::sphere_t<double>(glm::dvec3(3.0, 0.0, 0.0), 1.0), 1.0, glm::dvec3(1.0, 0.0, 0.0));
+	glm::dvec3 const Diagonal = glm::normalize(glm::dvec3(0.0, 1.0, 1.0));
+	Error += separated(a, glm::sphere_t<double>(glm::dvec3(0.0, 2.0, 2.0), 0.5), std::sqrt(8.0) - 1.5, Diagonal);
+
+	// The closest points of two spheres are unique
+	glm::gjk_result_t<double> Result;
+	glm::collideConvex(a, glm::sphere_t<double>(glm::dvec3(0.0, 2.0, 2.0), 0.5), Result);
+	Error += near(Result.mPointA, Diagonal, 1e-6) && near(Result.mPointB, glm::dvec3(0.0, 2.0, 2.0) - 0.5 * Diagonal, 1e-6) ? 0 : 1;
+	Error += overlapping(a, glm::sphere_t<double>(glm::dvec3(0.0, 0.0, 1.5), 1.0), 0.5, glm::dvec3(0.0, 0.0, 1.0), 1e-2);
+
+	return Error;
+}
+
+static int test_boxes()
+{
+	int Error = 0;
+
+	glm::aabox_t<double> const Box(glm::dvec3(-1.0), glm::dvec3(1.0));
+
+	// A box turned 45 degrees around z points an edge at the other box
+	double const c = std::sqrt(0.5);
+	glm::dmat3 const Turned(glm::dvec3(c, c, 0.0), glm::dvec3(-c, c, 0.0), glm::dvec3(0.0, 0.0, 1.0));
+	glm::obox_t<double> const Diamond(glm::dvec3(3.0, 0.5, 0.0), Turned, glm::dvec3(1.0));
+	Error += separated(Box, Diamond, 2.0 - std::sqrt(2.0), glm::dvec3(1.0, 0.0, 0.0));
+
+	// Face to face, shifted along y
+	Error += separated(Box, glm::obox_t<double>(glm::dvec3(0.3, 3.5, -0.2), glm::dmat3(1.0), glm::dvec3(0.5)), 2.0, glm::dvec3(0.0, 1.0, 0.0));
+
+	// The smallest overlap is along x
+	Error += overlapping(Box, glm::aabox_t<double>(glm::dvec3(0.6, -0.8, -0.9), glm::dvec3(1.6, 1.2, 1.1)), 0.4, glm::dvec3(1.0, 0.0, 0.0), 1e-6);
+	Error += overlapping(Box, glm::obox_t<double>(glm::dvec3(0.2, -1.5, 0.1), glm::dmat3(1.0), glm::dvec3(0.6, 0.8, 0.6)), 0.3, glm::dvec3(0.0, -1.0, 0.0), 1e-6);
+
+	return Error;
+}
+
+static int test_capsuleHull()
+{
+	int Error = 0;
+
+	glm::capsule_t<double> const Capsule(glm::dvec3(0.0, -1.0, 0.0), glm::dvec3(0.0, 1.0, 0.0), 0.5);
+	Error += separated(Capsule, glm::sphere_t<double>(glm::dvec3(2.0, 0.5, 0.0), 0.5), 1.0, glm::dvec3(1.0, 0.0, 0.0));
+	Error += separated(Capsule, glm::sphere_t<double>(glm::dvec3(0.0, 3.0, 0.0), 0.5), 1.0, glm::dvec3(0.0, 1.0, 0.0));
+
+	// A unit cube hull placed with a rotation and a translation
+	std::vector<glm::dvec3> Corners;
+	for(int i = 0; i < 8; ++i)
+		Corners.push_back(glm::dvec3((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5));
+	glm::convex_hulld Hull;
+	Error += glm::computeConvexHull(&Corners[0], Corners.size(), Hull) ? 0 : 1;
+	glm::dmat3 const Swap(glm::dvec3(0.0, 1.0, 0.0), glm::dvec3(-1.0, 0.0, 0.0), glm::dvec3(0.0, 0.0, 1.0));
+	glm::transformed_shape_t<glm::convex_hulld, double> const Placed(Hull, Swap, glm::dvec3(-2.0, 0.0, 0.0));
+	Error += separated(Capsule, Placed, 1.0, glm::dvec3(-1.0, 0.0, 0.0));
+	Error += overlapping(Capsule, glm::transformed_shape_t<glm::convex_hulld, double>(Hull, Swap, glm::dvec3(0.0, 1.7, 0.0)), 0.3, glm::dvec3(0.0, 1.0, 0.0), 1e-2);
+
+	return Error;
+}
+
+static int test_cacheBatch()
+{
+	int Error = 0;
+
+	std::vector<glm::sphere_t<double> > Spheres;
+	Spheres.push_back(glm::sphere_t<double>(glm::dvec3(0.0), 1.0));
+	Spheres.push_back(glm::sphere_t<double>(glm::dvec3(1.5, 0.0, 0.0), 1.0));
+	Spheres.push_back(glm::sphere_t<double>(glm::dvec3(0.0, 5.0, 0.0), 1.0));
+	glm::uint32_t const Pairs[] = {0, 1, 0, 2, 1, 2};
+
+	std::vector<glm::gjk_cache_t<double> > Caches(3);
+	for(std::size_t i = 0; i < Caches.size(); ++i)
+		Caches[i].mCount = 0;
+	std::vector<glm::gjk_result_t<double> > Cold(3), Warm(3);
+	Error += glm::collideConvexBatch(&Spheres[0], &Spheres[0], Pairs, 3, &Caches[0], &Cold[0]) == 1 ? 0 : 1;
+	Error += Cold[0].mIntersecting && !Cold[1].mIntersecting && !Cold[2].mIntersecting ? 0 : 1;
+	Error += std::abs(Cold[1].mDistance - 3.0) < 1e-6 ? 0 : 1;
+
+	// The cached simplices give the same answers in fewer iterations
+	Error += glm::collideConvexBatch(&Spheres[0], &Spheres[0], Pairs, 3, &Caches[0], &Warm[0]) == 1 ? 0 : 1;
+	for(std::size_t i = 1; i < 3; ++i)
+	{
+		Error += std::abs(Warm[i].mDistance - Cold[i].mDistance) < 1e-6 ? 0 : 1;
+		Error += Warm[i].mIterations <= Cold[i].mIterations ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_spheres();
+	Error += test_boxes();
+	Error += test_capsuleHull();
+	Error += test_cacheBatch();
+
+	return Error;
+}
@@ -0,0 +1,151 @@
+#include <glm/glm.hpp>
+#include <glmext/ConvexHull.h>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static double nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return double(State >> 8) / double(1 << 23) - 1.0;
+}
+
+// Enclosed volume, closed surface, faces on their planes and facing outwards
+static int checkHull(glm::convex_hulld const& Hull, std::vector<glm::dvec3> const& Points, double& Volume)
+{
+	int Error = 0;
+
+	glm::dvec3 Center(0.0);
+	for(std::size_t v = 0; v < Hull.mVertices.size(); ++v)
+	{
+		Error += Hull.mVertices[v] == Points[Hull.mSourceIndices[v]] ? 0 : 1;
+		Center += Hull.mVertices[v];
+	}
+	Center /= double(Hull.mVertices.size());
+
+	Error += Hull.mPlanes.size() == Hull.getFaceCount() ? 0 : 1;
+	Error += Hull.getFaceCount() == 2 * Hull.mVertices.size() - 4 ? 0 : 1;
+
+	Volume = 0.0;
+	std::map<std::pair<glm::uint32_t, glm::uint32_t>, int> Edges;
+	for(std::size_t f = 0; f < Hull.getFaceCount(); ++f)
+	{
+		glm::dvec3 const& a = Hull.mVertices[Hull.mIndices[3 * f]];
+		glm::dvec3 const& b = Hull.mVertices[Hull.mIndices[3 * f + 1]];
+		glm::dvec3 const& c = Hull.mVertices[Hull.mIndices[3 * f + 2]];
+		Volume += glm::dot(a - Center, glm::cross(b - Center, c - Center)) / 6.0;
+
+		glm::plane_t<double> const& Plane = Hull.mPlanes[f];
+		Error += std::abs(Plane.distanceTo(a)) < 1e-9 && std::abs(Plane.distanceTo(b)) < 1e-9 && std::abs(Plane.distanceTo(c)) < 1e-9 ? 0 : 1;
+		Error += glm::dot(Plane.normal, glm::cross(b - a, c - a)) > 0.0 ? 0 : 1;
+		Error += Plane.distanceTo(Center) < 0.0 ? 0 : 1;
+
+		for(int k = 0; k < 3; ++k)
+			++Edges[std::make_pair(Hull.mIndices[3 * f + k], Hull.mIndices[3 * f + (k + 1) % 3])];
+	}
+	for(std::map<std::pair<glm::uint32_t, glm::uint32_t>, int>::const_iterator it = Edges.begin(); it != Edges.end(); ++it)
+		Error += it->second == 1 && Edges.count(std::make_pair(it->first.second, it->first.first)) == 1 ? 0 : 1;
+
+	for(std::size_t i = 0; i < Points.size(); ++i)
+		Error += Hull.contains(Points[i], 1e-9) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_cube()
+{
+	int Error = 0;
+
+	// Interior points first so the corners are not found right away
+	glm::uint32_t State = 7u;
+	std::vector<glm::dvec3> Points;
+	for(int i = 0; i < 200; ++i)
+		Points.push_back(glm::dvec3(nextRandom(State), nextRandom(State), nextRandom(State)) * 0.99);
+	for(int c = 0; c < 8; ++c)
+		Points.push_back(glm::dvec3((c & 1) ? 1.0 : -1.0, (c & 2) ? 1.0 : -1.0, (c & 4) ? 1.0 : -1.0));
+
+	glm::convex_hulld Hull;
+	Error += glm::computeConvexHull(&Points[0], Points.size(), Hull) ? 0 : 1;
+	Error += Hull.mVertices.size() == 8 ? 0 : 1;
+	Error += Hull.getFaceCount() == 12 ? 0 : 1;
+	for(std::size_t v = 0; v < Hull.mSourceIndices.size(); ++v)
+		Error += Hull.mSourceIndices[v] >= 200 ? 0 : 1;
+
+	double Volume = 0.0;
+	Error += checkHull(Hull, Points, Volume);
+	Error += std::abs(Volume - 8.0) < 1e-9 ? 0 : 1;
+
+	Error += !Hull.contains(glm::dvec3(1.01, 0.0, 0.0), 1e-9) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_sphere()
+{
+	int Error = 0;
+
+	// Every point of the sphere is a hull vertex, the interior points are not
+	glm::uint32_t State = 99u;
+	std::vector<glm::dvec3> Points;
+	for(int i = 0; i < 300; ++i)
+		Points.push_back(glm::dvec3(nextRandom(State), nextRandom(State), nextRandom(State)) * 0.5);
+	std::size_t const InteriorCount = Points.size();
+	while(Points.size() < InteriorCount + 200)
+	{
+		glm::dvec3 const p(nextRandom(State), nextRandom(State), nextRandom(State));
+		if(glm::length(p) > 0.1 && glm::length(p) < 1.0)
+			Points.push_back(glm::normalize(p));
+	}
+
+	glm::quickhulld Builder;
+	glm::convex_hulld Hull;
+	Error += Builder.begin(&Points[0], Points.size()) ? 0 : 1;
+	Builder.partitionPoints(0, Points.size() / 2);
+	Builder.partitionPoints(Points.size() / 2, Points.size() - Points.size() / 2);
+	Builder.build(Hull);
+	Error += Hull.mVertices.size() == 200 ? 0 : 1;
+	for(std::size_t v = 0; v < Hull.mSourceIndices.size(); ++v)
+		Error += Hull.mSourceIndices[v] >= InteriorCount ? 0 : 1;
+
+	double Volume = 0.0;
+	Error += checkHull(Hull, Points, Volume);
+	Error += Volume < 4.0 / 3.0 * 3.14159265358979 && Volume > 3.5 ? 0 : 1;
+
+	// A reused builder gives the same hull
+	glm::convex_hulld Again;
+	Error += Builder.begin(&Points[0], Points.size()) ? 0 : 1;
+	Builder.partitionPoints(0, Points.size());
+	Builder.build(Again);
+	Error += Again.mIndices == Hull.mIndices && Again.mSourceIndices == Hull.mSourceIndices ? 0 : 1;
+
+	return Error;
+}
+
+static int test_degenerate()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> Points;
+	for(int i = 0; i < 20; ++i)
+		Points.push_back(glm::dvec3(double(i % 5), double(i / 5), 2.0));
+
+	glm::convex_hulld Hull;
+	Error += !glm::computeConvexHull(&Points[0], Points.size(), Hull) ? 0 : 1;
+	Error += Hull.mVertices.empty() && Hull.mIndices.empty() ? 0 : 1;
+	Error += !glm::computeConvexHull(&Points[0], 3, Hull) ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_cube();
+	Error += test_sphere();
+	Error += test_degenerate();
+
+	return Error;
+}
@@ -0,0 +1,214 @@
+#include <glm/glm.hpp>
+#include <glmext/Curve.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static double nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return double(State >> 8) / double(1 << 23) - 1.0;
+}
+
+static double distance2(glm::dvec3 const& a, glm::dvec3 const& b)
+{
+	return glm::dot(a - b, a - b);
+}
+
+// Points on a helix, unevenly spaced
+static std::vector<glm::dvec3> helix(std::size_t Count)
+{
+	std::vector<glm::dvec3> Points;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		double const a = double(i) * 0.9 + 0.2 * std::sin(double(i) * 1.7);
+		Points.push_back(glm::dvec3(std::cos(a), double(i) * 0.3, std::sin(a)) * 2.0);
+	}
+	return Points;
+}
+
+// The length of a polyline through Steps samples per segment up to u
+static double denseLength(glm::curved const& Curve, double u, int Steps)
+{
+	int const Count = static_cast<int>(u * double(Steps));
+	double Result = 0.0;
+	glm::dvec3 Previous = Curve.position(0.0);
+	for(int k = 1; k <= Count; ++k)
+	{
+		glm::dvec3 const Next = Curve.position(double(k) / double(Steps));
+		Result += glm::length(Next - Previous);
+		Previous = Next;
+	}
+	return Result + glm::length(Curve.position(u) - Previous);
+}
+
+static int test_interpolation()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = helix(8);
+	glm::curved Curve;
+	Curve.setCatmullRom(&Points[0], Points.size());
+	Error += Curve.getType() == glm::CURVE_CATMULL_ROM && Curve.getSegmentCount() == 7 ? 0 : 1;
+	for(std::size_t i = 0; i < Points.size(); ++i)
+		Error += glm::length(Curve.position(double(i)) - Points[i]) < 1e-12 ? 0 : 1;
+
+	// Closed, with a continuous tangent where it closes once scaled to the knot intervals
+	Curve.setCatmullRom(&Points[0], Points.size(), true);
+	Error += Curve.getSegmentCount() == 8 ? 0 : 1;
+	Error += glm::length(Curve.position(8.0) - Points[0]) < 1e-12 ? 0 : 1;
+	Error += glm::length(Curve.tangent(8.0) * std::sqrt(glm::length(Points[1] - Points[0]) / glm::length(Points[0] - Points[7])) - Curve.tangent(0.0)) < 1e-9 ? 0 : 1;
+
+	std::vector<glm::dvec3> Tangents(Points.size());
+	for(std::size_t i = 0; i < Points.size(); ++i)
+		Tangents[i] = glm::dvec3(1.0, double(i), -0.5);
+	Curve.setHermite(&Points[0], &Tangents[0], Points.size());
+	for(std::size_t i = 0; i < Points.size(); ++i)
+	{
+		Error += glm::length(Curve.position(double(i)) - Points[i]) < 1e-12 ? 0 : 1;
+		Error += glm::length(Curve.tangent(double(i)) - Tangents[i]) < 1e-12 ? 0 : 1;
+	}
+
+	Curve.setBezier(&Points[0], 7);
+	Error += Curve.getSegmentCount() == 2 ? 0 : 1;
+	Error += Curve.position(0.0) == Points[0] && glm::length(Curve.position(1.0) - Points[3]) < 1e-12 && glm::length(Curve.position(2.0) - Points[6]) < 1e-12 ? 0 : 1;
+	Error += glm::length(Curve.tangent(0.0) - (Points[1] - Points[0]) * 3.0) < 1e-12 ? 0 : 1;
+
+	// B-splines approximate their control points, with a continuous second derivative
+	Curve.setBSpline(&Points[0], Points.size());
+	Error += Curve.getSegmentCount() == 5 ? 0 : 1;
+	Error += glm::length(Curve.position(0.0) - (Points[0] + Points[1] * 4.0 + Points[2]) / 6.0) < 1e-12 ? 0 : 1;
+	for(int i = 1; i < 5; ++i)
+	{
+		double const h = 1e-4;
+		glm::dvec3 const Before = (Curve.tangent(double(i) - h) - Curve.tangent(double(i) - 2.0 * h)) / h;
+		glm::dvec3 const After = (Curve.tangent(double(i) + 2.0 * h) - Curve.tangent(double(i) + h)) / h;
+		Error += glm::length(Curve.tangent(double(i) - 1e-12) - Curve.tangent(double(i))) < 1e-9 ? 0 : 1;
+		Error += glm::length(Before - After) < 1e-2 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_arcLength()
+{
+	int Error = 0;
+
+	// A straight Bezier with evenly spaced controls has its chord as length
+	glm::dvec3 const Line[] = {glm::dvec3(0.0), glm::dvec3(1.0, 2.0, 2.0), glm::dvec3(2.0, 4.0, 4.0), glm::dvec3(3.0, 6.0, 6.0)};
+	glm::curved Curve;
+	Curve.setBezier(Line, 4);
+	Error += std::abs(Curve.getLength() - 9.0) < 1e-12 ? 0 : 1;
+	Error += std::abs(Curve.parameterAt(4.5) - 0.5) < 1e-12 ? 0 : 1;
+
+	// Against dense polylines
+	std::vector<glm::dvec3> const Points = helix(8);
+	Curve.setCatmullRom(&Points[0], Points.size());
+	int const Steps = 20000;
+	Error += std::abs(Curve.getLength() - denseLength(Curve, 7.0, Steps)) < 1e-6 * Curve.getLength() ? 0 : 1;
+	double const Parameters[] = {0.0, 0.3, 1.0, 2.71, 4.5, 6.99};
+	for(std::size_t i = 0; i < sizeof(Parameters) / sizeof(Parameters[0]); ++i)
+	{
+		double const Distance = Curve.distanceAt(Parameters[i]);
+		Error += std::abs(Distance - denseLength(Curve, Parameters[i], Steps)) < 1e-6 * Curve.getLength() ? 0 : 1;
+		Error += std::abs(Curve.parameterAt(Distance) - Parameters[i]) < 1e-9 ? 0 : 1;
+	}
+	Error += Curve.parameterAt(-1.0) == 0.0 && Curve.parameterAt(Curve.getLength() * 2.0) == 7.0 ? 0 : 1;
+
+	// Evenly spaced samples, from end to end
+	std::vector<glm::dvec3> Positions(41), Tangents(41);
+	Curve.sampleUniform(Positions.size(), &Positions[0], &Tangents[0]);
+	Error += glm::length(Positions.front() - Points.front()) < 1e-12 && glm::length(Positions.back() - Points.back()) < 1e-9 ? 0 : 1;
+	double const Step = Curve.getLength() / 40.0;
+	for(std::size_t i = 0; i < Positions.size(); ++i)
+	{
+		double const u = Curve.closestPoint(Positions[i]);
+		Error += std::abs(Curve.distanceAt(u) - Step * double(i)) < 1e-9 ? 0 : 1;
+		Error += std::abs(glm::length(Tangents[i]) - 1.0) < 1e-12 ? 0 : 1;
+		Error += glm::length(Tangents[i] - glm::normalize(Curve.tangent(u))) < 1e-6 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Batches over a count that is not a whole number of blocks match the single evaluations
+static int test_evaluateBatch()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = helix(6);
+	glm::curved Curve;
+	Curve.setCatmullRom(&Points[0], Points.size(), false, 1.0);
+	std::vector<double> Parameters;
+	for(int i = 0; i < 37; ++i)
+		Parameters.push_back(double(i) * 0.15 - 0.3);
+	std::vector<glm::dvec3> Positions(Parameters.size()), Tangents(Parameters.size());
+	Curve.evaluateBatch(&Parameters[0], Parameters.size(), &Positions[0], &Tangents[0]);
+	for(std::size_t i = 0; i < Parameters.size(); ++i)
+	{
+		Error += Positions[i] == Curve.position(Parameters[i]) ? 0 : 1;
+		Error += glm::length(Tangents[i] - Curve.tangent(Parameters[i])) < 1e-12 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Closest points and bounds against dense sampling
+static int test_closestPoint()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = helix(12);
+	glm::curved Curve;
+	Curve.setCatmullRom(&Points[0], Points.size());
+	int const Steps = 4000;
+	std::vector<glm::dvec3> Samples;
+	for(int k = 0; k <= 11 * Steps; ++k)
+		Samples.push_back(Curve.position(double(k) / double(Steps)));
+
+	glm::uint32_t State = 31u;
+	for(int Test = 0; Test < 50; ++Test)
+	{
+		glm::dvec3 const p = glm::dvec3(nextRandom(State) * 3.0, nextRandom(State) * 2.0 + 1.6, nextRandom(State) * 3.0);
+		double Dense = std::numeric_limits<double>::max();
+		for(std::size_t k = 0; k < Samples.size(); ++k)
+			Dense = glm::min(Dense, distance2(Samples[k], p));
+
+		glm::dvec3 Point;
+		double Distance2 = 0.0;
+		double const u = Curve.closestPoint(p, &Point, &Distance2);
+		Error += u >= 0.0 && u <= 11.0 && Point == Curve.position(u) ? 0 : 1;
+		Error += std::abs(Distance2 - distance2(Point, p)) < 1e-12 ? 0 : 1;
+		Error += std::sqrt(Distance2) <= std::sqrt(Dense) + 1e-12 && std::sqrt(Dense) - std::sqrt(Distance2) < 1e-5 ? 0 : 1;
+	}
+
+	// Segment boxes hold their samples and are touched by them
+	for(std::size_t i = 0; i < Curve.getSegmentCount(); ++i)
+	{
+		glm::aaboxd const& Box = Curve.getSegmentBounds(i);
+		glm::dvec3 Lo(std::numeric_limits<double>::max()), Hi(-std::numeric_limits<double>::max());
+		for(int k = 0; k <= Steps; ++k)
+		{
+			glm::dvec3 const& Sample = Samples[i * Steps + std::size_t(k)];
+			Lo = glm::min(Lo, Sample);
+			Hi = glm::max(Hi, Sample);
+		}
+		Error += glm::all(glm::lessThanEqual(Box.getMin(), Lo + 1e-12)) && glm::all(glm::greaterThanEqual(Box.getMax(), Hi - 1e-12)) ? 0 : 1;
+		Error += glm::length(Box.getMin() - Lo) < 1e-6 && glm::length(Box.getMax() - Hi) < 1e-6 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_interpolation();
+	Error += test_arcLength();
+	Error += test_evaluateBatch();
+	Error += test_closestPoint();
+
+	return Error;
+}
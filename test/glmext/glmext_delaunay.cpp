@@ -0,0 +1,226 @@
+#include <glm/glm.hpp>
+#include <glmext/Delaunay.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static double nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return double(State >> 8) / double(1 << 23) - 1.0;
+}
+
+// Every triangle counter clockwise with no point strictly inside its
+// circumcircle, every point used, and the boundary edges convex
+static int checkDelaunay(std::vector<glm::dvec2> const& Points, std::vector<glm::uint32_t> const& Triangles, std::size_t Distinct)
+{
+	int Error = 0;
+
+	std::vector<int> Used(Points.size(), 0);
+	std::vector<std::pair<glm::uint32_t, glm::uint32_t> > Edges;
+	for(std::size_t t = 0; t < Triangles.size(); t += 3)
+	{
+		glm::dvec2 const& a = Points[Triangles[t]];
+		glm::dvec2 const& b = Points[Triangles[t + 1]];
+		glm::dvec2 const& c = Points[Triangles[t + 2]];
+		Error += glm::orient2d(a, b, c) > 0.0 ? 0 : 1;
+		for(std::size_t i = 0; i < Points.size(); ++i)
+			Error += glm::incircle(a, b, c, Points[i]) <= 0.0 ? 0 : 1;
+		for(int k = 0; k < 3; ++k)
+		{
+			Used[Triangles[t + k]] = 1;
+			Edges.push_back(std::make_pair(Triangles[t + k], Triangles[t + (k + 1) % 3]));
+		}
+	}
+	Error += std::count(Used.begin(), Used.end(), 1) == static_cast<std::ptrdiff_t>(Distinct) ? 0 : 1;
+
+	// An edge without its twin is on the hull, with every point on its left or on it
+	std::sort(Edges.begin(), Edges.end());
+	for(std::size_t e = 0; e < Edges.size(); ++e)
+	{
+		if(std::binary_search(Edges.begin(), Edges.end(), std::make_pair(Edges[e].second, Edges[e].first)))
+			continue;
+		for(std::size_t i = 0; i < Points.size(); ++i)
+			Error += glm::orient2d(Points[Edges[e].first], Points[Edges[e].second], Points[i]) >= 0.0 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static double area(std::vector<glm::dvec2> const& Points, std::vector<glm::uint32_t> const& Triangles)
+{
+	double Result = 0.0;
+	for(std::size_t t = 0; t < Triangles.size(); t += 3)
+		Result += glm::orient2d(Points[Triangles[t]], Points[Triangles[t + 1]], Points[Triangles[t + 2]]) * 0.5;
+	return Result;
+}
+
+static bool lessTriangle(glm::u32vec3 const& a, glm::u32vec3 const& b)
+{
+	return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : a.z < b.z);
+}
+
+// Triangles rotated to start at their smallest index, then sorted
+static std::vector<glm::u32vec3> normalized(std::vector<glm::uint32_t> const& Triangles)
+{
+	std::vector<glm::u32vec3> Result;
+	for(std::size_t t = 0; t < Triangles.size(); t += 3)
+	{
+		glm::u32vec3 Triangle(Triangles[t], Triangles[t + 1], Triangles[t + 2]);
+		while(Triangle.x > Triangle.y || Triangle.x > Triangle.z)
+			Triangle = glm::u32vec3(Triangle.y, Triangle.z, Triangle.x);
+		Result.push_back(Triangle);
+	}
+	std::sort(Result.begin(), Result.end(), lessTriangle);
+	return Result;
+}
+
+static int test_random()
+{
+	int Error = 0;
+
+	glm::uint32_t State = 13u;
+	std::vector<glm::dvec2> Points;
+	for(int i = 0; i < 300; ++i)
+		Points.push_back(glm::dvec2(nextRandom(State), nextRandom(State)));
+	for(int i = 0; i < 20; ++i)
+		Points.push_back(Points[std::size_t(i) * 7]);
+
+	glm::delaunayd Delaunay;
+	Delaunay.build(&Points[0], Points.size());
+	Error += Delaunay.getVertexCount() == 300 ? 0 : 1;
+	std::vector<glm::uint32_t> Triangles;
+	std::size_t const Count = Delaunay.getTriangles(Triangles);
+	Error += Count * 3 == Triangles.size() ? 0 : 1;
+	Error += checkDelaunay(Points, Triangles, 300);
+
+	// Euler: E = V + F - 1 over the finite faces
+	std::vector<glm::uint32_t> Edges;
+	Error += Delaunay.getEdges(Edges) == 300 + Count - 1 ? 0 : 1;
+
+	// A staged build gives the same triangles
+	glm::delaunayd Staged;
+	Staged.begin(&Points[0], Points.size());
+	std::vector<glm::delaunay_task_t> Leaves, Merges;
+	Staged.splitTop(3, Leaves, Merges);
+	for(std::size_t t = Leaves.size(); t-- > 0;)
+		Staged.buildSubtree(Leaves[t]);
+	for(std::size_t t = 0; t < Merges.size(); ++t)
+		Staged.mergeSubtrees(Merges[t]);
+	Staged.end();
+	std::vector<glm::uint32_t> StagedTriangles;
+	Staged.getTriangles(StagedTriangles);
+	Error += normalized(StagedTriangles) == normalized(Triangles) ? 0 : 1;
+
+	return Error;
+}
+
+// A square grid: collinear and cocircular points everywhere
+static int test_grid()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec2> Points;
+	for(int y = 0; y < 10; ++y)
+		for(int x = 0; x < 10; ++x)
+			Points.push_back(glm::dvec2(x, y));
+
+	glm::delaunayd Delaunay;
+	Delaunay.build(&Points[0], Points.size());
+	std::vector<glm::uint32_t> Triangles;
+	Error += Delaunay.getTriangles(Triangles) == 2 * 9 * 9 ? 0 : 1;
+	Error += checkDelaunay(Points, Triangles, Points.size());
+	Error += area(Points, Triangles) == 81.0 ? 0 : 1;
+
+	// The diagonal passes through grid points and is split at them
+	Error += Delaunay.insertConstraint(0, 99) ? 0 : 1;
+	std::vector<glm::uint32_t> Edges;
+	std::vector<glm::uint8> Constrained;
+	Delaunay.getEdges(Edges, &Constrained);
+	std::size_t ConstrainedCount = 0;
+	for(std::size_t e = 0; e < Constrained.size(); ++e)
+	{
+		if(!Constrained[e])
+			continue;
+		++ConstrainedCount;
+		Error += Edges[2 * e] % 11 == 0 && Edges[2 * e + 1] % 11 == 0 && glm::max(Edges[2 * e], Edges[2 * e + 1]) - glm::min(Edges[2 * e], Edges[2 * e + 1]) == 11 ? 0 : 1;
+	}
+	Error += ConstrainedCount == 9 ? 0 : 1;
+
+	// The other diagonal crosses it
+	Error += !Delaunay.insertConstraint(9, 90) ? 0 : 1;
+	Triangles.clear();
+	Error += Delaunay.getTriangles(Triangles) == 2 * 9 * 9 ? 0 : 1;
+	Error += area(Points, Triangles) == 81.0 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_constraint()
+{
+	int Error = 0;
+
+	glm::uint32_t State = 29u;
+	std::vector<glm::dvec2> Points;
+	Points.push_back(glm::dvec2(-1.0, 0.01));
+	Points.push_back(glm::dvec2(1.0, -0.01));
+	for(int i = 0; i < 200; ++i)
+		Points.push_back(glm::dvec2(nextRandom(State), nextRandom(State)));
+
+	glm::delaunayd Delaunay;
+	Delaunay.build(&Points[0], Points.size());
+	std::vector<glm::uint32_t> Triangles;
+	Delaunay.getTriangles(Triangles);
+	double const Area = area(Points, Triangles);
+
+	Error += Delaunay.insertConstraint(0, 1) ? 0 : 1;
+	std::vector<glm::uint32_t> Edges;
+	std::vector<glm::uint8> Constrained;
+	Delaunay.getEdges(Edges, &Constrained);
+	bool Found = false;
+	for(std::size_t e = 0; e < Constrained.size(); ++e)
+		Found = Found || (Constrained[e] && glm::min(Edges[2 * e], Edges[2 * e + 1]) == 0 && glm::max(Edges[2 * e], Edges[2 * e + 1]) == 1);
+	Error += Found ? 0 : 1;
+
+	// Still a counter clockwise triangulation of the same hull
+	Triangles.clear();
+	Delaunay.getTriangles(Triangles);
+	for(std::size_t t = 0; t < Triangles.size(); t += 3)
+		Error += glm::orient2d(Points[Triangles[t]], Points[Triangles[t + 1]], Points[Triangles[t + 2]]) > 0.0 ? 0 : 1;
+	Error += std::abs(area(Points, Triangles) - Area) < 1e-12 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_collinear()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec2> Points;
+	for(int i = 0; i < 7; ++i)
+		Points.push_back(glm::dvec2(double(6 - i), double(6 - i) * 0.5));
+
+	glm::delaunayd Delaunay;
+	Delaunay.build(&Points[0], Points.size());
+	std::vector<glm::uint32_t> Triangles, Edges;
+	Error += Delaunay.getTriangles(Triangles) == 0 ? 0 : 1;
+	Error += Delaunay.getEdges(Edges) == 6 ? 0 : 1;
+	for(std::size_t e = 0; e < Edges.size(); e += 2)
+		Error += glm::max(Edges[e], Edges[e + 1]) - glm::min(Edges[e], Edges[e + 1]) == 1 ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_random();
+	Error += test_grid();
+	Error += test_constraint();
+	Error += test_collinear();
+
+	return Error;
+}
@@ -0,0 +1,154 @@
+#include <glm/glm.hpp>
+#include <glmext/DistanceField.h>
+#include <cmath>
+#include <vector>
+
+// A unit cube centered at the origin, outward faces counter clockwise
+static void cubeMesh(std::vector<glm::vec3>& Positions, std::vector<glm::uint32_t>& Indices)
+{
+	for(int i = 0; i < 8; ++i)
+		Positions.push_back(glm::vec3((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f));
+	glm::uint32_t const Faces[] =
+	{
+		0, 2, 3, 0, 3, 1,	// -z
+		4, 5, 7, 4, 7, 6,	// +z
+		0, 1, 5, 0, 5, 4,	// -y
+		2, 6, 7, 2, 7, 3,	// +y
+		0, 4, 6, 0, 6, 2,	// -x
+		1, 3, 7, 1, 7, 5	// +x
+	};
+	Indices.assign(Faces, Faces + 36);
+}
+
+static int test_analytic()
+{
+	int Error = 0;
+
+	glm::sphere_t<float> const Sphere(glm::vec3(0.1f, -0.2f, 0.3f), 1.0f);
+	glm::sdf_gridf Grid(glm::aabox_t<float>(glm::vec3(-1.5f), glm::vec3(1.5f)), 0.05f, 1);
+	glm::evaluateSignedDistance(Sphere, Grid);
+
+	for(int i = 0; i < 100; ++i)
+	{
+		glm::vec3 const Point(std::sin(float(i) * 0.7f) * 1.3f, std::cos(float(i) * 1.1f) * 1.3f, std::sin(float(i) * 2.3f) * 1.3f);
+		float const Exact = glm::signedDistance(Sphere, Point);
+		Error += std::abs(glm::sampleDistance(Grid, Point) - Exact) < 0.01f ? 0 : 1;
+
+		// The gradient of a distance field has unit length away from the center
+		if(glm::length(Point - Sphere.getCenter()) > 0.3f)
+			Error += std::abs(glm::length(glm::sampleGradient(Grid, Point)) - 1.0f) < 0.05f ? 0 : 1;
+	}
+
+	glm::aabox_t<float> const Box(glm::vec3(-0.5f), glm::vec3(0.5f));
+	Error += std::abs(glm::signedDistance(Box, glm::vec3(0.0f)) + 0.5f) < 1e-6f ? 0 : 1;
+	Error += std::abs(glm::signedDistance(Box, glm::vec3(1.5f, 0.0f, 0.0f)) - 1.0f) < 1e-6f ? 0 : 1;
+	Error += std::abs(glm::signedDistance(Box, glm::vec3(1.5f, 1.5f, 0.0f)) - std::sqrt(2.0f)) < 1e-6f ? 0 : 1;
+
+	return Error;
+}
+
+static int test_distanceTransform()
+{
+	int Error = 0;
+
+	// Exact squared distances against brute force, on a sparse set of seeds
+	glm::ivec3 const Dims(13, 9, 7);
+	std::size_t const Count = static_cast<std::size_t>(Dims.x * Dims.y * Dims.z);
+	std::vector<float> Values(Count, std::numeric_limits<float>::max());
+	std::vector<glm::ivec3> Seeds;
+	Seeds.push_back(glm::ivec3(1, 2, 3));
+	Seeds.push_back(glm::ivec3(11, 8, 0));
+	Seeds.push_back(glm::ivec3(6, 4, 6));
+	for(std::size_t s = 0; s < Seeds.size(); ++s)
+		Values[static_cast<std::size_t>(Seeds[s].x + Dims.x * (Seeds[s].y + Dims.y * Seeds[s].z))] = 0.0f;
+
+	glm::distanceTransform(&Values[0], Dims);
+
+	for(int z = 0; z < Dims.z; ++z)
+	for(int y = 0; y < Dims.y; ++y)
+	for(int x = 0; x < Dims.x; ++x)
+	{
+		int Nearest = std::numeric_limits<int>::max();
+		for(std::size_t s = 0; s < Seeds.size(); ++s)
+		{
+			glm::ivec3 const d = glm::ivec3(x, y, z) - Seeds[s];
+			Nearest = glm::min(Nearest, d.x * d.x + d.y * d.y + d.z * d.z);
+		}
+		Error += Values[static_cast<std::size_t>(x + Dims.x * (y + Dims.y * z))] == static_cast<float>(Nearest) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_mask()
+{
+	int Error = 0;
+
+	glm::sdf_gridf Grid(glm::ivec3(24, 24, 24), glm::vec3(-1.15f), 0.1f);
+	glm::vec3 const Center(0.0f);
+	std::vector<glm::uint8_t> Mask(Grid.mValues.size());
+	for(int z = 0; z < 24; ++z)
+	for(int y = 0; y < 24; ++y)
+	for(int x = 0; x < 24; ++x)
+		Mask[Grid.getIndex(x, y, z)] = glm::length(Grid.getPosition(x, y, z) - Center) < 0.8f ? 1 : 0;
+
+	glm::signedDistanceFromMask(&Mask[0], Grid);
+
+	for(int z = 0; z < 24; ++z)
+	for(int y = 0; y < 24; ++y)
+	for(int x = 0; x < 24; ++x)
+	{
+		float const Value = Grid(x, y, z);
+		float const Exact = glm::length(Grid.getPosition(x, y, z) - Center) - 0.8f;
+		Error += (Value < 0.0f) == (Mask[Grid.getIndex(x, y, z)] != 0) ? 0 : 1;
+		Error += std::abs(Value - Exact) < 0.1f ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_mesh(glm::SdfSignMode Mode)
+{
+	int Error = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	cubeMesh(Positions, Indices);
+
+	glm::aabox_t<float> const Box(glm::vec3(-0.5f), glm::vec3(0.5f));
+	glm::sdf_gridf Grid(Box, 0.0625f, 6);
+	glm::meshToSignedDistance(&Positions[0], &Indices[0], 12, 2.0f, Mode, Grid);
+
+	glm::ivec3 const Dims = Grid.getDims();
+	for(int z = 0; z < Dims.z; ++z)
+	for(int y = 0; y < Dims.y; ++y)
+	for(int x = 0; x < Dims.x; ++x)
+	{
+		float const Exact = glm::signedDistance(Box, Grid.getPosition(x, y, z));
+		float const Value = Grid(x, y, z);
+		if(std::abs(Exact) <= 2.0f * Grid.getVoxelSize())
+		{
+			// Exact band, the sign of voxels on the surface is either way
+			Error += std::abs(std::abs(Value) - std::abs(Exact)) < 1e-5f ? 0 : 1;
+			if(std::abs(Exact) > 1e-5f)
+				Error += (Value < 0.0f) == (Exact < 0.0f) ? 0 : 1;
+		}
+		else
+			Error += std::abs(Value - Exact) <= Grid.getVoxelSize() ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_analytic();
+	Error += test_distanceTransform();
+	Error += test_mask();
+	Error += test_mesh(glm::SDF_SIGN_RAY_PARITY);
+	Error += test_mesh(glm::SDF_SIGN_WINDING_NUMBER);
+
+	return Error;
+}
@@ -0,0 +1,159 @@
+#include <glm/glm.hpp>
+#include <glmext/Interval.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+	typedef long double reference;
+
+	template<typename T>
+	static T randomBound()
+	{
+		T const Unit = static_cast<T>(std::rand()) / static_cast<T>(RAND_MAX) * static_cast<T>(2) - static_cast<T>(1);
+		return static_cast<T>(std::ldexp(Unit, std::rand() % 40 - 20));
+	}
+
+	template<typename T>
+	static int contains(glm::interval_t<T> const& Interval, reference Value)
+	{
+		return static_cast<reference>(Interval.getLower()) <= Value && Value <= static_cast<reference>(Interval.getUpper()) ? 0 : 1;
+	}
+
+	template<typename T>
+	static int test_operators()
+	{
+		int Error = 0;
+
+		std::srand(17);
+		for(int i = 0; i < 100000; ++i)
+		{
+			T a0 = randomBound<T>(), a1 = randomBound<T>(), b0 = randomBound<T>(), b1 = randomBound<T>();
+			if(a0 > a1)
+				std::swap(a0, a1);
+			if(b0 > b1)
+				std::swap(b0, b1);
+			if(i % 5 == 0)
+				a1 = a0;
+
+			glm::interval_t<T> const A(a0, a1), B(b0, b1);
+			glm::interval_t<T> const Sum = A + B, Difference = A - B, Product = A * B, Quotient = A / B, Root = glm::sqrt(A);
+
+			reference const As[] = {a0, (static_cast<reference>(a0) + a1) / 2, a1};
+			reference const Bs[] = {b0, (static_cast<reference>(b0) + b1) / 2, b1};
+			for(int j = 0; j < 3; ++j)
+			for(int k = 0; k < 3; ++k)
+			{
+				Error += contains(Sum, As[j] + Bs[k]);
+				Error += contains(Difference, As[j] - Bs[k]);
+				Error += contains(Product, As[j] * Bs[k]);
+				if(b0 > 0 || b1 < 0)
+					Error += contains(Quotient, As[j] / Bs[k]);
+				if(As[j] >= 0)
+					Error += contains(Root, std::sqrt(As[j]));
+			}
+
+			// Outward rounding widens by a few ulps only
+			reference const Width = static_cast<reference>(Product.getUpper()) - static_cast<reference>(Product.getLower());
+			reference const Magnitude = std::max(std::abs(static_cast<reference>(Product.getUpper())), std::abs(static_cast<reference>(Product.getLower())));
+			reference const Exact = std::max(std::max(As[0] * Bs[0], As[0] * Bs[2]), std::max(As[2] * Bs[0], As[2] * Bs[2]))
+				- std::min(std::min(As[0] * Bs[0], As[0] * Bs[2]), std::min(As[2] * Bs[0], As[2] * Bs[2]));
+			Error += Width - Exact <= Magnitude * std::numeric_limits<T>::epsilon() * 8 + std::numeric_limits<T>::min() * 4 ? 0 : 1;
+		}
+
+		// Division by an interval containing zero, then products with zero
+		glm::interval_t<T> const Entire = glm::interval_t<T>(1, 2) / glm::interval_t<T>(-1, 1);
+		Error += Entire.getLower() == -std::numeric_limits<T>::infinity() && Entire.getUpper() == std::numeric_limits<T>::infinity() ? 0 : 1;
+		glm::interval_t<T> const Product = Entire * glm::interval_t<T>(0, 1);
+		Error += Product.contains(static_cast<T>(0.5)) && Product.contains(static_cast<T>(-1e6)) ? 0 : 1;
+		glm::interval_t<T> const Zero = Entire * glm::interval_t<T>(0);
+		Error += Zero.contains(static_cast<T>(0)) && Zero.getWidth() < static_cast<T>(1) ? 0 : 1;
+
+		// The negative part of a square root is dropped
+		glm::interval_t<T> const Root = glm::sqrt(glm::interval_t<T>(-1, 4));
+		Error += Root.contains(static_cast<T>(0)) && Root.contains(static_cast<T>(2)) && Root.getUpper() < static_cast<T>(2.001) ? 0 : 1;
+
+		Error += glm::certainlyLess(glm::interval_t<T>(0, 1), glm::interval_t<T>(2, 3)) ? 0 : 1;
+		Error += !glm::certainlyLess(glm::interval_t<T>(0, 2), glm::interval_t<T>(2, 3)) ? 0 : 1;
+		Error += glm::certainlyGreater(glm::interval_t<T>(4, 5), glm::interval_t<T>(2, 3)) ? 0 : 1;
+		glm::interval_t<T> const Negated = -glm::interval_t<T>(1, 2);
+		Error += Negated.getLower() == static_cast<T>(-2) && Negated.getUpper() == static_cast<T>(-1) ? 0 : 1;
+
+		return Error;
+	}
+
+	template<typename T>
+	static int test_vector()
+	{
+		int Error = 0;
+
+		typedef glm::interval_t<T> interval;
+		typedef glm::vec<3, interval> interval3;
+
+		interval3 const A(interval(1, 2), interval(-1, 1), interval(static_cast<T>(0.5)));
+		interval3 const B(interval(3), interval(2), interval(-1, 0));
+
+		interval const Dot = glm::dot(A, B);
+		interval3 const Cross = glm::cross(A, B);
+
+		// Corners of A and B and their exact dot and cross products
+		for(int i = 0; i < 8; ++i)
+		for(int j = 0; j < 2; ++j)
+		{
+			glm::vec<3, reference> const a(
+				(i & 1) ? A.x.getUpper() : A.x.getLower(),
+				(i & 2) ? A.y.getUpper() : A.y.getLower(),
+				A.z.getLower());
+			glm::vec<3, reference> const b(B.x.getLower(), B.y.getLower(), j ? B.z.getUpper() : B.z.getLower());
+			Error += contains(Dot, a.x * b.x + a.y * b.y + a.z * b.z);
+			Error += contains(Cross.x, a.y * b.z - a.z * b.y);
+			Error += contains(Cross.y, a.z * b.x - a.x * b.z);
+			Error += contains(Cross.z, a.x * b.y - a.y * b.x);
+		}
+		Error += Dot.getLower() > static_cast<T>(0.49) && Dot.getUpper() < static_cast<T>(8.01) ? 0 : 1;
+
+		interval3 const Sum = A + B * interval(2);
+		Error += Sum.x.contains(static_cast<T>(7)) && Sum.x.contains(static_cast<T>(8)) ? 0 : 1;
+
+		return Error;
+	}
+
+	template<typename T>
+	static int test_aabox()
+	{
+		int Error = 0;
+
+		glm::aabox_t<T> const Box(glm::vec<3, T>(-1, 0, 2), glm::vec<3, T>(1, 3, 5));
+		glm::vec<3, glm::interval_t<T> > const Intervals = glm::toIntervals(Box);
+		Error += Intervals.y.getLower() == static_cast<T>(0) && Intervals.z.getUpper() == static_cast<T>(5) ? 0 : 1;
+
+		glm::aabox_t<T> const Back = glm::toAABox(Intervals);
+		Error += !Back.isEmpty() && Back.getMin() == Box.getMin() && Back.getMax() == Box.getMax() ? 0 : 1;
+
+		// Conservative bounds of the box translated and scaled
+		glm::aabox_t<T> const Moved = glm::toAABox(Intervals * glm::interval_t<T>(2) + glm::vec<3, glm::interval_t<T> >(glm::interval_t<T>(1)));
+		Error += Moved.getMin().x <= static_cast<T>(-1) && Moved.getMax().z >= static_cast<T>(11) ? 0 : 1;
+		Error += Moved.getMin().x > static_cast<T>(-1.001) && Moved.getMax().z < static_cast<T>(11.001) ? 0 : 1;
+
+		// The empty box round trips to an empty box
+		glm::vec<3, glm::interval_t<T> > const Empty = glm::toIntervals(glm::aabox_t<T>());
+		Error += Empty.x.getLower() > Empty.x.getUpper() ? 0 : 1;
+		Error += glm::toAABox(Empty).isEmpty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_operators<float>();
+	Error += test_operators<double>();
+	Error += test_vector<float>();
+	Error += test_vector<double>();
+	Error += test_aabox<float>();
+	Error += test_aabox<double>();
+
+	return Error;
+}
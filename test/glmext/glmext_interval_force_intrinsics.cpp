@@ -0,0 +1,4 @@
+#define GLM_FORCE_INTRINSICS
+
+// The same checks, on the SSE2 interval_t<double> where available
+#include "glmext_interval.cpp"
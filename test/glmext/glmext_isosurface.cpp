@@ -0,0 +1,152 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glmext/Isosurface.h>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+static float const Radius = 0.7f;
+
+// A sphere of the given radius sampled on a grid around the origin
+static glm::sdf_grid_t<float> sphereGrid()
+{
+	glm::sdf_grid_t<float> Grid(glm::ivec3(21, 19, 17), glm::vec3(-1.0f, -0.9f, -0.8f), 0.1f);
+	glm::ivec3 const& Dims = Grid.getDims();
+	for(int z = 0; z < Dims.z; ++z)
+	for(int y = 0; y < Dims.y; ++y)
+	for(int x = 0; x < Dims.x; ++x)
+		Grid(x, y, z) = glm::length(Grid.getPosition(x, y, z)) - Radius;
+	return Grid;
+}
+
+// Each directed edge used once and its reverse once: closed and consistently oriented
+static int closedMesh(glm::iso_meshf const& Mesh)
+{
+	int Error = 0;
+
+	std::map<std::pair<glm::uint32_t, glm::uint32_t>, int> Edges;
+	for(std::size_t i = 0; i < Mesh.mIndices.size(); i += 3)
+	for(int k = 0; k < 3; ++k)
+		++Edges[std::make_pair(Mesh.mIndices[i + k], Mesh.mIndices[i + (k + 1) % 3])];
+	for(std::map<std::pair<glm::uint32_t, glm::uint32_t>, int>::const_iterator it = Edges.begin(); it != Edges.end(); ++it)
+	{
+		if(it->first.first == it->first.second)
+			continue;
+		std::map<std::pair<glm::uint32_t, glm::uint32_t>, int>::const_iterator Reverse = Edges.find(std::make_pair(it->first.second, it->first.first));
+		Error += it->second == 1 && Reverse != Edges.end() && Reverse->second == 1 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Sum of the signed tetrahedron volumes, positive for outward facing triangles
+static float meshVolume(glm::iso_meshf const& Mesh)
+{
+	float Volume = 0.0f;
+	for(std::size_t i = 0; i < Mesh.mIndices.size(); i += 3)
+	{
+		glm::vec3 const& a = Mesh.mPositions[Mesh.mIndices[i]];
+		glm::vec3 const& b = Mesh.mPositions[Mesh.mIndices[i + 1]];
+		glm::vec3 const& c = Mesh.mPositions[Mesh.mIndices[i + 2]];
+		Volume += glm::dot(a, glm::cross(b, c)) / 6.0f;
+	}
+	return Volume;
+}
+
+static int test_sphere(glm::IsoMethod Method, float Tolerance)
+{
+	int Error = 0;
+
+	glm::sdf_grid_t<float> const Grid = sphereGrid();
+	glm::iso_meshf Mesh;
+	glm::extractIsosurface(Grid, 0.0f, Method, Mesh);
+	Error += !Mesh.mIndices.empty() && Mesh.mIndices.size() % 3 == 0 ? 0 : 1;
+	Error += Mesh.mPositions.size() == Mesh.mNormals.size() && Mesh.mPositions.size() == Mesh.mKeys.size() ? 0 : 1;
+
+	for(std::size_t v = 0; v < Mesh.mPositions.size(); ++v)
+	{
+		glm::vec3 const& p = Mesh.mPositions[v];
+		Error += std::abs(glm::length(p) - Radius) < Tolerance ? 0 : 1;
+		Error += glm::dot(Mesh.mNormals[v], glm::normalize(p)) > 0.95f ? 0 : 1;
+	}
+
+	Error += closedMesh(Mesh);
+	float const Expected = 4.0f / 3.0f * glm::pi<float>() * Radius * Radius * Radius;
+	Error += std::abs(meshVolume(Mesh) - Expected) < Expected * 0.05f ? 0 : 1;
+
+	// Chunks merged back give the same surface
+	glm::ivec3 const Cells = Grid.getDims() - 1;
+	glm::ivec3 const Split(7, 11, 5);
+	std::vector<glm::iso_meshf> Chunks(8);
+	for(int c = 0; c < 8; ++c)
+	{
+		glm::ivec3 const Lo((c & 1) ? Split.x : 0, (c & 2) ? Split.y : 0, (c & 4) ? Split.z : 0);
+		glm::ivec3 const Hi((c & 1) ? Cells.x : Split.x, (c & 2) ? Cells.y : Split.y, (c & 4) ? Cells.z : Split.z);
+		glm::extractIsosurfaceChunk(Grid, 0.0f, Method, Lo, Hi, Chunks[c]);
+	}
+	glm::iso_meshf Merged;
+	glm::mergeIsosurfaceChunks(&Chunks[0], Chunks.size(), Merged);
+	Error += Merged.mPositions.size() == Mesh.mPositions.size() ? 0 : 1;
+	Error += Merged.mIndices.size() == Mesh.mIndices.size() ? 0 : 1;
+	Error += closedMesh(Merged);
+	Error += std::abs(meshVolume(Merged) - meshVolume(Mesh)) < 1e-4f ? 0 : 1;
+
+	return Error;
+}
+
+// Distance from each corner of the box to its nearest mesh vertex, and the mesh volume error
+static void boxErrors(glm::sdf_grid_t<float> const& Grid, glm::vec3 const& Half, glm::IsoMethod Method, float& CornerError, float& VolumeError, int& Error)
+{
+	glm::iso_meshf Mesh;
+	glm::extractIsosurface(Grid, 0.0f, Method, Mesh);
+	Error += closedMesh(Mesh);
+	VolumeError = std::abs(meshVolume(Mesh) - 8.0f * Half.x * Half.y * Half.z);
+
+	CornerError = 0.0f;
+	for(int c = 0; c < 8; ++c)
+	{
+		glm::vec3 const Corner((c & 1) ? Half.x : -Half.x, (c & 2) ? Half.y : -Half.y, (c & 4) ? Half.z : -Half.z);
+		float Nearest = 1.0f;
+		for(std::size_t v = 0; v < Mesh.mPositions.size(); ++v)
+			Nearest = glm::min(Nearest, glm::length(Mesh.mPositions[v] - Corner));
+		CornerError = glm::max(CornerError, Nearest);
+	}
+}
+
+// Dual contouring follows the corners of a box closer than marching cubes
+static int test_sharpFeatures()
+{
+	int Error = 0;
+
+	glm::sdf_grid_t<float> Grid(glm::ivec3(16), glm::vec3(-0.75f), 0.1f);
+	glm::vec3 const Half(0.42f, 0.37f, 0.33f);
+	for(int z = 0; z < 16; ++z)
+	for(int y = 0; y < 16; ++y)
+	for(int x = 0; x < 16; ++x)
+	{
+		glm::vec3 const q = glm::abs(Grid.getPosition(x, y, z)) - Half;
+		Grid(x, y, z) = glm::length(glm::max(q, glm::vec3(0.0f))) + glm::min(glm::max(q.x, glm::max(q.y, q.z)), 0.0f);
+	}
+
+	float CornerMC, VolumeMC, CornerDC, VolumeDC;
+	boxErrors(Grid, Half, glm::ISO_MARCHING_CUBES, CornerMC, VolumeMC, Error);
+	boxErrors(Grid, Half, glm::ISO_DUAL_CONTOURING, CornerDC, VolumeDC, Error);
+	Error += CornerDC < CornerMC ? 0 : 1;
+	Error += VolumeDC < VolumeMC ? 0 : 1;
+	Error += CornerDC < 0.6f * Grid.getVoxelSize() ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_sphere(glm::ISO_MARCHING_CUBES, 0.01f);
+	Error += test_sphere(glm::ISO_DUAL_CONTOURING, 0.02f);
+	Error += test_sharpFeatures();
+
+	return Error;
+}
@@ -0,0 +1,171 @@
+#include <glm/glm.hpp>
+#include <glmext/KdTree.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static float nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return float(State >> 8) / float(1 << 23) - 1.0f;
+}
+
+template<glm::length_t L>
+static std::vector<glm::vec<L, float> > randomPoints(std::size_t Count, glm::uint32_t Seed)
+{
+	std::vector<glm::vec<L, float> > Points(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+		for(glm::length_t a = 0; a < L; ++a)
+			Points[i][a] = nextRandom(Seed);
+	return Points;
+}
+
+// Accumulated one axis after the other, like the tree, so the results compare exactly
+template<glm::length_t L>
+static float distance2(glm::vec<L, float> const& a, glm::vec<L, float> const& b)
+{
+	float Result = 0.0f;
+	for(glm::length_t i = 0; i < L; ++i)
+		Result += (a[i] - b[i]) * (a[i] - b[i]);
+	return Result;
+}
+
+// Compares the queries of a tree with brute force searches over its points
+template<glm::length_t L>
+static int checkQueries(glm::kd_tree_t<L, float> const& Tree, std::vector<glm::vec<L, float> > const& Points, std::vector<glm::vec<L, float> > const& Queries)
+{
+	int Error = 0;
+
+	std::size_t const k = 7;
+	float const Radius2 = 0.05f;
+	std::vector<glm::uint32_t> Indices(k);
+	std::vector<float> Distances2(k);
+	for(std::size_t q = 0; q < Queries.size(); ++q)
+	{
+		std::vector<float> Brute(Points.size());
+		for(std::size_t i = 0; i < Points.size(); ++i)
+			Brute[i] = distance2(Points[i], Queries[q]);
+		std::vector<float> Sorted(Brute);
+		std::sort(Sorted.begin(), Sorted.end());
+
+		// Nearest
+		float Nearest2 = 0.0f;
+		glm::uint32_t const Nearest = Tree.nearest(Queries[q], std::numeric_limits<float>::max(), &Nearest2);
+		Error += Nearest < Points.size() && Brute[Nearest] == Sorted[0] && Nearest2 == Sorted[0] ? 0 : 1;
+		Error += Tree.nearest(Queries[q], Sorted[0] * 0.5f) == std::numeric_limits<glm::uint32_t>::max() ? 0 : 1;
+
+		// k nearest, nearest first; the radius is exclusive
+		Error += Tree.knearest(Queries[q], k, &Indices[0], &Distances2[0]) == k ? 0 : 1;
+		for(std::size_t i = 0; i < k; ++i)
+			Error += Distances2[i] == Sorted[i] && Brute[Indices[i]] == Sorted[i] ? 0 : 1;
+		std::size_t const Within = static_cast<std::size_t>(std::lower_bound(Sorted.begin(), Sorted.end(), Sorted[2]) - Sorted.begin());
+		Error += Tree.knearest(Queries[q], k, &Indices[0], &Distances2[0], Sorted[2]) == std::min(Within, k) ? 0 : 1;
+
+		// Radius, inclusive
+		std::vector<glm::uint32_t> Found;
+		std::vector<float> FoundDistances2;
+		Error += Tree.radiusSearch(Queries[q], Radius2, Found, &FoundDistances2) == Found.size() ? 0 : 1;
+		std::vector<glm::uint32_t> Expected;
+		for(std::size_t i = 0; i < Points.size(); ++i)
+			if(Brute[i] <= Radius2)
+				Expected.push_back(static_cast<glm::uint32_t>(i));
+		for(std::size_t i = 0; i < Found.size(); ++i)
+			Error += FoundDistances2[i] == Brute[Found[i]] ? 0 : 1;
+		std::sort(Found.begin(), Found.end());
+		Error += Found == Expected ? 0 : 1;
+	}
+
+	return Error;
+}
+
+template<glm::length_t L>
+static int test_tree(std::size_t Count, std::size_t LeafSize)
+{
+	int Error = 0;
+
+	std::vector<glm::vec<L, float> > const Points = randomPoints<L>(Count, 11u);
+	std::vector<glm::vec<L, float> > const Queries = randomPoints<L>(40, 23u);
+
+	glm::kd_tree_t<L, float> Tree;
+	Tree.build(&Points[0], Points.size(), LeafSize);
+	Error += Tree.size() == Count && Tree.getLeafSize() == LeafSize ? 0 : 1;
+	for(std::size_t i = 0; i < Tree.size(); ++i)
+		Error += Tree.getPoint(i) == Points[Tree.getIndex(i)] ? 0 : 1;
+	Error += checkQueries(Tree, Points, Queries);
+
+	// A staged build gives the same tree
+	glm::kd_tree_t<L, float> Staged;
+	Staged.beginBuild(&Points[0], Points.size(), LeafSize);
+	std::vector<glm::kd_build_task_t> Tasks;
+	Staged.splitTop(2, Tasks);
+	for(std::size_t t = Tasks.size(); t-- > 0;)
+		Staged.buildSubtree(Tasks[t]);
+	Staged.endBuild();
+	for(std::size_t i = 0; i < Tree.size(); ++i)
+		Error += Staged.getIndex(i) == Tree.getIndex(i) ? 0 : 1;
+
+	// Batches match the single queries
+	std::size_t const k = 4;
+	std::vector<glm::uint32_t> Indices(Queries.size() * k), Single(k);
+	std::vector<float> Distances2(Queries.size() * k), SingleDistances2(k);
+	std::vector<std::size_t> Counts(Queries.size());
+	Tree.knearestBatch(&Queries[0], 0, Queries.size() / 2, k, &Indices[0], &Distances2[0], &Counts[0]);
+	Tree.knearestBatch(&Queries[0], Queries.size() / 2, Queries.size() - Queries.size() / 2, k, &Indices[0], &Distances2[0], &Counts[0]);
+	glm::kd_radius_result_t<float> Radius;
+	Radius.clear();
+	Tree.radiusSearchBatch(&Queries[0], 0, Queries.size(), 0.05f, Radius);
+	Error += Radius.getQueryCount() == Queries.size() ? 0 : 1;
+	for(std::size_t q = 0; q < Queries.size(); ++q)
+	{
+		Error += Counts[q] == Tree.knearest(Queries[q], k, &Single[0], &SingleDistances2[0]) ? 0 : 1;
+		Error += std::equal(Single.begin(), Single.end(), Indices.begin() + q * k) ? 0 : 1;
+
+		std::vector<glm::uint32_t> Found;
+		Tree.radiusSearch(Queries[q], 0.05f, Found);
+		Error += std::equal(Found.begin(), Found.end(), Radius.mIndices.begin() + Radius.mOffsets[q]) && Found.size() == Radius.mOffsets[q + 1] - Radius.mOffsets[q] ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_edgeCases()
+{
+	int Error = 0;
+
+	glm::kd_tree_t<3, float> Empty;
+	Empty.build(static_cast<glm::vec3 const*>(NULL), 0);
+	glm::uint32_t Index = 0;
+	float Distance2 = 0.0f;
+	std::vector<glm::uint32_t> Found;
+	Error += Empty.nearest(glm::vec3(0.0f)) == std::numeric_limits<glm::uint32_t>::max() ? 0 : 1;
+	Error += Empty.knearest(glm::vec3(0.0f), 1, &Index, &Distance2) == 0 ? 0 : 1;
+	Error += Empty.radiusSearch(glm::vec3(0.0f), 1.0f, Found) == 0 ? 0 : 1;
+
+	// Many equal points, fewer points than k
+	std::vector<glm::vec3> Same(40, glm::vec3(0.5f));
+	Same.push_back(glm::vec3(0.0f));
+	glm::kd_tree_t<3, float> Tree;
+	Tree.build(&Same[0], Same.size(), 4);
+	Error += Tree.nearest(glm::vec3(0.1f)) == 40 ? 0 : 1;
+	Error += Tree.radiusSearch(glm::vec3(0.5f), 0.0f, Found) == 40 ? 0 : 1;
+	std::vector<glm::uint32_t> Indices(50);
+	std::vector<float> Distances2(50);
+	Error += Tree.knearest(glm::vec3(0.0f), 50, &Indices[0], &Distances2[0]) == Same.size() ? 0 : 1;
+	Error += Indices[0] == 40 && Distances2[0] == 0.0f ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_tree<2>(500, 16);
+	Error += test_tree<3>(1000, 16);
+	Error += test_tree<3>(333, 1);
+	Error += test_tree<4>(257, 5);
+	Error += test_edgeCases();
+
+	return Error;
+}
@@ -0,0 +1,158 @@
+#include <glm/glm.hpp>
+#include <glmext/KMeans.h>
+#include <algorithm>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static double nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return double(State >> 8) / double(1 << 23) - 1.0;
+}
+
+// Blobs of points around a few centers, plus some noise between them
+static std::vector<glm::dvec3> blobs(std::size_t Count)
+{
+	glm::dvec3 const Centers[] = {glm::dvec3(0, 0, 0), glm::dvec3(4, 0, 1), glm::dvec3(-3, 3, 0), glm::dvec3(1, -4, 2), glm::dvec3(0, 2, -5)};
+	glm::uint32_t State = 17u;
+	std::vector<glm::dvec3> Points;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		glm::dvec3 const Offset(nextRandom(State), nextRandom(State), nextRandom(State));
+		Points.push_back(i % 10 == 9 ? Offset * 5.0 : Centers[i % 5] + Offset * 1.2);
+	}
+	return Points;
+}
+
+static double distance2(glm::dvec3 const& a, glm::dvec3 const& b)
+{
+	return glm::dot(a - b, a - b);
+}
+
+// At convergence every point is on its nearest centroid and every centroid is the mean of its points
+static int checkConverged(std::vector<glm::dvec3> const& Points, glm::kmeans_state3d const& State)
+{
+	int Error = 0;
+
+	std::size_t const k = State.getClusterCount();
+	std::vector<glm::dvec3> Sums(k, glm::dvec3(0.0));
+	std::vector<std::size_t> Counts(k, 0);
+	for(std::size_t i = 0; i < Points.size(); ++i)
+	{
+		double const Best = distance2(Points[i], State.mCentroids[State.mAssignments[i]]);
+		for(std::size_t j = 0; j < k; ++j)
+			Error += distance2(Points[i], State.mCentroids[j]) >= Best * (1.0 - 1e-12) ? 0 : 1;
+		Sums[State.mAssignments[i]] += Points[i];
+		++Counts[State.mAssignments[i]];
+	}
+	for(std::size_t j = 0; j < k; ++j)
+		Error += Counts[j] > 0 && glm::length(Sums[j] / double(Counts[j]) - State.mCentroids[j]) < 1e-12 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_kmeansPlusPlus()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = blobs(200);
+	std::vector<glm::dvec3> a(5), b(5);
+	glm::kmeansPlusPlus(&Points[0], Points.size(), 5, 42u, &a[0]);
+	glm::kmeansPlusPlus(&Points[0], Points.size(), 5, 42u, &b[0]);
+	Error += a == b ? 0 : 1;
+	for(std::size_t c = 0; c < a.size(); ++c)
+	{
+		Error += std::find(Points.begin(), Points.end(), a[c]) != Points.end() ? 0 : 1;
+		Error += std::count(a.begin(), a.end(), a[c]) == 1 ? 0 : 1;
+	}
+
+	// Once every distinct point is picked, the last point fills the rest
+	std::vector<glm::dvec3> Two(10, glm::dvec3(1.0));
+	Two[3] = glm::dvec3(2.0);
+	std::vector<glm::dvec3> Picked(4);
+	glm::kmeansPlusPlus(&Two[0], Two.size(), 4, 1u, &Picked[0]);
+	Error += Picked[0] != Picked[1] && Picked[2] == Two.back() && Picked[3] == Two.back() ? 0 : 1;
+
+	return Error;
+}
+
+static int test_methods()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = blobs(1000);
+	glm::KMeansMethod const Methods[] = {glm::KMEANS_LLOYD, glm::KMEANS_HAMERLY, glm::KMEANS_ELKAN};
+	glm::kmeans_state3d States[3];
+	int Passes[3];
+	for(int m = 0; m < 3; ++m)
+	{
+		glm::kmeans_params_t Params;
+		Params.mMethod = Methods[m];
+		Params.mSeed = 7u;
+		Passes[m] = glm::kmeans(&Points[0], Points.size(), 5, Params, States[m]);
+		Error += Passes[m] > 1 && Passes[m] < Params.mMaxIterations ? 0 : 1;
+		Error += States[m].getClusterCount() == 5 ? 0 : 1;
+		Error += checkConverged(Points, States[m]);
+	}
+
+	// The bounds only skip work: every method makes the same passes
+	for(int m = 1; m < 3; ++m)
+	{
+		Error += Passes[m] == Passes[0] ? 0 : 1;
+		Error += States[m].mAssignments == States[0].mAssignments ? 0 : 1;
+		Error += States[m].mCentroids == States[0].mCentroids ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Passes split over chunks with one accumulator each match the single call
+static int test_chunked()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> const Points = blobs(500);
+	glm::kmeans_params_t Params;
+	Params.mMethod = glm::KMEANS_ELKAN;
+	glm::kmeans_state3d Reference;
+	int const Passes = glm::kmeans(&Points[0], Points.size(), 5, Params, Reference);
+
+	std::vector<glm::dvec3> Initial(5);
+	glm::kmeansPlusPlus(&Points[0], Points.size(), 5, Params.mSeed, &Initial[0]);
+	glm::kmeans_state3d State;
+	State.reset(&Initial[0], Initial.size(), Points.size(), Params.mMethod);
+	std::vector<glm::kmeans_accumulator_t<3> > Accumulators(3);
+	std::size_t const Chunk = 170;
+	for(int Pass = 0; Pass < Passes; ++Pass)
+	{
+		for(std::size_t a = 0; a < Accumulators.size(); ++a)
+		{
+			Accumulators[a].reset(5);
+			std::size_t const First = a * Chunk;
+			glm::kmeansAssignRange(&Points[0], First, std::min(Chunk, Points.size() - First), State, Accumulators[a]);
+		}
+		glm::kmeansUpdate(State, &Accumulators[0], Accumulators.size());
+	}
+	Error += State.mAssignments == Reference.mAssignments ? 0 : 1;
+	for(std::size_t j = 0; j < 5; ++j)
+		Error += glm::length(State.mCentroids[j] - Reference.mCentroids[j]) < 1e-12 ? 0 : 1;
+
+	// More clusters than points is clamped
+	glm::kmeans_state3d Small;
+	glm::kmeans(&Points[0], 3, 8, Params, Small);
+	Error += Small.getClusterCount() == 3 ? 0 : 1;
+	Error += checkConverged(std::vector<glm::dvec3>(Points.begin(), Points.begin() + 3), Small);
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_kmeansPlusPlus();
+	Error += test_methods();
+	Error += test_chunked();
+
+	return Error;
+}
@@ -0,0 +1,143 @@
+#include <glm/glm.hpp>
+#include <glmext/Meshlet.h>
+#include <algorithm>
+#include <vector>
+
+// A flat grid in the z = 0 plane, triangles counter clockwise seen from +z
+static void gridMesh(int Size, std::vector<glm::vec3>& Positions, std::vector<glm::uint32_t>& Indices)
+{
+	for(int y = 0; y <= Size; ++y)
+	for(int x = 0; x <= Size; ++x)
+		Positions.push_back(glm::vec3(float(x), float(y), 0.0f));
+	for(int y = 0; y < Size; ++y)
+	for(int x = 0; x < Size; ++x)
+	{
+		glm::uint32_t const v = static_cast<glm::uint32_t>(y * (Size + 1) + x);
+		glm::uint32_t const Row = static_cast<glm::uint32_t>(Size + 1);
+		glm::uint32_t const Quad[] = {v, v + 1, v + Row + 1, v, v + Row + 1, v + Row};
+		Indices.insert(Indices.end(), Quad, Quad + 6);
+	}
+}
+
+// An axis aligned box as a frustum, planes facing outwards
+static glm::frustum_t<float> boxFrustum(glm::vec3 const& Min, glm::vec3 const& Max)
+{
+	glm::frustum_t<float> Frustum;
+	for(int Axis = 0; Axis < 3; ++Axis)
+	{
+		glm::vec3 Normal(0.0f);
+		Normal[Axis] = 1.0f;
+		Frustum.mPlanes[2 * Axis] = glm::plane_t<float>(-Normal, Min);
+		Frustum.mPlanes[2 * Axis + 1] = glm::plane_t<float>(Normal, Max);
+	}
+	return Frustum;
+}
+
+static int test_buildMeshlets()
+{
+	int Error = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(16, Positions, Indices);
+	std::size_t const TriangleCount = Indices.size() / 3;
+
+	glm::meshlet_setf Set;
+	glm::buildMeshlets(&Positions[0], Positions.size(), &Indices[0], TriangleCount, 32, 40, Set);
+	Error += Set.mMeshlets.size() == Set.mBounds.size() ? 0 : 1;
+	Error += Set.mMeshlets.size() >= TriangleCount / 40 ? 0 : 1;
+
+	// Every triangle lands in exactly one meshlet, within the limits
+	std::vector<int> Seen(TriangleCount, 0);
+	for(std::size_t m = 0; m < Set.mMeshlets.size(); ++m)
+	{
+		glm::meshlet_t const& Meshlet = Set.mMeshlets[m];
+		Error += Meshlet.mVertexCount <= 32 ? 0 : 1;
+		Error += Meshlet.mTriangleCount >= 1 && Meshlet.mTriangleCount <= 40 ? 0 : 1;
+
+		glm::meshlet_boundsf const& Bounds = Set.mBounds[m];
+		for(glm::uint32_t t = 0; t < Meshlet.mTriangleCount; ++t)
+		{
+			glm::uint32_t Corners[3];
+			for(int k = 0; k < 3; ++k)
+			{
+				glm::uint8_t const Local = Set.mTriangles[3 * (Meshlet.mTriangleOffset + t) + k];
+				Error += Local < Meshlet.mVertexCount ? 0 : 1;
+				Corners[k] = Set.mVertices[Meshlet.mVertexOffset + Local];
+
+				glm::vec3 const& p = Positions[Corners[k]];
+				Error += glm::length(p - Bounds.mSphere.getCenter()) <= Bounds.mSphere.getRadius() * 1.0001f ? 0 : 1;
+				Error += glm::all(glm::lessThanEqual(Bounds.mBox.getMin(), p)) && glm::all(glm::lessThanEqual(p, Bounds.mBox.getMax())) ? 0 : 1;
+			}
+
+			bool Found = false;
+			for(std::size_t i = 0; i < TriangleCount && !Found; ++i)
+			{
+				if(Indices[3 * i] != Corners[0] || Indices[3 * i + 1] != Corners[1] || Indices[3 * i + 2] != Corners[2])
+					continue;
+				++Seen[i];
+				Found = true;
+			}
+			Error += Found ? 0 : 1;
+		}
+
+		// All the normals are +z, the cone is tight
+		Error += glm::length(Bounds.mConeAxis - glm::vec3(0, 0, 1)) < 1e-5f ? 0 : 1;
+		Error += Bounds.mConeCutoff < 1e-3f ? 0 : 1;
+	}
+	for(std::size_t i = 0; i < TriangleCount; ++i)
+		Error += Seen[i] == 1 ? 0 : 1;
+
+	// The result only depends on the input
+	glm::meshlet_setf Again;
+	glm::buildMeshlets(&Positions[0], Positions.size(), &Indices[0], TriangleCount, 32, 40, Again);
+	Error += Again.mVertices == Set.mVertices && Again.mTriangles == Set.mTriangles ? 0 : 1;
+
+	return Error;
+}
+
+static int test_cullMeshlets()
+{
+	int Error = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(16, Positions, Indices);
+
+	glm::meshlet_setf Set;
+	glm::buildMeshlets(&Positions[0], Positions.size(), &Indices[0], Indices.size() / 3, 32, 40, Set);
+	std::size_t const Count = Set.mBounds.size();
+	std::vector<glm::uint32_t> Visible(Count);
+
+	// Everything is in view from the front side
+	glm::frustum_t<float> const All = boxFrustum(glm::vec3(-1.0f), glm::vec3(17.0f));
+	Error += glm::cullMeshlets(&Set.mBounds[0], Count, All, glm::vec3(8, 8, 10), &Visible[0]) == Count ? 0 : 1;
+	for(std::size_t i = 0; i < Count; ++i)
+		Error += Visible[i] == i ? 0 : 1;
+
+	// Everything is back facing from below
+	Error += glm::cullMeshlets(&Set.mBounds[0], Count, All, glm::vec3(8, 8, -10), &Visible[0]) == 0 ? 0 : 1;
+
+	// Only the meshlets whose sphere touches the frustum are kept
+	glm::frustum_t<float> const Corner = boxFrustum(glm::vec3(-1.0f), glm::vec3(2.0f, 2.0f, 1.0f));
+	std::size_t const Kept = glm::cullMeshlets(&Set.mBounds[0], Count, Corner, glm::vec3(8, 8, 10), &Visible[0]);
+	Error += Kept >= 1 && Kept < Count ? 0 : 1;
+	for(std::size_t i = 0; i < Kept; ++i)
+	{
+		glm::sphere_t<float> const& Sphere = Set.mBounds[Visible[i]].mSphere;
+		glm::vec3 const Nearest = glm::clamp(Sphere.getCenter(), glm::vec3(-1.0f), glm::vec3(2.0f, 2.0f, 1.0f));
+		Error += glm::length(Nearest - Sphere.getCenter()) <= Sphere.getRadius() * 1.7320509f ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_buildMeshlets();
+	Error += test_cullMeshlets();
+
+	return Error;
+}
@@ -0,0 +1,189 @@
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_projection.hpp>
+#include <glmext/OcclusionBuffer.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static float nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return float(State >> 8) / float(1 << 23) - 1.0f;
+}
+
+// Camera at the origin looking down -z, on a screen that does not split in whole tiles
+static int const Width = 100;
+static int const Height = 70;
+
+static glm::mat4 projection()
+{
+	return glm::perspectiveZO(glm::radians(60.0f), float(Width) / float(Height), 1.0f, 100.0f);
+}
+
+// A square facing the camera at depth -10, as two triangles
+static void buildOccluders(glm::occlusion_bufferf& Buffer)
+{
+	glm::vec3 const Positions[] = {glm::vec3(-2, -2, -10), glm::vec3(2, -2, -10), glm::vec3(2, 2, -10), glm::vec3(-2, 2, -10)};
+	glm::uint32_t const Indices[] = {0, 1, 2, 0, 2, 3};
+	Buffer.resize(Width, Height);
+	glm::binOccluders(Buffer, Positions, Indices, 2, projection());
+}
+
+// Each texel above level 0 is the farthest of the 2x2 texels below
+static int checkPyramid(glm::occlusion_bufferf const& Buffer)
+{
+	int Error = 0;
+
+	for(int l = 1; l < Buffer.getLevelCount(); ++l)
+	for(int y = 0; y < Buffer.getLevelHeight(l); ++y)
+	for(int x = 0; x < Buffer.getLevelWidth(l); ++x)
+	{
+		float Farthest = 0.0f;
+		for(int j = 2 * y; j <= std::min(2 * y + 1, Buffer.getLevelHeight(l - 1) - 1); ++j)
+		for(int i = 2 * x; i <= std::min(2 * x + 1, Buffer.getLevelWidth(l - 1) - 1); ++i)
+			Farthest = std::max(Farthest, Buffer.getDepth(l - 1, i, j));
+		Error += Buffer.getDepth(l, x, y) == Farthest ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_rasterize()
+{
+	int Error = 0;
+
+	glm::occlusion_bufferf Buffer;
+	buildOccluders(Buffer);
+	Error += Buffer.getTileCount() == 4 * 3 && Buffer.mTriangles.size() == 2 ? 0 : 1;
+	Error += Buffer.getLevelCount() == 8 && Buffer.getLevelWidth(7) == 1 && Buffer.getLevelHeight(7) == 1 ? 0 : 1;
+	glm::rasterizeOccluders(Buffer);
+
+	// Pixels whose center is clearly inside the projected square have its depth, the others are cleared
+	glm::vec4 const Viewport(0.0f, 0.0f, float(Width), float(Height));
+	glm::vec3 const Lo = glm::projectZO(glm::vec3(-2, -2, -10), glm::mat4(1.0f), projection(), Viewport);
+	glm::vec3 const Hi = glm::projectZO(glm::vec3(2, 2, -10), glm::mat4(1.0f), projection(), Viewport);
+	for(int y = 0; y < Height; ++y)
+	for(int x = 0; x < Width; ++x)
+	{
+		glm::vec2 const Center(float(x) + 0.5f, float(y) + 0.5f);
+		bool const Inside = Center.x > Lo.x + 0.01f && Center.x < Hi.x - 0.01f && Center.y > Lo.y + 0.01f && Center.y < Hi.y - 0.01f;
+		bool const Outside = Center.x < Lo.x - 0.01f || Center.x > Hi.x + 0.01f || Center.y < Lo.y - 0.01f || Center.y > Hi.y + 0.01f;
+		if(Inside)
+			Error += std::abs(Buffer.getDepth(0, x, y) - Lo.z) < 1e-5f ? 0 : 1;
+		else if(Outside)
+			Error += Buffer.getDepth(0, x, y) == 1.0f ? 0 : 1;
+	}
+	Error += checkPyramid(Buffer);
+
+	// Tiles in any order, then the levels above them, give the same pyramid
+	glm::occlusion_bufferf Tiled;
+	buildOccluders(Tiled);
+	for(int Tile = Tiled.getTileCount(); Tile-- > 0;)
+		glm::rasterizeOcclusionTile(Tiled, Tile);
+	glm::finishOcclusionBuffer(Tiled);
+	Error += Tiled.mLevels == Buffer.mLevels ? 0 : 1;
+
+	// A triangle behind the camera is dropped; one through the near plane is clipped
+	glm::vec3 const Positions[] = {glm::vec3(-1, -1, 5), glm::vec3(1, -1, 5), glm::vec3(0, 1, 5), glm::vec3(-1, -1, -5), glm::vec3(1, -1, -5), glm::vec3(0, 1, 5)};
+	glm::uint32_t const Indices[] = {0, 1, 2, 3, 4, 5};
+	glm::occlusion_bufferf Clipped;
+	Clipped.resize(Width, Height);
+	glm::binOccluders(Clipped, Positions, Indices, 1, projection());
+	Error += Clipped.mTriangles.empty() ? 0 : 1;
+	glm::binOccluders(Clipped, Positions, Indices + 3, 1, projection());
+	Error += Clipped.mTriangles.size() == 2 ? 0 : 1;
+	for(std::size_t t = 0; t < Clipped.mTriangles.size(); ++t)
+		for(int k = 0; k < 3; ++k)
+			Error += Clipped.mTriangles[t].mVertices[k].z >= -1e-6f && Clipped.mTriangles[t].mVertices[k].z <= 1.0f ? 0 : 1;
+	Clipped.clearOccluders();
+	Error += Clipped.mTriangles.empty() ? 0 : 1;
+
+	return Error;
+}
+
+static int test_isOccluded()
+{
+	int Error = 0;
+
+	glm::occlusion_bufferf Buffer;
+	buildOccluders(Buffer);
+	glm::rasterizeOccluders(Buffer);
+	glm::mat4 const Projection = projection();
+
+	Error += glm::isOccluded(Buffer, glm::aaboxf(glm::vec3(-0.5f, -0.5f, -21.0f), glm::vec3(0.5f, 0.5f, -20.0f)), Projection) ? 0 : 1;
+	Error += !glm::isOccluded(Buffer, glm::aaboxf(glm::vec3(-0.5f, -0.5f, -6.0f), glm::vec3(0.5f, 0.5f, -5.0f)), Projection) ? 0 : 1;
+	Error += !glm::isOccluded(Buffer, glm::aaboxf(glm::vec3(5.0f, -0.5f, -21.0f), glm::vec3(6.0f, 0.5f, -20.0f)), Projection) ? 0 : 1;
+	Error += !glm::isOccluded(Buffer, glm::aaboxf(glm::vec3(-0.5f, -0.5f, -21.0f), glm::vec3(0.5f, 0.5f, 1.0f)), Projection) ? 0 : 1;
+	Error += glm::isOccluded(Buffer, glm::aaboxf(glm::vec3(100.0f, -0.5f, -21.0f), glm::vec3(101.0f, 0.5f, -20.0f)), Projection) ? 0 : 1;
+
+	// Conservative: a hidden box is behind every pixel it covers
+	glm::vec4 const Viewport(0.0f, 0.0f, float(Width), float(Height));
+	glm::uint32_t State = 9u;
+	int Hidden = 0;
+	for(int Test = 0; Test < 200; ++Test)
+	{
+		glm::vec3 const Center(nextRandom(State) * 4.0f, nextRandom(State) * 3.0f, -16.0f + nextRandom(State) * 8.0f);
+		glm::vec3 const Half(0.1f + 0.6f * std::abs(nextRandom(State)));
+		glm::aaboxf const Box(Center - Half, Center + Half);
+		if(!glm::isOccluded(Buffer, Box, Projection))
+			continue;
+		++Hidden;
+
+		glm::vec3 Corners[8];
+		glm::getCorners(Box, Corners);
+		glm::vec3 Lo(1e30f), Hi(-1e30f);
+		for(int k = 0; k < 8; ++k)
+		{
+			glm::vec3 const Window = glm::projectZO(Corners[k], glm::mat4(1.0f), Projection, Viewport);
+			Lo = glm::min(Lo, Window);
+			Hi = glm::max(Hi, Window);
+		}
+		for(int y = std::max(int(Lo.y), 0); y <= std::min(int(Hi.y), Height - 1); ++y)
+			for(int x = std::max(int(Lo.x), 0); x <= std::min(int(Hi.x), Width - 1); ++x)
+				Error += Buffer.getDepth(0, x, y) < Lo.z ? 0 : 1;
+	}
+	Error += Hidden > 10 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_cullOccludees()
+{
+	int Error = 0;
+
+	glm::occlusion_bufferf Buffer;
+	buildOccluders(Buffer);
+	glm::rasterizeOccluders(Buffer);
+	glm::mat4 const Projection = projection();
+	glm::frustumf const Frustum(Projection);
+
+	// Hidden, in front, beside the occluder, behind the camera, hidden
+	glm::aaboxf const Boxes[] = {
+		glm::aaboxf(glm::vec3(-0.5f, -0.5f, -21.0f), glm::vec3(0.5f, 0.5f, -20.0f)),
+		glm::aaboxf(glm::vec3(-0.5f, -0.5f, -6.0f), glm::vec3(0.5f, 0.5f, -5.0f)),
+		glm::aaboxf(glm::vec3(5.0f, -0.5f, -21.0f), glm::vec3(6.0f, 0.5f, -20.0f)),
+		glm::aaboxf(glm::vec3(-0.5f, -0.5f, 5.0f), glm::vec3(0.5f, 0.5f, 6.0f)),
+		glm::aaboxf(glm::vec3(1.0f, 1.0f, -30.0f), glm::vec3(2.0f, 2.0f, -25.0f))};
+	glm::uint32_t Visible[5];
+	Error += glm::cullOccludees(Buffer, Frustum, Projection, Boxes, 0, 5, Visible) == 2 ? 0 : 1;
+	Error += Visible[0] == 1 && Visible[1] == 2 ? 0 : 1;
+
+	// A range writes from the start of its output
+	Error += glm::cullOccludees(Buffer, Frustum, Projection, Boxes, 2, 3, Visible) == 1 ? 0 : 1;
+	Error += Visible[0] == 2 ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_rasterize();
+	Error += test_isOccluded();
+	Error += test_cullOccludees();
+
+	return Error;
+}
@@ -0,0 +1,144 @@
+#include <glm/glm.hpp>
+#include <glmext/Particles.h>
+#include <cmath>
+#include <vector>
+
+// Particles on a spiral, with lifetimes from 0.5 to 3.5
+static glm::particle_systemd spiral(std::size_t Count)
+{
+	glm::particle_systemd Particles;
+	Particles.reserve(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		double const a = double(i) * 0.7;
+		glm::dvec3 const Position(std::cos(a), double(i) * 0.1, std::sin(a));
+		glm::dvec3 const Velocity(-std::sin(a), 1.0, std::cos(a));
+		Particles.emit(Position, Velocity, glm::dvec4(double(i), 0.0, 0.0, 1.0), 0.5 + double(i % 7) * 0.5);
+	}
+	return Particles;
+}
+
+static int test_update()
+{
+	int Error = 0;
+
+	glm::particle_systemd Particles = spiral(37);
+	glm::particle_systemd const Before(Particles);
+
+	glm::particle_forcesd Forces;
+	Forces.mGravity = glm::dvec3(0.0, -9.8, 0.0);
+	Forces.mDrag = 0.3;
+	Forces.mCurlStrength = 2.0;
+	Forces.mCurlFrequency = 0.5;
+	Forces.mCurlSpeed = 0.25;
+	Forces.mTime = 1.5;
+
+	// An unaligned range across blocks; the particles outside are untouched
+	double const dt = 0.02;
+	std::size_t const First = 5, Count = 20;
+	glm::updateParticles(Particles, First, Count, Forces, dt);
+	for(std::size_t i = 0; i < Particles.size(); ++i)
+	{
+		if(i < First || i >= First + Count)
+		{
+			Error += Particles.getPosition(i) == Before.getPosition(i) && Particles.getVelocity(i) == Before.getVelocity(i) ? 0 : 1;
+			Error += Particles.mAges[i] == 0.0 ? 0 : 1;
+			continue;
+		}
+
+		glm::dvec3 const p = Before.getPosition(i);
+		glm::dvec3 const Acceleration = Forces.mGravity + glm::curlNoise(p * Forces.mCurlFrequency, Forces.mTime * Forces.mCurlSpeed) * Forces.mCurlStrength;
+		glm::dvec3 const v = (Before.getVelocity(i) + Acceleration * dt) * std::exp(-Forces.mDrag * dt);
+		Error += glm::length(Particles.getVelocity(i) - v) < 1e-12 ? 0 : 1;
+		Error += glm::length(Particles.getPosition(i) - (p + v * dt)) < 1e-12 ? 0 : 1;
+		Error += Particles.mAges[i] == dt ? 0 : 1;
+	}
+
+	// Drag alone decays the velocity exponentially
+	glm::particle_systemd Slowing = spiral(3);
+	glm::particle_forcesd Drag;
+	Drag.mDrag = 2.0;
+	for(int Step = 0; Step < 50; ++Step)
+		glm::updateParticles(Slowing, 0, Slowing.size(), Drag, 0.01);
+	Error += glm::length(Slowing.getVelocity(1) - glm::dvec3(-std::sin(0.7), 1.0, std::cos(0.7)) * std::exp(-1.0)) < 1e-12 ? 0 : 1;
+
+	return Error;
+}
+
+// The curl of a potential has no divergence; with the same central
+// differences as curlNoise it vanishes up to rounding
+static int test_curlNoise()
+{
+	int Error = 0;
+
+	double const h = 1e-2;
+	double Magnitude = 0.0;
+	for(int i = 0; i < 20; ++i)
+	{
+		glm::dvec3 const p(0.37 * i, 1.3 - 0.11 * i, 0.05 * i * i);
+		double Divergence = 0.0;
+		for(int Axis = 0; Axis < 3; ++Axis)
+		{
+			glm::dvec3 Step(0.0);
+			Step[Axis] = h;
+			Divergence += (glm::curlNoise(p + Step, 0.4)[Axis] - glm::curlNoise(p - Step, 0.4)[Axis]) / (2.0 * h);
+		}
+		Magnitude = glm::max(Magnitude, glm::length(glm::curlNoise(p, 0.4)));
+		Error += std::abs(Divergence) < 1e-8 ? 0 : 1;
+	}
+	Error += Magnitude > 0.5 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_compact()
+{
+	int Error = 0;
+
+	glm::particle_systemd Particles = spiral(50);
+	for(std::size_t i = 0; i < Particles.size(); ++i)
+		Particles.mAges[i] = 1.6;
+	std::size_t Expected = 0;
+	for(std::size_t i = 0; i < Particles.size(); ++i)
+		Expected += Particles.mAges[i] < Particles.mLifetimes[i] ? 1 : 0;
+	Error += glm::countLiveParticles(Particles, 0, Particles.size()) == Expected ? 0 : 1;
+
+	// Chunked compaction at the prefix sums of the chunk counts
+	std::size_t const ChunkSize = 16;
+	std::vector<std::size_t> Offsets(1, 0);
+	for(std::size_t First = 0; First < Particles.size(); First += ChunkSize)
+		Offsets.push_back(Offsets.back() + glm::countLiveParticles(Particles, First, ChunkSize));
+	glm::particle_systemd Chunked;
+	Chunked.resize(Offsets.back());
+	for(std::size_t c = 0; c + 1 < Offsets.size(); ++c)
+		Error += glm::compactParticleRange(Particles, c * ChunkSize, ChunkSize, Chunked, Offsets[c]) == Offsets[c + 1] - Offsets[c] ? 0 : 1;
+
+	glm::particle_systemd const Source(Particles);
+	Error += glm::compactParticles(Particles) == Expected ? 0 : 1;
+	Error += Particles.size() == Expected && Chunked.size() == Expected ? 0 : 1;
+
+	// Live particles keep their order and state
+	std::size_t Next = 0;
+	for(std::size_t i = 0; i < Source.size(); ++i)
+	{
+		if(!(Source.mAges[i] < Source.mLifetimes[i]))
+			continue;
+		Error += Particles.mColors[Next] == Source.mColors[i] && Particles.getPosition(Next) == Source.getPosition(i) ? 0 : 1;
+		Error += Chunked.mColors[Next] == Source.mColors[i] && Chunked.getVelocity(Next) == Source.getVelocity(i) ? 0 : 1;
+		Error += Chunked.mLifetimes[Next] == Source.mLifetimes[i] ? 0 : 1;
+		++Next;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_update();
+	Error += test_curlNoise();
+	Error += test_compact();
+
+	return Error;
+}
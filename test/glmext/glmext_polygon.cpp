@@ -0,0 +1,263 @@
+#include <glm/glm.hpp>
+#include <glmext/Polygon.h>
+#include <cmath>
+#include <vector>
+
+static glm::polygond square(double MinX, double MinY, double Size)
+{
+	glm::dvec2 const Points[] = {glm::dvec2(MinX, MinY), glm::dvec2(MinX + Size, MinY), glm::dvec2(MinX + Size, MinY + Size), glm::dvec2(MinX, MinY + Size)};
+	glm::polygond Polygon;
+	Polygon.clear();
+	Polygon.addRing(Points, 4);
+	return Polygon;
+}
+
+// A star with Count branches, or a regular polygon when Inner equals Outer
+static void addStar(glm::polygond& Polygon, glm::dvec2 const& Center, double Inner, double Outer, int Count, bool Clockwise)
+{
+	std::vector<glm::dvec2> Points;
+	for(int i = 0; i < 2 * Count; ++i)
+	{
+		double const Angle = 3.14159265358979 * double(Clockwise ? -i : i) / double(Count) + 0.1;
+		double const Radius = i & 1 ? Inner : Outer;
+		Points.push_back(Center + glm::dvec2(std::cos(Angle), std::sin(Angle)) * Radius);
+	}
+	Polygon.addRing(&Points[0], Points.size());
+}
+
+// The area by the even-odd rule, from the nesting of the rings
+static double area(glm::polygond const& Polygon)
+{
+	glm::polygon_indexd Index;
+	Index.build(Polygon);
+	std::vector<glm::uint32_t> Depths;
+	std::vector<std::size_t> Parents;
+	Index.computeNesting(Depths, Parents);
+	double Result = 0.0;
+	for(std::size_t r = 0; r < Polygon.getRingCount(); ++r)
+		Result += std::abs(glm::ringArea2(Polygon, r)) * (Depths[r] & 1 ? -0.5 : 0.5);
+	return Result;
+}
+
+// Triangles counter clockwise, covering the polygon once: the areas add up,
+// and samples inside the polygon are in exactly one triangle, outside in none
+static int checkTriangulation(glm::polygond const& Polygon, std::vector<glm::uint32_t> const& Indices)
+{
+	int Error = 0;
+
+	double Sum = 0.0;
+	for(std::size_t t = 0; t < Indices.size(); t += 3)
+	{
+		double const Area2 = glm::orient2d(Polygon.mPoints[Indices[t]], Polygon.mPoints[Indices[t + 1]], Polygon.mPoints[Indices[t + 2]]);
+		Error += Area2 > 0.0 ? 0 : 1;
+		Sum += Area2 * 0.5;
+	}
+	Error += std::abs(Sum - area(Polygon)) < 1e-9 ? 0 : 1;
+
+	glm::polygon_indexd Index;
+	Index.build(Polygon);
+	glm::dvec2 const Lo = Polygon.mBounds.getMin(), Hi = Polygon.mBounds.getMax();
+	for(int j = 0; j < 40; ++j)
+	for(int i = 0; i < 40; ++i)
+	{
+		glm::dvec2 const p = Lo + (Hi - Lo) * glm::dvec2(double(i) + 0.4321, double(j) + 0.5678) / 40.0;
+		int const Location = Index.locate(p);
+		if(Location < 0)
+			continue;
+		int Covered = 0;
+		for(std::size_t t = 0; t < Indices.size(); t += 3)
+		{
+			glm::dvec2 const& a = Polygon.mPoints[Indices[t]];
+			glm::dvec2 const& b = Polygon.mPoints[Indices[t + 1]];
+			glm::dvec2 const& c = Polygon.mPoints[Indices[t + 2]];
+			Covered += glm::orient2d(a, b, p) > 0.0 && glm::orient2d(b, c, p) > 0.0 && glm::orient2d(c, a, p) > 0.0 ? 1 : 0;
+		}
+		Error += Covered == Location ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_locate()
+{
+	int Error = 0;
+
+	// A square with a square hole, and an island in the hole
+	glm::polygond Polygon = square(0.0, 0.0, 10.0);
+	glm::polygond const Hole = square(2.0, 2.0, 6.0), Island = square(4.0, 4.0, 2.0);
+	Polygon.addRing(&Hole.mPoints[0], 4);
+	Polygon.addRing(&Island.mPoints[0], 4);
+
+	glm::polygon_indexd Index;
+	Index.build(Polygon);
+	Error += Index.locate(glm::dvec2(1.0, 1.0)) == 1 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(3.0, 5.0)) == 0 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(5.0, 5.0)) == 1 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(11.0, 5.0)) == 0 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(10.0, 5.0)) == -1 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(2.0, 2.0)) == -1 ? 0 : 1;
+	Error += Index.locate(glm::dvec2(5.0, 6.0)) == -1 ? 0 : 1;
+
+	std::vector<glm::uint32_t> Depths;
+	std::vector<std::size_t> Parents;
+	Index.computeNesting(Depths, Parents);
+	Error += Depths[0] == 0 && Depths[1] == 1 && Depths[2] == 2 ? 0 : 1;
+	Error += Parents[0] == 3 && Parents[1] == 0 && Parents[2] == 1 ? 0 : 1;
+	Error += area(Polygon) == 100.0 - 36.0 + 4.0 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_triangulate()
+{
+	int Error = 0;
+	glm::ear_clipperd Clipper;
+
+	// Concave rings in either orientation give n - 2 triangles
+	for(int Clockwise = 0; Clockwise < 2; ++Clockwise)
+	{
+		glm::polygond Star;
+		Star.clear();
+		addStar(Star, glm::dvec2(0.5, -0.25), 0.3, 1.0, 9, Clockwise != 0);
+		std::vector<glm::uint32_t> Indices;
+		Error += Clipper.triangulate(Star, Indices) == 16 ? 0 : 1;
+		Error += checkTriangulation(Star, Indices);
+	}
+
+	// A ring long enough for the z-order hash
+	glm::polygond Large;
+	Large.clear();
+	addStar(Large, glm::dvec2(0.0), 0.8, 1.0, 100, false);
+	std::vector<glm::uint32_t> Indices;
+	Error += Clipper.triangulate(Large, Indices) == 198 ? 0 : 1;
+	Error += checkTriangulation(Large, Indices);
+
+	// Holes and islands, the hole given counter clockwise like the outer ring
+	glm::polygond Nested = square(0.0, 0.0, 10.0);
+	addStar(Nested, glm::dvec2(5.0), 1.5, 3.5, 5, false);
+	addStar(Nested, glm::dvec2(5.0), 0.5, 0.5, 6, true);
+	glm::polygond const Corner = square(8.5, 8.5, 1.0);
+	Nested.addRing(&Corner.mPoints[0], 4);
+	Indices.clear();
+	Clipper.triangulate(Nested, Indices);
+	Error += checkTriangulation(Nested, Indices);
+
+	// The batch matches
+	glm::polygond const Polygons[] = {Large, Nested};
+	std::vector<glm::uint32_t> Batch[2];
+	glm::triangulatePolygons(Polygons, 0, 2, Batch);
+	std::vector<glm::uint32_t> Single;
+	Clipper.triangulate(Large, Single);
+	Error += Batch[0] == Single && Batch[1] == Indices ? 0 : 1;
+
+	return Error;
+}
+
+// The result of a boolean operation against its definition, by sampling,
+// and its area against inclusion-exclusion
+static int checkBoolean(glm::polygond const& a, glm::polygond const& b)
+{
+	int Error = 0;
+
+	glm::polygon_clipperd Clipper;
+	glm::PolygonBoolean const Operations[] = {glm::POLYGON_UNION, glm::POLYGON_INTERSECTION, glm::POLYGON_DIFFERENCE};
+	glm::polygond Results[3];
+	for(int o = 0; o < 3; ++o)
+	{
+		Clipper.compute(a, b, Operations[o], Results[o]);
+
+		// Outer rings counter clockwise and holes clockwise: the signed ring areas add up
+		double Signed = 0.0;
+		for(std::size_t r = 0; r < Results[o].getRingCount(); ++r)
+			Signed += glm::ringArea2(Results[o], r) * 0.5;
+		Error += std::abs(Signed - area(Results[o])) < 1e-9 ? 0 : 1;
+	}
+	double const Union = area(Results[0]), Intersection = area(Results[1]), Difference = area(Results[2]);
+	Error += std::abs(Union + Intersection - area(a) - area(b)) < 1e-9 ? 0 : 1;
+	Error += std::abs(Difference + Intersection - area(a)) < 1e-9 ? 0 : 1;
+
+	glm::polygon_indexd IndexA, IndexB, IndexResults[3];
+	IndexA.build(a);
+	IndexB.build(b);
+	for(int o = 0; o < 3; ++o)
+		IndexResults[o].build(Results[o]);
+	glm::dvec2 const Lo = glm::min(a.mBounds.getMin(), b.mBounds.getMin()) - 0.1;
+	glm::dvec2 const Hi = glm::max(a.mBounds.getMax(), b.mBounds.getMax()) + 0.1;
+	for(int j = 0; j < 50; ++j)
+	for(int i = 0; i < 50; ++i)
+	{
+		glm::dvec2 const p = Lo + (Hi - Lo) * glm::dvec2(double(i) + 0.3791, double(j) + 0.6173) / 50.0;
+		int const InA = IndexA.locate(p), InB = IndexB.locate(p);
+		if(InA < 0 || InB < 0)
+			continue;
+		Error += IndexResults[0].locate(p) == (InA | InB) ? 0 : 1;
+		Error += IndexResults[1].locate(p) == (InA & InB) ? 0 : 1;
+		Error += IndexResults[2].locate(p) == (InA & (1 - InB)) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_boolean()
+{
+	int Error = 0;
+
+	// Overlapping squares, exact areas
+	glm::polygond const a = square(0.0, 0.0, 2.0), b = square(1.0, 1.0, 2.0);
+	glm::polygon_clipperd Clipper;
+	glm::polygond Result;
+	Clipper.compute(a, b, glm::POLYGON_UNION, Result);
+	Error += Result.getRingCount() == 1 && area(Result) == 7.0 ? 0 : 1;
+	Clipper.compute(a, b, glm::POLYGON_INTERSECTION, Result);
+	Error += Result.getRingCount() == 1 && area(Result) == 1.0 ? 0 : 1;
+	Clipper.compute(a, b, glm::POLYGON_DIFFERENCE, Result);
+	Error += Result.getRingCount() == 1 && area(Result) == 3.0 ? 0 : 1;
+	Error += checkBoolean(a, b);
+
+	// Disjoint squares
+	glm::polygond const Far = square(5.0, 0.0, 1.0);
+	Clipper.compute(a, Far, glm::POLYGON_UNION, Result);
+	Error += Result.getRingCount() == 2 && area(Result) == 5.0 ? 0 : 1;
+	Clipper.compute(a, Far, glm::POLYGON_INTERSECTION, Result);
+	Error += Result.getRingCount() == 0 ? 0 : 1;
+	Clipper.compute(a, Far, glm::POLYGON_DIFFERENCE, Result);
+	Error += Result.getRingCount() == 1 && area(Result) == 4.0 ? 0 : 1;
+
+	// A square inside the other makes a hole
+	glm::polygond const Inner = square(0.5, 0.5, 1.0);
+	Clipper.compute(a, Inner, glm::POLYGON_DIFFERENCE, Result);
+	Error += Result.getRingCount() == 2 && area(Result) == 3.0 ? 0 : 1;
+
+	// Stars crossing each other, one with a hole, in either orientation
+	glm::polygond Star;
+	Star.clear();
+	addStar(Star, glm::dvec2(0.0), 0.4, 1.0, 7, false);
+	addStar(Star, glm::dvec2(0.05, 0.0), 0.15, 0.15, 8, false);
+	glm::polygond Other;
+	Other.clear();
+	addStar(Other, glm::dvec2(0.45, 0.2), 0.5, 0.9, 5, true);
+	Error += checkBoolean(Star, Other);
+	Error += checkBoolean(Other, Star);
+	Error += checkBoolean(Star, square(-0.3, -0.2, 0.6));
+
+	// The batch matches
+	glm::polygond const As[] = {a, Star}, Bs[] = {b, Other};
+	glm::polygond Results[2];
+	glm::clipPolygons(As, Bs, 0, 2, glm::POLYGON_INTERSECTION, Results);
+	Clipper.compute(Star, Other, glm::POLYGON_INTERSECTION, Result);
+	Error += Results[0].getRingCount() == 1 && area(Results[0]) == 1.0 ? 0 : 1;
+	Error += Results[1].mPoints == Result.mPoints && Results[1].mRingOffsets == Result.mRingOffsets ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_locate();
+	Error += test_triangulate();
+	Error += test_boolean();
+
+	return Error;
+}
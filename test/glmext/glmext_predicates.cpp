@@ -0,0 +1,214 @@
+#include <glm/glm.hpp>
+#include <glmext/Predicates.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Uniform integers in [-Range, Range] from a fixed linear congruential sequence
+static glm::int64 nextInteger(glm::uint32_t& State, glm::int64 Range)
+{
+	State = State * 1664525u + 1013904223u;
+	return static_cast<glm::int64>((State >> 8) % static_cast<glm::uint32_t>(2 * Range + 1)) - Range;
+}
+
+static int sign(glm::int64 Value)
+{
+	return Value > 0 ? 1 : (Value < 0 ? -1 : 0);
+}
+
+// Reference determinants over integer coordinates, exact while they fit in 64 bits
+static int orient2dSign(glm::i64vec2 const& a, glm::i64vec2 const& b, glm::i64vec2 const& c)
+{
+	return sign((a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x));
+}
+
+static int orient3dSign(glm::i64vec3 const& a, glm::i64vec3 const& b, glm::i64vec3 const& c, glm::i64vec3 const& d)
+{
+	glm::i64vec3 const ad = a - d, bd = b - d, cd = c - d;
+	return sign(ad.z * (bd.x * cd.y - cd.x * bd.y) + bd.z * (cd.x * ad.y - ad.x * cd.y) + cd.z * (ad.x * bd.y - bd.x * ad.y));
+}
+
+static int incircleSign(glm::i64vec2 const& a, glm::i64vec2 const& b, glm::i64vec2 const& c, glm::i64vec2 const& d)
+{
+	glm::i64vec2 const ad = a - d, bd = b - d, cd = c - d;
+	glm::int64 const aLift = ad.x * ad.x + ad.y * ad.y;
+	glm::int64 const bLift = bd.x * bd.x + bd.y * bd.y;
+	glm::int64 const cLift = cd.x * cd.x + cd.y * cd.y;
+	return sign(aLift * (bd.x * cd.y - cd.x * bd.y) + bLift * (cd.x * ad.y - ad.x * cd.y) + cLift * (ad.x * bd.y - bd.x * ad.y));
+}
+
+template<typename T>
+static int test_arithmetic()
+{
+	typedef glm::predicate_arithmetic_t<T> arith;
+	int Error = 0;
+
+	T const Eps = arith::epsilon();
+	T x, y;
+	arith::twoSum(T(1), Eps, x, y);
+	Error += x == T(1) && y == Eps ? 0 : 1;
+	arith::twoDiff(T(1), Eps, x, y);
+	Error += x == T(1) - Eps && y == T(0) ? 0 : 1;
+	T const a = T(1) + T(2) * Eps * T(3), b = T(1) - T(2) * Eps * T(5);
+	arith::twoProduct(a, b, x, y);
+	Error += x == a * b && y == std::fma(a, b, -x) ? 0 : 1;
+
+	// (1 + eps) + (1 + eps) and (1 + eps)(1 - eps), exactly
+	T const e[2] = {Eps, T(1)}, f[2] = {-Eps, T(1)};
+	T h[8];
+	Error += arith::sum(e, 2, e, 2, h) == 2 && h[0] == T(2) * Eps && h[1] == T(2) ? 0 : 1;
+	Error += arith::product(e, 2, f, 2, h) == 2 && h[0] == -Eps * Eps && h[1] == T(1) ? 0 : 1;
+	Error += arith::sum(e, 2, f, 2, h) == 1 && h[0] == T(2) ? 0 : 1;
+
+	return Error;
+}
+
+// Nearly degenerate integer configurations, big enough that the floating
+// point determinants round, against the 64 bit integer determinants
+template<typename T>
+static int test_integers(int Bits)
+{
+	typedef glm::vec<2, T> vec2;
+	typedef glm::vec<3, T> vec3;
+	int Error = 0;
+	glm::uint32_t State = 1u;
+
+	// Points on a line through a, off by at most one unit
+	glm::int64 const Half = glm::int64(1) << (Bits / 2);
+	for(int Test = 0; Test < 2000; ++Test)
+	{
+		glm::i64vec2 const a(nextInteger(State, Half * Half), nextInteger(State, Half * Half));
+		glm::i64vec2 const d(nextInteger(State, Half), nextInteger(State, Half));
+		glm::i64vec2 const b = a + d * nextInteger(State, Half);
+		glm::i64vec2 const c = a + d * nextInteger(State, Half) + glm::i64vec2(0, nextInteger(State, 1));
+		int const Expected = orient2dSign(a, b, c);
+		Error += glm::predicateSign(glm::orient2d(vec2(a), vec2(b), vec2(c))) == Expected ? 0 : 1;
+		Error += glm::predicateSign(glm::orient2dExact(vec2(a), vec2(b), vec2(c))) == Expected ? 0 : 1;
+		Error += glm::predicateSign(glm::orient2d(vec2(b), vec2(a), vec2(c))) == -Expected ? 0 : 1;
+	}
+
+	// Points on a plane through a, off by at most one unit
+	glm::int64 const Third = glm::int64(1) << (Bits / 3);
+	for(int Test = 0; Test < 2000; ++Test)
+	{
+		glm::i64vec3 const a(nextInteger(State, Third * Third), nextInteger(State, Third * Third), nextInteger(State, Third * Third));
+		glm::i64vec3 const u(nextInteger(State, Third), nextInteger(State, Third), nextInteger(State, Third));
+		glm::i64vec3 const v(nextInteger(State, Third), nextInteger(State, Third), nextInteger(State, Third));
+		glm::i64vec3 const b = a + u * nextInteger(State, Third);
+		glm::i64vec3 const c = a + v * nextInteger(State, Third);
+		glm::i64vec3 const d = a + u * nextInteger(State, Third) + v * nextInteger(State, Third) + glm::i64vec3(0, 0, nextInteger(State, 1));
+		int const Expected = orient3dSign(a, b, c, d);
+		Error += glm::predicateSign(glm::orient3d(vec3(a), vec3(b), vec3(c), vec3(d))) == Expected ? 0 : 1;
+		Error += glm::predicateSign(glm::orient3dExact(vec3(a), vec3(b), vec3(c), vec3(d))) == Expected ? 0 : 1;
+	}
+
+	// Integer points on circles of radius 65 s, off by at most one unit
+	glm::i64vec2 const Circle[] = {glm::i64vec2(65, 0), glm::i64vec2(63, 16), glm::i64vec2(60, 25), glm::i64vec2(56, 33), glm::i64vec2(52, 39), glm::i64vec2(39, 52), glm::i64vec2(33, 56), glm::i64vec2(25, 60), glm::i64vec2(16, 63), glm::i64vec2(0, 65)};
+	glm::int64 const Scale = glm::int64(1) << (Bits / 4);
+	for(int Test = 0; Test < 2000; ++Test)
+	{
+		glm::i64vec2 const Center(nextInteger(State, Scale * 64), nextInteger(State, Scale * 64));
+		glm::int64 const s = 1 + glm::abs(nextInteger(State, Scale));
+		glm::i64vec2 Points[4];
+		for(int k = 0; k < 4; ++k)
+		{
+			glm::i64vec2 const Unit = Circle[glm::abs(nextInteger(State, 9))];
+			Points[k] = Center + glm::i64vec2(nextInteger(State, 1) < 0 ? -Unit.x : Unit.x, nextInteger(State, 1) < 0 ? -Unit.y : Unit.y) * s;
+		}
+		Points[3].x += nextInteger(State, 1);
+		int const Expected = incircleSign(Points[0], Points[1], Points[2], Points[3]);
+		Error += glm::predicateSign(glm::incircle(vec2(Points[0]), vec2(Points[1]), vec2(Points[2]), vec2(Points[3]))) == Expected ? 0 : 1;
+		Error += glm::predicateSign(glm::incircleExact(vec2(Points[0]), vec2(Points[1]), vec2(Points[2]), vec2(Points[3]))) == Expected ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Shewchuk's grid of points one ulp apart near (0.5, 0.5), against the line
+// y = x through (12, 12) and (24, 24): the sign is that of y - x, exactly
+template<typename T>
+static int test_grid()
+{
+	typedef glm::vec<2, T> vec2;
+	typedef glm::vec<3, T> vec3;
+	int Error = 0;
+
+	T const Ulp = std::ldexp(T(1), -std::numeric_limits<T>::digits);
+	int const First = glm::predicateSign(glm::orient3d(vec3(12, 12, 0), vec3(24, 24, 0), vec3(12, 12, 1), vec3(T(0.5), T(0.5) + Ulp, T(0))));
+	Error += First != 0 ? 0 : 1;
+	for(int j = 0; j < 64; ++j)
+	for(int i = 0; i < 64; ++i)
+	{
+		T const x = T(0.5) + T(i) * Ulp, y = T(0.5) + T(j) * Ulp;
+		int const Expected = j > i ? 1 : (j < i ? -1 : 0);
+		Error += glm::predicateSign(glm::orient2d(vec2(12, 12), vec2(24, 24), vec2(x, y))) == Expected ? 0 : 1;
+		Error += glm::predicateSign(glm::orient3d(vec3(12, 12, 0), vec3(24, 24, 0), vec3(12, 12, 1), vec3(x, y, T(0)))) == First * Expected ? 0 : 1;
+	}
+
+	return Error;
+}
+
+template<typename T>
+static int test_conventions()
+{
+	typedef glm::vec<2, T> vec2;
+	typedef glm::vec<3, T> vec3;
+	int Error = 0;
+
+	Error += glm::orient2d(vec2(0, 0), vec2(1, 0), vec2(0, 1)) == T(1) ? 0 : 1;
+	Error += glm::orient3d(vec3(0, 0, 0), vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, -1)) > T(0) ? 0 : 1;
+	Error += glm::incircle(vec2(1, 0), vec2(0, 1), vec2(-1, 0), vec2(0, 0)) > T(0) ? 0 : 1;
+	Error += glm::incircle(vec2(1, 0), vec2(0, 1), vec2(-1, 0), vec2(0, -1)) == T(0) ? 0 : 1;
+	Error += glm::incircle(vec2(1, 0), vec2(-1, 0), vec2(0, 1), vec2(0, 0)) < T(0) ? 0 : 1;
+
+	return Error;
+}
+
+// The batches, over a count that is not a whole number of blocks, match the single predicates
+template<typename T>
+static int test_batch()
+{
+	typedef glm::vec<2, T> vec2;
+	typedef glm::vec<3, T> vec3;
+	int Error = 0;
+
+	T const Ulp = std::ldexp(T(1), -std::numeric_limits<T>::digits);
+	std::vector<vec2> Points2;
+	std::vector<vec3> Points3;
+	for(int i = 0; i < 37; ++i)
+	{
+		Points2.push_back(vec2(T(0.5) + T(i % 5) * Ulp, T(0.5) + T(i % 7) * Ulp + T(i / 20)));
+		Points3.push_back(vec3(Points2.back(), T(i % 3) * Ulp));
+	}
+	std::vector<int> Signs(Points2.size());
+
+	glm::orient2dBatch(vec2(12, 12), vec2(24, 24), &Points2[0], Points2.size(), &Signs[0]);
+	for(std::size_t i = 0; i < Points2.size(); ++i)
+		Error += Signs[i] == glm::predicateSign(glm::orient2d(vec2(12, 12), vec2(24, 24), Points2[i])) ? 0 : 1;
+	glm::orient3dBatch(vec3(0, 0, 0), vec3(1, 1, 0), vec3(0, 0, 1), &Points3[0], Points3.size(), &Signs[0]);
+	for(std::size_t i = 0; i < Points3.size(); ++i)
+		Error += Signs[i] == glm::predicateSign(glm::orient3d(vec3(0, 0, 0), vec3(1, 1, 0), vec3(0, 0, 1), Points3[i])) ? 0 : 1;
+	glm::incircleBatch(vec2(1, 0), vec2(0, 1), vec2(-1, 0), &Points2[0], Points2.size(), &Signs[0]);
+	for(std::size_t i = 0; i < Points2.size(); ++i)
+		Error += Signs[i] == glm::predicateSign(glm::incircle(vec2(1, 0), vec2(0, 1), vec2(-1, 0), Points2[i])) ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_arithmetic<float>();
+	Error += test_arithmetic<double>();
+	Error += test_integers<float>(12);
+	Error += test_integers<double>(28);
+	Error += test_grid<float>();
+	Error += test_grid<double>();
+	Error += test_conventions<float>();
+	Error += test_conventions<double>();
+	Error += test_batch<float>();
+	Error += test_batch<double>();
+
+	return Error;
+}
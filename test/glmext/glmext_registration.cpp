@@ -0,0 +1,172 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glmext/Registration.h>
+#include <cmath>
+#include <vector>
+
+// Uniform values in [-1, 1) from a fixed linear congruential sequence
+static double nextRandom(glm::uint32_t& State)
+{
+	State = State * 1664525u + 1013904223u;
+	return double(State >> 8) / double(1 << 23) - 1.0;
+}
+
+static bool nearMatrix(glm::dmat3 const& a, glm::dmat3 const& b, double Tolerance)
+{
+	for(int c = 0; c < 3; ++c)
+		if(glm::length(a[c] - b[c]) > Tolerance)
+			return false;
+	return true;
+}
+
+// Points on an ellipsoid with three different axes, with their normals: its
+// shape pins down all six degrees of freedom of a rigid transform
+static void ellipsoid(std::vector<glm::dvec3>& Points, std::vector<glm::dvec3>& Normals)
+{
+	glm::dvec3 const Axes(1.0, 0.7, 0.45);
+	for(int i = 1; i < 24; ++i)
+	for(int j = 0; j < 40; ++j)
+	{
+		double const Theta = 3.14159265358979 * double(i) / 24.0;
+		double const Phi = 2.0 * 3.14159265358979 * double(j) / 40.0;
+		glm::dvec3 const Unit(std::sin(Theta) * std::cos(Phi), std::sin(Theta) * std::sin(Phi), std::cos(Theta));
+		Points.push_back(Unit * Axes);
+		Normals.push_back(glm::normalize(Unit / Axes));
+	}
+}
+
+static int test_svd()
+{
+	int Error = 0;
+
+	glm::uint32_t State = 3u;
+	for(int Test = 0; Test < 20; ++Test)
+	{
+		glm::dmat3 a;
+		for(int c = 0; c < 3; ++c)
+			a[c] = glm::dvec3(nextRandom(State), nextRandom(State), nextRandom(State));
+		// Every fifth matrix is rank deficient
+		if(Test % 5 == 0)
+			a[2] = a[0] * 0.5 - a[1] * 2.0;
+
+		glm::dmat3 u, v;
+		glm::dvec3 s;
+		glm::svd3Jacobi(a, u, s, v);
+		Error += nearMatrix(u * glm::dmat3(s.x, 0, 0, 0, s.y, 0, 0, 0, s.z) * glm::transpose(v), a, 1e-12) ? 0 : 1;
+		Error += nearMatrix(glm::transpose(u) * u, glm::dmat3(1.0), 1e-12) && nearMatrix(glm::transpose(v) * v, glm::dmat3(1.0), 1e-12) ? 0 : 1;
+		Error += s.x >= s.y && s.y >= s.z && s.z >= 0.0 ? 0 : 1;
+		if(Test % 5 == 0)
+			Error += s.z < 1e-12 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_kabsch()
+{
+	int Error = 0;
+
+	glm::uint32_t State = 5u;
+	std::vector<glm::dvec3> Source, Target;
+	glm::dmat3 const Rotation = glm::mat3_cast(glm::angleAxis(1.2, glm::normalize(glm::dvec3(1.0, -2.0, 0.5))));
+	glm::dvec3 const Translation(0.3, -1.0, 2.5);
+	for(int i = 0; i < 30; ++i)
+	{
+		Source.push_back(glm::dvec3(nextRandom(State), nextRandom(State), nextRandom(State)));
+		Target.push_back(Rotation * Source.back() + Translation);
+	}
+
+	glm::dmat3 R;
+	glm::dvec3 t;
+	Error += glm::kabsch(&Source[0], &Target[0], static_cast<double const*>(NULL), Source.size(), R, t) ? 0 : 1;
+	Error += nearMatrix(R, Rotation, 1e-12) && glm::length(t - Translation) < 1e-12 ? 0 : 1;
+
+	// A zero weight outlier does not matter
+	std::vector<double> Weights(Source.size(), 1.0);
+	Target[7] += glm::dvec3(5.0, 0.0, 0.0);
+	Weights[7] = 0.0;
+	Error += glm::kabsch(&Source[0], &Target[0], &Weights[0], Source.size(), R, t) ? 0 : 1;
+	Error += nearMatrix(R, Rotation, 1e-12) && glm::length(t - Translation) < 1e-12 ? 0 : 1;
+
+	// A mirrored point set still gives a proper rotation
+	std::vector<glm::dvec3> Mirrored(Source);
+	for(std::size_t i = 0; i < Mirrored.size(); ++i)
+		Mirrored[i].x = -Mirrored[i].x;
+	Error += glm::kabsch(&Source[0], &Mirrored[0], static_cast<double const*>(NULL), Source.size(), R, t) ? 0 : 1;
+	Error += std::abs(glm::determinant(R) - 1.0) < 1e-12 ? 0 : 1;
+
+	std::vector<double> const Zero(Source.size(), 0.0);
+	Error += !glm::kabsch(&Source[0], &Target[0], &Zero[0], Source.size(), R, t) ? 0 : 1;
+	Error += R == glm::dmat3(1.0) && t == glm::dvec3(0.0) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_robustWeight()
+{
+	int Error = 0;
+
+	Error += glm::robustWeight(glm::ROBUST_NONE, 10.0, 1.0) == 1.0 ? 0 : 1;
+	Error += glm::robustWeight(glm::ROBUST_HUBER, 0.5, 1.0) == 1.0 ? 0 : 1;
+	Error += glm::robustWeight(glm::ROBUST_HUBER, 4.0, 1.0) == 0.25 ? 0 : 1;
+	Error += glm::robustWeight(glm::ROBUST_TUKEY, 0.5, 1.0) == 0.5625 ? 0 : 1;
+	Error += glm::robustWeight(glm::ROBUST_TUKEY, 1.5, 1.0) == 0.0 ? 0 : 1;
+
+	return Error;
+}
+
+// Recovers a known transform of a subset of the target points
+static int test_icp(bool PointToPlane, bool Outliers)
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> Target, Normals;
+	ellipsoid(Target, Normals);
+	glm::kd_tree_t<3, double> Tree;
+	Tree.build(&Target[0], Target.size());
+
+	// The source is the target moved by the inverse of the expected transform
+	glm::dmat3 const Rotation = glm::mat3_cast(glm::angleAxis(0.15, glm::normalize(glm::dvec3(0.3, 1.0, -0.4))));
+	glm::dvec3 const Translation(0.04, -0.03, 0.05);
+	std::vector<glm::dvec3> Source;
+	for(std::size_t i = 0; i < Target.size(); i += 3)
+		Source.push_back(glm::transpose(Rotation) * (Target[i] - Translation));
+	if(Outliers)
+		for(int i = 0; i < 10; ++i)
+			Source.push_back(glm::dvec3(2.0 + 0.1 * double(i), 0.5, 0.0));
+
+	glm::icp_paramsd Params;
+	Params.mMaxIterations = 100;
+	Params.mTolerance = 1e-12;
+	Params.mPointToPlane = PointToPlane;
+	if(Outliers)
+	{
+		Params.mKernel = glm::ROBUST_TUKEY;
+		Params.mKernelScale = 0.2;
+	}
+	glm::icp_resultd Result;
+	glm::alignICP(Tree, &Normals[0], &Source[0], Source.size(), Params, Result);
+
+	Error += Result.mIterations > 1 && Result.mIterations <= Params.mMaxIterations ? 0 : 1;
+	Error += Result.mCorrespondences == Source.size() ? 0 : 1;
+	Error += nearMatrix(Result.mRotation, Rotation, 1e-6) ? 0 : 1;
+	Error += glm::length(Result.mTranslation - Translation) < 1e-6 ? 0 : 1;
+	if(!Outliers)
+		Error += Result.mRmsError < 1e-6 ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_svd();
+	Error += test_kabsch();
+	Error += test_robustWeight();
+	Error += test_icp(false, false);
+	Error += test_icp(true, false);
+	Error += test_icp(false, true);
+
+	return Error;
+}
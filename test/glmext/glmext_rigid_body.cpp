@@ -0,0 +1,187 @@
+#include <glm/glm.hpp>
+#include <glmext/RigidBody.h>
+#include <cmath>
+#include <vector>
+
+static int test_integrate()
+{
+	int Error = 0;
+
+	glm::rigid_body_setd Bodies;
+	glm::uint32_t const Falling = Bodies.addBody(glm::dvec3(0.0, 10.0, 0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 2.0, glm::sphereInertia(2.0, 0.5));
+	glm::uint32_t const Ground = Bodies.addBody(glm::dvec3(0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 0.0, glm::dmat3(1.0));
+	Error += Bodies.size() == 2 ? 0 : 1;
+
+	// Semi-implicit Euler: velocity first, then position with the new velocity
+	glm::dvec3 const Gravity(0.0, -10.0, 0.0);
+	double const dt = 0.01;
+	for(int Step = 1; Step <= 100; ++Step)
+	{
+		glm::integrateVelocities(Bodies, 0, Bodies.size(), Gravity, dt);
+		glm::integratePositions(Bodies, 0, Bodies.size(), dt);
+	}
+	Error += glm::length(Bodies.mLinearVelocities[Falling] - Gravity) < 1e-9 ? 0 : 1;
+	Error += std::abs(Bodies.mPositions[Falling].y - (10.0 - 10.0 * dt * dt * 100.0 * 101.0 / 2.0)) < 1e-9 ? 0 : 1;
+	Error += Bodies.mPositions[Ground] == glm::dvec3(0.0) && Bodies.mLinearVelocities[Ground] == glm::dvec3(0.0) ? 0 : 1;
+
+	// Forces and torques act once then clear
+	glm::dvec3 const HalfExtents(1.0, 0.5, 0.25);
+	glm::uint32_t const Box = Bodies.addBody(glm::dvec3(0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 3.0, glm::boxInertia(3.0, HalfExtents));
+	Bodies.mForces[Box] = glm::dvec3(6.0, 0.0, 0.0);
+	Bodies.mTorques[Box] = glm::dvec3(0.0, 0.0, 2.0);
+	glm::integrateVelocities(Bodies, Box, 1, glm::dvec3(0.0), 0.5);
+	Error += glm::length(Bodies.mLinearVelocities[Box] - glm::dvec3(1.0, 0.0, 0.0)) < 1e-12 ? 0 : 1;
+	double const Izz = 3.0 / 3.0 * (HalfExtents.x * HalfExtents.x + HalfExtents.y * HalfExtents.y);
+	Error += glm::length(Bodies.mAngularVelocities[Box] - glm::dvec3(0.0, 0.0, 2.0 * 0.5 / Izz)) < 1e-12 ? 0 : 1;
+	Error += Bodies.mForces[Box] == glm::dvec3(0.0) && Bodies.mTorques[Box] == glm::dvec3(0.0) ? 0 : 1;
+
+	// Spinning about z keeps the orientation a unit quaternion about z
+	glm::integratePositions(Bodies, Box, 1, 0.5);
+	glm::dquat const q = Bodies.mOrientations[Box];
+	Error += std::abs(glm::length(q) - 1.0) < 1e-12 && std::abs(q.x) < 1e-12 && std::abs(q.y) < 1e-12 && q.z > 0.0 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_colorContacts()
+{
+	int Error = 0;
+
+	// A chain of dynamic bodies resting on one static body
+	glm::rigid_body_setd Bodies;
+	glm::uint32_t const Ground = Bodies.addBody(glm::dvec3(0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 0.0, glm::dmat3(1.0));
+	for(int i = 0; i < 6; ++i)
+		Bodies.addBody(glm::dvec3(double(i), 1.0, 0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 1.0, glm::sphereInertia(1.0, 0.5));
+
+	std::vector<glm::contact_constraintd> Contacts;
+	for(glm::uint32_t i = 1; i <= 6; ++i)
+	{
+		glm::contact_constraintd Contact = glm::contact_constraintd();
+		Contact.mBodyA = Ground;
+		Contact.mBodyB = i;
+		Contacts.push_back(Contact);
+		if(i < 6)
+		{
+			Contact.mBodyA = i;
+			Contact.mBodyB = i + 1;
+			Contacts.push_back(Contact);
+		}
+	}
+	std::vector<glm::contact_constraintd> const Original(Contacts);
+
+	std::vector<glm::uint32_t> Offsets;
+	glm::colorContacts(&Contacts[0], Contacts.size(), Bodies, Offsets);
+	Error += Offsets.size() >= 3 && Offsets.front() == 0 && Offsets.back() == Contacts.size() ? 0 : 1;
+	for(std::size_t Batch = 0; Batch + 1 < Offsets.size(); ++Batch)
+	{
+		std::vector<int> Used(Bodies.size(), 0);
+		for(glm::uint32_t i = Offsets[Batch]; i < Offsets[Batch + 1]; ++i)
+		{
+			++Used[Contacts[i].mBodyA];
+			++Used[Contacts[i].mBodyB];
+		}
+		for(std::size_t b = 1; b < Bodies.size(); ++b)
+			Error += Used[b] <= 1 ? 0 : 1;
+	}
+
+	// Same contacts, reordered
+	for(std::size_t i = 0; i < Original.size(); ++i)
+	{
+		int Found = 0;
+		for(std::size_t j = 0; j < Contacts.size(); ++j)
+			Found += Contacts[j].mBodyA == Original[i].mBodyA && Contacts[j].mBodyB == Original[i].mBodyB;
+		Error += Found == 1 ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_collision()
+{
+	int Error = 0;
+
+	// Two spheres meeting head on, off the center of mass line
+	glm::rigid_body_setd Bodies;
+	glm::uint32_t const a = Bodies.addBody(glm::dvec3(-0.5, 0.0, 0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 1.0, glm::sphereInertia(1.0, 0.5));
+	glm::uint32_t const b = Bodies.addBody(glm::dvec3(0.5, 0.1, 0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 3.0, glm::sphereInertia(3.0, 0.5));
+	Bodies.mLinearVelocities[a] = glm::dvec3(2.0, 0.0, 0.0);
+	Bodies.mLinearVelocities[b] = glm::dvec3(-1.0, 0.0, 0.0);
+
+	glm::contact_constraintd Contact = glm::contact_constraintd();
+	Contact.mBodyA = a;
+	Contact.mBodyB = b;
+	Contact.mPoint = glm::dvec3(0.0, 0.05, 0.0);
+	Contact.mNormal = glm::dvec3(1.0, 0.0, 0.0);
+	Contact.mFriction = 0.5;
+
+	glm::dvec3 const Momentum = Bodies.mLinearVelocities[a] * 1.0 + Bodies.mLinearVelocities[b] * 3.0;
+	glm::contact_solver_paramsd Params;
+	std::vector<glm::uint32_t> Offsets;
+	glm::colorContacts(&Contact, 1, Bodies, Offsets);
+	glm::solveContacts(Bodies, &Contact, Offsets, 0.01, Params);
+
+	glm::dvec3 const After = Bodies.mLinearVelocities[a] * 1.0 + Bodies.mLinearVelocities[b] * 3.0;
+	Error += glm::length(After - Momentum) < 1e-9 ? 0 : 1;
+	Error += Contact.mNormalImpulse > 0.0 ? 0 : 1;
+
+	// The contact points no longer approach
+	glm::dvec3 const VelocityA = Bodies.mLinearVelocities[a] + glm::cross(Bodies.mAngularVelocities[a], Contact.mPoint - Bodies.mPositions[a]);
+	glm::dvec3 const VelocityB = Bodies.mLinearVelocities[b] + glm::cross(Bodies.mAngularVelocities[b], Contact.mPoint - Bodies.mPositions[b]);
+	Error += glm::dot(VelocityB - VelocityA, Contact.mNormal) > -1e-9 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_resting()
+{
+	int Error = 0;
+
+	// A box dropped on a static ground settles at its height
+	glm::rigid_body_setd Bodies;
+	glm::uint32_t const Ground = Bodies.addBody(glm::dvec3(0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 0.0, glm::dmat3(1.0));
+	glm::dvec3 const HalfExtents(0.5);
+	glm::uint32_t const Box = Bodies.addBody(glm::dvec3(0.0, 0.6, 0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), 1.0, glm::boxInertia(1.0, HalfExtents));
+
+	glm::contact_solver_paramsd Params;
+	std::vector<glm::contact_constraintd> Contacts(4, glm::contact_constraintd());
+	for(int Step = 0; Step < 200; ++Step)
+	{
+		// The bottom corners touch the plane y = 0, impulses carried over
+		glm::dmat3 const Rotation = glm::mat3_cast(Bodies.mOrientations[Box]);
+		for(int c = 0; c < 4; ++c)
+		{
+			glm::dvec3 const Corner = Bodies.mPositions[Box] + Rotation * glm::dvec3((c & 1) ? 0.5 : -0.5, -0.5, (c & 2) ? 0.5 : -0.5);
+			glm::contact_constraintd& Contact = Contacts[c];
+			Contact.mBodyA = Ground;
+			Contact.mBodyB = Box;
+			Contact.mPoint = glm::dvec3(Corner.x, 0.0, Corner.z);
+			Contact.mNormal = glm::dvec3(0.0, 1.0, 0.0);
+			Contact.mPenetration = -Corner.y;
+			Contact.mFriction = 0.6;
+		}
+		glm::stepRigidBodies(Bodies, &Contacts[0], Contacts.size(), glm::dvec3(0.0, -10.0, 0.0), 1.0 / 60.0, Params);
+	}
+
+	Error += std::abs(Bodies.mPositions[Box].y - 0.5) < Params.mSlop * 2.0 ? 0 : 1;
+	Error += glm::length(Bodies.mLinearVelocities[Box]) < 1e-2 ? 0 : 1;
+	Error += glm::length(Bodies.mAngularVelocities[Box]) < 1e-2 ? 0 : 1;
+	Error += std::abs(Bodies.mPositions[Box].x) < 1e-4 && std::abs(Bodies.mPositions[Box].z) < 1e-4 ? 0 : 1;
+
+	// The static ground never picks up a velocity
+	Error += Bodies.mPositions[Ground] == glm::dvec3(0.0) ? 0 : 1;
+	Error += Bodies.mLinearVelocities[Ground] == glm::dvec3(0.0) && Bodies.mAngularVelocities[Ground] == glm::dvec3(0.0) ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_integrate();
+	Error += test_colorContacts();
+	Error += test_collision();
+	Error += test_resting();
+
+	return Error;
+}
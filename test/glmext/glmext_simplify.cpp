@@ -0,0 +1,151 @@
+#include <glm/glm.hpp>
+#include <glmext/Simplify.h>
+#include <cmath>
+#include <vector>
+
+// Size * Size quads over [0, 1]^2 in the z = 0 plane, counter clockwise seen from +z
+static void gridMesh(int Size, std::vector<glm::dvec3>& Positions, std::vector<glm::uint32_t>& Indices)
+{
+	for(int y = 0; y <= Size; ++y)
+	for(int x = 0; x <= Size; ++x)
+		Positions.push_back(glm::dvec3(double(x) / double(Size), double(y) / double(Size), 0.0));
+	for(int y = 0; y < Size; ++y)
+	for(int x = 0; x < Size; ++x)
+	{
+		glm::uint32_t const v = static_cast<glm::uint32_t>(y * (Size + 1) + x);
+		glm::uint32_t const Quad[] = {v, v + 1, v + static_cast<glm::uint32_t>(Size) + 2, v, v + static_cast<glm::uint32_t>(Size) + 2, v + static_cast<glm::uint32_t>(Size) + 1};
+		Indices.insert(Indices.end(), Quad, Quad + 6);
+	}
+}
+
+// Sum of the signed areas along z, and the number of triangles facing -z
+static double signedArea(std::vector<glm::dvec3> const& Positions, std::vector<glm::uint32_t> const& Indices, int& Flipped)
+{
+	double Area = 0.0;
+	Flipped = 0;
+	for(std::size_t t = 0; t < Indices.size(); t += 3)
+	{
+		glm::dvec3 const& a = Positions[Indices[t]];
+		glm::dvec3 const& b = Positions[Indices[t + 1]];
+		glm::dvec3 const& c = Positions[Indices[t + 2]];
+		double const z = glm::cross(b - a, c - a).z * 0.5;
+		Flipped += z <= 0.0 ? 1 : 0;
+		Area += z;
+	}
+	return Area;
+}
+
+static int test_quadric()
+{
+	int Error = 0;
+
+	glm::quadricd Quadric(glm::dvec3(1, 0, 0), 2.0, 1.0);
+	Error += std::abs(Quadric.evaluate(glm::dvec3(5, 7, -3)) - 9.0) < 1e-12 ? 0 : 1;
+
+	glm::dvec3 Minimum(0.0);
+	Error += !Quadric.findMinimum(Minimum) ? 0 : 1;
+
+	// Three planes meet at a single point of zero error
+	Quadric += glm::quadricd(glm::dvec3(0, 1, 0), -1.0, 2.0);
+	Quadric = Quadric + glm::quadricd(glm::dvec3(0, 0, 1), 3.0, 0.5);
+	Error += Quadric.findMinimum(Minimum) ? 0 : 1;
+	Error += glm::length(Minimum - glm::dvec3(2, -1, 3)) < 1e-9 ? 0 : 1;
+	Error += std::abs(Quadric.evaluate(Minimum)) < 1e-9 ? 0 : 1;
+	Error += std::abs(Quadric.evaluate(glm::dvec3(2, 0, 3)) - 2.0) < 1e-9 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_simplifyMesh()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(16, Positions, Indices);
+
+	// A flat mesh collapses at no cost, keeping its border, so its area, and never flipping
+	double const Cost = glm::simplifyMesh(&Positions[0], Positions.size(), Indices, 64, 1e-6);
+	Error += Indices.size() / 3 <= 64 ? 0 : 1;
+	Error += Cost < 1e-9 ? 0 : 1;
+
+	int Flipped = 0;
+	Error += std::abs(signedArea(Positions, Indices, Flipped) - 1.0) < 1e-9 ? 0 : 1;
+	Error += Flipped == 0 ? 0 : 1;
+	for(std::size_t i = 0; i < Indices.size(); ++i)
+		Error += Positions[Indices[i]].z == 0.0 ? 0 : 1;
+
+	// Locked vertices never move nor disappear
+	std::vector<glm::dvec3> Bumped;
+	std::vector<glm::uint32_t> BumpedIndices;
+	gridMesh(12, Bumped, BumpedIndices);
+	std::vector<glm::uint8_t> Locked(Bumped.size(), 0);
+	for(std::size_t i = 0; i < Bumped.size(); ++i)
+	{
+		Bumped[i].z = 0.05 * std::sin(Bumped[i].x * 6.0) * std::cos(Bumped[i].y * 5.0);
+		Locked[i] = i % 7 == 0 ? 1 : 0;
+	}
+	std::vector<glm::dvec3> const Original(Bumped);
+	glm::simplifyMesh(&Bumped[0], Bumped.size(), BumpedIndices, 40, 1.0, &Locked[0]);
+	Error += BumpedIndices.size() / 3 < 288 ? 0 : 1;
+	for(std::size_t i = 0; i < Bumped.size(); ++i)
+	{
+		if(!Locked[i])
+			continue;
+		Error += Bumped[i] == Original[i] ? 0 : 1;
+		Error += std::find(BumpedIndices.begin(), BumpedIndices.end(), static_cast<glm::uint32_t>(i)) != BumpedIndices.end() ? 0 : 1;
+	}
+
+	// The max error bounds the collapses
+	std::vector<glm::dvec3> Grid;
+	std::vector<glm::uint32_t> Strict;
+	gridMesh(12, Grid, Strict);
+	Bumped = Original;
+	double const Bounded = glm::simplifyMesh(&Bumped[0], Bumped.size(), Strict, 0, 1e-5);
+	Error += Bounded <= 1e-5 ? 0 : 1;
+	std::vector<glm::uint32_t> Loose;
+	gridMesh(12, Grid, Loose);
+	Bumped = Original;
+	glm::simplifyMesh(&Bumped[0], Bumped.size(), Loose, 0, 1.0);
+	Error += Strict.size() > Loose.size() ? 0 : 1;
+
+	return Error;
+}
+
+static int test_simplifyMeshClusters()
+{
+	int Error = 0;
+
+	std::vector<glm::dvec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(24, Positions, Indices);
+
+	std::vector<std::vector<glm::uint32_t> > Clusters;
+	std::vector<glm::uint8_t> Locked;
+	glm::buildSimplifyClusters(&Positions[0], Positions.size(), Indices, 0.25, Clusters, Locked);
+	Error += Clusters.size() == 16 ? 0 : 1;
+
+	std::vector<glm::dvec3> const Original(Positions);
+	glm::simplifyMeshClusters(&Positions[0], Positions.size(), Indices, 0.25, 0.25, 1e-6);
+	Error += Indices.size() / 3 < 24 * 24 * 2 / 2 ? 0 : 1;
+
+	int Flipped = 0;
+	Error += std::abs(signedArea(Positions, Indices, Flipped) - 1.0) < 1e-9 ? 0 : 1;
+	Error += Flipped == 0 ? 0 : 1;
+	for(std::size_t i = 0; i < Positions.size(); ++i)
+		if(Locked[i])
+			Error += Positions[i] == Original[i] ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_quadric();
+	Error += test_simplifyMesh();
+	Error += test_simplifyMeshClusters();
+
+	return Error;
+}
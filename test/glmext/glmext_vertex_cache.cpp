@@ -0,0 +1,155 @@
+#include <glm/glm.hpp>
+#include <glmext/VertexCache.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// A regular grid, triangles counter clockwise seen from +z
+static void gridMesh(int Size, std::vector<glm::vec3>& Positions, std::vector<glm::uint32_t>& Indices)
+{
+	for(int y = 0; y <= Size; ++y)
+	for(int x = 0; x <= Size; ++x)
+		Positions.push_back(glm::vec3(float(x), float(y), 0.0f));
+	for(int y = 0; y < Size; ++y)
+	for(int x = 0; x < Size; ++x)
+	{
+		glm::uint32_t const v = static_cast<glm::uint32_t>(y * (Size + 1) + x);
+		glm::uint32_t const Row = static_cast<glm::uint32_t>(Size + 1);
+		glm::uint32_t const Quad[] = {v, v + 1, v + Row + 1, v, v + Row + 1, v + Row};
+		Indices.insert(Indices.end(), Quad, Quad + 6);
+	}
+}
+
+// Shuffles the triangles with a fixed linear congruential sequence
+static void shuffleTriangles(std::vector<glm::uint32_t>& Indices)
+{
+	glm::uint32_t State = 12345u;
+	for(std::size_t i = Indices.size() / 3; i > 1; --i)
+	{
+		State = State * 1664525u + 1013904223u;
+		std::size_t const j = (State >> 8) % i;
+		for(int k = 0; k < 3; ++k)
+			std::swap(Indices[3 * (i - 1) + k], Indices[3 * j + k]);
+	}
+}
+
+static bool lessTriangle(glm::uvec3 const& a, glm::uvec3 const& b)
+{
+	return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : a.z < b.z);
+}
+
+// The triangles rotated to start at their smallest index, then sorted
+static std::vector<glm::uvec3> canonicalTriangles(std::vector<glm::uint32_t> const& Indices)
+{
+	std::vector<glm::uvec3> Result;
+	for(std::size_t i = 0; i < Indices.size(); i += 3)
+	{
+		glm::uvec3 t(Indices[i], Indices[i + 1], Indices[i + 2]);
+		while(t.x > t.y || t.x > t.z)
+			t = glm::uvec3(t.y, t.z, t.x);
+		Result.push_back(t);
+	}
+	std::sort(Result.begin(), Result.end(), lessTriangle);
+	return Result;
+}
+
+static int test_computeACMR()
+{
+	int Error = 0;
+
+	// No reuse at all
+	glm::uint32_t const Separate[] = {0, 1, 2, 3, 4, 5};
+	Error += glm::computeACMR(Separate, 6, 6, 16) == 3.0f ? 0 : 1;
+
+	// A strip reuses two vertices per triangle
+	glm::uint32_t const Strip[] = {0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5};
+	Error += glm::computeACMR(Strip, 12, 6, 16) == 1.5f ? 0 : 1;
+
+	// A single entry cache only hits when the last vertex repeats
+	Error += glm::computeACMR(Strip, 12, 6, 1) == 2.5f ? 0 : 1;
+
+	return Error;
+}
+
+static int test_optimizeVertexCache()
+{
+	int Error = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(32, Positions, Indices);
+	shuffleTriangles(Indices);
+
+	std::vector<glm::uint32_t> Optimized(Indices.size());
+	glm::vertex_cache_report_t const Report = glm::optimizeVertexCache(&Indices[0], Indices.size(), Positions.size(), 16, &Optimized[0]);
+	Error += Report.mACMRBefore == glm::computeACMR(&Indices[0], Indices.size(), Positions.size(), 16) ? 0 : 1;
+	Error += Report.mACMRAfter == glm::computeACMR(&Optimized[0], Optimized.size(), Positions.size(), 16) ? 0 : 1;
+	Error += Report.mACMRBefore > 2.0f ? 0 : 1;
+	Error += Report.mACMRAfter < 0.9f ? 0 : 1;
+	Error += canonicalTriangles(Optimized) == canonicalTriangles(Indices) ? 0 : 1;
+
+	// Overdraw ordering moves whole clusters, the cache efficiency stays
+	std::vector<glm::uint32_t> Overdraw(Optimized);
+	glm::optimizeOverdraw(&Overdraw[0], Overdraw.size(), &Positions[0], Positions.size(), 16);
+	Error += canonicalTriangles(Overdraw) == canonicalTriangles(Indices) ? 0 : 1;
+	Error += glm::computeACMR(&Overdraw[0], Overdraw.size(), Positions.size(), 16) <= Report.mACMRAfter * 1.1f ? 0 : 1;
+
+	glm::vec3 const View(0.0f, 0.0f, -1.0f);
+	std::vector<glm::uint32_t> Viewed(Optimized);
+	glm::optimizeOverdraw(&Viewed[0], Viewed.size(), &Positions[0], Positions.size(), 16, &View, 1);
+	Error += canonicalTriangles(Viewed) == canonicalTriangles(Indices) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_optimizeVertexFetch()
+{
+	int Error = 0;
+
+	std::vector<glm::vec3> Positions;
+	std::vector<glm::uint32_t> Indices;
+	gridMesh(8, Positions, Indices);
+	shuffleTriangles(Indices);
+
+	// Drop the last triangle, leaving at most a few vertices unreferenced
+	Indices.resize(Indices.size() - 3);
+	std::vector<bool> Referenced(Positions.size(), false);
+	for(std::size_t i = 0; i < Indices.size(); ++i)
+		Referenced[Indices[i]] = true;
+	std::size_t const ReferencedCount = static_cast<std::size_t>(std::count(Referenced.begin(), Referenced.end(), true));
+
+	std::vector<glm::uint32_t> Remap(Positions.size());
+	std::size_t const Count = glm::optimizeVertexFetchRemap(&Indices[0], Indices.size(), Positions.size(), &Remap[0]);
+	Error += Count == ReferencedCount ? 0 : 1;
+	for(std::size_t v = 0; v < Positions.size(); ++v)
+		Error += (Remap[v] == std::numeric_limits<glm::uint32_t>::max()) == !Referenced[v] ? 0 : 1;
+
+	std::vector<glm::uint32_t> Remapped(Indices);
+	glm::remapIndexBuffer(&Remapped[0], Remapped.size(), &Remap[0]);
+	std::vector<glm::vec3> Fetched(Count);
+	glm::remapVertexBuffer(&Positions[0], Positions.size(), &Remap[0], &Fetched[0]);
+
+	// Same triangles, vertices numbered by first use
+	glm::uint32_t Next = 0;
+	for(std::size_t i = 0; i < Indices.size(); ++i)
+	{
+		Error += Fetched[Remapped[i]] == Positions[Indices[i]] ? 0 : 1;
+		Error += Remapped[i] <= Next ? 0 : 1;
+		if(Remapped[i] == Next)
+			++Next;
+	}
+	Error += Next == Count ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_computeACMR();
+	Error += test_optimizeVertexCache();
+	Error += test_optimizeVertexFetch();
+
+	return Error;
+}
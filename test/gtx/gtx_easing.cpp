@@ -2,6 +2,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/easing.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <vector>
 
 namespace
 {
@@ -49,6 +51,48 @@ namespace
 		r = glm::bounceEaseOut(a);
 		r = glm::bounceEaseInOut(a);
 	}
+
+	template<typename T>
+	static int _test_easing_batch(T Epsilon)
+	{
+		typedef T (*easingFunc_t)(T const&);
+		easingFunc_t const Functions[] =
+		{
+			glm::linearInterpolation,
+			glm::quadraticEaseIn, glm::quadraticEaseOut, glm::quadraticEaseInOut,
+			glm::cubicEaseIn, glm::cubicEaseOut, glm::cubicEaseInOut,
+			glm::quarticEaseIn, glm::quarticEaseOut, glm::quarticEaseInOut,
+			glm::quinticEaseIn, glm::quinticEaseOut, glm::quinticEaseInOut,
+			glm::sineEaseIn, glm::sineEaseOut, glm::sineEaseInOut,
+			glm::circularEaseIn, glm::circularEaseOut, glm::circularEaseInOut,
+			glm::exponentialEaseIn, glm::exponentialEaseOut, glm::exponentialEaseInOut,
+			glm::elasticEaseIn, glm::elasticEaseOut, glm::elasticEaseInOut,
+			glm::backEaseIn, glm::backEaseOut, glm::backEaseInOut,
+			glm::bounceEaseIn, glm::bounceEaseOut, glm::bounceEaseInOut
+		};
+
+		int Error = 0;
+
+		std::size_t const Count = 1001;
+		std::vector<T> In(Count), Out(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+			In[i] = static_cast<T>(i) / static_cast<T>(Count - 1);
+
+		for(int f = 0; f <= glm::easing_bounce_in_out; ++f)
+		{
+			glm::easingBatch(static_cast<glm::easing_function>(f), &In[0], Count, &Out[0]);
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += glm::epsilonEqual(Out[i], Functions[f](In[i]), Epsilon) ? 0 : 1;
+		}
+
+		// In place
+		std::vector<T> Values(In);
+		glm::easingBatch(glm::easing_elastic_out, &Values[0], Count, &Values[0]);
+		for(std::size_t i = 0; i < Count; ++i)
+			Error += glm::epsilonEqual(Values[i], glm::elasticEaseOut(In[i]), Epsilon) ? 0 : 1;
+
+		return Error;
+	}
 }
 
 int main()
@@ -58,6 +102,9 @@ int main()
 	_test_easing<float>();
 	_test_easing<double>();
 
+	Error += _test_easing_batch<float>(0.00001f);
+	Error += _test_easing_batch<double>(0.0000000001);
+
 	return Error;
 }
 
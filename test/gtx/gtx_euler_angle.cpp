@@ -7,6 +7,7 @@
 #include <glm/gtc/epsilon.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <glm/gtx/euler_angles.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <cstdio>
 #include <vector>
 #include <utility>
@@ -427,6 +428,64 @@ namespace test_eulerAngles
 	}
 }//namespace test_extractsEulerAngles
 
+namespace test_eulerAngleBatch
+{
+	typedef glm::mat4::value_type value;
+	typedef glm::mat4 (*rotationFunc_t)(value const&, value const&, value const&);
+
+	static int test(glm::euler_order Order, rotationFunc_t rotationFunc)
+	{
+		int Error = 0;
+
+		std::size_t const Count = 37;
+		std::vector<value> T1(Count), T2(Count), T3(Count);
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			value const x = static_cast<value>(i) / static_cast<value>(Count);
+			T1[i] = glm::mix(-3.0f, 3.0f, x);
+			T2[i] = glm::mix(0.1f, 1.4f, x);
+			T3[i] = glm::mix(2.5f, -2.5f, x);
+		}
+
+		std::vector<glm::mat4> Mat4(Count);
+		std::vector<glm::mat3> Mat3(Count);
+		std::vector<glm::quat> Quat(Count);
+		glm::eulerAngleBatch(Order, &T1[0], &T2[0], &T3[0], Count, &Mat4[0]);
+		glm::eulerAngleBatch(Order, &T1[0], &T2[0], &T3[0], Count, &Mat3[0]);
+		glm::eulerAngleBatch(Order, &T1[0], &T2[0], &T3[0], Count, &Quat[0]);
+
+		std::vector<value> E1(Count), E2(Count), E3(Count);
+		glm::extractEulerAngleBatch(Order, &Mat4[0], Count, &E1[0], &E2[0], &E3[0]);
+
+		std::vector<value> F1(Count), F2(Count), F3(Count);
+		glm::extractEulerAngleBatch(Order, &Mat3[0], Count, &F1[0], &F2[0], &F3[0]);
+
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			glm::mat4 const Expected = rotationFunc(T1[i], T2[i], T3[i]);
+			for(glm::length_t c = 0; c < 4; ++c)
+				Error += glm::all(glm::epsilonEqual(Mat4[i][c], Expected[c], 0.00001f)) ? 0 : 1;
+
+			glm::mat3 const Expected3(Expected);
+			glm::mat3 const FromQuat = glm::mat3_cast(Quat[i]);
+			for(glm::length_t c = 0; c < 3; ++c)
+			{
+				Error += glm::all(glm::epsilonEqual(Mat3[i][c], Expected3[c], 0.00001f)) ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(FromQuat[c], Expected3[c], 0.0001f)) ? 0 : 1;
+			}
+
+			Error += glm::epsilonEqual(E1[i], T1[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(E2[i], T2[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(E3[i], T3[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(F1[i], T1[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(F2[i], T2[i], 0.0001f) ? 0 : 1;
+			Error += glm::epsilonEqual(F3[i], T3[i], 0.0001f) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace test_eulerAngleBatch
+
 namespace test_extractsEulerAngles
 {
 	template<typename RotationFunc, typename TestExtractionFunc>
@@ -533,5 +592,18 @@ int main()
 	Error += test_extractsEulerAngles::test(glm::eulerAngleZYX<value>, glm::extractEulerAngleZYX<value>);
 	Error += test_extractsEulerAngles::test(glm::eulerAngleZXY<value>, glm::extractEulerAngleZXY<value>);
 
+	Error += test_eulerAngleBatch::test(glm::euler_xyz, glm::eulerAngleXYZ<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_xzy, glm::eulerAngleXZY<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_yxz, glm::eulerAngleYXZ<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_yzx, glm::eulerAngleYZX<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_zxy, glm::eulerAngleZXY<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_zyx, glm::eulerAngleZYX<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_xyx, glm::eulerAngleXYX<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_xzx, glm::eulerAngleXZX<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_yxy, glm::eulerAngleYXY<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_yzy, glm::eulerAngleYZY<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_zxz, glm::eulerAngleZXZ<value>);
+	Error += test_eulerAngleBatch::test(glm::euler_zyz, glm::eulerAngleZYZ<value>);
+
 	return Error; 
 }
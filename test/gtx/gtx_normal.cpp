@@ -1,9 +1,123 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/normal.hpp>
+#include <glm/ext/scalar_relational.hpp>
+#include <glm/ext/vector_relational.hpp>
+#include <vector>
+
+static int test_triangleNormalBatch()
+{
+	int Error = 0;
+
+	glm::vec3 const Positions[] = {
+		glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 2)};
+	glm::uint32 const Indices[] = {0, 1, 2, 0, 2, 3, 0, 3, 1, 1, 3, 2};
+
+	std::vector<glm::vec3> Normals(4 * 5, glm::vec3(0));
+	std::vector<glm::uint32> ManyIndices;
+	for(std::size_t i = 0; i < Normals.size(); ++i)
+		ManyIndices.insert(ManyIndices.end(), Indices + (i % 4) * 3, Indices + (i % 4) * 3 + 3);
+
+	glm::triangleNormalBatch(Positions, &ManyIndices[0], Normals.size(), &Normals[0]);
+	for(std::size_t i = 0; i < Normals.size(); ++i)
+	{
+		glm::uint32 const* Triangle = &ManyIndices[i * 3];
+		glm::vec3 const Expected = glm::triangleNormal(Positions[Triangle[0]], Positions[Triangle[1]], Positions[Triangle[2]]);
+		Error += glm::all(glm::equal(Normals[i], Expected, 0.0001f)) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+// Unit quad in the xy plane split in two triangles of different areas, texture coordinates matching positions
+static int test_computeVertexNormals()
+{
+	int Error = 0;
+
+	glm::vec3 const Positions[] = {
+		glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(1, 1, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1)};
+	glm::uint32 const Indices[] = {0, 1, 2, 0, 2, 3, 0, 4, 1};
+
+	glm::vec3 Normals[5];
+	glm::computeVertexNormals(Positions, 5, Indices, 3, Normals);
+	Error += glm::all(glm::equal(Normals[2], glm::vec3(0, 0, 1), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(Normals[4], glm::vec3(0, 1, 0), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(Normals[0], glm::normalize(glm::vec3(0, 1, 2)), 0.0001f)) ? 0 : 1;
+
+	// Two partitions reduced give the same normals
+	std::vector<glm::vec3> Partials(2 * 5, glm::vec3(0));
+	glm::accumulateVertexNormals(Positions, Indices, 0, 2, &Partials[0]);
+	glm::accumulateVertexNormals(Positions, Indices, 2, 1, &Partials[5]);
+
+	glm::vec3 Reduced[5];
+	glm::reduceVertexAttributes(&Partials[0], 2, 5, 3, Reduced);
+	glm::reduceVertexAttributes(&Partials[3], 2, 5, 2, Reduced + 3);
+	glm::normalizeVertexNormals(Reduced, 5);
+	for(std::size_t i = 0; i < 5; ++i)
+		Error += glm::all(glm::equal(Reduced[i], Normals[i], 0.0001f)) ? 0 : 1;
+
+	// Unreferenced vertices keep a null normal
+	glm::vec3 Isolated[6];
+	glm::vec3 const MorePositions[] = {
+		Positions[0], Positions[1], Positions[2], Positions[3], Positions[4], glm::vec3(5)};
+	glm::computeVertexNormals(MorePositions, 6, Indices, 3, Isolated);
+	Error += glm::all(glm::equal(Isolated[5], glm::vec3(0), 0.0f)) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_computeVertexTangents()
+{
+	int Error = 0;
+
+	glm::vec3 const Positions[] = {
+		glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(1, 1, 0), glm::vec3(0, 1, 0)};
+	glm::vec3 const Normals[] = {
+		glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1)};
+	glm::uint32 const Indices[] = {0, 1, 2, 0, 2, 3};
+
+	{
+		glm::vec2 const TexCoords[] = {
+			glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1)};
+
+		glm::vec4 Tangents[4];
+		glm::computeVertexTangents(Positions, Normals, TexCoords, 4, Indices, 2, Tangents);
+		for(std::size_t i = 0; i < 4; ++i)
+			Error += glm::all(glm::equal(Tangents[i], glm::vec4(1, 0, 0, 1), 0.0001f)) ? 0 : 1;
+	}
+
+	// Mirrored texture coordinates flip the handedness
+	{
+		glm::vec2 const TexCoords[] = {
+			glm::vec2(1, 0), glm::vec2(0, 0), glm::vec2(0, 1), glm::vec2(1, 1)};
+
+		glm::vec4 Tangents[4];
+		glm::computeVertexTangents(Positions, Normals, TexCoords, 4, Indices, 2, Tangents);
+		for(std::size_t i = 0; i < 4; ++i)
+			Error += glm::all(glm::equal(Tangents[i], glm::vec4(-1, 0, 0, -1), 0.0001f)) ? 0 : 1;
+	}
+
+	// Tangents are orthonormalized against the normal, degenerate ones replaced
+	{
+		glm::vec3 const Tilted[] = {glm::vec3(1, 0, 1), glm::vec3(0, 0, 3)};
+		glm::vec3 const Bitangents[] = {glm::vec3(0, 1, 0), glm::vec3(0, 1, 0)};
+
+		glm::vec4 Tangents[2];
+		glm::orthonormalizeTangents(Normals, Tilted, Bitangents, 2, Tangents);
+		Error += glm::all(glm::equal(Tangents[0], glm::vec4(1, 0, 0, 1), 0.0001f)) ? 0 : 1;
+		Error += glm::equal(glm::length(glm::vec3(Tangents[1])), 1.0f, 0.0001f) ? 0 : 1;
+		Error += glm::equal(glm::dot(glm::vec3(Tangents[1]), Normals[1]), 0.0f, 0.0001f) ? 0 : 1;
+	}
+
+	return Error;
+}
 
 int main()
 {
 	int Error(0);
 
+	Error += test_triangleNormalBatch();
+	Error += test_computeVertexNormals();
+	Error += test_computeVertexTangents();
+
 	return Error;
 }
@@ -1,9 +1,125 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/polar_coordinates.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+template<typename T>
+static int test_polarBatch(T Epsilon)
+{
+	int Error(0);
+
+	// Not a multiple of the block size, to cover the tail
+	std::size_t const Count = 67;
+	std::vector<T> X(Count), Y(Count), Z(Count), Latitude(Count), Longitude(Count), Radius(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		X[i] = static_cast<T>(std::cos(static_cast<double>(i) * 0.7) * 10.0);
+		Y[i] = static_cast<T>(static_cast<double>(i % 11) - 5.0);
+		Z[i] = static_cast<T>(std::sin(static_cast<double>(i) * 1.3) * 3.0);
+	}
+	X[3] = Z[3] = static_cast<T>(0);
+
+	glm::polarBatch(&X[0], &Y[0], &Z[0], Count, &Latitude[0], &Longitude[0], &Radius[0]);
+
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		T const Rho = std::sqrt(X[i] * X[i] + Z[i] * Z[i]);
+		Error += glm::epsilonEqual(Latitude[i], std::atan2(Y[i], Rho), Epsilon) ? 0 : 1;
+		Error += glm::epsilonEqual(Longitude[i], std::atan2(X[i], Z[i]), Epsilon) ? 0 : 1;
+		Error += glm::epsilonEqual(Radius[i], std::sqrt(X[i] * X[i] + Y[i] * Y[i] + Z[i] * Z[i]), Epsilon * Radius[i]) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+template<typename T>
+static int test_euclideanBatch(T Epsilon)
+{
+	int Error(0);
+
+	std::size_t const Count = 35;
+	std::vector<T> Latitude(Count), Longitude(Count), Radius(Count), X(Count), Y(Count), Z(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Latitude[i] = static_cast<T>(std::sin(static_cast<double>(i)) * 1.4);
+		Longitude[i] = static_cast<T>(static_cast<double>(i) * 0.17 - 3.0);
+		Radius[i] = static_cast<T>(1 + i % 7);
+	}
+
+	glm::euclideanBatch(&Latitude[0], &Longitude[0], &Radius[0], Count, &X[0], &Y[0], &Z[0]);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		glm::vec<3, T> const Point = glm::euclidean(glm::vec<2, T>(Latitude[i], Longitude[i])) * Radius[i];
+		Error += glm::all(glm::epsilonEqual(Point, glm::vec<3, T>(X[i], Y[i], Z[i]), Epsilon * Radius[i])) ? 0 : 1;
+	}
+
+	// Round trip through a sensor to world transform
+	glm::mat<4, 4, T, glm::defaultp> const Transform = glm::translate(
+		glm::rotate(glm::mat<4, 4, T, glm::defaultp>(1), static_cast<T>(0.7), glm::vec<3, T>(1, 2, 3)),
+		glm::vec<3, T>(5, -3, 2));
+	std::vector<T> Latitude2(Count), Longitude2(Count), Radius2(Count);
+	glm::euclideanBatch(Transform, &Latitude[0], &Longitude[0], &Radius[0], Count, &X[0], &Y[0], &Z[0]);
+	glm::polarBatch(glm::inverse(Transform), &X[0], &Y[0], &Z[0], Count, &Latitude2[0], &Longitude2[0], &Radius2[0]);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Error += glm::epsilonEqual(Latitude2[i], Latitude[i], Epsilon * static_cast<T>(100)) ? 0 : 1;
+		Error += glm::epsilonEqual(Longitude2[i], Longitude[i], Epsilon * static_cast<T>(100)) ? 0 : 1;
+		Error += glm::epsilonEqual(Radius2[i], Radius[i], Epsilon * static_cast<T>(100) * Radius[i]) ? 0 : 1;
+	}
+
+	// Without radius, in place
+	glm::euclideanBatch(&Latitude[0], &Longitude[0], static_cast<T const*>(NULL), Count, &Latitude[0], &Longitude[0], &Radius[0]);
+	for(std::size_t i = 0; i < Count; ++i)
+		Error += glm::epsilonEqual(Latitude[i] * Latitude[i] + Longitude[i] * Longitude[i] + Radius[i] * Radius[i], static_cast<T>(1), Epsilon * static_cast<T>(4)) ? 0 : 1;
+
+	return Error;
+}
+
+template<typename T>
+static int test_euclideanBatch_large(T Epsilon, T Range)
+{
+	int Error(0);
+
+	// Angles far outside [-2 pi, 2 pi], negative ones included
+	std::size_t const Count = 37;
+	std::vector<T> Latitude(Count), Longitude(Count), X(Count), Y(Count), Z(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Latitude[i] = static_cast<T>(std::cos(static_cast<double>(i) * 3.1)) * Range;
+		Longitude[i] = static_cast<T>(std::sin(static_cast<double>(i) * 1.7)) * Range;
+	}
+	Longitude[0] = static_cast<T>(-250);
+
+	// A dropped return and an angle far beyond the accurate range only spoil their own lanes
+	Latitude[5] = std::numeric_limits<T>::quiet_NaN();
+	Longitude[6] = static_cast<T>(1e30);
+
+	glm::euclideanBatch(&Latitude[0], &Longitude[0], static_cast<T const*>(NULL), Count, &X[0], &Y[0], &Z[0]);
+	Error += std::isnan(X[5]) && std::isnan(Y[5]) && std::isnan(Z[5]) ? 0 : 1;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		if(i == 5 || i == 6)
+			continue;
+		glm::vec<3, T> const Point = glm::euclidean(glm::vec<2, T>(Latitude[i], Longitude[i]));
+		Error += glm::all(glm::epsilonEqual(Point, glm::vec<3, T>(X[i], Y[i], Z[i]), Epsilon)) ? 0 : 1;
+	}
+
+	return Error;
+}
 
 int main()
 {
 	int Error(0);
 
+	Error += test_polarBatch<float>(1e-5f);
+	Error += test_polarBatch<double>(1e-12);
+	Error += test_euclideanBatch<float>(1e-5f);
+	Error += test_euclideanBatch<double>(1e-12);
+	Error += test_euclideanBatch_large<float>(1e-5f, 8000.0f);
+	Error += test_euclideanBatch_large<double>(1e-12, 1000000.0);
+
 	return Error;
 }
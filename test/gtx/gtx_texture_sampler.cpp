@@ -0,0 +1,243 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/texture_sampler.hpp>
+#include <glm/ext/vector_relational.hpp>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <vector>
+
+static int test_wrapTexel()
+{
+	int Error = 0;
+
+	Error += glm::wrapTexel(-1, 4, glm::wrap_clamp) == 0 ? 0 : 1;
+	Error += glm::wrapTexel(5, 4, glm::wrap_clamp) == 3 ? 0 : 1;
+	Error += glm::wrapTexel(2, 4, glm::wrap_clamp) == 2 ? 0 : 1;
+
+	Error += glm::wrapTexel(-1, 4, glm::wrap_repeat) == 3 ? 0 : 1;
+	Error += glm::wrapTexel(5, 4, glm::wrap_repeat) == 1 ? 0 : 1;
+	Error += glm::wrapTexel(-8, 4, glm::wrap_repeat) == 0 ? 0 : 1;
+
+	Error += glm::wrapTexel(-1, 4, glm::wrap_mirror_repeat) == 0 ? 0 : 1;
+	Error += glm::wrapTexel(4, 4, glm::wrap_mirror_repeat) == 3 ? 0 : 1;
+	Error += glm::wrapTexel(6, 4, glm::wrap_mirror_repeat) == 1 ? 0 : 1;
+	Error += glm::wrapTexel(8, 4, glm::wrap_mirror_repeat) == 0 ? 0 : 1;
+
+	Error += glm::wrapTexel(-1, 4, glm::wrap_mirror_clamp) == 0 ? 0 : 1;
+	Error += glm::wrapTexel(-3, 4, glm::wrap_mirror_clamp) == 2 ? 0 : 1;
+	Error += glm::wrapTexel(-9, 4, glm::wrap_mirror_clamp) == 3 ? 0 : 1;
+	Error += glm::wrapTexel(9, 4, glm::wrap_mirror_clamp) == 3 ? 0 : 1;
+
+	return Error;
+}
+
+static int test_sampleBilinear()
+{
+	int Error = 0;
+
+	glm::vec4 Texels[4] = {
+		glm::vec4(0.0f), glm::vec4(1.0f),
+		glm::vec4(2.0f), glm::vec4(3.0f)};
+	glm::texture_image<glm::vec4> const Image = {Texels, 2, 2};
+
+	// Texel centers return the texels themselves
+	Error += glm::all(glm::equal(glm::sampleBilinear(Image, glm::vec2(0.25f, 0.25f), glm::wrap_clamp), glm::vec4(0.0f), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(glm::sampleBilinear(Image, glm::vec2(0.75f, 0.75f), glm::wrap_clamp), glm::vec4(3.0f), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(glm::sampleNearest(Image, glm::vec2(0.7f, 0.2f), glm::wrap_clamp), glm::vec4(1.0f), 0.0001f)) ? 0 : 1;
+
+	// The image center averages the four texels
+	Error += glm::all(glm::equal(glm::sampleBilinear(Image, glm::vec2(0.5f, 0.5f), glm::wrap_clamp), glm::vec4(1.5f), 0.0001f)) ? 0 : 1;
+
+	// The image corner blends across the edges when repeating
+	Error += glm::all(glm::equal(glm::sampleBilinear(Image, glm::vec2(0.0f, 0.0f), glm::wrap_repeat), glm::vec4(1.5f), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(glm::sampleBilinear(Image, glm::vec2(0.0f, 0.0f), glm::wrap_clamp), glm::vec4(0.0f), 0.0001f)) ? 0 : 1;
+
+	glm::u8vec4 Bytes[4] = {
+		glm::u8vec4(0), glm::u8vec4(255),
+		glm::u8vec4(255), glm::u8vec4(0)};
+	glm::texture_image<glm::u8vec4 const> const ImageU8 = {Bytes, 2, 2};
+	Error += glm::all(glm::equal(glm::sampleBilinear(ImageU8, glm::vec2(0.5f, 0.5f), glm::wrap_clamp), glm::vec4(0.5f), 0.0001f)) ? 0 : 1;
+	Error += glm::all(glm::equal(glm::sampleBilinear(ImageU8, glm::vec2(0.75f, 0.25f), glm::wrap_clamp), glm::vec4(1.0f), 0.0001f)) ? 0 : 1;
+
+	return Error;
+}
+
+static int test_sampleBilinearBatch()
+{
+	int Error = 0;
+
+	int const Width = 7;
+	int const Height = 5;
+	std::vector<glm::vec4> Texels(Width * Height, glm::vec4(0.0f));
+	for(std::size_t i = 0; i < Texels.size(); ++i)
+		Texels[i] = glm::vec4(static_cast<float>(i), static_cast<float>(i % 3), static_cast<float>(i * i % 11), 1.0f);
+	glm::texture_image<glm::vec4> const Image = {&Texels[0], Width, Height};
+
+	std::vector<glm::vec2> UVs;
+	for(int i = 0; i < 53; ++i)
+		UVs.push_back(glm::vec2(static_cast<float>(i) * 0.071f - 1.3f, static_cast<float>(i) * -0.037f + 0.9f));
+
+	glm::wrap_mode const Modes[] = {glm::wrap_clamp, glm::wrap_repeat, glm::wrap_mirror_repeat, glm::wrap_mirror_clamp};
+	for(std::size_t m = 0; m < sizeof(Modes) / sizeof(Modes[0]); ++m)
+	{
+		std::vector<glm::vec4> Batch(UVs.size(), glm::vec4(0.0f));
+		glm::sampleBilinearBatch(Image, &UVs[0], UVs.size(), Modes[m], &Batch[0]);
+
+		for(std::size_t i = 0; i < UVs.size(); ++i)
+		{
+			glm::vec2 const Texel = UVs[i] * glm::vec2(Width, Height) - 0.5f;
+			glm::ivec2 const T0(glm::floor(Texel));
+			glm::vec2 const F = Texel - glm::floor(Texel);
+			glm::vec4 const Expected = glm::mix(
+				glm::mix(glm::texelFetch(Image, T0, Modes[m]), glm::texelFetch(Image, T0 + glm::ivec2(1, 0), Modes[m]), F.x),
+				glm::mix(glm::texelFetch(Image, T0 + glm::ivec2(0, 1), Modes[m]), glm::texelFetch(Image, T0 + glm::ivec2(1, 1), Modes[m]), F.x),
+				F.y);
+			Error += glm::all(glm::equal(Batch[i], Expected, 0.001f)) ? 0 : 1;
+		}
+	}
+
+	return Error;
+}
+
+static int test_generateMipmaps()
+{
+	int Error = 0;
+
+	// Box filtering an even extent averages 2 * 2 blocks
+	{
+		std::vector<glm::vec4> Texels(4 * 4 + 2 * 2 + 1, glm::vec4(0.0f));
+		for(std::size_t i = 0; i < 16; ++i)
+			Texels[i] = glm::vec4(static_cast<float>(i));
+
+		glm::texture_image<glm::vec4> const Levels[] = {
+			{&Texels[0], 4, 4},
+			{&Texels[16], 2, 2},
+			{&Texels[20], 1, 1}};
+		int const LevelCount = glm::levels(glm::ivec2(4, 4));
+		Error += LevelCount == 3 ? 0 : 1;
+
+		glm::generateMipmaps(Levels, LevelCount, glm::mip_filter_box, glm::wrap_clamp);
+
+		Error += glm::all(glm::equal(Texels[16], glm::vec4(2.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Texels[17], glm::vec4(4.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Texels[18], glm::vec4(10.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Texels[19], glm::vec4(12.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Texels[20], glm::vec4(7.5f), 0.0001f)) ? 0 : 1;
+
+		glm::vec4 const Trilinear = glm::sampleTrilinear(Levels, LevelCount, glm::vec2(0.125f, 0.125f), 0.5f, glm::wrap_clamp);
+		Error += glm::all(glm::equal(Trilinear, glm::mix(Texels[0], Texels[16], 0.5f), 0.0001f)) ? 0 : 1;
+	}
+
+	// Constant images stay constant for non power of two extents and both filters
+	glm::mip_filter const Filters[] = {glm::mip_filter_box, glm::mip_filter_kaiser};
+	for(std::size_t f = 0; f < sizeof(Filters) / sizeof(Filters[0]); ++f)
+	{
+		std::vector<glm::u8vec4> Texels(7 * 5 + 3 * 2 + 1 * 1, glm::u8vec4(200, 100, 50, 255));
+		glm::texture_image<glm::u8vec4> const Levels[] = {
+			{&Texels[0], 7, 5},
+			{&Texels[35], 3, 2},
+			{&Texels[41], 1, 1}};
+
+		glm::generateMipmaps(Levels, 3, Filters[f], glm::wrap_mirror_repeat);
+		for(std::size_t i = 35; i < Texels.size(); ++i)
+			Error += Texels[i] == glm::u8vec4(200, 100, 50, 255) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+static int test_generateMipmapChain()
+{
+	int Error = 0;
+
+	Error += glm::mipmapChainSize(glm::ivec2(4, 4)) == 21 ? 0 : 1;
+	Error += glm::mipmapChainSize(glm::ivec2(5, 3)) == 18 ? 0 : 1;
+	Error += glm::mipmapLevelOffset(glm::ivec2(5, 3), 2) == 17 ? 0 : 1;
+	Error += glm::mipmapLevelExtent(glm::ivec2(5, 3), 1) == glm::ivec2(2, 1) ? 0 : 1;
+
+	// RGBA32F, matches generateMipmaps with the box filter
+	{
+		std::vector<glm::vec4> Chain(glm::mipmapChainSize(glm::ivec2(4, 4)), glm::vec4(0.0f));
+		for(std::size_t i = 0; i < 16; ++i)
+			Chain[i] = glm::vec4(static_cast<float>(i));
+
+		glm::generateMipmapChain(&Chain[0], glm::ivec2(4, 4), false);
+		Error += glm::all(glm::equal(Chain[16], glm::vec4(2.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Chain[19], glm::vec4(12.5f), 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::equal(Chain[20], glm::vec4(7.5f), 0.0001f)) ? 0 : 1;
+
+		glm::texture_image<glm::vec4> Levels[3];
+		glm::mipmapChainLevels(&Chain[0], glm::ivec2(4, 4), Levels);
+		Error += Levels[1].data == &Chain[16] && Levels[1].width == 2 && Levels[2].height == 1 ? 0 : 1;
+	}
+
+	// RGBA8 sRGB, black and white average to linear 0.5, not to sRGB 0.5
+	{
+		std::vector<glm::u8vec4> Chain(glm::mipmapChainSize(glm::ivec2(2, 2)), glm::u8vec4(0));
+		Chain[0] = glm::u8vec4(0, 0, 0, 0);
+		Chain[1] = glm::u8vec4(255, 255, 255, 255);
+		Chain[2] = glm::u8vec4(255, 255, 255, 255);
+		Chain[3] = glm::u8vec4(0, 0, 0, 0);
+
+		glm::generateMipmapChain(&Chain[0], glm::ivec2(2, 2), true);
+		Error += Chain[4].x >= 187 && Chain[4].x <= 188 ? 0 : 1;
+		Error += Chain[4].w == 128 ? 0 : 1;
+
+		glm::generateMipmapChain(&Chain[0], glm::ivec2(2, 2), false);
+		Error += Chain[4].x == 128 ? 0 : 1;
+	}
+
+	// RGBA16F, constant non power of two images stay constant
+	{
+		glm::u16vec4 const Half = glm::packHalf(glm::vec4(0.25f, 0.5f, 1.0f, 1.0f));
+		std::vector<glm::u16vec4> Chain(glm::mipmapChainSize(glm::ivec2(7, 5)), Half);
+
+		glm::generateMipmapChain(&Chain[0], glm::ivec2(7, 5), true);
+		for(std::size_t i = 35; i < Chain.size(); ++i)
+			Error += Chain[i] == Half ? 0 : 1;
+	}
+
+	// Row ranges processed separately give the same chain
+	{
+		glm::ivec2 const Extent(37, 19);
+		std::vector<glm::u8vec4> Chain(glm::mipmapChainSize(Extent), glm::u8vec4(0));
+		for(std::size_t i = 0; i < static_cast<std::size_t>(Extent.x * Extent.y); ++i)
+			Chain[i] = glm::u8vec4(static_cast<glm::uint8>(i * 7), static_cast<glm::uint8>(i * 13), static_cast<glm::uint8>(i), 255);
+		std::vector<glm::u8vec4> Rows(Chain);
+
+		glm::generateMipmapChain(&Chain[0], Extent, true);
+		for(int Level = 1; Level < glm::levels(Extent); ++Level)
+			for(int Row = 0; Row < glm::mipmapLevelExtent(Extent, Level).y; Row += 3)
+				glm::downsampleMipmapRows(&Rows[0], Extent, Level, Row, 3, true);
+
+		Error += Chain == Rows ? 0 : 1;
+
+		// Tiles sharing one prepared filter per level, in reverse row order
+		std::vector<glm::u8vec4> Tiles(Rows.begin(), Rows.begin() + Extent.x * Extent.y);
+		Tiles.resize(Chain.size(), glm::u8vec4(0));
+		glm::mipmap_level_filter Filter;
+		std::vector<glm::vec4> Scratch(static_cast<std::size_t>(Extent.x));
+		for(int Level = 1; Level < glm::levels(Extent); ++Level)
+		{
+			glm::prepareMipmapLevel(Extent, Level, true, Filter);
+			for(int Row = (Filter.extent.y - 1) / 4 * 4; Row >= 0; Row -= 4)
+				glm::downsampleMipmapRows(&Tiles[0], Filter, Row, 4, &Scratch[0]);
+		}
+
+		Error += Chain == Tiles ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_wrapTexel();
+	Error += test_sampleBilinear();
+	Error += test_sampleBilinearBatch();
+	Error += test_generateMipmaps();
+	Error += test_generateMipmapChain();
+
+	return Error;
+}